@@ -0,0 +1,106 @@
+import csv,re,sys
+import argparse
+
+# Fits the media copy cost model (media_copy_cost_model.h) of a platform from
+# the RawPerfData.csv MediaPerfParser writes for copy runs: one run copying
+# linear surfaces and one copying tiled surfaces, each over a range of sizes
+# on every engine. Per engine the copy time is fitted as
+#     time_us = setupUs + bytes / bytesPerUs
+# and the MCPY_COST_TABLE initializer to hand to MediaCopyCostModel::SetTable
+# is printed.
+
+ENGINES = ('VEBOX', 'BLT', 'RENDER')
+
+def engine_of(name, patterns):
+    for engine in ENGINES:
+        if re.search(patterns[engine], name, re.IGNORECASE):
+            return engine
+    return None
+
+def read_samples(file_path, args, patterns):
+    samples = {engine: [] for engine in ENGINES}
+    scale = {'ms': 1000.0, 'us': 1.0, 'ns': 0.001}[args.time_unit]
+    with open(file_path, 'r', errors="ignore") as fh:
+        for row in csv.DictReader(fh, skipinitialspace=True):
+            row = {k.strip(): v for k, v in row.items() if k}
+            if not re.search(args.tag, row.get('PERF_TAG', ''), re.IGNORECASE):
+                continue
+            engine = engine_of(row.get('Engine', ''), patterns)
+            if engine is None:
+                continue
+            try:
+                time_us = float(row['Time']) * scale
+                size = float(row[args.bytes_column]) * 1024 * 1024
+            except (KeyError, ValueError):
+                continue
+            if size > 0 and time_us > 0:
+                samples[engine].append((size, time_us))
+    return samples
+
+def fit(samples):
+    # least squares of time_us = setup + size * usPerByte
+    n = len(samples)
+    if n < 2:
+        return None
+    sx = sum(s for s, t in samples)
+    sy = sum(t for s, t in samples)
+    sxx = sum(s * s for s, t in samples)
+    sxy = sum(s * t for s, t in samples)
+    det = n * sxx - sx * sx
+    if det <= 0:
+        return None
+    usPerByte = (n * sxy - sx * sy) / det
+    setup = (sy - usPerByte * sx) / n
+    if usPerByte <= 0:
+        return None
+    return int(round(1.0 / usPerByte)), max(0, int(round(setup)))
+
+def calibrate(file_path, args, patterns):
+    result = {}
+    for engine, samples in read_samples(file_path, args, patterns).items():
+        result[engine] = fit(samples)
+        if result[engine] is None:
+            print('warning: %s: not enough %s copies of different sizes, keeping the default' % (file_path, engine), file=sys.stderr)
+    return result
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Fit the media copy cost table from MediaPerfParser raw data')
+    parser.add_argument('-l', '--linear', help='RawPerfData.csv of the linear copies', required=True)
+    parser.add_argument('-t', '--tiled', help='RawPerfData.csv of the tiled copies', required=True)
+    parser.add_argument('-r', '--resolve', help='RawPerfData.csv of the resolves of compressed surfaces')
+    parser.add_argument('--tag', default='COPY', help='regex of the PERF_TAG of the copies')
+    parser.add_argument('--resolve-tag', default='DECOMP|RESOLVE', help='regex of the PERF_TAG of the resolves')
+    parser.add_argument('--bytes-column', default='Read Traffic (MB)', help='column with the MB copied')
+    parser.add_argument('--time-unit', default='ms', choices=['ms', 'us', 'ns'], help='unit of the Time column')
+    parser.add_argument('--vebox', default='ve', help='regex of the vebox engine names')
+    parser.add_argument('--blt', default='bl|bcs|copy', help='regex of the blitter engine names')
+    parser.add_argument('--render', default='render|rcs|ccs|3d|compute', help='regex of the render engine names')
+    args = parser.parse_args()
+
+    patterns = {'VEBOX': args.vebox, 'BLT': args.blt, 'RENDER': args.render}
+    defaults = {'VEBOX': (10000, 20000, 30), 'BLT': (16000, 12000, 15), 'RENDER': (20000, 40000, 60)}
+
+    linear = calibrate(args.linear, args, patterns)
+    tiled = calibrate(args.tiled, args, patterns)
+
+    resolve = 30000
+    if args.resolve:
+        args.tag = args.resolve_tag
+        samples = sum(read_samples(args.resolve, args, {e: '.' for e in ENGINES}).values(), [])
+        fitted = fit(samples)
+        if fitted is None:
+            print('warning: %s: not enough resolves of different sizes, keeping the default' % args.resolve, file=sys.stderr)
+        else:
+            resolve = fitted[0]
+
+    print('const MCPY_COST_TABLE table =')
+    print('{')
+    print('    {')
+    for engine in ENGINES:
+        linearRate, linearSetup = linear[engine] or (defaults[engine][0], defaults[engine][2])
+        tiledRate, tiledSetup = tiled[engine] or (defaults[engine][1], defaults[engine][2])
+        setup = (linearSetup + tiledSetup) // 2
+        print('        {%d, %d, %d},%s// MCPY_ENGINE_%s' % (linearRate, tiledRate, setup, ' ' * max(1, 20 - len('%d, %d, %d' % (linearRate, tiledRate, setup))), engine))
+    print('    },')
+    print('    %d,%s// resolve' % (resolve, ' ' * max(1, 24 - len(str(resolve)))))
+    print('};')
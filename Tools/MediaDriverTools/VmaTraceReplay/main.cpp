@@ -0,0 +1,333 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     main.cpp
+//! \brief    Replays a GPU virtual address alloc/free trace on mos_vma and on
+//!           the linear hole list it replaced, checking both hand out the
+//!           same addresses and timing them.
+//!
+//!           Trace format, one operation per line, '#' starts a comment:
+//!             a <id> <size> <alignment>   allocate, remember the address as <id>
+//!             f <id>                      free the allocation <id>
+//!
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+#include "mos_vma.h"
+
+// Same range as MEMZONE_SYS of the i915 buffer manager
+#define TRACE_HEAP_START    (1ull << 16)
+#define TRACE_HEAP_SIZE     ((1ull << 40) - TRACE_HEAP_START)
+#define TRACE_PAGE_SIZE     4096ull
+
+struct TraceOp
+{
+    bool     alloc;
+    uint32_t id;
+    uint64_t size;
+    uint64_t alignment;
+};
+
+//!
+//! \brief  The hole list allocator mos_vma used before, kept as reference
+//!
+class LinearVmaHeap
+{
+public:
+    LinearVmaHeap(uint64_t start, uint64_t size, bool allocHigh) : m_allocHigh(allocHigh)
+    {
+        Free(start, size);
+    }
+
+    uint64_t Alloc(uint64_t size, uint64_t alignment)
+    {
+        if (m_allocHigh)
+        {
+            for (auto it = m_holes.begin(); it != m_holes.end(); ++it)
+            {
+                if (size > it->size)
+                    continue;
+                uint64_t offset = ((it->size - size) + it->offset) / alignment * alignment;
+                if (offset < it->offset)
+                    continue;
+                Take(it, offset, size);
+                return offset;
+            }
+        }
+        else
+        {
+            for (auto rit = m_holes.rbegin(); rit != m_holes.rend(); ++rit)
+            {
+                if (size > rit->size)
+                    continue;
+                uint64_t offset   = rit->offset;
+                uint64_t misalign = offset % alignment;
+                if (misalign)
+                {
+                    uint64_t pad = alignment - misalign;
+                    if (pad > rit->size - size)
+                        continue;
+                    offset += pad;
+                }
+                Take(std::prev(rit.base()), offset, size);
+                return offset;
+            }
+        }
+        return 0;
+    }
+
+    void Free(uint64_t offset, uint64_t size)
+    {
+        auto low = m_holes.begin();
+        while (low != m_holes.end() && low->offset > offset)
+            ++low;
+        auto high = (low == m_holes.begin()) ? m_holes.end() : std::prev(low);
+
+        bool highAdjacent = high != m_holes.end() && offset + size == high->offset;
+        bool lowAdjacent  = low != m_holes.end() && low->offset + low->size == offset;
+
+        if (lowAdjacent && highAdjacent)
+        {
+            low->size += size + high->size;
+            m_holes.erase(high);
+        }
+        else if (lowAdjacent)
+        {
+            low->size += size;
+        }
+        else if (highAdjacent)
+        {
+            high->offset = offset;
+            high->size += size;
+        }
+        else
+        {
+            m_holes.insert(low, Hole{offset, size});
+        }
+    }
+
+private:
+    struct Hole
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    void Take(std::list<Hole>::iterator hole, uint64_t offset, uint64_t size)
+    {
+        if (offset == hole->offset && size == hole->size)
+        {
+            m_holes.erase(hole);
+            return;
+        }
+        uint64_t waste = (hole->size - size) - (offset - hole->offset);
+        if (waste == 0)
+        {
+            hole->size -= size;
+            return;
+        }
+        if (offset == hole->offset)
+        {
+            hole->offset += size;
+            hole->size -= size;
+            return;
+        }
+        m_holes.insert(hole, Hole{offset + size, waste});
+        hole->size = offset - hole->offset;
+    }
+
+    std::list<Hole> m_holes;  // ordered from high to low addresses
+    bool m_allocHigh;
+};
+
+static bool LoadTrace(const char *path, std::vector<TraceOp> &ops)
+{
+    FILE *file = fopen(path, "r");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    uint32_t lineNumber = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        lineNumber++;
+        TraceOp op = {};
+        unsigned long long size = 0, alignment = 0;
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+        else if (sscanf(line, "a %u %llu %llu", &op.id, &size, &alignment) == 3 && size && alignment)
+        {
+            op.alloc     = true;
+            op.size      = size;
+            op.alignment = alignment;
+        }
+        else if (sscanf(line, "f %u", &op.id) == 1)
+        {
+            op.alloc = false;
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: malformed operation\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+        ops.push_back(op);
+    }
+
+    fclose(file);
+    return true;
+}
+
+//!
+//! \brief  Print a trace resembling many decode streams: long lived DPB
+//!         surfaces with a churn of small command and status buffers
+//!
+static void GenerateTrace(uint32_t numOps, uint32_t maxLive, uint32_t seed)
+{
+    static const uint64_t sizes[] = {
+        4096, 8192, 65536, 2 * 1024 * 1024,                 // batch, status and state buffers
+        1382400 * 2, 3110400 * 2, 12441600 * 2,             // 720p/1080p/4K DPB surfaces with metadata
+    };
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> live;
+    uint32_t nextId = 0;
+
+    printf("# VmaTraceReplay --generate %u %u %u\n", numOps, maxLive, seed);
+    for (uint32_t i = 0; i < numOps; i++)
+    {
+        bool alloc = live.empty() || (live.size() < maxLive && (rng() % 100) < 55);
+        if (alloc)
+        {
+            uint64_t size      = sizes[rng() % (sizeof(sizes) / sizeof(sizes[0]))];
+            uint64_t alignment = (rng() % 4 == 0) ? 65536 : TRACE_PAGE_SIZE;
+            size = (size + TRACE_PAGE_SIZE - 1) / TRACE_PAGE_SIZE * TRACE_PAGE_SIZE;
+            printf("a %u %llu %llu\n", nextId, (unsigned long long)size, (unsigned long long)alignment);
+            live.push_back(nextId++);
+        }
+        else
+        {
+            uint32_t index = rng() % live.size();
+            printf("f %u\n", live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+}
+
+template <class AllocFunc, class FreeFunc>
+static double Replay(const std::vector<TraceOp> &ops, std::vector<uint64_t> &addresses, AllocFunc alloc, FreeFunc release)
+{
+    std::map<uint32_t, std::pair<uint64_t, uint64_t>> live;
+    addresses.clear();
+    addresses.reserve(ops.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto &op : ops)
+    {
+        if (op.alloc)
+        {
+            uint64_t address = alloc(op.size, op.alignment);
+            addresses.push_back(address);
+            if (address)
+            {
+                live[op.id] = std::make_pair(address, op.size);
+            }
+        }
+        else
+        {
+            auto it = live.find(op.id);
+            if (it != live.end())
+            {
+                release(it->second.first, it->second.second);
+                live.erase(it);
+            }
+            addresses.push_back(0);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && strcmp(argv[1], "--generate") == 0)
+    {
+        GenerateTrace(atoi(argv[2]), atoi(argv[3]), argc > 4 ? atoi(argv[4]) : 1);
+        return 0;
+    }
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: VmaTraceReplay <trace file> [--low]\n");
+        fprintf(stderr, "       VmaTraceReplay --generate <operations> <max live> [seed] > <trace file>\n");
+        return -1;
+    }
+
+    bool allocHigh = !(argc > 2 && strcmp(argv[2], "--low") == 0);
+
+    std::vector<TraceOp> ops;
+    if (!LoadTrace(argv[1], ops))
+    {
+        return -1;
+    }
+
+    std::vector<uint64_t> vmaAddresses, linearAddresses;
+
+    mos_vma_heap heap;
+    mos_vma_heap_init(&heap, TRACE_HEAP_START, TRACE_HEAP_SIZE);
+    heap.alloc_high = allocHigh;
+    double vmaTime = Replay(ops, vmaAddresses,
+        [&](uint64_t size, uint64_t alignment) { return mos_vma_heap_alloc(&heap, size, alignment); },
+        [&](uint64_t offset, uint64_t size) { mos_vma_heap_free(&heap, offset, size); });
+    mos_vma_heap_finish(&heap);
+
+    LinearVmaHeap linear(TRACE_HEAP_START, TRACE_HEAP_SIZE, allocHigh);
+    double linearTime = Replay(ops, linearAddresses,
+        [&](uint64_t size, uint64_t alignment) { return linear.Alloc(size, alignment); },
+        [&](uint64_t offset, uint64_t size) { linear.Free(offset, size); });
+
+    for (size_t i = 0; i < ops.size(); i++)
+    {
+        if (vmaAddresses[i] != linearAddresses[i])
+        {
+            fprintf(stderr, "Mismatch at operation %zu: mos_vma 0x%llx, linear 0x%llx\n", i,
+                (unsigned long long)vmaAddresses[i], (unsigned long long)linearAddresses[i]);
+            return -1;
+        }
+    }
+
+    printf("%zu operations, %s addresses first\n", ops.size(), allocHigh ? "high" : "low");
+    printf("mos_vma:    %10.3f ms\n", vmaTime);
+    printf("hole list:  %10.3f ms\n", linearTime);
+    return 0;
+}
@@ -40,6 +40,7 @@
 #include "media_common_defs.h"
 
 class XRenderHal_Platform_Interface;
+class RenderHalKernelIndex;
 
 //------------------------------------------------------------------------------
 // Macros specific to RenderHal sub-comp
@@ -959,6 +960,7 @@ typedef struct _RENDERHAL_STATE_HEAP
 
     // Arrays created dynamically
     PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;                              // Kernel allocation table (or linked list)
+    RenderHalKernelIndex        *pKernelIndex;                                  // Kernel allocation table index by KUID/KCID, free entries and last use
 
     // Dynamic Kernel States
     PMHW_MEMORY_POOL               pKernelAllocMemPool;                         // Kernel states memory pool (mallocs)
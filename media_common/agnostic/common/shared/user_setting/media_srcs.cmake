@@ -23,6 +23,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_user_setting_value.h
     ${CMAKE_CURRENT_LIST_DIR}/media_user_setting_configure.h
     ${CMAKE_CURRENT_LIST_DIR}/media_user_setting_definition.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_user_setting_read_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/media_user_setting.h
 )
 
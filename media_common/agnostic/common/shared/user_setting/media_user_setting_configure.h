@@ -28,6 +28,7 @@
 #define __MEDIA_USER_SETTING_CONFIGURE__H__
 
 #include <string>
+#include <vector>
 #include "media_user_setting_definition.h"
 #include "mos_utilities.h"
 
@@ -104,6 +105,8 @@ public:
     //!           Whether use costom value when failed
     //! \return   MOS_STATUS
     //!           MOS_STATUS_SUCCESS if no error,MOS_STATUS_USER_FEATURE_KEY_OPEN_FAILED if user setting is not set, otherwise will return specific failed reason
+    //! \note     Internal items are read from registry and environment once, until Write
+    //!           changes the item. Environment variables changed after that read are not seen.
     //!
     MOS_STATUS Read(Value &value,
         const std::string &itemName,
@@ -214,6 +217,23 @@ protected:
 
     const uint32_t GetRegAccessDataType(MOS_USER_FEATURE_VALUE_TYPE type);
 
+    //!
+    //! \brief    Publish the parsed result of reading an internal item
+    //! \param    [in] def
+    //!           Definition of the item
+    //! \param    [in] generation
+    //!           Read cache generation of the item taken before the read
+    //! \param    [in] status
+    //!           Status of the registry and environment read
+    //! \param    [in] value
+    //!           The value read, only kept if status is success
+    //!
+    void PublishReadResult(
+        const std::shared_ptr<Definition> &def,
+        uint64_t generation,
+        MOS_STATUS status,
+        const Value &value);
+
 protected:
     MosMutex m_mutexLock; //!< mutex for protecting definitions
     Definitions m_definitions[Group::MaxCount]{}; //!< definitions of media user setting
@@ -227,6 +247,7 @@ protected:
     static const std::map<uint32_t, ExtPathCFG> m_pathOption;
     std::string                                 m_statedConfigPath = "";
     std::string                                 m_statedReportPath = "";
+    RetiredResults<ReadResult>                  m_staleReadResults;  //!< read results withdrawn by Write, protected by m_mutexLock
 };
 }
 }
@@ -33,6 +33,7 @@
 #include <iosfwd>
 #include "mos_defs_specific.h"
 #include "media_user_setting_value.h"
+#include "media_user_setting_read_cache.h"
 
 namespace MediaUserSetting {
 
@@ -55,6 +56,16 @@ enum Group
 
 namespace Internal {
 
+//!
+//! \brief   Parsed result of reading an item from registry or environment.
+//!          Immutable once published on its definition.
+//!
+struct ReadResult
+{
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    Value      value{};
+};
+
 class Definition
 {
 public:
@@ -156,6 +167,13 @@ public:
     //!           the custom path
     //!
     bool UseStatePath() const { return m_statePath; }
+
+    //!
+    //! \brief    Get the read cache of the definition
+    //! \return   ReadCache<ReadResult> &
+    //!           the cache, not copied with the definition
+    //!
+    ReadCache<ReadResult> &GetReadCache() { return m_readCache; }
 private:
     //!
     //! \brief    Set the values of definition
@@ -173,6 +191,7 @@ private:
     std::string m_subPath{};    //!< custome path is a relative path, it could be null
     UFKEY_NEXT m_rootKey{};    //!< root key
     bool m_statePath      = true;    //!< Whether the item read from a specific path
+    ReadCache<ReadResult> m_readCache; //!< Cached read result, protected by the configure lock
 };
 
 using Definitions = std::map<std::size_t, std::shared_ptr<Definition>>;
@@ -0,0 +1,181 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_user_setting_read_cache.h
+//! \brief    Cache of the parsed read result of a media user setting item
+//!
+
+#ifndef __MEDIA_USER_SETTING_READ_CACHE__H__
+#define __MEDIA_USER_SETTING_READ_CACHE__H__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace MediaUserSetting {
+namespace Internal {
+
+//!
+//! \brief   Holds the read result of an item, published once and withdrawn by writes.
+//!          Get is lock free. GetGeneration, Publish and Withdraw must be called under
+//!          the lock serializing writes of the item, the owner allocates and frees results.
+//!          A reader takes the generation before reading the registry and publishes with
+//!          it, so a result parsed before a write can never be published after the write.
+//!
+template <class Result>
+class ReadCache
+{
+public:
+    ReadCache() = default;
+    ReadCache(const ReadCache &) = delete;
+    ReadCache &operator=(const ReadCache &) = delete;
+
+    //!
+    //! \brief    Get the published result
+    //! \return   const Result *
+    //!           the result, nullptr if none is published
+    //!
+    const Result *Get() const { return m_result.load(std::memory_order_acquire); }
+
+    //!
+    //! \brief    Get the write generation, call with the lock held
+    //! \return   uint64_t
+    //!           number of writes withdrawing the result so far
+    //!
+    uint64_t GetGeneration() const { return m_generation; }
+
+    //!
+    //! \brief    Publish a result, call with the lock held
+    //! \param    [in] result
+    //!           Result to publish, owned by the cache on success
+    //! \param    [in] generation
+    //!           Generation taken before the result was read
+    //! \return   bool
+    //!           false if a write happened since or another result was published first
+    //!
+    bool Publish(Result *result, uint64_t generation)
+    {
+        if (generation != m_generation || m_result.load(std::memory_order_relaxed) != nullptr)
+        {
+            return false;
+        }
+        m_result.store(result, std::memory_order_release);
+        return true;
+    }
+
+    //!
+    //! \brief    Withdraw the result and start a new generation, call with the lock held
+    //! \return   Result *
+    //!           the withdrawn result, which lock free readers may still hold
+    //!
+    Result *Withdraw()
+    {
+        ++m_generation;
+        return m_result.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<Result *> m_result{nullptr}; //!< Published result
+    uint64_t              m_generation = 0;  //!< Bumped by every withdraw
+};
+
+//!
+//! \brief   Results withdrawn from read caches, freed once no lock free reader can hold them.
+//!          Readers bracket Get and the use of the result with Enter and Leave. Retire and
+//!          Reclaim must be called under the lock serializing writes, after the withdraw.
+//!          A reader entering after the withdraw can only get the new result, so results
+//!          retired while no reader is inside are safe to free.
+//!
+template <class Result>
+class RetiredResults
+{
+public:
+    RetiredResults() = default;
+    RetiredResults(const RetiredResults &) = delete;
+    RetiredResults &operator=(const RetiredResults &) = delete;
+
+    //!
+    //! \brief    Start a lock free read of a cache
+    //!
+    void Enter() { m_readers.fetch_add(1, std::memory_order_seq_cst); }
+
+    //!
+    //! \brief    End a lock free read, the result got must not be used after this
+    //!
+    void Leave() { m_readers.fetch_sub(1, std::memory_order_release); }
+
+    //!
+    //! \brief    Keep a withdrawn result until it can be freed, call with the lock held
+    //! \param    [in] result
+    //!           Result returned by ReadCache::Withdraw, may be nullptr
+    //!
+    void Retire(Result *result)
+    {
+        if (result != nullptr)
+        {
+            m_retired.push_back(result);
+        }
+    }
+
+    //!
+    //! \brief    Free the retired results if no reader is inside, call with the lock held
+    //! \param    [in] free
+    //!           Callable freeing one result
+    //! \return   size_t
+    //!           number of results freed
+    //!
+    template <class Free>
+    size_t Reclaim(Free free)
+    {
+        if (m_retired.empty())
+        {
+            return 0;
+        }
+        // Orders the withdraw before the reader count, pairs with the increment in Enter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_readers.load(std::memory_order_acquire) != 0)
+        {
+            return 0;
+        }
+        size_t count = m_retired.size();
+        for (Result *result : m_retired)
+        {
+            free(result);
+        }
+        m_retired.clear();
+        return count;
+    }
+
+    //!
+    //! \brief    Get the number of results waiting to be freed, call with the lock held
+    //! \return   size_t
+    //!
+    size_t GetCount() const { return m_retired.size(); }
+
+private:
+    std::atomic<uint32_t> m_readers{0}; //!< Lock free readers inside Enter and Leave
+    std::vector<Result *> m_retired;    //!< Withdrawn results not freed yet
+};
+
+}
+}
+#endif // __MEDIA_USER_SETTING_READ_CACHE__H__
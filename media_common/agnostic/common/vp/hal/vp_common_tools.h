@@ -160,6 +160,8 @@ typedef struct _VP_CONFIG
     bool       bAdvancedScalingInUseReported;      // Reported Advanced Scaling Enabled
     bool       isPacketReused;              // true if vp packet reused.
     bool       isPacketReusedReported;      // Reported vp packet reused.
+    uint32_t   dwCompBbHits;                // Composition batch buffers reused
+    uint32_t   dwCompBbMisses;              // Composition batch buffers not found for reuse
 
     // Configurations for cache control
     uint32_t   dwDndiReferenceBuffer;
@@ -148,7 +148,11 @@ CmDeviceRTBase::CmDeviceRTBase(uint32_t options):
     m_hasGpuInitKernel(false),
     m_kernelsLoaded(0),
     m_preloadKernelEnabled(true),
-    m_queuePriority(CM_DEVICE_CREATE_PRIORITY_DEFAULT)
+    m_queuePriority(CM_DEVICE_CREATE_PRIORITY_DEFAULT),
+    m_copyKernelParamArray(CM_INIT_GPUCOPY_KERNL_COUNT),
+    m_copyKernelParamArrayCount(0),
+    m_copyKernelHitCount(0),
+    m_copyKernelMissCount(0)
 {
     //Initialize the structures in the class
     MOS_ZeroMemory(&m_halMaxValues, sizeof(m_halMaxValues));
@@ -213,6 +217,15 @@ void CmDeviceRTBase::DestructCommon()
         pCmData->cmHalState->advExecutor->WaitForAllTasksFinished();
     }
 
+    // GPU copy kernels themselves are destroyed with the other kernels below
+    for( uint32_t i = 0; i < m_copyKernelParamArrayCount; i ++ )
+    {
+        CM_GPUCOPY_KERNEL *gpuCopyParam = (CM_GPUCOPY_KERNEL*)m_copyKernelParamArray.GetElement( i );
+        CmSafeDelete(gpuCopyParam);
+    }
+    m_copyKernelParamArray.Delete();
+    m_copyKernelParamArrayCount = 0;
+
     for( uint32_t i = 0; i < m_kernelCount; i ++ )
     {
         CmKernelRT* kernel = (CmKernelRT*)m_kernelArray.GetElement( i );
@@ -406,6 +419,12 @@ int32_t CmDeviceRTBase::Initialize(MOS_CONTEXT *mosContext)
         {
             m_hasGpuInitKernel = true;
         }
+
+        // Best effort, copies fall back to creating kernels on first use
+        if (m_hasGpuCopyKernel)
+        {
+            PrewarmGPUCopyKernels();
+        }
     }
 
     // prepare GPU predefined queue/kernel/task for surface init
@@ -896,6 +915,19 @@ CSync* CmDeviceRTBase::GetQueueLock()
     return &m_criticalSectionQueue;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get the lock serializing HAL execution on a GPU context
+//| Returns:    Pointer to the lock, or nullptr for an invalid context.
+//*-----------------------------------------------------------------------------
+CSync* CmDeviceRTBase::GetGpuContextExecuteLock(MOS_GPU_CONTEXT gpuContext)
+{
+    if (gpuContext < 0 || gpuContext >= MOS_GPU_CONTEXT_MAX)
+    {
+        return nullptr;
+    }
+    return &m_criticalSectionGpuContextExecute[gpuContext];
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Get Max values from Device
 //| Returns:    Result of the operation.
@@ -2740,6 +2772,357 @@ int32_t CmDeviceRTBase::LoadPredefinedInitKernel(CmProgram*& program)
     return hr;
 }
 
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       AcquireGPUCopyKernel()
+//| Purpose:    Get an idle GPUCopy kernel matching the copy, creating one if none is cached.
+//|             The returned kernel is locked until ReleaseGPUCopyKernel() is called.
+//| Arguments:
+//|             widthInByte      [in]  surface's width in bytes
+//|             height           [in]  surface's height
+//|             format           [in]  surface's format
+//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
+//|             kernelParam      [out] kernel param
+//|
+//| Returns:    Result of the operation.
+//|
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmDeviceRTBase::AcquireGPUCopyKernel(uint32_t widthInByte,
+                                             uint32_t height,
+                                             CM_SURFACE_FORMAT format,
+                                             CM_GPUCOPY_DIRECTION copyDirection,
+                                             CM_GPUCOPY_KERNEL* &kernelParam)
+{
+    int32_t              hr           = CM_SUCCESS;
+    CM_GPUCOPY_KERNEL_ID kernelTypeID = GPU_COPY_KERNEL_UNKNOWN;
+
+    kernelParam = nullptr;
+    CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyKrnID(widthInByte, height, format, copyDirection, kernelTypeID));
+
+    {
+        // Search and lock in one step so two queues never get the same kernel
+        CLock locker(m_criticalSectionGPUCopyKrn);
+
+        for (uint32_t index = 0; index < m_copyKernelParamArrayCount; index++)
+        {
+            CM_GPUCOPY_KERNEL *gpuCopyKernel = (CM_GPUCOPY_KERNEL*)m_copyKernelParamArray.GetElement(index);
+            if (gpuCopyKernel != nullptr &&
+                !gpuCopyKernel->locked &&
+                gpuCopyKernel->kernelID == kernelTypeID)
+            {
+                gpuCopyKernel->locked = true;
+                kernelParam = gpuCopyKernel;
+                m_copyKernelHitCount++;
+                goto finish;
+            }
+        }
+        m_copyKernelMissCount++;
+    }
+
+    kernelParam = new (std::nothrow) CM_GPUCOPY_KERNEL;
+    CM_CHK_NULL_GOTOFINISH_CMERROR(kernelParam);
+    CmSafeMemSet(kernelParam, 0, sizeof(CM_GPUCOPY_KERNEL));
+
+    CM_CHK_CMSTATUS_GOTOFINISH(AllocateGPUCopyKernel(widthInByte, height, format, copyDirection, kernelParam->kernel));
+    kernelParam->kernelID = kernelTypeID;
+    kernelParam->locked   = true;
+
+    {
+        CLock locker(m_criticalSectionGPUCopyKrn);
+        if (!m_copyKernelParamArray.SetElement(m_copyKernelParamArrayCount, kernelParam))
+        {
+            CM_ASSERTMESSAGE("Error: Out of system memory.");
+            hr = CM_OUT_OF_HOST_MEMORY;
+        }
+        else
+        {
+            m_copyKernelParamArrayCount++;
+        }
+    }
+
+finish:
+    if (hr != CM_SUCCESS && kernelParam != nullptr)
+    {
+        if (kernelParam->kernel)
+        {
+            DestroyKernel(kernelParam->kernel);
+        }
+        CmSafeDelete(kernelParam);
+    }
+    return hr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       ReleaseGPUCopyKernel()
+//| Purpose:    Return a GPUCopy kernel to the cache once its task has been enqueued
+//*---------------------------------------------------------------------------------------------------------
+void CmDeviceRTBase::ReleaseGPUCopyKernel(CM_GPUCOPY_KERNEL *kernelParam)
+{
+    CLock locker(m_criticalSectionGPUCopyKrn);
+    kernelParam->locked = false;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       PrewarmGPUCopyKernels()
+//| Purpose:    Create the GPUCopy kernels used by common 720p, 1080p and 4K NV12, P010 and ARGB
+//|             copies, so that the first copy of those shapes does not pay for kernel creation.
+//|             Kernels are keyed by copy type, so shapes sharing a type share one kernel.
+//| Returns:    Result of the operation.
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmDeviceRTBase::PrewarmGPUCopyKernels()
+{
+    static const uint32_t widths[]  = { 1280, 1920, 3840 };
+    static const uint32_t heights[] = { 720, 1080, 2160 };
+    static const struct
+    {
+        CM_SURFACE_FORMAT format;
+        uint32_t          bytesPerPixel;
+    } formats[] = {
+        { CM_SURFACE_FORMAT_NV12,     1 },
+        { CM_SURFACE_FORMAT_P010,     2 },
+        { CM_SURFACE_FORMAT_A8R8G8B8, 4 } };
+    static const CM_GPUCOPY_DIRECTION directions[] = {
+        CM_FASTCOPY_CPU2GPU, CM_FASTCOPY_GPU2CPU, CM_FASTCOPY_GPU2GPU };
+
+    int32_t hr = CM_SUCCESS;
+
+    if (!m_hasGpuCopyKernel)
+    {
+        return CM_NOT_IMPLEMENTED;
+    }
+
+    for (uint32_t i = 0; i < sizeof(widths) / sizeof(widths[0]); i++)
+    {
+        for (uint32_t j = 0; j < sizeof(formats) / sizeof(formats[0]); j++)
+        {
+            for (uint32_t k = 0; k < sizeof(directions) / sizeof(directions[0]); k++)
+            {
+                uint32_t             widthInByte  = widths[i] * formats[j].bytesPerPixel;
+                CM_GPUCOPY_KERNEL_ID kernelTypeID = GPU_COPY_KERNEL_UNKNOWN;
+                bool                 cached       = false;
+
+                CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyKrnID(widthInByte, heights[i], formats[j].format, directions[k], kernelTypeID));
+
+                m_criticalSectionGPUCopyKrn.Acquire();
+                for (uint32_t index = 0; index < m_copyKernelParamArrayCount; index++)
+                {
+                    CM_GPUCOPY_KERNEL *gpuCopyKernel = (CM_GPUCOPY_KERNEL*)m_copyKernelParamArray.GetElement(index);
+                    if (gpuCopyKernel != nullptr && gpuCopyKernel->kernelID == kernelTypeID)
+                    {
+                        cached = true;
+                        break;
+                    }
+                }
+                m_criticalSectionGPUCopyKrn.Release();
+
+                if (!cached)
+                {
+                    CM_GPUCOPY_KERNEL *gpuCopyKernel = nullptr;
+                    CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyKernel(widthInByte, heights[i], formats[j].format, directions[k], gpuCopyKernel));
+                    ReleaseGPUCopyKernel(gpuCopyKernel);
+                }
+            }
+        }
+    }
+
+finish:
+    return hr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       GetGPUCopyKernelCacheStats()
+//| Purpose:    Report how many GPUCopy kernel requests were served by a cached kernel
+//|             and how many had to create a new one.
+//*---------------------------------------------------------------------------------------------------------
+void CmDeviceRTBase::GetGPUCopyKernelCacheStats(uint32_t &hitCount, uint32_t &missCount)
+{
+    CLock locker(m_criticalSectionGPUCopyKrn);
+    hitCount  = m_copyKernelHitCount;
+    missCount = m_copyKernelMissCount;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       GetGPUCopyKrnID()
+//| Purpose:    Calculate the kernel ID accroding surface's width, height and copy direction
+//| Arguments:
+//|             widthInByte      [in]  surface's width in bytes
+//|             height           [in]  surface's height
+//|             format           [in]  surface's height
+//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
+//|             kernelID         [out] kernel id
+//|
+//| Returns:    Result of the operation.
+//|
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmDeviceRTBase::GetGPUCopyKrnID( uint32_t widthInByte, uint32_t height, CM_SURFACE_FORMAT format,
+            CM_GPUCOPY_DIRECTION copyDirection, CM_GPUCOPY_KERNEL_ID &kernelID )
+{
+    int32_t hr = CM_SUCCESS;
+
+    kernelID = GPU_COPY_KERNEL_UNKNOWN;
+
+    if (format == CM_SURFACE_FORMAT_NV12 || format == CM_SURFACE_FORMAT_P010 || format == CM_SURFACE_FORMAT_P016)
+    {
+        switch(copyDirection)
+        {
+            case CM_FASTCOPY_GPU2CPU:
+                if ( (height&0x7) ||(widthInByte&0x7f))
+                {
+                    kernelID = GPU_COPY_KERNEL_GPU2CPU_UNALIGNED_NV12_ID ;
+                }
+                else
+                {   // height 8-row aligned, widthByte 128 multiple
+                    kernelID = GPU_COPY_KERNEL_GPU2CPU_ALIGNED_NV12_ID ;
+                }
+                break;
+
+            case CM_FASTCOPY_CPU2GPU:
+                kernelID = GPU_COPY_KERNEL_CPU2GPU_NV12_ID;
+                break;
+
+            case CM_FASTCOPY_GPU2GPU:
+                kernelID = GPU_COPY_KERNEL_GPU2GPU_NV12_ID;
+                break;
+
+            case CM_FASTCOPY_CPU2CPU:
+                kernelID = GPU_COPY_KERNEL_CPU2CPU_ID;
+                break;
+
+            default :
+                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
+                hr = CM_FAILURE;
+                break;
+        }
+    }
+    else
+    {
+        switch(copyDirection)
+        {
+            case CM_FASTCOPY_GPU2CPU:
+                if ( (height&0x7) ||(widthInByte&0x7f))
+                {
+                    kernelID = GPU_COPY_KERNEL_GPU2CPU_UNALIGNED_ID;
+                }
+                else
+                {   // height 8-row aligned, widthByte 128 multiple
+                    kernelID = GPU_COPY_KERNEL_GPU2CPU_ALIGNED_ID;
+                }
+                break;
+
+            case CM_FASTCOPY_CPU2GPU:
+                kernelID = GPU_COPY_KERNEL_CPU2GPU_ID;
+                break;
+
+            case CM_FASTCOPY_GPU2GPU:
+                kernelID = GPU_COPY_KERNEL_GPU2GPU_ID;
+                break;
+
+            case CM_FASTCOPY_CPU2CPU:
+                kernelID = GPU_COPY_KERNEL_CPU2CPU_ID;
+                break;
+
+            default :
+                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
+                hr = CM_FAILURE;
+                break;
+        }
+    }
+
+    return hr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       AllocateGPUCopyKernel()
+//| Purpose:    Allocate GPUCopy Kernel
+//| Arguments:
+//|             widthInByte      [in]  surface's width in bytes
+//|             height           [in]  surface's height
+//|             format           [in]  surface's height
+//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
+//|             kernel          [out] pointer to created kernel
+//|
+//| Returns:    Result of the operation.
+//|
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmDeviceRTBase::AllocateGPUCopyKernel( uint32_t widthInByte, uint32_t height, CM_SURFACE_FORMAT format,
+            CM_GPUCOPY_DIRECTION copyDirection, CmKernel *&kernel )
+{
+    int32_t          hr                 = CM_SUCCESS;
+    CmProgram       *gpuCopyProgram    = nullptr;
+
+    CM_CHK_CMSTATUS_GOTOFINISH( LoadPredefinedCopyKernel(gpuCopyProgram));
+    CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyProgram);
+
+    if (format == CM_SURFACE_FORMAT_NV12 || format == CM_SURFACE_FORMAT_P010 || format == CM_SURFACE_FORMAT_P016)
+    {
+        switch(copyDirection)
+        {
+            case CM_FASTCOPY_GPU2CPU:
+                if ( (height&0x7) ||(widthInByte&0x7f))
+                {
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_NV12_32x32 ) , kernel,"PredefinedGPUCopyKernel"));
+                }
+                else
+                {   // height 8-row aligned, widthByte 128 multiple
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_NV12_aligned_32x32 ) , kernel,"PredefinedGPUCopyKernel"));
+                }
+                break;
+
+            case CM_FASTCOPY_CPU2GPU:
+                CM_CHK_CMSTATUS_GOTOFINISH( CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_write_NV12_32x32 ), kernel, "PredefinedGPUCopyKernel"));
+                break;
+
+            case CM_FASTCOPY_GPU2GPU:
+                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_2DTo2D_NV12_32x32), kernel, "PredefinedGPUCopyKernel"));
+                break;
+
+            case CM_FASTCOPY_CPU2CPU:
+                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_BufferToBuffer_4k), kernel, "PredefinedGPUCopyKernel"));
+                break;
+
+            default :
+                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
+                hr = CM_FAILURE;
+                break;
+        }
+    }
+    else
+    {
+        switch(copyDirection)
+        {
+            case CM_FASTCOPY_GPU2CPU:
+                if ( (height&0x7) ||(widthInByte&0x7f))
+                {
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_32x32 ) , kernel, "PredefinedGPUCopyKernel"));
+                }
+                else
+                {   // height 8-row aligned, widthByte 128 multiple
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_aligned_32x32  ) , kernel, "PredefinedGPUCopyKernel"));
+                }
+                break;
+
+            case CM_FASTCOPY_CPU2GPU:
+                CM_CHK_CMSTATUS_GOTOFINISH( CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_write_32x32 ), kernel, "PredefinedGPUCopyKernel" ));
+                break;
+
+            case CM_FASTCOPY_GPU2GPU:
+                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_2DTo2D_32x32), kernel, "PredefinedGPUCopyKernel"));
+                break;
+
+            case CM_FASTCOPY_CPU2CPU:
+                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_BufferToBuffer_4k), kernel, "PredefinedGPUCopyKernel"));
+                break;
+
+            default :
+                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
+                hr = CM_FAILURE;
+                break;
+        }
+    }
+
+finish:
+    return hr;
+}
+
 
 //*-----------------------------------------------------------------------------
 //| Purpose:    Prepare program/kernel/task/queue, used by GPU init surface API
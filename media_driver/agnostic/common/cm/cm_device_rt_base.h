@@ -36,6 +36,7 @@
 #include "cm_log.h"
 #include "cm_program.h"
 #include "cm_notifier.h"
+#include "cm_thread_space_order_cache.h"
 
 #if USE_EXTENSION_CODE
 #include "cm_gtpin.h"
@@ -78,6 +79,14 @@ struct CM_OBJECT_COUNT
     int32_t eventCount;
 };
 
+//! \brief    Predefined GPU copy kernel shared by all queues of a device
+struct CM_GPUCOPY_KERNEL
+{
+    CmKernel *kernel;
+    CM_GPUCOPY_KERNEL_ID kernelID;
+    bool locked;
+};
+
 
 //! \brief    Class CmDeviceRTBase definitions
 class CmDeviceRTBase: public CmDevice
@@ -348,8 +357,27 @@ public:
 
     CSync* GetQueueLock();
 
+    CSync* GetGpuContextExecuteLock(MOS_GPU_CONTEXT gpuContext);
+
+    CmThreadSpaceOrderCache* GetThreadSpaceOrderCache()
+    {
+        return &m_threadSpaceOrderCache;
+    }
+
     int32_t LoadPredefinedCopyKernel(CmProgram*& pProgram);
 
+    int32_t AcquireGPUCopyKernel(uint32_t widthInByte,
+                                 uint32_t height,
+                                 CM_SURFACE_FORMAT format,
+                                 CM_GPUCOPY_DIRECTION copyDirection,
+                                 CM_GPUCOPY_KERNEL* &kernelParam);
+
+    void ReleaseGPUCopyKernel(CM_GPUCOPY_KERNEL *kernelParam);
+
+    int32_t PrewarmGPUCopyKernels();
+
+    void GetGPUCopyKernelCacheStats(uint32_t &hitCount, uint32_t &missCount);
+
     int32_t LoadPredefinedInitKernel(CmProgram*& pProgram);
 
     int32_t GetKernelSlot()
@@ -480,6 +508,18 @@ protected:
 
     void DestructCommon();
 
+    int32_t GetGPUCopyKrnID(uint32_t widthInByte,
+                            uint32_t height,
+                            CM_SURFACE_FORMAT format,
+                            CM_GPUCOPY_DIRECTION copyDirection,
+                            CM_GPUCOPY_KERNEL_ID &kernelID);
+
+    int32_t AllocateGPUCopyKernel(uint32_t widthInByte,
+                                  uint32_t height,
+                                  CM_SURFACE_FORMAT format,
+                                  CM_GPUCOPY_DIRECTION copyDirection,
+                                  CmKernel* &kernel);
+
     inline bool IsMediaResetNeeded(uint32_t options)
     {
         return (options & CM_DEVICE_CONFIG_MEDIA_RESET_ENABLE) ? true : false;
@@ -593,6 +633,12 @@ protected:
 
     CSync m_criticalSectionQueue;
 
+    // Serializes HAL execution per GPU context shared by several queues
+    CSync m_criticalSectionGpuContextExecute[MOS_GPU_CONTEXT_MAX];
+
+    // Board orders of software-scoreboard thread spaces, shared by all of them
+    CmThreadSpaceOrderCache m_threadSpaceOrderCache;
+
     std::list<uint8_t *> m_printBufferMems;
 
     std::list<CmBufferUP *> m_printBufferUPs;
@@ -633,6 +679,17 @@ protected:
 
     uint8_t        m_queuePriority;
 
+    // GPU copy kernels, reused by all queues
+    CmDynamicArray m_copyKernelParamArray;
+
+    uint32_t       m_copyKernelParamArrayCount;
+
+    uint32_t       m_copyKernelHitCount;
+
+    uint32_t       m_copyKernelMissCount;
+
+    CSync          m_criticalSectionGPUCopyKrn;
+
     static const uint32_t m_maxPrintBuffer;
 private:
     CmDeviceRTBase(const CmDeviceRTBase& other);
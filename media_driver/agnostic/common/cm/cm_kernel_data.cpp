@@ -91,7 +91,8 @@ CmKernelData::CmKernelData(  CmKernelRT* kernel ):
     m_kerneldatasize( 0 ),
     m_kernel(kernel),
     m_refCount(0),
-    m_isInUse(true)
+    m_isInUse(true),
+    m_argGeneration(0)
 {
    CmSafeMemSet(&m_halKernelParam, 0, sizeof(CM_HAL_KERNEL_PARAM));
    m_halKernelParam.samplerHeap = MOS_New( std::list<SamplerParam> );
@@ -173,11 +174,11 @@ int32_t CmKernelData::GetKernelDataSize()
 //*-----------------------------------------------------------------------------
 uint32_t CmKernelData::Acquire( void )
 {
-    ++m_refCount;
+    uint32_t refCount = ++m_refCount;
 
-    m_isInUse  = true; // reused or created
+    m_isInUse.store(true, std::memory_order_release); // reused or created
 
-    return m_refCount;
+    return refCount;
 }
 
 //*-----------------------------------------------------------------------------
@@ -186,16 +187,15 @@ uint32_t CmKernelData::Acquire( void )
 //*-----------------------------------------------------------------------------
 uint32_t CmKernelData::SafeRelease( )
 {
-
-    --m_refCount;
-    if( m_refCount == 0 )
+    uint32_t refCount = --m_refCount;
+    if( refCount == 0 )
     {
         delete this;
         return 0;
     }
     else
     {
-        return m_refCount;
+        return refCount;
     }
 }
 
@@ -214,7 +214,7 @@ PCM_HAL_KERNEL_PARAM CmKernelData::GetHalCmKernelData( )
 //*-----------------------------------------------------------------------------
 bool CmKernelData::IsInUse()
 {
-    return m_isInUse;
+    return m_isInUse.load(std::memory_order_acquire);
 }
 
 //*-----------------------------------------------------------------------------
@@ -232,8 +232,26 @@ uint32_t CmKernelData::GetKernelCurbeSize( void )
 //*-----------------------------------------------------------------------------
 int32_t CmKernelData::ResetStatus( void )
 {
-    m_isInUse = false;
+    m_isInUse.store(false, std::memory_order_release);
 
     return CM_SUCCESS;
 }
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get the kernel argument generation of the kernel data
+//| Returns:    The generation.
+//*-----------------------------------------------------------------------------
+uint64_t CmKernelData::GetArgGeneration( void )
+{
+    return m_argGeneration;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Set the kernel argument generation of the kernel data
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmKernelData::SetArgGeneration( uint64_t generation )
+{
+    m_argGeneration = generation;
+}
 }  // namespace
@@ -27,6 +27,7 @@
 #ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMKERNELDATA_H_
 #define MEDIADRIVER_AGNOSTIC_COMMON_CM_CMKERNELDATA_H_
 
+#include <atomic>
 #include "cm_array.h"
 #include "cm_hal.h"
 
@@ -51,6 +52,8 @@ public:
     bool IsInUse( void );
     uint32_t GetKernelCurbeSize( void );
     int32_t ResetStatus( void );
+    uint64_t GetArgGeneration( void );
+    void SetArgGeneration( uint64_t generation );
 
 protected:
 
@@ -61,11 +64,15 @@ protected:
 
     uint32_t     m_kerneldatasize;
     CmKernelRT*  m_kernel;
-    uint32_t     m_refCount;
+    // tasks of different threads acquire and release the same kernel data
+    std::atomic<uint32_t> m_refCount;
     CM_HAL_KERNEL_PARAM m_halKernelParam;
 
     // if it is Ture, it means the task with this kernel is not flushed yet
-    bool         m_isInUse;
+    std::atomic<bool> m_isInUse;
+
+    // generation of the kernel arguments this kernel data reflects
+    uint64_t     m_argGeneration;
 
 private:
     CmKernelData (const CmKernelData& other);
@@ -314,6 +314,7 @@ CmKernelRT::CmKernelRT(CmDeviceRT *device,
     m_dirty( CM_KERNEL_DATA_CLEAN ),
     m_lastKernelData( nullptr ),
     m_lastKernelDataSize( 0 ),
+    m_argGeneration( 0 ),
     m_indexInTask(0),
     m_threadSpaceAssociated(false),
     m_perThreadArgExists(false),
@@ -360,6 +361,7 @@ CmKernelRT::CmKernelRT(CmDeviceRT *device,
     CmSafeMemSet(m_pKernelPayloadSurfaceArray, 0, sizeof(m_pKernelPayloadSurfaceArray));
     CmSafeMemSet(m_IndirectSurfaceInfoArray, 0, sizeof(m_IndirectSurfaceInfoArray));
     CmSafeMemSet( m_samplerBtiEntry, 0, sizeof( m_samplerBtiEntry ) );
+    CmSafeMemSet( m_kernelDataPool, 0, sizeof( m_kernelDataPool ) );
 
     if (m_samplerBtiCount > 0)
     {
@@ -385,6 +387,8 @@ CmKernelRT::~CmKernelRT( void )
         CmKernelData::Destroy( m_lastKernelData );
     }
 
+    ReleaseKernelDataPool();
+
     if( m_device->CheckGTPinEnabled() && !m_blCreatingGPUCopyKernel)
     {
         MosSafeDeleteArray(m_binary);
@@ -2772,78 +2776,29 @@ finish:
 int32_t CmKernelRT::SortThreadSpace( CmThreadSpaceRT*  threadSpace )
 {
     int32_t                   hr = CM_SUCCESS;
-    CM_DEPENDENCY_PATTERN dependencyPatternType = CM_NONE_DEPENDENCY;
+    int32_t                   sortResult = CM_SUCCESS;
 
     CM_CHK_NULL_GOTOFINISH_CMERROR(threadSpace);
 
-    threadSpace->GetDependencyPatternType(dependencyPatternType);
-
     if(!threadSpace->IsThreadAssociated())
     {//Skip Sort if it is media walker
         return CM_SUCCESS;
     }
 
-    if (threadSpace->CheckDependencyVectorsSet())
-    {
-        threadSpace->WavefrontDependencyVectors();
+    if (threadSpace->ReuseBoardOrder())
+    {//Skip Sort if the order is up to date or cached by another thread space
+#if (_DEBUG || _RELEASE_INTERNAL)
+        return threadSpace->VerifyBoardOrder();
+#else
+        return CM_SUCCESS;
+#endif
     }
-    else
-    {
-        switch (dependencyPatternType)
-        {
-            case CM_WAVEFRONT:
-                threadSpace->Wavefront45Sequence();
-                break;
-
-            case CM_WAVEFRONT26:
-                threadSpace->Wavefront26Sequence();
-                break;
 
-            case CM_WAVEFRONT26Z:
-                threadSpace->Wavefront26ZSequence();
-                break;
+    hr = threadSpace->GenerateBoardOrder(sortResult);
 
-            case CM_WAVEFRONT26ZI:
-                CM_26ZI_DISPATCH_PATTERN dispatchPattern;
-                threadSpace->Get26ZIDispatchPattern(dispatchPattern);
-                switch (dispatchPattern)
-                {
-                case VVERTICAL_HVERTICAL_26:
-                    threadSpace->Wavefront26ZISeqVVHV26();
-                    break;
-                case VVERTICAL_HHORIZONTAL_26:
-                    threadSpace->Wavefront26ZISeqVVHH26();
-                    break;
-                case VVERTICAL26_HHORIZONTAL26:
-                    threadSpace->Wavefront26ZISeqVV26HH26();
-                    break;
-                case VVERTICAL1X26_HHORIZONTAL1X26:
-                    threadSpace->Wavefront26ZISeqVV1x26HH1x26();
-                    break;
-                default:
-                    threadSpace->Wavefront26ZISeqVVHV26();
-                    break;
-                }
-                break;
-
-            case CM_HORIZONTAL_WAVE:
-                threadSpace->HorizentalSequence();
-                break;
-
-            case CM_VERTICAL_WAVE:
-                threadSpace->VerticalSequence();
-                break;
-
-            case CM_NONE_DEPENDENCY:
-            case CM_WAVEFRONT26X:
-            case CM_WAVEFRONT26ZIG:
-                break;
-
-            default:
-                CM_ASSERTMESSAGE("Error: Invalid thread dependency type.");
-                hr = CM_FAILURE;
-                break;
-        }
+    if (hr == CM_SUCCESS && sortResult == CM_SUCCESS)
+    {
+        threadSpace->CacheBoardOrder();
     }
 
 finish:
@@ -3332,6 +3287,12 @@ int32_t CmKernelRT::Reset( void )
 
     ResetKernelSurfaces();
 
+    // Argument layout may change after reset, pooled kernel data can't be patched
+    {
+        CLock locker(*m_device->GetProgramKernelLock());
+        ReleaseKernelDataPool();
+    }
+
     return CM_SUCCESS;
 }
 
@@ -3521,6 +3482,7 @@ int32_t CmKernelRT::CreateKernelData(
 {
     int32_t              hr              = CM_SUCCESS;
     PCM_HAL_KERNEL_PARAM halKernelParam = nullptr;
+    CmKernelData         *idleKernelData = nullptr;
 
     if( (threadSpace != nullptr) && (m_threadSpace != nullptr) )
     {
@@ -3528,6 +3490,9 @@ int32_t CmKernelRT::CreateKernelData(
         return CM_INVALID_THREAD_SPACE;
     }
 
+    // Must be checked before the dirty status is consumed below
+    bool patchable = IsPatchableChange(threadSpace);
+
     if(m_lastKernelData == nullptr)
     {
         CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
@@ -3556,8 +3521,23 @@ int32_t CmKernelRT::CreateKernelData(
         else
         {
             if(m_lastKernelData->IsInUse())
-            { // Need to Create a new one , if the kernel data is in use
-                CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
+            { // Need another one if the kernel data is in use. Patch a flushed one if possible, or create a new one.
+                idleKernelData = patchable ? GetIdleKernelData() : nullptr;
+                if (idleKernelData != nullptr)
+                {
+                    hr = PatchKernelData(idleKernelData, threadSpace);
+                    if (hr != CM_SUCCESS)
+                    {
+                        CmKernelData::Destroy(idleKernelData);
+                        goto finish;
+                    }
+                    kernelData = idleKernelData;
+                    kernelDataSize = kernelData->GetKernelDataSize();
+                }
+                else
+                {
+                    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(kernelData, kernelDataSize, threadSpace));
+                }
                 CM_CHK_CMSTATUS_GOTOFINISH(AcquireKernelProgram()); // increase kernel/program's ref count
                 CM_CHK_CMSTATUS_GOTOFINISH(UpdateLastKernelData(kernelData));
             }
@@ -3586,6 +3566,7 @@ int32_t CmKernelRT::CreateKernelData(
         }
     }
 
+    UpdateArgGeneration(kernelData, patchable);
     CleanArgDirtyFlag();
     if(threadSpace)
     {
@@ -3660,6 +3641,7 @@ int32_t CmKernelRT::CreateKernelData(
         }
     }
 
+    UpdateArgGeneration(kernelData, false);
     CleanArgDirtyFlag();
 
 finish:
@@ -4938,12 +4920,22 @@ int32_t CmKernelRT::UpdateLastKernelData(
         return CM_NULL_POINTER;
     }
 
+    CSync* kernelLock = m_device->GetProgramKernelLock();
+    CLock locker(*kernelLock);
     if(m_lastKernelData)
     {
-        CmKernelData::Destroy(m_lastKernelData); // reduce ref count or delete it
+        // Keep the replaced kernel data for patching, the pool owns its reference now.
+        // The oldest entry drops out when the pool is full.
+        if (m_kernelDataPool[CM_KERNEL_DATA_POOL_SIZE - 1] != nullptr)
+        {
+            CmKernelData::Destroy(m_kernelDataPool[CM_KERNEL_DATA_POOL_SIZE - 1]); // reduce ref count or delete it
+        }
+        for (uint32_t i = CM_KERNEL_DATA_POOL_SIZE - 1; i > 0; i--)
+        {
+            m_kernelDataPool[i] = m_kernelDataPool[i - 1];
+        }
+        m_kernelDataPool[0] = m_lastKernelData;
     }
-    CSync* kernelLock = m_device->GetProgramKernelLock();
-    CLock locker(*kernelLock);
     m_lastKernelData = kernelData;
     m_lastKernelData->Acquire();
     m_lastKernelDataSize = m_lastKernelData->GetKernelDataSize();
@@ -4951,6 +4943,220 @@ int32_t CmKernelRT::UpdateLastKernelData(
     return hr;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Checks whether the pending changes only touch per-kernel
+//|             arguments, which UpdateKernelData patches one by one.
+//| Returns:    True if a pooled kernel data can be patched for this enqueue.
+//*-----------------------------------------------------------------------------
+bool CmKernelRT::IsPatchableChange(const CmThreadSpaceRT *threadSpace)
+{
+    if (m_dirty & ~(CM_KERNEL_DATA_KERNEL_ARG_DIRTY | CM_KERNEL_DATA_GLOBAL_SURFACE_DIRTY))
+    {
+        return false;
+    }
+
+    if (m_perThreadArgExists)
+    {
+        return false; // thread args are laid out per thread space
+    }
+
+    CmThreadSpaceRT *taskThreadSpace = const_cast<CmThreadSpaceRT *>(threadSpace);
+    if (taskThreadSpace && taskThreadSpace->GetDirtyStatus() != CM_THREAD_SPACE_CLEAN)
+    {
+        return false;
+    }
+
+    if (m_threadSpace && m_threadSpace->GetDirtyStatus() != CM_THREAD_SPACE_CLEAN)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Takes a flushed kernel data out of the pool.
+//|             The flusher only ever clears the in-use flag, and does so after
+//|             the HAL has consumed the kernel data. Once seen idle and taken
+//|             out of the pool under the program kernel lock, the kernel data
+//|             is owned by the caller, which may patch it without more locking.
+//| Returns:    Kernel data holding one reference for the caller, or nullptr.
+//*-----------------------------------------------------------------------------
+CmKernelData *CmKernelRT::GetIdleKernelData()
+{
+    CSync* kernelLock = m_device->GetProgramKernelLock();
+    CLock locker(*kernelLock);
+
+    for (uint32_t i = 0; i < CM_KERNEL_DATA_POOL_SIZE; i++)
+    {
+        CmKernelData *kernelData = m_kernelDataPool[i];
+        if (kernelData != nullptr && !kernelData->IsInUse())
+        {
+            for (uint32_t j = i; j < CM_KERNEL_DATA_POOL_SIZE - 1; j++)
+            {
+                m_kernelDataPool[j] = m_kernelDataPool[j + 1];
+            }
+            m_kernelDataPool[CM_KERNEL_DATA_POOL_SIZE - 1] = nullptr;
+            return kernelData;
+        }
+    }
+
+    return nullptr;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Brings a pooled kernel data up to date with the current args.
+//| Returns:    Result of the operation.
+//*-----------------------------------------------------------------------------
+int32_t CmKernelRT::PatchKernelData(
+    CmKernelData*   kernelData,
+    const CmThreadSpaceRT* threadSpace)
+{
+    int32_t              hr             = CM_SUCCESS;
+    PCM_HAL_KERNEL_PARAM halKernelParam = nullptr;
+
+    CM_CHK_NULL_GOTOFINISH_CMERROR(kernelData);
+    halKernelParam = kernelData->GetHalCmKernelData();
+    CM_CHK_NULL_GOTOFINISH_CMERROR(halKernelParam);
+
+    // Besides the args dirty for this enqueue, patch every arg changed by the
+    // enqueues issued since this kernel data was built.
+    for (uint32_t i = 0; i < m_argCount; i++)
+    {
+        if (m_args[i].generation > kernelData->GetArgGeneration())
+        {
+            m_args[i].isDirty = true;
+        }
+    }
+
+    CM_CHK_CMSTATUS_GOTOFINISH(UpdateKernelData(kernelData, threadSpace));
+
+    // Its content now matches the latest kernel data, so is its batch buffer
+    halKernelParam->kernelId = m_id;
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    CM_CHK_CMSTATUS_GOTOFINISH(VerifyPatchedKernelData(kernelData, threadSpace));
+#endif
+
+finish:
+    return hr;
+}
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+//*-----------------------------------------------------------------------------
+//| Purpose:    Checks the CURBE arguments of a patched kernel data against a
+//|             kernel data built from scratch. Only kernels whose arguments
+//|             are all general values are checked, since building another
+//|             kernel data consumes sampler BTIs and state buffer bindings.
+//| Returns:    CM_FAILURE if the patched kernel data differs.
+//*-----------------------------------------------------------------------------
+int32_t CmKernelRT::VerifyPatchedKernelData(
+    CmKernelData*   kernelData,
+    const CmThreadSpaceRT* threadSpace)
+{
+    int32_t              hr            = CM_SUCCESS;
+    CmKernelData         *rebuiltData  = nullptr;
+    uint32_t             rebuiltSize   = 0;
+    PCM_HAL_KERNEL_PARAM patchedParam  = nullptr;
+    PCM_HAL_KERNEL_PARAM rebuiltParam  = nullptr;
+    uint64_t             id            = m_id;
+    uint32_t             sizeInCurbe   = m_sizeInCurbe;
+
+    if (m_samplerBtiCount != 0 || m_stateBufferBounded != CM_STATE_BUFFER_NONE)
+    {
+        return CM_SUCCESS;
+    }
+    for (uint32_t i = 0; i < m_argCount; i++)
+    {
+        if (m_args[i].unitKind != ARG_KIND_GENERAL)
+        {
+            return CM_SUCCESS;
+        }
+    }
+
+    patchedParam = kernelData->GetHalCmKernelData();
+    CM_CHK_NULL_GOTOFINISH_CMERROR(patchedParam);
+    CM_CHK_CMSTATUS_GOTOFINISH(CreateKernelDataInternal(rebuiltData, rebuiltSize, threadSpace));
+    rebuiltParam = rebuiltData->GetHalCmKernelData();
+    CM_CHK_NULL_GOTOFINISH_CMERROR(rebuiltParam);
+
+    if (patchedParam->numArgs != rebuiltParam->numArgs ||
+        patchedParam->totalCurbeSize != rebuiltParam->totalCurbeSize)
+    {
+        hr = CM_FAILURE;
+    }
+    for (uint32_t i = 0; hr == CM_SUCCESS && i < rebuiltParam->numArgs; i++)
+    {
+        PCM_HAL_KERNEL_ARG_PARAM patchedArg = &patchedParam->argParams[i];
+        PCM_HAL_KERNEL_ARG_PARAM rebuiltArg = &rebuiltParam->argParams[i];
+        if (patchedArg->unitSize != rebuiltArg->unitSize ||
+            patchedArg->payloadOffset != rebuiltArg->payloadOffset ||
+            patchedArg->firstValue == nullptr ||
+            rebuiltArg->firstValue == nullptr ||
+            CmSafeMemCompare(patchedArg->firstValue, rebuiltArg->firstValue, rebuiltArg->unitSize) != 0)
+        {
+            hr = CM_FAILURE;
+        }
+    }
+    if (hr != CM_SUCCESS)
+    {
+        CM_ASSERTMESSAGE("Error: Patched kernel data differs from a rebuilt one.");
+    }
+
+finish:
+    CmKernelData::Destroy(rebuiltData);
+    // Building the reference must not change what later enqueues reuse
+    m_id = id;
+    m_sizeInCurbe = sizeInCurbe;
+    return hr;
+}
+#endif
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Records which arguments change in this enqueue and the
+//|             generation the resulting kernel data reflects.
+//*-----------------------------------------------------------------------------
+void CmKernelRT::UpdateArgGeneration(CmKernelData *kernelData, bool patchable)
+{
+    m_argGeneration++;
+
+    for (uint32_t i = 0; i < m_argCount; i++)
+    {
+        if (m_args[i].isDirty)
+        {
+            m_args[i].generation = m_argGeneration;
+        }
+    }
+
+    if (kernelData)
+    {
+        kernelData->SetArgGeneration(m_argGeneration);
+    }
+
+    if (!patchable)
+    {
+        CLock locker(*m_device->GetProgramKernelLock());
+        ReleaseKernelDataPool();
+    }
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Drops the references held by the kernel data pool.
+//|             Caller holds the program kernel lock unless the kernel is
+//|             being destroyed.
+//*-----------------------------------------------------------------------------
+void CmKernelRT::ReleaseKernelDataPool()
+{
+    for (uint32_t i = 0; i < CM_KERNEL_DATA_POOL_SIZE; i++)
+    {
+        if (m_kernelDataPool[i] != nullptr)
+        {
+            CmKernelData::Destroy(m_kernelDataPool[i]);
+            m_kernelDataPool[i] = nullptr;
+        }
+    }
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Wrapper of  CmKernelData::Destroy.
 //| Returns:    Result of the operation.
@@ -69,6 +69,8 @@ struct CM_ARG
 
     uint32_t unitVmeArraySize; // number of Vme surfaces in surface array
 
+    uint64_t generation; // kernel argument generation in which the value was last changed
+
     // pointer to the arg values. the size is unitCount * unitSize
     union
     {
@@ -103,6 +105,7 @@ struct CM_ARG
         surfArrayArg = nullptr;
         aliasCreated = false;
         isStatelessBuffer = false;
+        generation = 0;
     }
 };
 
@@ -115,6 +118,8 @@ enum CM_KERNEL_INTERNAL_ARG_TYPE
 struct CM_KERNEL_INFO;
 class CmExecutionAdv;
 
+#define CM_KERNEL_DATA_POOL_SIZE 4  // idle kernel data kept for patching per kernel
+
 namespace CMRT_UMD
 {
 class CmDeviceRT;
@@ -364,6 +369,22 @@ protected:
 
     int32_t UpdateLastKernelData(CmKernelData *&kernelData);
 
+    bool IsPatchableChange(const CmThreadSpaceRT *threadSpace);
+
+    CmKernelData *GetIdleKernelData();
+
+    int32_t PatchKernelData(CmKernelData *kernelData,
+                            const CmThreadSpaceRT *threadSpace);
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    int32_t VerifyPatchedKernelData(CmKernelData *kernelData,
+                                    const CmThreadSpaceRT *threadSpace);
+#endif
+
+    void UpdateArgGeneration(CmKernelData *kernelData, bool patchable);
+
+    void ReleaseKernelDataPool();
+
     int32_t CreateKernelIndirectData(
         PCM_HAL_INDIRECT_DATA_PARAM halIndirectData);
 
@@ -469,6 +490,13 @@ protected:
     CmKernelData *m_lastKernelData;
     uint32_t m_lastKernelDataSize;
 
+    // Kernel data replaced while still in use. Once flushed, an entry can be
+    // patched with the arguments changed since it was built instead of
+    // creating new kernel data from scratch. Emptied on any change that is
+    // not a plain per-kernel argument update.
+    CmKernelData *m_kernelDataPool[CM_KERNEL_DATA_POOL_SIZE];
+    uint64_t m_argGeneration;  // bumped on each CreateKernelData
+
     uint32_t m_indexInTask;
     bool m_threadSpaceAssociated;  // Indicates if this kernel is associated the task threadspace
                             // (scoreboard)
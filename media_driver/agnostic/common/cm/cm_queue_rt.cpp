@@ -57,8 +57,7 @@
 #define BLOCK_WIDTH                  (64)
 #define PAGE_ALIGNED                 (0x1000)
 
-#define GPUCOPY_KERNEL_LOCK(a) ((a)->locked = true)
-#define GPUCOPY_KERNEL_UNLOCK(a) ((a)->locked = false)
+#define GPUCOPY_KERNEL_UNLOCK(a) (m_device->ReleaseGPUCopyKernel(a))
 using namespace CMRT_UMD;
 
 namespace CMRT_UMD
@@ -134,9 +133,10 @@ CmQueueRT::CmQueueRT(CmDeviceRT *device,
                      CM_QUEUE_CREATE_OPTION queueCreateOption):
     m_device(device),
     m_eventArray(CM_INIT_EVENT_COUNT),
+    m_halExecuteLock(&m_criticalSectionHalExecute),
+    m_flushRequests(0),
+    m_flusherActive(false),
     m_eventCount(0),
-    m_copyKernelParamArray(CM_INIT_GPUCOPY_KERNL_COUNT),
-    m_copyKernelParamArrayCount(0),
     m_halMaxValues(nullptr),
     m_queueOption(queueCreateOption),
     m_usingVirtualEngine(false),
@@ -178,16 +178,6 @@ CmQueueRT::~CmQueueRT()
     }
     m_eventArray.Delete();
 
-    // Do not destroy the kernel in m_copyKernelParamArray.
-    // They have been destoyed in ~CmDevice() before destroying Queue
-    for( uint32_t i = 0; i < m_copyKernelParamArrayCount; i ++ )
-    {
-        CM_GPUCOPY_KERNEL *gpuCopyParam = (CM_GPUCOPY_KERNEL*)m_copyKernelParamArray.GetElement( i );
-        CmSafeDelete(gpuCopyParam);
-    }
-
-    m_copyKernelParamArray.Delete();
-
     CM_HAL_STATE *hal_state = static_cast<CM_CONTEXT_DATA*>(m_device->GetAccelData())->cmHalState;
     ReleaseSyncBuffer(hal_state);
     return;
@@ -341,6 +331,15 @@ int32_t CmQueueRT::Initialize()
         }
     }
 
+    // Queues sharing a GPU context (e.g. the render context) must serialize
+    // their submissions on that context. A queue owning its compute context
+    // keeps its own lock, so it never waits on other queues.
+    if (m_gpuContextHandle == MOS_GPU_CONTEXT_INVALID_HANDLE)
+    {
+        m_halExecuteLock = m_device->GetGpuContextExecuteLock((MOS_GPU_CONTEXT)m_queueOption.GPUContext);
+        CM_CHK_NULL_RETURN_CMERROR(m_halExecuteLock);
+    }
+
 finish:
     return hr;
 }
@@ -593,57 +592,52 @@ int32_t CmQueueRT::Enqueue_RT(
 
     bool isEventVisible = (event == CM_NO_EVENT)? false:true;
 
-    CLock Locker(m_criticalSectionTaskInternal);
-
-    // set the current tracker index in renderhal
-    PCM_CONTEXT_DATA cmData = (PCM_CONTEXT_DATA)m_device->GetAccelData();
-    CM_CHK_NULL_RETURN_CMERROR(cmData);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState->renderHal);
-    cmData->cmHalState->renderHal->currentTrackerIndex = m_trackerIndex;
-
-    CmTaskInternal* task = nullptr;
-    int32_t result = CmTaskInternal::Create(kernelCount, totalThreadCount, kernelArray, threadSpace, m_device, syncBitmap, task, conditionalEndBitmap, conditionalEndInfo);
-    if( result != CM_SUCCESS )
     {
-        CM_ASSERTMESSAGE("Error: Create CM task internal failure.");
-        return result;
-    }
+        // Only task creation touches state shared with other enqueuers.
+        // Flushing is left to FlushTaskWithoutSync, which has a single flusher.
+        CLock Locker(m_criticalSectionTaskInternal);
 
-    LARGE_INTEGER nEnqueueTime;
-    if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )))
-    {
-        CM_ASSERTMESSAGE("Error: Query performance counter failure.");
-        CmTaskInternal::Destroy(task);
-        return CM_FAILURE;
-    }
+        CmTaskInternal* task = nullptr;
+        int32_t result = CmTaskInternal::Create(kernelCount, totalThreadCount, kernelArray, threadSpace, m_device, syncBitmap, task, conditionalEndBitmap, conditionalEndInfo, m_trackerIndex);
+        if( result != CM_SUCCESS )
+        {
+            CM_ASSERTMESSAGE("Error: Create CM task internal failure.");
+            return result;
+        }
 
-    int32_t taskDriverId = -1;
+        LARGE_INTEGER nEnqueueTime;
+        if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )))
+        {
+            CM_ASSERTMESSAGE("Error: Query performance counter failure.");
+            CmTaskInternal::Destroy(task);
+            return CM_FAILURE;
+        }
 
-    result = CreateEvent(task, isEventVisible, taskDriverId, event);
-    if (result != CM_SUCCESS)
-    {
-        CM_ASSERTMESSAGE("Error: Create event failure.");
-        return result;
-    }
-    if ( event != nullptr )
-    {
-        event->SetEnqueueTime( nEnqueueTime );
-    }
+        int32_t taskDriverId = -1;
 
-    task->SetPowerOption( powerOption );
+        result = CreateEvent(task, isEventVisible, taskDriverId, event);
+        if (result != CM_SUCCESS)
+        {
+            CM_ASSERTMESSAGE("Error: Create event failure.");
+            return result;
+        }
+        if ( event != nullptr )
+        {
+            event->SetEnqueueTime( nEnqueueTime );
+        }
 
-    task->SetProperty(taskConfig);
+        task->SetPowerOption( powerOption );
 
-    if( !m_enqueuedTasks.Push( task ) )
-    {
-        CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.");
-        return CM_FAILURE;
-    }
+        task->SetProperty(taskConfig);
 
-    result = FlushTaskWithoutSync();
+        if( !m_enqueuedTasks.Push( task ) )
+        {
+            CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.");
+            return CM_FAILURE;
+        }
+    }
 
-    return result;
+    return FlushTaskWithoutSync();
 }
 
 int32_t CmQueueRT::Enqueue_RT(CmKernelRT* kernelArray[],
@@ -671,59 +665,53 @@ int32_t CmQueueRT::Enqueue_RT(CmKernelRT* kernelArray[],
         return CM_INVALID_ARG_VALUE;
     }
 
-    CLock Locker(m_criticalSectionTaskInternal);
-
-    // set the current tracker index in renderhal
-    PCM_CONTEXT_DATA cmData = (PCM_CONTEXT_DATA)m_device->GetAccelData();
-    CM_CHK_NULL_RETURN_CMERROR(cmData);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState->renderHal);
-    cmData->cmHalState->renderHal->currentTrackerIndex = m_trackerIndex;
-
-    CmTaskInternal* task = nullptr;
-    int32_t result = CmTaskInternal::Create( kernelCount, totalThreadCount, kernelArray,
-                                            threadGroupSpace, m_device, syncBitmap, task,
-                                            conditionalEndBitmap, conditionalEndInfo, krnExecCfg);
-    if( result != CM_SUCCESS )
     {
-        CM_ASSERTMESSAGE("Error: Create CmTaskInternal failure.");
-        return result;
-    }
+        CLock Locker(m_criticalSectionTaskInternal);
 
-    LARGE_INTEGER nEnqueueTime;
-    if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )))
-    {
-        CM_ASSERTMESSAGE("Error: Query performance counter failure.");
-        CmTaskInternal::Destroy(task);
-        return CM_FAILURE;
-    }
+        CmTaskInternal* task = nullptr;
+        int32_t result = CmTaskInternal::Create( kernelCount, totalThreadCount, kernelArray,
+                                                threadGroupSpace, m_device, syncBitmap, task,
+                                                conditionalEndBitmap, conditionalEndInfo, krnExecCfg,
+                                                m_trackerIndex);
+        if( result != CM_SUCCESS )
+        {
+            CM_ASSERTMESSAGE("Error: Create CmTaskInternal failure.");
+            return result;
+        }
 
-    int32_t taskDriverId = -1;
+        LARGE_INTEGER nEnqueueTime;
+        if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )))
+        {
+            CM_ASSERTMESSAGE("Error: Query performance counter failure.");
+            CmTaskInternal::Destroy(task);
+            return CM_FAILURE;
+        }
 
-    result = CreateEvent(task, !(event == CM_NO_EVENT) , taskDriverId, event);
-    if (result != CM_SUCCESS)
-    {
-        CM_ASSERTMESSAGE("Error: Create event failure.");
-        return result;
-    }
-    if ( event != nullptr )
-    {
-        event->SetEnqueueTime( nEnqueueTime );
-    }
+        int32_t taskDriverId = -1;
 
-    task->SetPowerOption( powerOption );
+        result = CreateEvent(task, !(event == CM_NO_EVENT) , taskDriverId, event);
+        if (result != CM_SUCCESS)
+        {
+            CM_ASSERTMESSAGE("Error: Create event failure.");
+            return result;
+        }
+        if ( event != nullptr )
+        {
+            event->SetEnqueueTime( nEnqueueTime );
+        }
 
-    task->SetProperty(taskConfig);
+        task->SetPowerOption( powerOption );
 
-    if( !m_enqueuedTasks.Push( task ) )
-    {
-        CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
-        return CM_FAILURE;
-    }
+        task->SetProperty(taskConfig);
 
-    result = FlushTaskWithoutSync();
+        if( !m_enqueuedTasks.Push( task ) )
+        {
+            CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
+            return CM_FAILURE;
+        }
+    }
 
-    return result;
+    return FlushTaskWithoutSync();
 }
 
 int32_t CmQueueRT::Enqueue_RT( CmKernelRT* kernelArray[],
@@ -787,63 +775,56 @@ int32_t CmQueueRT::Enqueue_RT( CmKernelRT* kernelArray[],
         }
     }
 
-    CLock Locker(m_criticalSectionTaskInternal);
-
-    // set the current tracker index in renderhal
-    PCM_CONTEXT_DATA cmData = (PCM_CONTEXT_DATA)m_device->GetAccelData();
-    CM_CHK_NULL_RETURN_CMERROR(cmData);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState);
-    CM_CHK_NULL_RETURN_CMERROR(cmData->cmHalState->renderHal);
-    cmData->cmHalState->renderHal->currentTrackerIndex = m_trackerIndex;
+    {
+        CLock Locker(m_criticalSectionTaskInternal);
 
-    result = CmTaskInternal::Create( kernelCount, totalThreadCount, kernelArray, task, numTasksGenerated, isLastTask, hints, m_device );
+        result = CmTaskInternal::Create( kernelCount, totalThreadCount, kernelArray, task, numTasksGenerated, isLastTask, hints, m_device, m_trackerIndex );
 
-    if( result != CM_SUCCESS )
-    {
-        CM_ASSERTMESSAGE("Error: Create CM task internal failure.");
-        return result;
-    }
+        if( result != CM_SUCCESS )
+        {
+            CM_ASSERTMESSAGE("Error: Create CM task internal failure.");
+            return result;
+        }
 
-    LARGE_INTEGER nEnqueueTime;
-    if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )) )
-    {
-        CM_ASSERTMESSAGE("Error: Query performance counter failure.");
-        CmTaskInternal::Destroy(task);
-        return CM_FAILURE;
-    }
+        LARGE_INTEGER nEnqueueTime;
+        if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )) )
+        {
+            CM_ASSERTMESSAGE("Error: Query performance counter failure.");
+            CmTaskInternal::Destroy(task);
+            return CM_FAILURE;
+        }
 
-    result = CreateEvent(task, isEventVisible, taskDriverId, event);
-    if (result != CM_SUCCESS)
-    {
-        CM_ASSERTMESSAGE("Error: Create event failure.");
-        return result;
-    }
-    if ( event != nullptr )
-    {
-        event->SetEnqueueTime( nEnqueueTime );
-    }
+        result = CreateEvent(task, isEventVisible, taskDriverId, event);
+        if (result != CM_SUCCESS)
+        {
+            CM_ASSERTMESSAGE("Error: Create event failure.");
+            return result;
+        }
+        if ( event != nullptr )
+        {
+            event->SetEnqueueTime( nEnqueueTime );
+        }
 
-    for( uint32_t i = 0; i < kernelCount; ++i )
-    {
-        CmKernelRT* kernel = nullptr;
-        task->GetKernel(i, kernel);
-        if( kernel != nullptr )
+        for( uint32_t i = 0; i < kernelCount; ++i )
         {
-            kernel->SetAdjustedYCoord(0);
+            CmKernelRT* kernel = nullptr;
+            task->GetKernel(i, kernel);
+            if( kernel != nullptr )
+            {
+                kernel->SetAdjustedYCoord(0);
+            }
         }
-    }
 
-    task->SetPowerOption( powerOption );
+        task->SetPowerOption( powerOption );
 
-    if (!m_enqueuedTasks.Push(task))
-    {
-        CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
-        return CM_FAILURE;
+        if (!m_enqueuedTasks.Push(task))
+        {
+            CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
+            return CM_FAILURE;
+        }
     }
 
-    result = FlushTaskWithoutSync();
-
-    return result;
+    return FlushTaskWithoutSync();
 }
 
 //*-----------------------------------------------------------------------------
@@ -2529,6 +2510,8 @@ void CmQueueRT::PopTaskFromFlushedQueue()
             }
         }
 
+        // Kernel data released here is shared with task creation
+        CLock locker(m_criticalSectionTaskInternal);
         CmTaskInternal::Destroy( topTask );
     }
     return;
@@ -3307,6 +3290,9 @@ finish:
 //! to their order in the the queue. The queue will be empty after flush,
 //! This is a non-blocking call. i.e. it returs immediately without waiting for
 //! GPU to finish the execution of tasks.
+//! Only one thread flushes a queue at a time. A caller finding another flusher
+//! active leaves its request to that flusher and returns without waiting,
+//! unless flushBlocked is set.
 //! INPUT:
 //! OUTPUT:
 //!     CM_SUCCESS if all tasks in the queue are submitted
@@ -3324,103 +3310,138 @@ int32_t CmQueueRT::FlushTaskWithoutSync( bool flushBlocked )
     CmEventRT*          event = nullptr;
     int32_t             taskId = 0;
 
-    m_criticalSectionHalExecute.Acquire(); // Enter HalCm Execute Protection
+    // Post the request before competing for the flusher role, so that an
+    // active flusher re-checks the queue after this thread gives up.
+    m_flushRequests.fetch_add(1);
+    if (flushBlocked)
+    {
+        while (m_flusherActive.exchange(true))
+        {
+            std::this_thread::yield();
+        }
+    }
+    else if (m_flusherActive.exchange(true))
+    {
+        return CM_SUCCESS;
+    }
 
-    while( !m_enqueuedTasks.IsEmpty() )
+    do
     {
-        uint32_t flushedTaskCount = m_flushedTasks.GetCount();
-        if ( flushBlocked )
+        m_flushRequests.store(0);
+        m_halExecuteLock->Acquire(); // Enter HalCm Execute Protection
+
+        // renderHal is shared by the queues of the device, so the tracker
+        // index is only switched to this queue's while holding the HAL lock
+        CM_CHK_NULL_GOTOFINISH_CMERROR(cmData);
+        CM_CHK_NULL_GOTOFINISH_CMERROR(cmData->cmHalState);
+        CM_CHK_NULL_GOTOFINISH_CMERROR(cmData->cmHalState->renderHal);
+        cmData->cmHalState->renderHal->currentTrackerIndex = m_trackerIndex;
+
+        while( !m_enqueuedTasks.IsEmpty() )
         {
-            while( flushedTaskCount >= m_halMaxValues->maxTasks )
+            uint32_t flushedTaskCount = m_flushedTasks.GetCount();
+            if ( flushBlocked )
             {
-                // If the task count in flushed queue is no less than hw restrictiion,
-                // query the staus of flushed task queue. Remove any finished tasks from the queue
-                QueryFlushedTasks();
-                flushedTaskCount = m_flushedTasks.GetCount();
+                while( flushedTaskCount >= m_halMaxValues->maxTasks )
+                {
+                    // If the task count in flushed queue is no less than hw restrictiion,
+                    // query the staus of flushed task queue. Remove any finished tasks from the queue
+                    QueryFlushedTasks();
+                    flushedTaskCount = m_flushedTasks.GetCount();
+                }
             }
-        }
-        else
-        {
-            if( flushedTaskCount >= m_halMaxValues->maxTasks )
+            else
             {
-                // If the task count in flushed queue is no less than hw restrictiion,
-                // query the staus of flushed task queue. Remove any finished tasks from the queue
-                QueryFlushedTasks();
-                flushedTaskCount = m_flushedTasks.GetCount();
                 if( flushedTaskCount >= m_halMaxValues->maxTasks )
                 {
-                    // If none of flushed tasks finishes, we can't flush more taks.
-                    break;
+                    // If the task count in flushed queue is no less than hw restrictiion,
+                    // query the staus of flushed task queue. Remove any finished tasks from the queue
+                    QueryFlushedTasks();
+                    flushedTaskCount = m_flushedTasks.GetCount();
+                    if( flushedTaskCount >= m_halMaxValues->maxTasks )
+                    {
+                        // If none of flushed tasks finishes, we can't flush more taks.
+                        break;
+                    }
                 }
             }
-        }
 
-        task = (CmTaskInternal*)m_enqueuedTasks.Pop();
-        CM_CHK_NULL_GOTOFINISH_CMERROR( task );
+            task = (CmTaskInternal*)m_enqueuedTasks.Pop();
+            CM_CHK_NULL_GOTOFINISH_CMERROR( task );
 
-        CmNotifierGroup *notifiers = m_device->GetNotifiers();
-        if (notifiers != nullptr)
-        {
-            notifiers->NotifyTaskFlushed(m_device, task);
-        }
+            CmNotifierGroup *notifiers = m_device->GetNotifiers();
+            if (notifiers != nullptr)
+            {
+                notifiers->NotifyTaskFlushed(m_device, task);
+            }
 
-        task->GetTaskType(taskType);
+            task->GetTaskType(taskType);
 
-        switch(taskType)
-        {
-            case CM_INTERNAL_TASK_WITH_THREADSPACE:
-                hr = FlushGeneralTask(task);
-                break;
+            switch(taskType)
+            {
+                case CM_INTERNAL_TASK_WITH_THREADSPACE:
+                    hr = FlushGeneralTask(task);
+                    break;
 
-            case CM_INTERNAL_TASK_WITH_THREADGROUPSPACE:
-                hr = FlushGroupTask(task);
-                break;
+                case CM_INTERNAL_TASK_WITH_THREADGROUPSPACE:
+                    hr = FlushGroupTask(task);
+                    break;
 
-            case CM_INTERNAL_TASK_VEBOX:
-                hr = FlushVeboxTask(task);
-                break;
+                case CM_INTERNAL_TASK_VEBOX:
+                    hr = FlushVeboxTask(task);
+                    break;
 
-            case CM_INTERNAL_TASK_ENQUEUEWITHHINTS:
-                hr = FlushEnqueueWithHintsTask(task);
-                break;
+                case CM_INTERNAL_TASK_ENQUEUEWITHHINTS:
+                    hr = FlushEnqueueWithHintsTask(task);
+                    break;
 
-            default:    // by default, assume the task is considered as general task: CM_INTERNAL_TASK_WITH_THREADSPACE
-                hr = FlushGeneralTask(task);
-                break;
-        }
+                default:    // by default, assume the task is considered as general task: CM_INTERNAL_TASK_WITH_THREADSPACE
+                    hr = FlushGeneralTask(task);
+                    break;
+            }
 
-        if(hr == CM_SUCCESS)
-        {
-            m_flushedTasks.Push( task );
-            task->VtuneSetFlushTime(); // Record Flush Time
-        }
-        else
-        {
-            // Failed to flush, destroy the task.
-            CmTaskInternal::Destroy( task );
-        }
+            if(hr == CM_SUCCESS)
+            {
+                m_flushedTasks.Push( task );
+                task->VtuneSetFlushTime(); // Record Flush Time
+            }
+            else
+            {
+                // Failed to flush. The task may belong to another enqueuer
+                // which has already returned, so report the failure through
+                // its event before destroying the task.
+                task->GetTaskEvent(event);
+                if (event != nullptr)
+                {
+                    event->ModifyStatus(CM_STATUS_RESET, 0);
+                }
+                CLock locker(m_criticalSectionTaskInternal);
+                CmTaskInternal::Destroy( task );
+            }
 
-    } // loop for task
+        } // loop for task
 
 #if MDF_SURFACE_CONTENT_DUMP
-    if (cmData->cmHalState->dumpSurfaceContent)
-    {
-        task->GetTaskEvent(event);
-        if (event != nullptr)
+        if (cmData->cmHalState->dumpSurfaceContent)
         {
-            while (event->GetStatusWithoutFlush() != CM_STATUS_FINISHED)
+            task->GetTaskEvent(event);
+            if (event != nullptr)
             {
-                event->Query();
+                while (event->GetStatusWithoutFlush() != CM_STATUS_FINISHED)
+                {
+                    event->Query();
+                }
+                event->GetTaskDriverId(taskId);
             }
-            event->GetTaskDriverId(taskId);
+            task->SurfaceDump(taskId);
         }
-        task->SurfaceDump(taskId);
-    }
 #endif
-    QueryFlushedTasks();
+        QueryFlushedTasks();
 
 finish:
-    m_criticalSectionHalExecute.Release();//Leave HalCm Execute Protection
+        m_halExecuteLock->Release(); //Leave HalCm Execute Protection
+        m_flusherActive.store(false);
+    } while (hr == CM_SUCCESS && m_flushRequests.load() != 0 && !m_flusherActive.exchange(true));
 
     //Delayed destroy for resource
     m_device->GetSurfaceManager(surfaceMgr);
@@ -3468,36 +3489,44 @@ CM_RT_API int32_t CmQueueRT::EnqueueVebox(CmVebox * vebox, CmEvent* & event)
         return CM_NULL_POINTER;
     }
     CmVeboxRT *veboxRT = static_cast<CmVeboxRT *>(vebox);
-    CM_CHK_CMSTATUS_GOTOFINISH(CmTaskInternal::Create(m_device,  veboxRT, task ));
 
-    LARGE_INTEGER nEnqueueTime;
-    if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )) )
     {
-        CM_ASSERTMESSAGE("Error: Query Performance counter failure.");
-        hr = CM_FAILURE;
-        goto finish;
-    }
+        CLock Locker(m_criticalSectionTaskInternal);
 
-    CM_CHK_CMSTATUS_GOTOFINISH(CreateEvent(task, isEventVisible, taskDriverId, eventRT));
+        CM_CHK_CMSTATUS_GOTOFINISH(CmTaskInternal::Create(m_device,  veboxRT, task, m_trackerIndex ));
 
-    if ( eventRT != nullptr )
-    {
-        eventRT->SetEnqueueTime( nEnqueueTime );
-    }
-    event = eventRT;
+        LARGE_INTEGER nEnqueueTime;
+        if ( !(MosUtilities::MosQueryPerformanceCounter( (uint64_t*)&nEnqueueTime.QuadPart )) )
+        {
+            CM_ASSERTMESSAGE("Error: Query Performance counter failure.");
+            hr = CM_FAILURE;
+            goto finish;
+        }
 
-    if (!m_enqueuedTasks.Push(task))
-    {
-        CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
-        hr = CM_FAILURE;
-        goto finish;
+        CM_CHK_CMSTATUS_GOTOFINISH(CreateEvent(task, isEventVisible, taskDriverId, eventRT));
+
+        if ( eventRT != nullptr )
+        {
+            eventRT->SetEnqueueTime( nEnqueueTime );
+        }
+        event = eventRT;
+
+        if (!m_enqueuedTasks.Push(task))
+        {
+            CM_ASSERTMESSAGE("Error: Push enqueued tasks failure.")
+            hr = CM_FAILURE;
+            goto finish;
+        }
     }
 
-    CM_CHK_CMSTATUS_GOTOFINISH(FlushTaskWithoutSync());
+    // Once pushed, the task is owned by the flusher, which reports a flush
+    // failure through the event.
+    return FlushTaskWithoutSync();
 
 finish:
     if (hr != CM_SUCCESS)
     {
+        CLock Locker(m_criticalSectionTaskInternal);
         CmTaskInternal::Destroy(task);
     }
     return hr;
@@ -3616,7 +3645,7 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyGPUToCPUFullStride( CmSurface2D* surface
 
 //*---------------------------------------------------------------------------------------------------------
 //| Name:       CreateGPUCopyKernel()
-//| Purpose:    Create GPUCopy kernel, reuse the kernel if it has been created and resuable
+//| Purpose:    Get a GPUCopy kernel from the device, which creates it if no idle one is cached
 //| Arguments:
 //|             widthInByte      [in]  surface's width in bytes
 //|             height           [in]  surface's height
@@ -3633,298 +3662,7 @@ int32_t CmQueueRT::CreateGPUCopyKernel(uint32_t widthInByte,
                                        CM_GPUCOPY_DIRECTION copyDirection,
                                        CM_GPUCOPY_KERNEL* &gpuCopyKernelParam)
 {
-    int32_t     hr                 = CM_SUCCESS;
-
-    //Search existing kernel
-    CM_CHK_CMSTATUS_GOTOFINISH(SearchGPUCopyKernel(widthInByte, height, format, copyDirection, gpuCopyKernelParam));
-
-    if(gpuCopyKernelParam != nullptr)
-    { // reuse
-        GPUCOPY_KERNEL_LOCK(gpuCopyKernelParam);
-    }
-    else
-    {
-        gpuCopyKernelParam   = new (std::nothrow) CM_GPUCOPY_KERNEL ;
-        CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyKernelParam);
-        CmSafeMemSet(gpuCopyKernelParam, 0, sizeof(CM_GPUCOPY_KERNEL));
-
-        CM_CHK_CMSTATUS_GOTOFINISH(AllocateGPUCopyKernel(widthInByte, height, format, copyDirection, gpuCopyKernelParam->kernel));
-        CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyKrnID(widthInByte, height, format, copyDirection, gpuCopyKernelParam->kernelID));
-        GPUCOPY_KERNEL_LOCK(gpuCopyKernelParam);
-
-        CM_CHK_CMSTATUS_GOTOFINISH(AddGPUCopyKernel(gpuCopyKernelParam));
-    }
-
-finish:
-    if( hr != CM_SUCCESS)
-    {
-        CmSafeDelete(gpuCopyKernelParam);
-    }
-
-    return hr;
-}
-
-//*---------------------------------------------------------------------------------------------------------
-//| Name:       SearchGPUCopyKernel()
-//| Purpose:    Search if the required kernel exists
-//| Arguments:
-//|             widthInByte      [in]  surface's width in bytes
-//|             height           [in]  surface's height
-//|             format           [in]  surface's height
-//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
-//|             gpuCopyKernelParam [out] kernel param
-//|
-//| Returns:    Result of the operation.
-//|
-//*---------------------------------------------------------------------------------------------------------
-int32_t CmQueueRT::SearchGPUCopyKernel(uint32_t widthInByte,
-                                       uint32_t height,
-                                       CM_SURFACE_FORMAT format,
-                                       CM_GPUCOPY_DIRECTION copyDirection,
-                                       CM_GPUCOPY_KERNEL* &kernelParam)
-{
-    int32_t     hr = CM_SUCCESS;
-    CM_GPUCOPY_KERNEL *gpucopyKernel = nullptr;
-    CM_GPUCOPY_KERNEL_ID kernelTypeID = GPU_COPY_KERNEL_UNKNOWN;
-
-    kernelParam = nullptr;
-    CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyKrnID(widthInByte, height, format, copyDirection, kernelTypeID));
-
-    for(uint32_t index =0 ;  index< m_copyKernelParamArrayCount; index++)
-    {
-        gpucopyKernel = (CM_GPUCOPY_KERNEL*)m_copyKernelParamArray.GetElement(index);
-        if(gpucopyKernel != nullptr)
-        {
-            if(!gpucopyKernel->locked &&
-               gpucopyKernel->kernelID == kernelTypeID)
-            {
-                kernelParam = gpucopyKernel;
-                break;
-            }
-        }
-    }
-
-finish:
-    return hr;
-}
-
-//*---------------------------------------------------------------------------------------------------------
-//| Name:       AddGPUCopyKernel()
-//| Purpose:    Add new kernel into m_copyKernelParamArray
-//| Arguments:
-//|             widthInByte      [in]  surface's width in bytes
-//|             height           [in]  surface's height
-//|             format           [in]  surface's height
-//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
-//|             gpuCopyKernelParam [out] kernel param
-//|
-//| Returns:    Result of the operation.
-//|
-//*---------------------------------------------------------------------------------------------------------
-int32_t CmQueueRT::AddGPUCopyKernel(CM_GPUCOPY_KERNEL* &kernelParam)
-{
-    int32_t hr = CM_SUCCESS;
-    // critical section protection
-    CLock locker(m_criticalSectionGPUCopyKrn);
-
-    CM_CHK_NULL_GOTOFINISH(kernelParam, CM_INVALID_GPUCOPY_KERNEL);
-
-    // the newly created kernel must be locked
-    if(!kernelParam->locked)
-    {
-        CM_ASSERTMESSAGE("Error: The newly created kernel must be locked.")
-        hr = CM_INVALID_GPUCOPY_KERNEL;
-        goto finish;
-    }
-
-    m_copyKernelParamArray.SetElement(m_copyKernelParamArrayCount, kernelParam);
-    m_copyKernelParamArrayCount ++;
-
-finish:
-    return hr;
-}
-
-//*---------------------------------------------------------------------------------------------------------
-//| Name:       GetGPUCopyKrnID()
-//| Purpose:    Calculate the kernel ID accroding surface's width, height and copy direction
-//| Arguments:
-//|             widthInByte      [in]  surface's width in bytes
-//|             height           [in]  surface's height
-//|             format           [in]  surface's height
-//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
-//|             kernelID         [out] kernel id
-//|
-//| Returns:    Result of the operation.
-//|
-//*---------------------------------------------------------------------------------------------------------
-int32_t CmQueueRT::GetGPUCopyKrnID( uint32_t widthInByte, uint32_t height, CM_SURFACE_FORMAT format,
-            CM_GPUCOPY_DIRECTION copyDirection, CM_GPUCOPY_KERNEL_ID &kernelID )
-{
-    int32_t hr = CM_SUCCESS;
-
-    kernelID = GPU_COPY_KERNEL_UNKNOWN;
-
-    if (format == CM_SURFACE_FORMAT_NV12 || format == CM_SURFACE_FORMAT_P010 || format == CM_SURFACE_FORMAT_P016)
-    {
-        switch(copyDirection)
-        {
-            case CM_FASTCOPY_GPU2CPU:
-                if ( (height&0x7) ||(widthInByte&0x7f))
-                {
-                    kernelID = GPU_COPY_KERNEL_GPU2CPU_UNALIGNED_NV12_ID ;
-                }
-                else
-                {   // height 8-row aligned, widthByte 128 multiple
-                    kernelID = GPU_COPY_KERNEL_GPU2CPU_ALIGNED_NV12_ID ;
-                }
-                break;
-
-            case CM_FASTCOPY_CPU2GPU:
-                kernelID = GPU_COPY_KERNEL_CPU2GPU_NV12_ID;
-                break;
-
-            case CM_FASTCOPY_GPU2GPU:
-                kernelID = GPU_COPY_KERNEL_GPU2GPU_NV12_ID;
-                break;
-
-            case CM_FASTCOPY_CPU2CPU:
-                kernelID = GPU_COPY_KERNEL_CPU2CPU_ID;
-                break;
-
-            default :
-                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
-                hr = CM_FAILURE;
-                break;
-        }
-    }
-    else
-    {
-        switch(copyDirection)
-        {
-            case CM_FASTCOPY_GPU2CPU:
-                if ( (height&0x7) ||(widthInByte&0x7f))
-                {
-                    kernelID = GPU_COPY_KERNEL_GPU2CPU_UNALIGNED_ID;
-                }
-                else
-                {   // height 8-row aligned, widthByte 128 multiple
-                    kernelID = GPU_COPY_KERNEL_GPU2CPU_ALIGNED_ID;
-                }
-                break;
-
-            case CM_FASTCOPY_CPU2GPU:
-                kernelID = GPU_COPY_KERNEL_CPU2GPU_ID;
-                break;
-
-            case CM_FASTCOPY_GPU2GPU:
-                kernelID = GPU_COPY_KERNEL_GPU2GPU_ID;
-                break;
-
-            case CM_FASTCOPY_CPU2CPU:
-                kernelID = GPU_COPY_KERNEL_CPU2CPU_ID;
-                break;
-
-            default :
-                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
-                hr = CM_FAILURE;
-                break;
-        }
-    }
-
-    return hr;
-}
-
-//*---------------------------------------------------------------------------------------------------------
-//| Name:       AllocateGPUCopyKernel()
-//| Purpose:    Allocate GPUCopy Kernel
-//| Arguments:
-//|             widthInByte      [in]  surface's width in bytes
-//|             height           [in]  surface's height
-//|             format           [in]  surface's height
-//|             copyDirection    [in]  copy direction, cpu -> gpu or gpu -> cpu
-//|             kernel          [out] pointer to created kernel
-//|
-//| Returns:    Result of the operation.
-//|
-//*---------------------------------------------------------------------------------------------------------
-int32_t CmQueueRT::AllocateGPUCopyKernel( uint32_t widthInByte, uint32_t height, CM_SURFACE_FORMAT format,
-            CM_GPUCOPY_DIRECTION copyDirection, CmKernel *&kernel )
-{
-    int32_t          hr                 = CM_SUCCESS;
-    CmProgram       *gpuCopyProgram    = nullptr;
-
-    CM_CHK_CMSTATUS_GOTOFINISH( m_device->LoadPredefinedCopyKernel(gpuCopyProgram));
-    CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyProgram);
-
-    if (format == CM_SURFACE_FORMAT_NV12 || format == CM_SURFACE_FORMAT_P010 || format == CM_SURFACE_FORMAT_P016)
-    {
-        switch(copyDirection)
-        {
-            case CM_FASTCOPY_GPU2CPU:
-                if ( (height&0x7) ||(widthInByte&0x7f))
-                {
-                    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_NV12_32x32 ) , kernel,"PredefinedGPUCopyKernel"));
-                }
-                else
-                {   // height 8-row aligned, widthByte 128 multiple
-                    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_NV12_aligned_32x32 ) , kernel,"PredefinedGPUCopyKernel"));
-                }
-                break;
-
-            case CM_FASTCOPY_CPU2GPU:
-                CM_CHK_CMSTATUS_GOTOFINISH( m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_write_NV12_32x32 ), kernel, "PredefinedGPUCopyKernel"));
-                break;
-
-            case CM_FASTCOPY_GPU2GPU:
-                CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_2DTo2D_NV12_32x32), kernel, "PredefinedGPUCopyKernel"));
-                break;
-
-            case CM_FASTCOPY_CPU2CPU:
-                CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_BufferToBuffer_4k), kernel, "PredefinedGPUCopyKernel"));
-                break;
-
-            default :
-                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
-                hr = CM_FAILURE;
-                break;
-        }
-    }
-    else
-    {
-        switch(copyDirection)
-        {
-            case CM_FASTCOPY_GPU2CPU:
-                if ( (height&0x7) ||(widthInByte&0x7f))
-                {
-                    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_32x32 ) , kernel, "PredefinedGPUCopyKernel"));
-                }
-                else
-                {   // height 8-row aligned, widthByte 128 multiple
-                    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_read_aligned_32x32  ) , kernel, "PredefinedGPUCopyKernel"));
-                }
-                break;
-
-            case CM_FASTCOPY_CPU2GPU:
-                CM_CHK_CMSTATUS_GOTOFINISH( m_device->CreateKernel( gpuCopyProgram, _NAME( surfaceCopy_write_32x32 ), kernel, "PredefinedGPUCopyKernel" ));
-                break;
-
-            case CM_FASTCOPY_GPU2GPU:
-                CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_2DTo2D_32x32), kernel, "PredefinedGPUCopyKernel"));
-                break;
-
-            case CM_FASTCOPY_CPU2CPU:
-                CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateKernel(gpuCopyProgram, _NAME(SurfaceCopy_BufferToBuffer_4k), kernel, "PredefinedGPUCopyKernel"));
-                break;
-
-            default :
-                CM_ASSERTMESSAGE("Error: Invalid fast copy direction.")
-                hr = CM_FAILURE;
-                break;
-        }
-    }
-
-finish:
-    return hr;
+    return m_device->AcquireGPUCopyKernel(widthInByte, height, format, copyDirection, gpuCopyKernelParam);
 }
 
 CM_RT_API int32_t CmQueueRT::EnqueueFast(CmTask *task,
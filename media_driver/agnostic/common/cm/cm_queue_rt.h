@@ -29,7 +29,9 @@
 
 #include "cm_queue.h"
 
-#include <queue>
+#include <atomic>
+#include <new>
+#include <thread>
 
 #include "cm_array.h"
 #include "cm_csync.h"
@@ -49,63 +51,124 @@ class CmVebox;
 class CmBuffer;
 class CmSurface2D;
 class CmSurface2DRT;
+struct CM_GPUCOPY_KERNEL;
 
-struct CM_GPUCOPY_KERNEL
-{
-    CmKernel *kernel;
-    CM_GPUCOPY_KERNEL_ID kernelID;
-    bool locked;
-};
-
+//!
+//! \brief    Multi-producer, single-consumer task queue.
+//! \details  Push() is lock-free and may be called from any number of threads.
+//!           Pop() and Top() must only be called by one consumer at a time,
+//!           i.e. the flusher for m_enqueuedTasks or the owner of
+//!           m_criticalSectionFlushedTask for m_flushedTasks.
+//!
 class ThreadSafeQueue
 {
 public:
+    ThreadSafeQueue(): mHead(&mStub), mTail(&mStub), mCount(0)
+    {
+        mStub.element = nullptr;
+        mStub.next.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~ThreadSafeQueue()
+    {
+        Node *node = mTail;
+        while (node != nullptr)
+        {
+            Node *next = node->next.load(std::memory_order_relaxed);
+            if (node != &mStub)
+            {
+                delete node;
+            }
+            node = next;
+        }
+    }
+
     bool Push(CmTaskInternal *element)
     {
-        mCriticalSection.Acquire();
-        mQueue.push(element);
-        mCriticalSection.Release();
+        Node *node = new (std::nothrow) Node;
+        if (node == nullptr)
+        {
+            return false;
+        }
+        node->element = element;
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        Node *prev = mHead.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        mCount.fetch_add(1, std::memory_order_release);
         return true;
     }
 
     CmTaskInternal *Pop()
     {
-        CmTaskInternal *element = nullptr;
-        mCriticalSection.Acquire();
-        if (mQueue.empty())
+        Node *next = WaitNext();
+        if (next == nullptr)
         {
             CM_ASSERT(0);
+            return nullptr;
         }
-        else
+
+        // The popped node becomes the new stub; the old one is released.
+        Node *tail = mTail;
+        mTail = next;
+        if (tail != &mStub)
         {
-            element = mQueue.front();
-            mQueue.pop();
+            delete tail;
         }
-        mCriticalSection.Release();
-        return element;
+        mCount.fetch_sub(1, std::memory_order_release);
+        return next->element;
     }
 
     CmTaskInternal *Top()
     {
-        CmTaskInternal *element = nullptr;
-        if (mQueue.empty())
+        Node *next = WaitNext();
+        if (next == nullptr)
         {
             CM_ASSERT(0);
+            return nullptr;
         }
-        else
-        {
-            element = mQueue.front();
-        }
-        return element;
+        return next->element;
     }
 
-    bool IsEmpty() { return mQueue.empty(); }
+    bool IsEmpty() { return mCount.load(std::memory_order_acquire) == 0; }
 
-    int GetCount() { return mQueue.size(); }
+    int GetCount() { return (int)mCount.load(std::memory_order_acquire); }
 
 private:
-    std::queue<CmTaskInternal*> mQueue;
-    CSync mCriticalSection;
+    struct Node
+    {
+        CmTaskInternal     *element;
+        std::atomic<Node *> next;
+    };
+
+    //!
+    //! \brief    Returns the node following the tail.
+    //! \details  A producer links its node right after swapping the head, so a
+    //!           non-zero count with an unlinked tail only lasts for a few
+    //!           instructions; spin until the link becomes visible.
+    //!
+    Node *WaitNext()
+    {
+        Node *next = mTail->next.load(std::memory_order_acquire);
+        while (next == nullptr)
+        {
+            if (mCount.load(std::memory_order_acquire) == 0)
+            {
+                return nullptr;
+            }
+            std::this_thread::yield();
+            next = mTail->next.load(std::memory_order_acquire);
+        }
+        return next;
+    }
+
+    std::atomic<Node *>   mHead;     // Producers append here
+    Node                 *mTail;     // Owned by the consumer
+    Node                  mStub;
+    std::atomic<uint32_t> mCount;
+
+    ThreadSafeQueue(const ThreadSafeQueue &other);
+    ThreadSafeQueue &operator=(const ThreadSafeQueue &other);
 };
 
 //!
@@ -308,32 +371,12 @@ protected:
                         int32_t &taskDriverId,
                         CmEventRT *&event);
 
-    int32_t AddGPUCopyKernel(CM_GPUCOPY_KERNEL* &kernelParam);
-
-    int32_t GetGPUCopyKrnID(uint32_t widthInByte,
-                            uint32_t height,
-                            CM_SURFACE_FORMAT format,
-                            CM_GPUCOPY_DIRECTION copyDirection,
-                            CM_GPUCOPY_KERNEL_ID &kernelID);
-
-    int32_t AllocateGPUCopyKernel(uint32_t widthInByte,
-                                  uint32_t height,
-                                  CM_SURFACE_FORMAT format,
-                                  CM_GPUCOPY_DIRECTION copyDirection,
-                                  CmKernel* &kernel);
-
     int32_t CreateGPUCopyKernel(uint32_t widthInByte,
                                 uint32_t height,
                                 CM_SURFACE_FORMAT format,
                                 CM_GPUCOPY_DIRECTION copyDirection,
                                 CM_GPUCOPY_KERNEL* &gpuCopyKernelParam);
 
-    int32_t SearchGPUCopyKernel(uint32_t widthInByte,
-                                uint32_t height,
-                                CM_SURFACE_FORMAT format,
-                                CM_GPUCOPY_DIRECTION copyDirection,
-                                CM_GPUCOPY_KERNEL* &kernelParam);
-
     int32_t RegisterSyncEvent();
 
 
@@ -343,18 +386,17 @@ protected:
 
     CmDynamicArray m_eventArray;
     CSync m_criticalSectionEvent;        // Protect m_eventArray
-    CSync m_criticalSectionHalExecute;   // Protect execution in HALCm, i.e HalCm_Execute
+    CSync m_criticalSectionHalExecute;   // Protect HalCm_Execute on this queue's own compute context
+    CSync *m_halExecuteLock;             // Per GPU context lock used when submitting, see Initialize()
     CSync m_criticalSectionFlushedTask;  // Protect QueryFlushedTask
-    CSync m_criticalSectionTaskInternal;
+    CSync m_criticalSectionTaskInternal; // Protect task creation only; flushing happens outside
+
+    std::atomic<uint32_t> m_flushRequests;  // Flush requests not yet served by the active flusher
+    std::atomic<bool>     m_flusherActive;  // Set while one thread drains m_enqueuedTasks
 
     uint32_t m_eventCount;
     uint64_t m_CPUperformanceFrequency;
 
-    CmDynamicArray m_copyKernelParamArray;
-    uint32_t m_copyKernelParamArrayCount;
-
-    CSync m_criticalSectionGPUCopyKrn;
-
     CM_HAL_MAX_VALUES *m_halMaxValues;
     CM_QUEUE_CREATE_OPTION m_queueOption;
 
@@ -55,7 +55,8 @@ int32_t CmTaskInternal::Create(const uint32_t kernelCount, const uint32_t totalT
                                CmKernelRT* kernelArray[], const CmThreadSpaceRT* threadSpace,
                                CmDeviceRT* device, const uint64_t syncBitmap, CmTaskInternal*& task,
                                const uint64_t conditionalEndBitmap,
-                               PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo)
+                               PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo,
+                               uint32_t trackerIndex)
 {
     int32_t result = CM_SUCCESS;
     task = new (std::nothrow) CmTaskInternal(kernelCount, totalThreadCount, kernelArray, device,
@@ -63,6 +64,7 @@ int32_t CmTaskInternal::Create(const uint32_t kernelCount, const uint32_t totalT
                                              nullptr);
     if( task )
     {
+        task->m_trackerIndex = trackerIndex;
         result = task->Initialize(threadSpace, false);
         if( result != CM_SUCCESS )
         {
@@ -86,7 +88,8 @@ int32_t CmTaskInternal::Create( const uint32_t kernelCount, const uint32_t total
                                CmDeviceRT* device, const uint64_t syncBitmap, CmTaskInternal*& task,
                                const uint64_t conditionalEndBitmap,
                                PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo,
-                               const CM_EXECUTION_CONFIG* krnExecCfg)
+                               const CM_EXECUTION_CONFIG* krnExecCfg,
+                               uint32_t trackerIndex)
 {
     int32_t result = CM_SUCCESS;
     task = new (std::nothrow) CmTaskInternal(kernelCount, totalThreadCount, kernelArray, device,
@@ -95,6 +98,7 @@ int32_t CmTaskInternal::Create( const uint32_t kernelCount, const uint32_t total
 
     if( task )
     {
+        task->m_trackerIndex = trackerIndex;
         result = task->Initialize(threadGroupSpace);
         if( result != CM_SUCCESS )
         {
@@ -109,13 +113,15 @@ int32_t CmTaskInternal::Create( const uint32_t kernelCount, const uint32_t total
     return result;
 }
 
-int32_t CmTaskInternal::Create( CmDeviceRT* device, CmVeboxRT* vebox, CmTaskInternal*& task )
+int32_t CmTaskInternal::Create( CmDeviceRT* device, CmVeboxRT* vebox, CmTaskInternal*& task,
+                                uint32_t trackerIndex )
 {
     int32_t result = CM_SUCCESS;
     task = new (std::nothrow) CmTaskInternal(0, 0, nullptr, device, CM_NO_KERNEL_SYNC,
                                              CM_NO_CONDITIONAL_END, nullptr, nullptr);
     if( task )
     {
+        task->m_trackerIndex = trackerIndex;
         result = task->Initialize(vebox);
         if( result != CM_SUCCESS )
         {
@@ -137,13 +143,14 @@ int32_t CmTaskInternal::Create( CmDeviceRT* device, CmVeboxRT* vebox, CmTaskInte
 int32_t CmTaskInternal::Create(const uint32_t kernelCount, const uint32_t totalThreadCount,
                                CmKernelRT* kernelArray[], CmTaskInternal*& task,
                                uint32_t numGeneratedTasks, bool isLastTask, uint32_t hints,
-                               CmDeviceRT* device)
+                               CmDeviceRT* device, uint32_t trackerIndex)
 {
     int32_t result = CM_SUCCESS;
     task = new (std::nothrow) CmTaskInternal(kernelCount, totalThreadCount, kernelArray, device,
                                              CM_NO_KERNEL_SYNC, CM_NO_CONDITIONAL_END, nullptr, nullptr);
     if ( task )
     {
+        task->m_trackerIndex = trackerIndex;
         result = task->Initialize(hints, numGeneratedTasks, isLastTask);
         if ( result != CM_SUCCESS )
         {
@@ -209,6 +216,7 @@ CmTaskInternal::CmTaskInternal(const uint32_t kernelCount, const uint32_t totalT
     m_cmDevice( device ),
     m_surfaceArray (nullptr),
     m_isSurfaceUpdateDone(false),
+    m_trackerIndex(0),
     m_taskType(CM_TASK_TYPE_DEFAULT),
     m_mediaStatePtr( nullptr )
 {
@@ -1840,8 +1848,10 @@ int32_t CmTaskInternal::UpdateSurfaceStateOnTaskCreation()
                 }
                 else
                 {
-                    surface->SetRenderTracker(state->renderHal->currentTrackerIndex,
-                               state->renderHal->trackerProducer.GetNextTracker(state->renderHal->currentTrackerIndex));
+                    // use the tracker of the enqueuing queue; renderHal's current
+                    // tracker index belongs to the flusher holding the HAL lock
+                    surface->SetRenderTracker(m_trackerIndex,
+                               state->renderHal->trackerProducer.GetNextTracker(m_trackerIndex));
                 }
 
                 // Push this surface's resource into array for CP check.
@@ -86,19 +86,22 @@ public:
                            CmKernelRT* kernelArray[], const CmThreadSpaceRT* threadSpace,
                            CmDeviceRT* device, const uint64_t syncBitmap, CmTaskInternal*& task,
                            const uint64_t conditionalEndBitmap,
-                           PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo );
+                           PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo,
+                           uint32_t trackerIndex );
     static int32_t Destroy( CmTaskInternal* &task );
     static int32_t Create( const uint32_t kernelCount, const uint32_t totalThreadCount,
                            CmKernelRT* kernelArray[], const CmThreadGroupSpace* threadGroupSpace,
                            CmDeviceRT* device, const uint64_t syncBitmap, CmTaskInternal*& task,
                            const uint64_t conditionalEndBitmap,
                            PCM_HAL_CONDITIONAL_BB_END_INFO conditionalEndInfo,
-                           const CM_EXECUTION_CONFIG* krnExecCfg);
-    static int32_t Create( CmDeviceRT* device, CmVeboxRT* vebox, CmTaskInternal*& task );
+                           const CM_EXECUTION_CONFIG* krnExecCfg,
+                           uint32_t trackerIndex);
+    static int32_t Create( CmDeviceRT* device, CmVeboxRT* vebox, CmTaskInternal*& task,
+                           uint32_t trackerIndex );
     static int32_t Create( const uint32_t kernelCount, const uint32_t totalThreadCount,
                            CmKernelRT* kernelArray[], CmTaskInternal*& task,
                            uint32_t numGeneratedTasks, bool isLastTask, uint32_t hints,
-                           CmDeviceRT* device);
+                           CmDeviceRT* device, uint32_t trackerIndex);
 
     int32_t GetKernelCount( uint32_t& count );
     int32_t GetKernel( const uint32_t index, CmKernelRT* & kernel );
@@ -240,6 +243,7 @@ protected:
     CmDeviceRT*                      m_cmDevice;
     bool                             *m_surfaceArray;  // vector-flag of surfaces R/W by this CM Task (containing multi-kernel)
     bool                             m_isSurfaceUpdateDone;
+    uint32_t                         m_trackerIndex;    // render tracker of the enqueuing queue
 
     uint32_t        m_taskType; //0 - Task with thread space, 1 - Task with thread group space, 2 - Task for VEBOX
 
@@ -0,0 +1,96 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_thread_space_order.cpp
+//! \brief     Contains scoreboard board order generators of the thread space.
+//!
+
+#include "cm_thread_space_order.h"
+
+namespace CMRT_UMD
+{
+//*-----------------------------------------------------------------------------
+//| Purpose:    Generate the Wave45 board order
+//*-----------------------------------------------------------------------------
+void CmWavefront45Order(uint32_t width, uint32_t height, uint32_t *boardOrder)
+{
+    // Threads on anti-diagonal x + y = d, top to bottom. Offsets along a
+    // diagonal are y * (width - 1) + d, so no visited flags are needed.
+    for (uint32_t d = 0; d < width + height - 1; d ++)
+    {
+        uint32_t yStart = (d < width) ? 0 : d - width + 1;
+        uint32_t yEnd = (d + 1 < height) ? d + 1 : height;
+        for (uint32_t y = yStart; y < yEnd; y ++)
+        {
+            boardOrder[y - yStart] = y * (width - 1) + d;
+        }
+        boardOrder += yEnd - yStart;
+    }
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Generate the Wave26 board order
+//*-----------------------------------------------------------------------------
+void CmWavefront26Order(uint32_t width, uint32_t height, uint32_t *boardOrder)
+{
+    // Threads on line x + 2 * y = d, top to bottom. Offsets along a line are
+    // y * (width - 2) + d (modulo 2^32 when width < 2).
+    for (uint32_t d = 0; d < width + 2 * (height - 1); d ++)
+    {
+        uint32_t yStart = (d < width) ? 0 : (d - width + 2) / 2;
+        uint32_t yEnd = (d / 2 + 1 < height) ? d / 2 + 1 : height;
+        for (uint32_t y = yStart; y < yEnd; y ++)
+        {
+            boardOrder[y - yStart] = y * (width - 2) + d;
+        }
+        boardOrder += yEnd - yStart;
+    }
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Generate the vertical wave board order
+//*-----------------------------------------------------------------------------
+void CmVerticalOrder(uint32_t width, uint32_t height, uint32_t *boardOrder)
+{
+    // Column-major order
+    for (uint32_t x = 0; x < width; x ++)
+    {
+        for (uint32_t y = 0; y < height; y ++)
+        {
+            boardOrder[y] = y * width + x;
+        }
+        boardOrder += height;
+    }
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Generate the horizontal wave board order
+//*-----------------------------------------------------------------------------
+void CmHorizontalOrder(uint32_t width, uint32_t height, uint32_t *boardOrder)
+{
+    // Row-major order
+    for (uint32_t i = 0; i < width * height; i ++)
+    {
+        boardOrder[i] = i;
+    }
+}
+};  //namespace
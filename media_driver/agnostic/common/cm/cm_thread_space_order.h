@@ -0,0 +1,81 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_thread_space_order.h
+//! \brief     Contains scoreboard board order generators of the thread space.
+//!
+
+#ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDER_H_
+#define MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDER_H_
+
+#include <stdint.h>
+
+namespace CMRT_UMD
+{
+//!
+//! \brief    Board order of the 45 degree wavefront: anti-diagonals from the
+//!           top left corner, each one from top to bottom.
+//! \param    [in] width
+//!           Width of the thread space.
+//! \param    [in] height
+//!           Height of the thread space.
+//! \param    [out] boardOrder
+//!           Destination of width * height linear offsets.
+//!
+void CmWavefront45Order(uint32_t width, uint32_t height, uint32_t *boardOrder);
+
+//!
+//! \brief    Board order of the 26 degree wavefront: lines x + 2 * y from
+//!           the top left corner, each one from top to bottom.
+//! \param    [in] width
+//!           Width of the thread space.
+//! \param    [in] height
+//!           Height of the thread space.
+//! \param    [out] boardOrder
+//!           Destination of width * height linear offsets.
+//!
+void CmWavefront26Order(uint32_t width, uint32_t height, uint32_t *boardOrder);
+
+//!
+//! \brief    Board order of the vertical wave, column by column.
+//! \param    [in] width
+//!           Width of the thread space.
+//! \param    [in] height
+//!           Height of the thread space.
+//! \param    [out] boardOrder
+//!           Destination of width * height linear offsets.
+//!
+void CmVerticalOrder(uint32_t width, uint32_t height, uint32_t *boardOrder);
+
+//!
+//! \brief    Board order of the horizontal wave, row by row.
+//! \param    [in] width
+//!           Width of the thread space.
+//! \param    [in] height
+//!           Height of the thread space.
+//! \param    [out] boardOrder
+//!           Destination of width * height linear offsets.
+//!
+void CmHorizontalOrder(uint32_t width, uint32_t height, uint32_t *boardOrder);
+};  //namespace
+
+#endif  // #ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDER_H_
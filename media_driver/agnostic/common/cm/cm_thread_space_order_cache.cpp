@@ -0,0 +1,121 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_thread_space_order_cache.cpp
+//! \brief     Contains Class CmThreadSpaceOrderCache implementations.
+//!
+
+#include "cm_thread_space_order_cache.h"
+
+#include "cm_mem.h"
+
+namespace CMRT_UMD
+{
+//*-----------------------------------------------------------------------------
+//| Purpose:    Constructor of CmThreadSpaceOrderCache
+//*-----------------------------------------------------------------------------
+CmThreadSpaceOrderCache::CmThreadSpaceOrderCache():
+    m_useCount(0),
+    m_hitCount(0),
+    m_missCount(0)
+{
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Destructor of CmThreadSpaceOrderCache
+//*-----------------------------------------------------------------------------
+CmThreadSpaceOrderCache::~CmThreadSpaceOrderCache()
+{
+    m_entries.clear();
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Copy the cached board order of a thread space setting
+//| Returns:    true if the order was found in the cache
+//*-----------------------------------------------------------------------------
+bool CmThreadSpaceOrderCache::Lookup(
+    const CM_THREAD_SPACE_ORDER_KEY   &key,
+    uint32_t                          *boardOrder,
+    CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo)
+{
+    CLock locker(m_criticalSection);
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        m_missCount++;
+        return false;
+    }
+
+    CacheEntry &entry = it->second;
+    CmFastMemCopy(boardOrder, entry.boardOrder.data(), entry.boardOrder.size() * sizeof(uint32_t));
+
+    if (dispatchInfo && dispatchInfo->numThreadsInWave && !entry.threadsInWave.empty())
+    {
+        CmFastMemCopy(dispatchInfo->numThreadsInWave, entry.threadsInWave.data(), entry.threadsInWave.size() * sizeof(uint32_t));
+        dispatchInfo->numWaves = (uint32_t)entry.threadsInWave.size();
+    }
+
+    entry.lastUse = ++m_useCount;
+    m_hitCount++;
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Store the board order of a thread space setting, evicting the
+//|             least recently used order if the cache is full
+//*-----------------------------------------------------------------------------
+void CmThreadSpaceOrderCache::Insert(
+    const CM_THREAD_SPACE_ORDER_KEY         &key,
+    const uint32_t                          *boardOrder,
+    const CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo)
+{
+    CLock locker(m_criticalSection);
+
+    if (m_entries.find(key) != m_entries.end())
+    {
+        return;
+    }
+
+    if (m_entries.size() >= CM_THREAD_SPACE_ORDER_CACHE_SIZE)
+    {
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->second.lastUse < oldest->second.lastUse)
+            {
+                oldest = it;
+            }
+        }
+        m_entries.erase(oldest);
+    }
+
+    CacheEntry &entry = m_entries[key];
+    entry.boardOrder.assign(boardOrder, boardOrder + key.width * key.height);
+    if (dispatchInfo && dispatchInfo->numThreadsInWave)
+    {
+        entry.threadsInWave.assign(dispatchInfo->numThreadsInWave,
+                                   dispatchInfo->numThreadsInWave + dispatchInfo->numWaves);
+    }
+    entry.lastUse = ++m_useCount;
+}
+};  //namespace
@@ -0,0 +1,134 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_thread_space_order_cache.h
+//! \brief     Contains Class CmThreadSpaceOrderCache definitions.
+//!
+
+#ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDERCACHE_H_
+#define MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDERCACHE_H_
+
+#include "cm_thread_space.h"
+#include "cm_csync.h"
+#include "cm_hal.h"
+
+#include <map>
+#include <vector>
+
+#define CM_THREAD_SPACE_ORDER_CACHE_SIZE    16
+
+//!
+//! \brief    Everything the scoreboard dispatch order of a thread space
+//!           depends on. Instances are compared bytewise, so they must be
+//!           zero-initialized before the fields are filled in.
+//!
+struct CM_THREAD_SPACE_ORDER_KEY
+{
+    uint32_t width;
+    uint32_t height;
+    CM_DEPENDENCY_PATTERN dependencyPattern;
+    CM_26ZI_DISPATCH_PATTERN dispatchPattern26ZI;
+    uint32_t blockWidth26ZI;
+    uint32_t blockHeight26ZI;
+    uint32_t dependencyVectorsSet;
+    CM_HAL_DEPENDENCY dependencyVectors;
+
+    bool operator<(const CM_THREAD_SPACE_ORDER_KEY &other) const
+    {
+        return memcmp(this, &other, sizeof(CM_THREAD_SPACE_ORDER_KEY)) < 0;
+    }
+    bool operator==(const CM_THREAD_SPACE_ORDER_KEY &other) const
+    {
+        return memcmp(this, &other, sizeof(CM_THREAD_SPACE_ORDER_KEY)) == 0;
+    }
+};
+
+namespace CMRT_UMD
+{
+//!
+//! \brief    Device-wide cache of thread space board orders, so thread spaces
+//!           sharing dimensions and dependency setting sort only once.
+//!           Least recently used orders are evicted beyond
+//!           CM_THREAD_SPACE_ORDER_CACHE_SIZE entries.
+//!
+class CmThreadSpaceOrderCache
+{
+public:
+    CmThreadSpaceOrderCache();
+
+    ~CmThreadSpaceOrderCache();
+
+    //!
+    //! \brief    Copy a cached board order out of the cache.
+    //! \param    [in] key
+    //!           Dimensions and dependency setting of the thread space.
+    //! \param    [out] boardOrder
+    //!           Destination of width * height entries.
+    //! \param    [out] dispatchInfo
+    //!           Receives the 26Z wave sizes if the cached entry has them and
+    //!           numThreadsInWave is not nullptr.
+    //! \return   true on a hit, false otherwise.
+    //!
+    bool Lookup(const CM_THREAD_SPACE_ORDER_KEY &key,
+                uint32_t *boardOrder,
+                CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo);
+
+    //!
+    //! \brief    Store a freshly generated board order.
+    //! \param    [in] key
+    //!           Dimensions and dependency setting of the thread space.
+    //! \param    [in] boardOrder
+    //!           Board order of width * height entries.
+    //! \param    [in] dispatchInfo
+    //!           26Z wave sizes, or nullptr if the pattern has none.
+    //!
+    void Insert(const CM_THREAD_SPACE_ORDER_KEY &key,
+                const uint32_t *boardOrder,
+                const CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo);
+
+    //! \brief    Number of lookups which were served from the cache.
+    uint64_t GetHitCount() { return m_hitCount; }
+
+    //! \brief    Number of lookups which had to fall back to sorting.
+    uint64_t GetMissCount() { return m_missCount; }
+
+private:
+    struct CacheEntry
+    {
+        std::vector<uint32_t> boardOrder;
+        std::vector<uint32_t> threadsInWave;
+        uint64_t lastUse;
+    };
+
+    std::map<CM_THREAD_SPACE_ORDER_KEY, CacheEntry> m_entries;
+    uint64_t m_useCount;
+    uint64_t m_hitCount;
+    uint64_t m_missCount;
+    CSync m_criticalSection;
+
+private:
+    CmThreadSpaceOrderCache(const CmThreadSpaceOrderCache &other);
+    CmThreadSpaceOrderCache &operator=(const CmThreadSpaceOrderCache &other);
+};
+};  //namespace
+
+#endif  // #ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACEORDERCACHE_H_
@@ -25,6 +25,7 @@
 //!
 
 #include "cm_thread_space_rt.h"
+#include "cm_thread_space_order.h"
 
 #include "cm_kernel_rt.h"
 #include "cm_task_rt.h"
@@ -177,12 +178,14 @@ CmThreadSpaceRT::CmThreadSpaceRT( CmDeviceRT* device , uint32_t indexTsArray, ui
     m_swScoreBoardEnabled(false),
     m_threadGroupSpace(nullptr),
     m_dirtyStatus(nullptr),
+    m_boardOrderValid(false),
     m_groupSelect(CM_MW_GROUP_NONE)
 {
     CmSafeMemSet( &m_dependency, 0, sizeof(CM_HAL_DEPENDENCY) );
     CmSafeMemSet( &m_wavefront26ZDispatchInfo, 0, sizeof(CM_HAL_WAVEFRONT26Z_DISPATCH_INFO) );
     CmSafeMemSet( &m_walkingParameters, 0, sizeof(m_walkingParameters) );
     CmSafeMemSet( &m_dependencyVectors, 0, sizeof(m_dependencyVectors) );
+    CmSafeMemSet( &m_boardOrderKey, 0, sizeof(m_boardOrderKey) );
 }
 
 //*-----------------------------------------------------------------------------
@@ -994,35 +997,8 @@ int32_t CmThreadSpaceRT::Wavefront45Sequence()
     }
     m_currentDependencyPattern = CM_WAVEFRONT;
 
-    CmSafeMemSet(m_boardFlag, WHITE, m_width*m_height*sizeof(uint32_t));
-    m_indexInList = 0;
-
-    for (uint32_t y = 0; y < m_height; y ++)
-    {
-        for (uint32_t x = 0; x < m_width; x ++)
-        {
-            CM_COORDINATE tempCoordinate;
-            int32_t linearOffset = y * m_width + x;
-            if (m_boardFlag[linearOffset] == WHITE)
-            {
-                m_boardOrderList[m_indexInList ++] = linearOffset;
-                m_boardFlag[linearOffset] = BLACK;
-                tempCoordinate.x = x - 1;
-                tempCoordinate.y = y + 1;
-                while ((tempCoordinate.x >= 0) && (tempCoordinate.y >= 0) &&
-                    (tempCoordinate.x < (int32_t)m_width) && (tempCoordinate.y < (int32_t)m_height))
-                {
-                    if (m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] == WHITE)
-                    {
-                        m_boardOrderList[m_indexInList ++] = tempCoordinate.y * m_width + tempCoordinate.x;
-                        m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] = BLACK;
-                    }
-                    tempCoordinate.x = tempCoordinate.x - 1;
-                    tempCoordinate.y = tempCoordinate.y + 1;
-                }
-            }
-        }
-    }
+    CmWavefront45Order(m_width, m_height, m_boardOrderList);
+    m_indexInList = m_width * m_height;
 
     return CM_SUCCESS;
 }
@@ -1038,35 +1014,8 @@ int32_t CmThreadSpaceRT::Wavefront26Sequence()
     }
     m_currentDependencyPattern = CM_WAVEFRONT26;
 
-    CmSafeMemSet(m_boardFlag, WHITE, m_width*m_height*sizeof(uint32_t));
-    m_indexInList = 0;
-
-    for (uint32_t y = 0; y < m_height; y ++)
-    {
-        for (uint32_t x = 0; x < m_width; x ++)
-        {
-            CM_COORDINATE tempCoordinate;
-            int32_t linearOffset = y * m_width + x;
-            if (m_boardFlag[linearOffset] == WHITE)
-            {
-                m_boardOrderList[m_indexInList ++] = linearOffset;
-                m_boardFlag[linearOffset] = BLACK;
-                tempCoordinate.x = x - 2;
-                tempCoordinate.y = y + 1;
-                while ((tempCoordinate.x >= 0) && (tempCoordinate.y >= 0) &&
-                    (tempCoordinate.x < (int32_t)m_width) && (tempCoordinate.y < (int32_t)m_height))
-                {
-                    if (m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] == WHITE)
-                    {
-                        m_boardOrderList[m_indexInList ++] = tempCoordinate.y * m_width + tempCoordinate.x;
-                        m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] = BLACK;
-                    }
-                    tempCoordinate.x = tempCoordinate.x - 2;
-                    tempCoordinate.y = tempCoordinate.y + 1;
-                }
-            }
-        }
-    }
+    CmWavefront26Order(m_width, m_height, m_boardOrderList);
+    m_indexInList = m_width * m_height;
 
    return CM_SUCCESS;
 }
@@ -1727,34 +1676,8 @@ int32_t CmThreadSpaceRT::VerticalSequence()
     }
     m_currentDependencyPattern = CM_VERTICAL_WAVE;
 
-    CmSafeMemSet(m_boardFlag, WHITE, m_width*m_height*sizeof(uint32_t));
-    m_indexInList = 0;
-
-    for (uint32_t x = 0; x < m_width; x ++)
-    {
-        for (uint32_t y = 0; y < m_height; y ++)
-        {
-            CM_COORDINATE tempCoordinate;
-            int32_t linearOffset = y * m_width + x;
-            if (m_boardFlag[linearOffset] == WHITE)
-            {
-                m_boardOrderList[m_indexInList ++] = linearOffset;
-                m_boardFlag[linearOffset] = BLACK;
-                tempCoordinate.x = x;
-                tempCoordinate.y = y + 1;
-                while ((tempCoordinate.x >= 0) && (tempCoordinate.y >= 0) &&
-                    (tempCoordinate.x < (int32_t)m_width) && (tempCoordinate.y < (int32_t)m_height))
-                {
-                    if (m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] == WHITE)
-                    {
-                        m_boardOrderList[m_indexInList ++] = tempCoordinate.y * m_width + tempCoordinate.x;
-                        m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] = BLACK;
-                    }
-                    tempCoordinate.y = tempCoordinate.y + 1;
-                }
-            }
-        }
-    }
+    CmVerticalOrder(m_width, m_height, m_boardOrderList);
+    m_indexInList = m_width * m_height;
 
     return CM_SUCCESS;
 }
@@ -1767,34 +1690,8 @@ int32_t CmThreadSpaceRT::HorizentalSequence()
     }
     m_currentDependencyPattern = CM_HORIZONTAL_WAVE;
 
-    CmSafeMemSet(m_boardFlag, WHITE, m_width*m_height*sizeof(uint32_t));
-    m_indexInList = 0;
-
-    for (uint32_t y = 0; y < m_height; y ++)
-    {
-        for (uint32_t x = 0; x < m_width; x ++)
-        {
-            CM_COORDINATE tempCoordinate;
-            int32_t linearOffset = y * m_width + x;
-            if (m_boardFlag[linearOffset] == WHITE)
-            {
-                m_boardOrderList[m_indexInList ++] = linearOffset;
-                m_boardFlag[linearOffset] = BLACK;
-                tempCoordinate.x = x + 1;
-                tempCoordinate.y = y;
-                while ((tempCoordinate.x >= 0) && (tempCoordinate.y >= 0) &&
-                    (tempCoordinate.x < (int32_t)m_width) && (tempCoordinate.y < (int32_t)m_height))
-                {
-                    if (m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] == WHITE)
-                    {
-                        m_boardOrderList[m_indexInList ++] = tempCoordinate.y * m_width + tempCoordinate.x;
-                        m_boardFlag[tempCoordinate.y * m_width + tempCoordinate.x] = BLACK;
-                    }
-                    tempCoordinate.x = tempCoordinate.x + 1;
-                }
-            }
-        }
-    }
+    CmHorizontalOrder(m_width, m_height, m_boardOrderList);
+    m_indexInList = m_width * m_height;
 
     return CM_SUCCESS;
 }
@@ -1900,6 +1797,223 @@ int32_t CmThreadSpaceRT::WavefrontDependencyVectors()
     return CM_SUCCESS;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Generate the board order for the current dependency setting
+//| Returns:    CM_FAILURE if the dependency type is invalid. The result of
+//|             the sequence generator is returned in sortResult.
+//*-----------------------------------------------------------------------------
+int32_t CmThreadSpaceRT::GenerateBoardOrder(int32_t &sortResult)
+{
+    int32_t hr = CM_SUCCESS;
+    sortResult = CM_SUCCESS;
+
+    if (m_dependencyVectorsSet)
+    {
+        sortResult = WavefrontDependencyVectors();
+    }
+    else
+    {
+        switch (m_dependencyPatternType)
+        {
+            case CM_WAVEFRONT:
+                sortResult = Wavefront45Sequence();
+                break;
+
+            case CM_WAVEFRONT26:
+                sortResult = Wavefront26Sequence();
+                break;
+
+            case CM_WAVEFRONT26Z:
+                sortResult = Wavefront26ZSequence();
+                break;
+
+            case CM_WAVEFRONT26ZI:
+                switch (m_26ZIDispatchPattern)
+                {
+                case VVERTICAL_HVERTICAL_26:
+                    sortResult = Wavefront26ZISeqVVHV26();
+                    break;
+                case VVERTICAL_HHORIZONTAL_26:
+                    sortResult = Wavefront26ZISeqVVHH26();
+                    break;
+                case VVERTICAL26_HHORIZONTAL26:
+                    sortResult = Wavefront26ZISeqVV26HH26();
+                    break;
+                case VVERTICAL1X26_HHORIZONTAL1X26:
+                    sortResult = Wavefront26ZISeqVV1x26HH1x26();
+                    break;
+                default:
+                    sortResult = Wavefront26ZISeqVVHV26();
+                    break;
+                }
+                break;
+
+            case CM_HORIZONTAL_WAVE:
+                sortResult = HorizentalSequence();
+                break;
+
+            case CM_VERTICAL_WAVE:
+                sortResult = VerticalSequence();
+                break;
+
+            case CM_NONE_DEPENDENCY:
+            case CM_WAVEFRONT26X:
+            case CM_WAVEFRONT26ZIG:
+                break;
+
+            default:
+                CM_ASSERTMESSAGE("Error: Invalid thread dependency type.");
+                hr = CM_FAILURE;
+                break;
+        }
+    }
+
+    return hr;
+}
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+//*-----------------------------------------------------------------------------
+//| Purpose:    Checks a reused board order, and the 26Z wave sizes, against
+//|             the sequence generators
+//| Returns:    CM_FAILURE if the reused board order differs.
+//*-----------------------------------------------------------------------------
+int32_t CmThreadSpaceRT::VerifyBoardOrder()
+{
+    uint32_t threadCount = m_width * m_height;
+    std::vector<uint32_t> reusedOrder(m_boardOrderList, m_boardOrderList + threadCount);
+    std::vector<uint32_t> reusedWaves;
+    bool hasWaves = (m_currentDependencyPattern == CM_WAVEFRONT26Z) &&
+                    (m_wavefront26ZDispatchInfo.numThreadsInWave != nullptr);
+    if (hasWaves)
+    {
+        reusedWaves.assign(m_wavefront26ZDispatchInfo.numThreadsInWave,
+                           m_wavefront26ZDispatchInfo.numThreadsInWave + m_wavefront26ZDispatchInfo.numWaves);
+    }
+
+    // The sequence generators skip the work if the pattern type matches
+    m_currentDependencyPattern = CM_NONE_DEPENDENCY;
+    int32_t sortResult = CM_SUCCESS;
+    int32_t hr = GenerateBoardOrder(sortResult);
+    if (hr != CM_SUCCESS || sortResult != CM_SUCCESS)
+    {
+        CM_ASSERTMESSAGE("Error: Failed to regenerate the reused board order.");
+        return CM_FAILURE;
+    }
+
+    if (CmSafeMemCompare(reusedOrder.data(), m_boardOrderList, threadCount * sizeof(uint32_t)) != 0 ||
+        (hasWaves &&
+         (reusedWaves.size() != m_wavefront26ZDispatchInfo.numWaves ||
+          CmSafeMemCompare(reusedWaves.data(), m_wavefront26ZDispatchInfo.numThreadsInWave,
+                           reusedWaves.size() * sizeof(uint32_t)) != 0)))
+    {
+        CM_ASSERTMESSAGE("Error: Reused board order differs from the generated one.");
+        return CM_FAILURE;
+    }
+    return CM_SUCCESS;
+}
+#endif
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Fill in what the board order depends on for the current setting
+//| Returns:    false if the current setting does not need a board order
+//*-----------------------------------------------------------------------------
+bool CmThreadSpaceRT::GetBoardOrderKey(CM_THREAD_SPACE_ORDER_KEY &key)
+{
+    CmSafeMemSet(&key, 0, sizeof(key));
+    key.width = m_width;
+    key.height = m_height;
+
+    if (m_dependencyVectorsSet)
+    {
+        key.dependencyPattern = CM_NONE_DEPENDENCY;
+        key.dependencyVectorsSet = 1;
+        key.dependencyVectors = m_dependencyVectors;
+        return true;
+    }
+
+    switch (m_dependencyPatternType)
+    {
+        case CM_WAVEFRONT:
+        case CM_WAVEFRONT26:
+        case CM_WAVEFRONT26Z:
+        case CM_WAVEFRONT26ZI:
+        case CM_HORIZONTAL_WAVE:
+        case CM_VERTICAL_WAVE:
+            key.dependencyPattern = m_dependencyPatternType;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (m_dependencyPatternType == CM_WAVEFRONT26ZI)
+    {
+        key.dispatchPattern26ZI = m_26ZIDispatchPattern;
+        key.blockWidth26ZI = m_26ZIBlockWidth;
+        key.blockHeight26ZI = m_26ZIBlockHeight;
+    }
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Skip sorting if the board order list already matches the
+//|             current setting, or can be copied from the device-wide cache
+//| Returns:    true if the board order list is up to date
+//*-----------------------------------------------------------------------------
+bool CmThreadSpaceRT::ReuseBoardOrder()
+{
+    CM_THREAD_SPACE_ORDER_KEY key;
+    if (!GetBoardOrderKey(key) || m_boardOrderList == nullptr)
+    {
+        return false;
+    }
+
+    if (m_boardOrderValid && (key == m_boardOrderKey))
+    {
+        return true;
+    }
+    m_boardOrderValid = false;
+
+    CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo =
+        (key.dependencyPattern == CM_WAVEFRONT26Z) ? &m_wavefront26ZDispatchInfo : nullptr;
+    if (m_device->GetThreadSpaceOrderCache()->Lookup(key, m_boardOrderList, dispatchInfo))
+    {
+        m_boardOrderKey = key;
+        m_boardOrderValid = true;
+        m_currentDependencyPattern = key.dependencyPattern;
+        if (key.dependencyPattern == CM_WAVEFRONT26ZI)
+        {
+            m_current26ZIDispatchPattern = key.dispatchPattern26ZI;
+        }
+        m_indexInList = m_width * m_height;
+        return true;
+    }
+
+    // The sequence generators only compare the pattern type, so make sure
+    // they run for the new setting.
+    m_currentDependencyPattern = CM_NONE_DEPENDENCY;
+    return false;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Publish the board order just generated to the device-wide cache
+//*-----------------------------------------------------------------------------
+void CmThreadSpaceRT::CacheBoardOrder()
+{
+    CM_THREAD_SPACE_ORDER_KEY key;
+    if (!GetBoardOrderKey(key) || m_boardOrderList == nullptr)
+    {
+        return;
+    }
+
+    CM_HAL_WAVEFRONT26Z_DISPATCH_INFO *dispatchInfo =
+        (key.dependencyPattern == CM_WAVEFRONT26Z) ? &m_wavefront26ZDispatchInfo : nullptr;
+    m_device->GetThreadSpaceOrderCache()->Insert(key, m_boardOrderList, dispatchInfo);
+
+    m_boardOrderKey = key;
+    m_boardOrderValid = true;
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Get Board Order list
 //*-----------------------------------------------------------------------------
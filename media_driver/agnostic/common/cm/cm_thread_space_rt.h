@@ -28,6 +28,7 @@
 #define MEDIADRIVER_AGNOSTIC_COMMON_CM_CMTHREADSPACERT_H_
 
 #include "cm_thread_space.h"
+#include "cm_thread_space_order_cache.h"
 #include "cm_hal.h"
 #include "cm_log.h"
 
@@ -163,6 +164,16 @@ public:
 
     int32_t WavefrontDependencyVectors();
 
+    int32_t GenerateBoardOrder(int32_t &sortResult);
+
+    bool ReuseBoardOrder();
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    int32_t VerifyBoardOrder();
+#endif
+
+    void CacheBoardOrder();
+
     bool IsThreadAssociated() const;
 
     bool IsDependencySet();
@@ -259,6 +270,12 @@ private:
 
     CM_HAL_WAVEFRONT26Z_DISPATCH_INFO m_wavefront26ZDispatchInfo;
 
+    bool GetBoardOrderKey(CM_THREAD_SPACE_ORDER_KEY &key);
+
+    // Setting the board order list was last generated or loaded for
+    CM_THREAD_SPACE_ORDER_KEY m_boardOrderKey;
+    bool m_boardOrderValid;
+
     //Group select in media pipe, by default no group setting
     CM_MW_GROUP_SELECT m_groupSelect;
 };
@@ -51,6 +51,8 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/cm_task_rt.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_task_internal.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_rt.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_order.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_order_cache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_vebox_rt.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_vebox_data.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_visa.cpp
@@ -115,6 +117,8 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/cm_task_internal.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_rt.h
+    ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_order.h
+    ${CMAKE_CURRENT_LIST_DIR}/cm_thread_space_order_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_vebox.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_vebox_rt.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_vebox_data.h
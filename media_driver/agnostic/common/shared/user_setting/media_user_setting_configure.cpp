@@ -62,6 +62,8 @@ Configure::Configure()
 
 Configure::~Configure()
 {
+    m_staleReadResults.Reclaim([](ReadResult *stale) { MOS_Delete(stale); });
+
     MosUtilities::MosUninitializeReg(m_regBufferMap);
 }
 
@@ -133,11 +135,12 @@ MOS_STATUS Configure::Read(Value &value,
     int32_t     ret     = 0;
     MOS_STATUS  status  = MOS_STATUS_SUCCESS;
     auto        &defs   = GetDefinitions(group);
-    auto        def     = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto        it      = defs.find(MakeHash(valueName));
+    if (it == defs.end() || it->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
+    const std::shared_ptr<Definition> &def = it->second;
     auto        defaultType = def->DefaultValue().ValueType();
 
     if (def->IsDebugOnly() && !m_isDebugMode)
@@ -145,6 +148,37 @@ MOS_STATUS Configure::Read(Value &value,
         value = useCustomValue ? customValue : def->DefaultValue();
         return MOS_STATUS_SUCCESS;
     }
+
+    // Internal items are parsed once, later reads take the published result without locking.
+    // Environment variables are only looked at by that first read, later changes of the
+    // environment are not seen. Only Write withdraws the result.
+    uint64_t generation = 0;
+    if (option == MEDIA_USER_SETTING_INTERNAL)
+    {
+        m_staleReadResults.Enter();
+        const ReadResult *cached = def->GetReadCache().Get();
+        if (cached != nullptr)
+        {
+            MOS_STATUS cachedStatus = cached->status;
+            if (cachedStatus == MOS_STATUS_SUCCESS)
+            {
+                value = cached->value;
+            }
+            else
+            {
+                value = useCustomValue ? customValue : def->DefaultValue();
+            }
+            m_staleReadResults.Leave();
+            return cachedStatus;
+        }
+        m_staleReadResults.Leave();
+
+        m_mutexLock.Lock();
+        generation = def->GetReadCache().GetGeneration();
+        m_staleReadResults.Reclaim([](ReadResult *stale) { MOS_Delete(stale); });
+        m_mutexLock.Unlock();
+    }
+
     //First, Read user setting. If succeed, return;
     {
         std::string path = GetReadPath(def, option);
@@ -172,6 +206,11 @@ MOS_STATUS Configure::Read(Value &value,
         status = MosUtilities::MosReadEnvVariable(def->ItemEnvName(), defaultType, value);
     }
 
+    if (option == MEDIA_USER_SETTING_INTERNAL)
+    {
+        PublishReadResult(def, generation, status, value);
+    }
+
     //If no 
     if (status != MOS_STATUS_SUCCESS && option == MEDIA_USER_SETTING_INTERNAL)
     {
@@ -181,6 +220,35 @@ MOS_STATUS Configure::Read(Value &value,
     return status;
 }
 
+void Configure::PublishReadResult(
+    const std::shared_ptr<Definition> &def,
+    uint64_t generation,
+    MOS_STATUS status,
+    const Value &value)
+{
+    ReadResult *result = MOS_New(ReadResult);
+    if (result == nullptr)
+    {
+        return;
+    }
+    result->status = status;
+    if (status == MOS_STATUS_SUCCESS)
+    {
+        result->value = value;
+    }
+
+    // Dropped if a write withdrew the item since the read started, or a concurrent
+    // reader published first
+    m_mutexLock.Lock();
+    bool published = def->GetReadCache().Publish(result, generation);
+    m_mutexLock.Unlock();
+
+    if (!published)
+    {
+        MOS_Delete(result);
+    }
+}
+
 MOS_STATUS Configure::Write(
     const std::string &valueName,
     const Value &value,
@@ -190,11 +258,12 @@ MOS_STATUS Configure::Write(
 {
     auto &defs = GetDefinitions(group);
 
-    auto def = defs[MakeHash(valueName)];
-    if (def == nullptr)
+    auto it = defs.find(MakeHash(valueName));
+    if (it == defs.end() || it->second == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
     }
+    auto def = it->second;
 
     if (def->IsDebugOnly() && !m_isDebugMode)
     {
@@ -220,6 +289,15 @@ MOS_STATUS Configure::Write(
 
         MosUtilities::MosCloseRegKey(key);
     }
+
+    // Any write of the item withdraws its published result, the next read parses it again.
+    // Readers may still hold the old result, it is freed by the first write or parsing
+    // read that finds no lock free reader inside.
+    if (status == MOS_STATUS_SUCCESS)
+    {
+        m_staleReadResults.Retire(def->GetReadCache().Withdraw());
+        m_staleReadResults.Reclaim([](ReadResult *stale) { MOS_Delete(stale); });
+    }
     m_mutexLock.Unlock();
 
     if (status != MOS_STATUS_SUCCESS)
@@ -25,6 +25,7 @@
 //!
 
 #include "media_user_setting_definition.h"
+#include "mos_utilities.h"
 
 namespace MediaUserSetting {
 namespace Internal {
@@ -57,6 +58,8 @@ Definition::Definition(const Definition& def)
 
 Definition::~Definition()
 {
+    ReadResult *result = m_readCache.Withdraw();
+    MOS_Delete(result);
 }
 
 inline Definition& Definition::operator=(const Definition& def)
@@ -25,6 +25,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/vphal_debug.c
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_common.c
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_composite.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_composite_bb_index.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_ief.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_renderstate.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_sfc_base.cpp
@@ -50,6 +51,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vphal_debug.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_common.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_composite.h
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_composite_bb_index.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_ief.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_renderstate.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_sfc_base.h
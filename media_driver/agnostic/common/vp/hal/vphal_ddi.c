@@ -217,6 +217,10 @@ void VpHal_DdiReportFeatureMode(
     pConfigValues->dwCurrentCompositionMode = pReport->GetFeatures().compositionMode;
     pConfigValues->dwCurrentScdMode         = pReport->GetFeatures().diScdMode;
 
+    // Report composition batch buffer reuse
+    pConfigValues->dwCompBbHits             = pReport->GetFeatures().compBbHits;
+    pConfigValues->dwCompBbMisses           = pReport->GetFeatures().compBbMisses;
+
     VP_DDI_NORMALMESSAGE("VP Feature Report: \
         OutputPipeMode %d, \
         HDRMode %d, \
@@ -2538,6 +2538,8 @@ typedef struct _VPHAL_BATCH_BUFFER
     PVPHAL_BATCH_BUFFER_PARAMS  pBBRenderData;                                  // Batch Buffer rendering data
 } VPHAL_BATCH_BUFFER;
 
+class VphalCompBbIndex;
+
 //!
 //! \brief Unified Batch Buffer Table
 //!
@@ -2547,6 +2549,7 @@ typedef struct _VPHAL_BATCH_BUFFER_TABLE
     int32_t                     iBbCountMax;                                    //!< Maximum count of BB that can be allocated of the render
     PMHW_BATCH_BUFFER           pBatchBufferHeader;                             //!< Pointer to the BB entry of the render
     PVPHAL_BATCH_BUFFER_PARAMS  pBbParamsHeader;                                //!< Pointer to the BB params entry of the render
+    VphalCompBbIndex            *pCompBbIndex;                                  //!< Index of the compositing BB args, nullptr to walk the table
 } VPHAL_BATCH_BUFFER_TABLE, *PVPHAL_BATCH_BUFFER_TABLE;
 
 //!
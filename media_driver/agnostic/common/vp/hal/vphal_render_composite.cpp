@@ -5033,8 +5033,52 @@ finish:
     return bResult;
 }
 
+//!
+//! \brief    Check whether a BB can be reused for the Composition BB arguments
+//! \param    [in] pBbEntry
+//!           Pointer to the BB table entry to be checked
+//! \param    [in] pInputBbParams
+//!           Pointer to the BB params required for the best match
+//! \param    [in] iBbSize
+//!           the BB size required for the best match
+//! \return   bool
+//!           Return true if the BB matches
+//!
+bool CompositeState::IsMatchBB(
+    PMHW_BATCH_BUFFER             pBbEntry,
+    PVPHAL_BATCH_BUFFER_PARAMS    pInputBbParams,
+    int32_t                       iBbSize)
+{
+    PVPHAL_BATCH_BUFFER_PARAMS    pSearchBbParams;   // Search BB parameters
+    PVPHAL_BB_COMP_ARGS           pCompBbArgs;       // 2nd level buffer rendering arguments
+    PVPHAL_BB_COMP_ARGS           pSearchBbArgs;     // Search BB comp parameters
+
+    pCompBbArgs = &pInputBbParams->BbArgs.CompositeBB;
+
+    // Must contain valid Compositing BB Argument set, must have adequate size,
+    // cannot reuse buffers from same call ID
+    pSearchBbParams = (PVPHAL_BATCH_BUFFER_PARAMS)pBbEntry->pPrivateData;
+
+    if (!pSearchBbParams                                              ||
+        pBbEntry->iSize           < iBbSize                           ||
+        pSearchBbParams->iCallID == pInputBbParams->iCallID           ||
+        pSearchBbParams->iType   != VPHAL_BB_TYPE_COMPOSITING         ||
+        pSearchBbParams->iSize   != sizeof(VPHAL_BB_COMP_ARGS))
+    {
+        return false;
+    }
+
+    // Must match Media ID, StepX, full blocks, layers and NLAS parameters
+    pSearchBbArgs = &(pSearchBbParams->BbArgs.CompositeBB);
+
+    return VphalCompBbIndex::IsMatch(*pSearchBbArgs, *pCompBbArgs);
+}
+
 //!
 //! \brief    Search for the best match BB according to the Composition BB arguments
+//! \details  With an index only the entries hashed like the arguments are checked,
+//!           otherwise the whole table is walked. The first match in table order
+//!           is taken either way
 //! \param    [in] pBatchBufferTable
 //!           Pointer to the BB table to be searched
 //! \param    [in] pInputBbParams
@@ -5055,89 +5099,46 @@ MOS_STATUS CompositeState::GetBestMatchBB(
 {
     PMHW_BATCH_BUFFER             pBbEntry;          // 2nd level BBs array entry
     PMHW_BATCH_BUFFER             pBestMatch;        // Best match for BB allocation
-    PVPHAL_BATCH_BUFFER_PARAMS    pSearchBbParams;   // Search BB parameters
-    PVPHAL_BB_COMP_ARGS           pCompBbArgs;       // 2nd level buffer rendering arguments
-    PVPHAL_BB_COMP_ARGS           pSearchBbArgs;     // Search BB comp parameters
+    VphalCompBbIndex              *pBbIndex;         // Index of the BB table
     int32_t                       i;
-    int32_t                       iCallID;
     int32_t                       iBbCount;
     MOS_STATUS                    eStatus;
 
     pBestMatch  = nullptr;
-    pCompBbArgs = &pInputBbParams->BbArgs.CompositeBB;
-    iCallID     = pInputBbParams->iCallID;
+    pBbIndex    = pBatchBufferTable->pCompBbIndex;
     eStatus     = MOS_STATUS_UNKNOWN;
 
     iBbCount = *pBatchBufferTable->piBatchBufferCount;
     pBbEntry = pBatchBufferTable->pBatchBufferHeader;
 
-    for (i = iBbCount; i > 0; i--, pBbEntry++)
+    if (pBbIndex)
     {
-        // Must contain valid Compositing BB Argument set, must have adequate size,
-        // cannot reuse buffers from same call ID
-        pSearchBbParams = (PVPHAL_BATCH_BUFFER_PARAMS)pBbEntry->pPrivateData;
-
-        if (!pSearchBbParams                                      ||
-            pBbEntry->iSize           < iBbSize                   ||
-            pSearchBbParams->iCallID == iCallID                   ||
-            pSearchBbParams->iType   != VPHAL_BB_TYPE_COMPOSITING ||
-            pSearchBbParams->iSize   != sizeof(VPHAL_BB_COMP_ARGS))
-        {
-            continue;
-        }
-
-        // Must match Media ID, StepX, full blocks, different Call ID
-        pSearchBbArgs = &(pSearchBbParams->BbArgs.CompositeBB);
-
-        if (pSearchBbArgs->iMediaID    != pCompBbArgs->iMediaID ||  // != Media ID
-            pSearchBbArgs->fStepX      != pCompBbArgs->fStepX   ||  // != Step X
-            pSearchBbArgs->bSkipBlocks != pCompBbArgs->bSkipBlocks) // != Skip Blocks
+        for (auto index : pBbIndex->Find(pInputBbParams->BbArgs.CompositeBB))
         {
-            continue;
-        }
-
-        // Target rectangle must match
-        if (memcmp(&pSearchBbArgs->rcOutput, &pCompBbArgs->rcOutput, sizeof(RECT)))
-        {
-            continue;
-        }
-
-        // BB must contain same or more layers than input BB
-        if (pSearchBbArgs->iLayers < pCompBbArgs->iLayers)
-        {
-            continue;
-        }
-
-        // Compare each layer, ignore layers that are not present in the input
-        if (memcmp(&pSearchBbArgs->rcDst, &pCompBbArgs->rcDst, pCompBbArgs->iLayers * sizeof(RECT)))
-        {
-            continue;
-        }
-
-        // Compare each layer rotation, ignore layers that are not present in the input
-        if (memcmp(&pSearchBbArgs->Rotation, &pCompBbArgs->Rotation, pCompBbArgs->iLayers * sizeof(VPHAL_ROTATION)))
-        {
-            continue;
-        }
-
-        // for AVS/Bi-Linear Scaling, NLAS enable or not
-        if (pSearchBbArgs->bEnableNLAS != pCompBbArgs->bEnableNLAS)
-        {
-            continue;
+            if (index < iBbCount && IsMatchBB(pBbEntry + index, pInputBbParams, iBbSize))
+            {
+                pBestMatch = pBbEntry + index;
+                break;
+            }
         }
-
-        // NLAS parameters must match when it's enabled
-        if (pCompBbArgs->bEnableNLAS &&
-            memcmp(&pSearchBbArgs->NLASParams, &pCompBbArgs->NLASParams, sizeof(VPHAL_NLAS_PARAMS)))
+        pBbIndex->Record(pBestMatch != nullptr);
+    }
+    else
+    {
+        for (i = iBbCount; i > 0; i--, pBbEntry++)
         {
-            continue;
+            if (IsMatchBB(pBbEntry, pInputBbParams, iBbSize))
+            {
+                pBestMatch = pBbEntry;
+                break;
+            }
         }
+    }
 
-        // Match -> reuse the BB regardless of the running state
-        pBestMatch = pBbEntry;
+    // Match -> reuse the BB regardless of the running state
+    if (pBestMatch)
+    {
         ((PVPHAL_BATCH_BUFFER_PARAMS)pBestMatch->pPrivateData)->bMatch = true;
-
-        break;
     }
 
     *ppBatchBuffer = pBestMatch;
@@ -5203,6 +5204,7 @@ MOS_STATUS CompositeState::AllocateBuffer(
     BatchBufferTable.pBbParamsHeader    = m_BufferParam;
     BatchBufferTable.iBbCountMax        = VPHAL_COMP_BUFFERS_MAX;
     BatchBufferTable.piBatchBufferCount = &m_iBatchBufferCount;
+    BatchBufferTable.pCompBbIndex       = &m_BatchBufferIndex;
 
     VPHAL_RENDER_CHK_STATUS(VpHal_RenderAllocateBB(
                   &BatchBufferTable,
@@ -7893,8 +7895,10 @@ void CompositeState::CopyReporting(VphalFeatureReport* pReporting)
 {
     VPHAL_RENDER_ASSERT(pReporting);
 
-    pReporting->GetFeatures().ief         = m_reporting->GetFeatures().ief;
-    pReporting->GetFeatures().scalingMode = m_reporting->GetFeatures().scalingMode;
+    pReporting->GetFeatures().ief          = m_reporting->GetFeatures().ief;
+    pReporting->GetFeatures().scalingMode  = m_reporting->GetFeatures().scalingMode;
+    pReporting->GetFeatures().compBbHits   = m_BatchBufferIndex.GetHits();
+    pReporting->GetFeatures().compBbMisses = m_BatchBufferIndex.GetMisses();
 
     if (m_reporting->GetFeatures().deinterlaceMode != VPHAL_DI_REPORT_PROGRESSIVE)
     {
@@ -30,6 +30,7 @@
 #include "vphal.h"
 #include "vphal_render_renderstate.h"
 #include "vphal_render_common.h"
+#include "vphal_render_composite_bb_index.h"
 #include "mhw_render_legacy.h"
 
 //!
@@ -389,6 +390,22 @@ public:
         int32_t                       iBbSize,
         PMHW_BATCH_BUFFER             *ppBatchBuffer);
 
+    //!
+    //! \brief    Check whether a BB can be reused for the Composition BB arguments
+    //! \param    [in] pBbEntry
+    //!           Pointer to the BB table entry to be checked
+    //! \param    [in] pInputBbParams
+    //!           Pointer to the BB params required for the best match
+    //! \param    [in] iBbSize
+    //!           the BB size required for the best match
+    //! \return   bool
+    //!           Return true if the BB matches
+    //!
+    static bool IsMatchBB(
+        PMHW_BATCH_BUFFER             pBbEntry,
+        PVPHAL_BATCH_BUFFER_PARAMS    pInputBbParams,
+        int32_t                       iBbSize);
+
     //!
     //! \brief    Load Palette Data
     //! \details  Load Palette Data according to color space and CSC matrix.
@@ -1141,6 +1158,7 @@ private:
     int32_t                         m_iBatchBufferCount;
     MHW_BATCH_BUFFER                m_BatchBuffer[VPHAL_COMP_BUFFERS_MAX];
     VPHAL_BATCH_BUFFER_PARAMS       m_BufferParam[VPHAL_COMP_BUFFERS_MAX];
+    VphalCompBbIndex                m_BatchBufferIndex;
 
     // Multiple phase support
     int32_t                         m_iCallID;
@@ -0,0 +1,197 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vphal_render_composite_bb_index.cpp
+//! \brief    Implements the index of the compositing batch buffers
+//!
+#include <algorithm>
+#include <cstring>
+#include "vphal_render_composite_bb_index.h"
+
+#define VPHAL_COMP_BB_HASH_OFFSET   0xcbf29ce484222325ULL
+#define VPHAL_COMP_BB_HASH_PRIME    0x100000001b3ULL
+
+static uint64_t VpHal_CompBbHash(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * VPHAL_COMP_BB_HASH_PRIME;
+    }
+    return hash;
+}
+
+int32_t VphalCompBbIndex::GetLayers(const VPHAL_BB_COMP_ARGS &args)
+{
+    return MOS_CLAMP_MIN_MAX(args.iLayers, 0, VPHAL_COMP_MAX_LAYERS);
+}
+
+uint64_t VphalCompBbIndex::HashCommon(const VPHAL_BB_COMP_ARGS &args)
+{
+    uint64_t hash  = VPHAL_COMP_BB_HASH_OFFSET;
+    float    stepX = (args.fStepX == 0.0f) ? 0.0f : args.fStepX;  // 0.0 and -0.0 compare equal
+    uint8_t  flags = (args.bSkipBlocks ? 1 : 0) | (args.bEnableNLAS ? 2 : 0);
+
+    hash = VpHal_CompBbHash(hash, &args.iMediaID, sizeof(args.iMediaID));
+    hash = VpHal_CompBbHash(hash, &stepX, sizeof(stepX));
+    hash = VpHal_CompBbHash(hash, &flags, sizeof(flags));
+    hash = VpHal_CompBbHash(hash, &args.rcOutput, sizeof(args.rcOutput));
+    if (args.bEnableNLAS)
+    {
+        hash = VpHal_CompBbHash(hash, &args.NLASParams, sizeof(args.NLASParams));
+    }
+    return hash;
+}
+
+uint64_t VphalCompBbIndex::HashLayer(uint64_t hash, const VPHAL_BB_COMP_ARGS &args, int32_t layer)
+{
+    hash = VpHal_CompBbHash(hash, &args.rcDst[layer], sizeof(args.rcDst[layer]));
+    hash = VpHal_CompBbHash(hash, &args.Rotation[layer], sizeof(args.Rotation[layer]));
+    return hash;
+}
+
+uint64_t VphalCompBbIndex::HashLayers(uint64_t hash, int32_t layers)
+{
+    return VpHal_CompBbHash(hash, &layers, sizeof(layers));
+}
+
+bool VphalCompBbIndex::IsMatch(const VPHAL_BB_COMP_ARGS &searchArgs, const VPHAL_BB_COMP_ARGS &inputArgs)
+{
+    if (searchArgs.iMediaID    != inputArgs.iMediaID ||  // != Media ID
+        searchArgs.fStepX      != inputArgs.fStepX   ||  // != Step X
+        searchArgs.bSkipBlocks != inputArgs.bSkipBlocks) // != Skip Blocks
+    {
+        return false;
+    }
+
+    // Target rectangle must match
+    if (memcmp(&searchArgs.rcOutput, &inputArgs.rcOutput, sizeof(RECT)))
+    {
+        return false;
+    }
+
+    // BB must contain same or more layers than input BB
+    if (searchArgs.iLayers < inputArgs.iLayers)
+    {
+        return false;
+    }
+
+    // Compare each layer, ignore layers that are not present in the input
+    if (memcmp(&searchArgs.rcDst, &inputArgs.rcDst, inputArgs.iLayers * sizeof(RECT)))
+    {
+        return false;
+    }
+
+    // Compare each layer rotation, ignore layers that are not present in the input
+    if (memcmp(&searchArgs.Rotation, &inputArgs.Rotation, inputArgs.iLayers * sizeof(VPHAL_ROTATION)))
+    {
+        return false;
+    }
+
+    // for AVS/Bi-Linear Scaling, NLAS enable or not
+    if (searchArgs.bEnableNLAS != inputArgs.bEnableNLAS)
+    {
+        return false;
+    }
+
+    // NLAS parameters must match when it's enabled
+    if (inputArgs.bEnableNLAS &&
+        memcmp(&searchArgs.NLASParams, &inputArgs.NLASParams, sizeof(VPHAL_NLAS_PARAMS)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void VphalCompBbIndex::Update(int32_t index, const VPHAL_BB_COMP_ARGS &args)
+{
+    if (index < 0)
+    {
+        return;
+    }
+    if (index >= (int32_t)m_entryKeys.size())
+    {
+        m_entryKeys.resize(index + 1);
+    }
+
+    Remove(index);
+
+    // The batch buffer serves any number of layers up to its own
+    std::vector<uint64_t> &keys   = m_entryKeys[index];
+    int32_t                layers = GetLayers(args);
+    uint64_t               hash   = HashCommon(args);
+    for (int32_t i = 0; i <= layers; i++)
+    {
+        keys.push_back(HashLayers(hash, i));
+        m_index.insert(std::make_pair(keys.back(), index));
+        if (i < layers)
+        {
+            hash = HashLayer(hash, args, i);
+        }
+    }
+}
+
+const std::vector<int32_t> &VphalCompBbIndex::Find(const VPHAL_BB_COMP_ARGS &args)
+{
+    int32_t  layers = GetLayers(args);
+    uint64_t hash   = HashCommon(args);
+    for (int32_t i = 0; i < layers; i++)
+    {
+        hash = HashLayer(hash, args, i);
+    }
+
+    m_candidates.clear();
+    auto range = m_index.equal_range(HashLayers(hash, layers));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        m_candidates.push_back(it->second);
+    }
+
+    // The table walk takes the first match
+    std::sort(m_candidates.begin(), m_candidates.end());
+    return m_candidates;
+}
+
+void VphalCompBbIndex::Remove(int32_t index)
+{
+    for (auto key : m_entryKeys[index])
+    {
+        auto range = m_index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == index)
+            {
+                m_index.erase(it);
+                break;
+            }
+        }
+    }
+    m_entryKeys[index].clear();
+}
+
+void VphalCompBbIndex::Clear()
+{
+    m_index.clear();
+    m_entryKeys.clear();
+    m_candidates.clear();
+}
@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vphal_render_composite_bb_index.h
+//! \brief    Index of the compositing batch buffers by their rendering arguments
+//!
+#ifndef __VPHAL_RENDER_COMPOSITE_BB_INDEX_H__
+#define __VPHAL_RENDER_COMPOSITE_BB_INDEX_H__
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "vphal_render_common.h"
+#include "media_class_trace.h"
+
+//!
+//! \class    VphalCompBbIndex
+//!
+//! \brief    Finds the compositing batch buffers which may be reused for a set
+//!           of rendering arguments without walking the batch buffer table.
+//!
+//! \detail   A batch buffer rendered with more layers can be reused for fewer
+//!           layers when the layers present match, so each entry is indexed
+//!           once per number of layers it could serve. Entries sharing a hash
+//!           are only candidates, the caller still compares the arguments.
+//!
+class VphalCompBbIndex
+{
+public:
+    VphalCompBbIndex() = default;
+
+    ~VphalCompBbIndex() = default;
+
+    //!
+    //! \brief  Index the batch buffer at the table entry with its new rendering arguments
+    //!
+    void Update(int32_t index, const VPHAL_BB_COMP_ARGS &args);
+
+    //!
+    //! \brief  Get the table entries which may match the rendering arguments
+    //!
+    //! \return const std::vector<int32_t> &
+    //!         Entry indices in table order, valid until the next call
+    //!
+    const std::vector<int32_t> &Find(const VPHAL_BB_COMP_ARGS &args);
+
+    //!
+    //! \brief  Count a search of the table, hit if a batch buffer was reused
+    //!
+    void Record(bool hit)
+    {
+        hit ? m_hits++ : m_misses++;
+    }
+
+    //!
+    //! \brief  Check whether a batch buffer rendered with the search arguments
+    //!         can be reused for the input arguments
+    //!
+    //! \return bool
+    //!         true if the batch buffer matches, the search arguments may have
+    //!         more layers than the input ones
+    //!
+    static bool IsMatch(const VPHAL_BB_COMP_ARGS &searchArgs, const VPHAL_BB_COMP_ARGS &inputArgs);
+
+    uint32_t GetHits() const { return m_hits; }
+    uint32_t GetMisses() const { return m_misses; }
+
+    void Clear();
+
+protected:
+    static uint64_t HashCommon(const VPHAL_BB_COMP_ARGS &args);
+    static uint64_t HashLayer(uint64_t hash, const VPHAL_BB_COMP_ARGS &args, int32_t layer);
+    static uint64_t HashLayers(uint64_t hash, int32_t layers);
+    static int32_t  GetLayers(const VPHAL_BB_COMP_ARGS &args);
+
+    void Remove(int32_t index);
+
+    std::unordered_multimap<uint64_t, int32_t> m_index;       //!< table entries by argument hash
+    std::vector<std::vector<uint64_t>>         m_entryKeys;   //!< hashes each table entry is indexed by
+    std::vector<int32_t>                       m_candidates;  //!< result of the last search
+    uint32_t                                   m_hits   = 0;  //!< searches reusing a batch buffer
+    uint32_t                                   m_misses = 0;  //!< searches ending with a new batch buffer
+
+MEDIA_CLASS_DEFINE_END(VphalCompBbIndex)
+};
+
+#endif  // __VPHAL_RENDER_COMPOSITE_BB_INDEX_H__
@@ -2049,6 +2049,14 @@ MOS_STATUS VpHal_RenderAllocateBB(
     pBbParams->iSize    = iBbArgSize;
     pBbParams->BbArgs   = pInputBbParams->BbArgs;
 
+    // Keep the compositing BB args searchable
+    if (BbType == VPHAL_BB_TYPE_COMPOSITING && pBatchBufferTable->pCompBbIndex)
+    {
+        pBatchBufferTable->pCompBbIndex->Update(
+            (int32_t)(pBatchBuffer - pBatchBufferTable->pBatchBufferHeader),
+            pInputBbParams->BbArgs.CompositeBB);
+    }
+
     eStatus = MOS_STATUS_SUCCESS;
 
 finish:
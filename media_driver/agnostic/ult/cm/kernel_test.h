@@ -20,6 +20,10 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
 #include <vector>
 #include "cm_test.h"
 
@@ -315,7 +319,346 @@ public:
         return return_value;
     }
 
+    //*-------------------------------------------------------------------------
+    //| Enqueues a DoNothing task from several threads into one queue, waits
+    //| for every task and checks that no task or kernel data leaks. Returns
+    //| the number of tasks enqueued per second in tasks_per_second if given.
+    //*-------------------------------------------------------------------------
+    int32_t MultiThreadEnqueue(uint32_t thread_count, uint32_t tasks_per_thread,
+                               double *tasks_per_second = nullptr)
+    {
+        CMRT_UMD::CmQueue *queue = nullptr;
+        int32_t result = m_mockDevice->CreateQueue(queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        // The first enqueue allocates state kept by the device, so warm up
+        // before taking the memory baseline.
+        result = EnqueueFromThreads(queue, 1, 1);
+        EXPECT_EQ(CM_SUCCESS, result);
+        const DriverSymbols &symbols = m_driverLoader.GetDriverSymbols();
+        int32_t mem_count = symbols.MOS_GetMemNinjaCounter();
+        int32_t gfx_mem_count = symbols.MOS_GetMemNinjaCounterGfx();
+
+        auto start = std::chrono::steady_clock::now();
+        result = EnqueueFromThreads(queue, thread_count, tasks_per_thread);
+        auto elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (tasks_per_second != nullptr)
+        {
+            *tasks_per_second = elapsed > 0 ?
+                thread_count*tasks_per_thread/elapsed : 0;
+        }
+
+        // Every task and the kernel data it held must be gone by now.
+        EXPECT_EQ(mem_count, symbols.MOS_GetMemNinjaCounter());
+        EXPECT_EQ(gfx_mem_count, symbols.MOS_GetMemNinjaCounterGfx());
+        return result;
+    }//===============
+
+    //*-------------------------------------------------------------------------
+    //| Enqueues a kernel with arg_count int arguments, changing one argument
+    //| before each enqueue, then as many enqueues that force a full rebuild
+    //| of the kernel data. Returns the CPU time per Enqueue() of both in
+    //| us_per_enqueue if given. Debug and release-internal drivers check each
+    //| patched kernel data against a rebuilt one and fail the enqueue if
+    //| their CURBE arguments differ.
+    //*-------------------------------------------------------------------------
+    int32_t PatchKernelArg(uint32_t arg_count, uint32_t enqueue_count,
+                           double (*us_per_enqueue)[2] = nullptr)
+    {
+        ResetDefaultIsaArray();
+        SetDefaultIsaArrayBinaries();
+        SetDefaultIsaArraySizes();
+        IsaData *isa_data = FindIsaData(&m_isaArray);
+        std::vector<uint8_t> isa = AddKernelArgs(isa_data->binary,
+                                                 isa_data->size,
+                                                 arg_count);
+        int32_t result = m_mockDevice->LoadProgram(
+            isa.data(), static_cast<uint32_t>(isa.size()), m_program, "nojitter");
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = m_mockDevice->CreateKernel(m_program, "DoNothing", m_kernel,
+                                            nullptr);
+        EXPECT_EQ(CM_SUCCESS, result);
+        if (result != CM_SUCCESS)
+        {
+            DestroyKernel();
+            return result;
+        }
+        result = m_kernel->SetThreadCount(1);
+        EXPECT_EQ(CM_SUCCESS, result);
+        for (uint32_t i = 0; i < arg_count; ++i)
+        {
+            int value = static_cast<int>(i);
+            result = m_kernel->SetKernelArg(i, sizeof(value), &value);
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+
+        CMRT_UMD::CmQueue *queue = nullptr;
+        result = m_mockDevice->CreateQueue(queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+        CMRT_UMD::CmTask *task = nullptr;
+        result = m_mockDevice->CreateTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = task->AddKernel(m_kernel);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        const uint32_t changed_arg = arg_count/2;
+        int32_t enqueue_result = CM_SUCCESS;
+        double seconds[2] = {0, 0};
+        for (int rebuild = 0; rebuild < 2; ++rebuild)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0; n < enqueue_count; ++n)
+            {
+                if (rebuild)
+                {
+                    // A thread count change cannot be patched
+                    m_kernel->SetThreadCount(n%2 + 1);
+                }
+                int value = static_cast<int>(n + arg_count);
+                m_kernel->SetKernelArg(changed_arg, sizeof(value), &value);
+                CMRT_UMD::CmEvent *event = CM_NO_EVENT;
+                int32_t ret = queue->Enqueue(task, event);
+                if (ret != CM_SUCCESS)
+                {
+                    enqueue_result = ret;
+                }
+            }
+            seconds[rebuild] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        if (us_per_enqueue != nullptr)
+        {
+            (*us_per_enqueue)[0] = seconds[0]*1e6/enqueue_count;
+            (*us_per_enqueue)[1] = seconds[1]*1e6/enqueue_count;
+        }
+
+        result = m_mockDevice->DestroyTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        DestroyKernel();
+        return enqueue_result;
+    }//===============
+
+    //*-------------------------------------------------------------------------
+    //| Enqueues a DoNothing kernel over two thread spaces of the same size set
+    //| up by Configure, then once more over the second one. The first enqueue
+    //| sorts its thread space, the second one is served by the device-wide
+    //| board order cache and the third reuses the thread space's own order.
+    //| Debug and release-internal drivers regenerate every reused board order
+    //| and fail the enqueue if it differs.
+    //*-------------------------------------------------------------------------
+    template<class Function>
+    int32_t EnqueueThreadSpaces(uint32_t width,
+                                uint32_t height,
+                                bool associate_threads,
+                                Function Configure)
+    {
+        int32_t result = CreateKernelFromDefaultIsa("DoNothing");
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = m_kernel->SetThreadCount(width*height);
+        EXPECT_EQ(CM_SUCCESS, result);
+        CMRT_UMD::CmTask *task = nullptr;
+        result = m_mockDevice->CreateTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = task->AddKernel(m_kernel);
+        EXPECT_EQ(CM_SUCCESS, result);
+        CMRT_UMD::CmQueue *queue = nullptr;
+        result = m_mockDevice->CreateQueue(queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        CMRT_UMD::CmThreadSpace *thread_spaces[2] = {nullptr, nullptr};
+        for (CMRT_UMD::CmThreadSpace *&thread_space : thread_spaces)
+        {
+            result = m_mockDevice->CreateThreadSpace(width, height,
+                                                     thread_space);
+            EXPECT_EQ(CM_SUCCESS, result);
+            for (uint32_t y = 0; associate_threads && y < height; ++y)
+            {
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    result = thread_space->AssociateThread(x, y, m_kernel,
+                                                           y*width + x);
+                    EXPECT_EQ(CM_SUCCESS, result);
+                }
+            }
+            result = Configure(thread_space);
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+
+        int32_t enqueue_result = CM_SUCCESS;
+        CMRT_UMD::CmThreadSpace *enqueue_order[]
+            = {thread_spaces[0], thread_spaces[1], thread_spaces[1]};
+        for (CMRT_UMD::CmThreadSpace *thread_space : enqueue_order)
+        {
+            CMRT_UMD::CmEvent *event = nullptr;
+            int32_t ret = queue->Enqueue(task, event, thread_space);
+            if (ret != CM_SUCCESS)
+            {
+                enqueue_result = ret;
+            }
+            if (event != nullptr)
+            {
+                EXPECT_EQ(CM_SUCCESS, event->WaitForTaskFinished());
+                EXPECT_EQ(CM_SUCCESS, queue->DestroyEvent(event));
+            }
+        }
+
+        for (CMRT_UMD::CmThreadSpace *&thread_space : thread_spaces)
+        {
+            result = m_mockDevice->DestroyThreadSpace(thread_space);
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+        result = m_mockDevice->DestroyTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        DestroyKernel();
+        return enqueue_result;
+    }//===============
+
 protected:
+    //*-------------------------------------------------------------------------
+    //| Returns a copy of a single-kernel CISA 3.6 binary whose kernel takes
+    //| arg_count int arguments. Arguments are appended after the last one of
+    //| the kernel, which must be an int; offsets behind them are moved.
+    //*-------------------------------------------------------------------------
+    static std::vector<uint8_t> AddKernelArgs(const uint8_t *isa,
+                                              size_t size,
+                                              uint32_t arg_count)
+    {
+        const size_t input_size = 9;  // kind, id, offset and size
+        std::vector<uint8_t> binary(isa, isa + size);
+        auto read32 = [&binary](size_t pos) {
+            uint32_t value = 0;
+            memcpy(&value, &binary[pos], sizeof(value));
+            return value;
+        };
+        auto write32 = [&binary](size_t pos, uint32_t value) {
+            memcpy(&binary[pos], &value, sizeof(value));
+        };
+        auto read16 = [&binary](size_t pos) {
+            uint16_t value = 0;
+            memcpy(&value, &binary[pos], sizeof(value));
+            return value;
+        };
+
+        // Kernel header: name, offset, size, input offset, relocation
+        // symbols and the gen binaries.
+        size_t pos = 8;
+        pos += 1 + binary[pos];
+        size_t kernel_size_pos = pos + 4;
+        uint32_t input_offset = read32(pos + 8);
+        pos += 12;
+        pos += 2 + 4*read16(pos);
+        pos += 2 + 4*read16(pos);
+        uint8_t gen_binary_count = binary[pos++];
+
+        uint32_t input_count = read32(input_offset);
+        if (input_count == 0 || arg_count <= input_count)
+        {
+            return binary;
+        }
+        uint32_t added = arg_count - input_count;
+        uint32_t delta = added*input_size;
+
+        size_t last_input = input_offset + 4 + (input_count - 1)*input_size;
+        uint32_t last_id = read32(last_input + 1);
+        uint16_t last_offset = read16(last_input + 5);
+        std::vector<uint8_t> inputs(delta);
+        for (uint32_t i = 0; i < added; ++i)
+        {
+            uint8_t *input = &inputs[i*input_size];
+            uint32_t id = last_id + i + 1;
+            uint16_t offset = static_cast<uint16_t>(last_offset + (i + 1)*sizeof(int));
+            uint16_t unit_size = sizeof(int);
+            input[0] = 0;  // general
+            memcpy(input + 1, &id, sizeof(id));
+            memcpy(input + 5, &offset, sizeof(offset));
+            memcpy(input + 7, &unit_size, sizeof(unit_size));
+        }
+        binary.insert(binary.begin() + last_input + input_size,
+                      inputs.begin(), inputs.end());
+
+        write32(input_offset, arg_count);
+        write32(kernel_size_pos, read32(kernel_size_pos) + delta);
+        size_t entry_pos = input_offset + 4 + arg_count*input_size + 4;
+        write32(entry_pos, read32(entry_pos) + delta);
+        for (uint8_t i = 0; i < gen_binary_count; ++i)
+        {
+            size_t offset_pos = pos + i*9 + 1;  // platform, offset, size
+            write32(offset_pos, read32(offset_pos) + delta);
+        }
+        return binary;
+    }
+
+    //*-------------------------------------------------------------------------
+    //| Enqueues tasks_per_thread tasks from each of thread_count threads with
+    //| visible events, then waits for and destroys all the events.
+    //*-------------------------------------------------------------------------
+    int32_t EnqueueFromThreads(CMRT_UMD::CmQueue *queue,
+                               uint32_t thread_count,
+                               uint32_t tasks_per_thread)
+    {
+        int32_t result = CreateKernelFromDefaultIsa("DoNothing");
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = m_kernel->SetThreadCount(1);
+        EXPECT_EQ(CM_SUCCESS, result);
+        CMRT_UMD::CmTask *task = nullptr;
+        result = m_mockDevice->CreateTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        result = task->AddKernel(m_kernel);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        std::atomic<int32_t> enqueue_result(CM_SUCCESS);
+        std::vector<std::vector<CMRT_UMD::CmEvent*>> events(thread_count);
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                for (uint32_t j = 0; j < tasks_per_thread; ++j)
+                {
+                    CMRT_UMD::CmEvent *event = nullptr;
+                    int32_t ret = queue->Enqueue(task, event);
+                    if (ret != CM_SUCCESS)
+                    {
+                        enqueue_result = ret;
+                    }
+                    if (event != nullptr)
+                    {
+                        events[i].push_back(event);
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        // A task failing to flush on another thread's behalf shows up here
+        // as an event that cannot finish.
+        uint32_t finished_count = 0;
+        for (std::vector<CMRT_UMD::CmEvent*> &thread_events : events)
+        {
+            for (CMRT_UMD::CmEvent *event : thread_events)
+            {
+                EXPECT_EQ(CM_SUCCESS, event->WaitForTaskFinished());
+                CM_STATUS status = CM_STATUS_QUEUED;
+                EXPECT_EQ(CM_SUCCESS, event->GetStatus(status));
+                EXPECT_EQ(CM_STATUS_FINISHED, status);
+                if (status == CM_STATUS_FINISHED)
+                {
+                    ++finished_count;
+                }
+                EXPECT_EQ(CM_SUCCESS, queue->DestroyEvent(event));
+            }
+        }
+        EXPECT_EQ(thread_count*tasks_per_thread, finished_count);
+
+        result = m_mockDevice->DestroyTask(task);
+        EXPECT_EQ(CM_SUCCESS, result);
+        DestroyKernel();
+        return enqueue_result;
+    }//===============
+
     //*-------------------------------------------------------------------------
     //| Creates CmSampler.
     //*-------------------------------------------------------------------------
@@ -572,3 +915,138 @@ TEST_F(KernelTest, SetSamplerBTI)
                              2, 5, CreateSampler8x8); });
     return;
 }
+
+TEST_F(KernelTest, PatchKernelArg)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return PatchKernelArg(16, 256); });
+    return;
+}//========
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(KernelTest, DISABLED_PatchKernelArgTime)
+{
+    RunEach<int32_t>(CM_SUCCESS, [this]() {
+        double us_per_enqueue[2] = {0, 0};
+        int32_t result = PatchKernelArg(16, 256, &us_per_enqueue);
+        printf("[ INFO     ] 16 args, one changed: %.2f us/Enqueue patched, "
+               "%.2f us/Enqueue rebuilt\n", us_per_enqueue[0],
+               us_per_enqueue[1]);
+        return result; });
+    return;
+}//========
+
+TEST_F(KernelTest, MultiThreadEnqueue)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return MultiThreadEnqueue(1, 256); });
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return MultiThreadEnqueue(8, 256); });
+    return;
+}//========
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(KernelTest, DISABLED_MultiThreadEnqueueRate)
+{
+    for (uint32_t thread_count : {1u, 8u})
+    {
+        RunEach<int32_t>(CM_SUCCESS, [this, thread_count]() {
+            double tasks_per_second = 0;
+            int32_t result = MultiThreadEnqueue(thread_count, 256,
+                                                &tasks_per_second);
+            printf("[ INFO     ] %u threads x 256 tasks: %.0f tasks/s\n",
+                   thread_count, tasks_per_second);
+            return result; });
+    }
+    return;
+}//========
+
+TEST_F(KernelTest, ThreadSpaceOrderCache)
+{
+    const uint32_t sizes[][2] = {{2, 2}, {16, 8}, {30, 20}, {64, 32}};
+    const CM_DEPENDENCY_PATTERN patterns[]
+        = {CM_NONE_DEPENDENCY, CM_WAVEFRONT, CM_WAVEFRONT26, CM_VERTICAL_WAVE,
+           CM_HORIZONTAL_WAVE, CM_WAVEFRONT26Z, CM_WAVEFRONT26X,
+           CM_WAVEFRONT26ZIG};
+    const CM_26ZI_DISPATCH_PATTERN dispatch_patterns[]
+        = {VVERTICAL_HVERTICAL_26, VVERTICAL_HHORIZONTAL_26,
+           VVERTICAL26_HHORIZONTAL26, VVERTICAL1X26_HHORIZONTAL1X26};
+    CM_DEPENDENCY dependency_vectors = {};
+    dependency_vectors.count = 3;
+    dependency_vectors.deltaX[0] = -1;
+    dependency_vectors.deltaY[0] = 0;
+    dependency_vectors.deltaX[1] = -1;
+    dependency_vectors.deltaY[1] = -1;
+    dependency_vectors.deltaX[2] = 1;
+    dependency_vectors.deltaY[2] = -1;
+
+    for (const uint32_t *size : sizes)
+    {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        for (CM_DEPENDENCY_PATTERN pattern : patterns)
+        {
+            RunEach<int32_t>(
+                CM_SUCCESS,
+                [this, width, height, pattern]() {
+                    return EnqueueThreadSpaces(
+                        width, height, true,
+                        [pattern](CMRT_UMD::CmThreadSpace *thread_space) {
+                            return thread_space->SelectThreadDependencyPattern(
+                                pattern); }); });
+        }
+
+        // 26ZI macro blocks are 16x8 by default
+        for (CM_26ZI_DISPATCH_PATTERN dispatch_pattern : dispatch_patterns)
+        {
+            if (width%16 != 0 || height%8 != 0)
+            {
+                break;
+            }
+            RunEach<int32_t>(
+                CM_SUCCESS,
+                [this, width, height, dispatch_pattern]() {
+                    return EnqueueThreadSpaces(
+                        width, height, true,
+                        [dispatch_pattern](
+                            CMRT_UMD::CmThreadSpace *thread_space) {
+                            int32_t result = thread_space
+                                ->SelectThreadDependencyPattern(
+                                    CM_WAVEFRONT26ZI);
+                            if (result != CM_SUCCESS)
+                            {
+                                return result;
+                            }
+                            return thread_space->Set26ZIDispatchPattern(
+                                dispatch_pattern); }); });
+        }
+
+        RunEach<int32_t>(
+            CM_SUCCESS,
+            [this, width, height, &dependency_vectors]() {
+                return EnqueueThreadSpaces(
+                    width, height, true,
+                    [&dependency_vectors](
+                        CMRT_UMD::CmThreadSpace *thread_space) {
+                        return thread_space->SelectThreadDependencyVectors(
+                            dependency_vectors); }); });
+
+        // Media walker thread spaces are never sorted, whatever the walking
+        // pattern.
+        for (int walking_pattern = CM_WALK_DEFAULT;
+             walking_pattern <= CM_WALK_WAVEFRONT26XD; ++walking_pattern)
+        {
+            CM_WALKING_PATTERN pattern
+                = static_cast<CM_WALKING_PATTERN>(walking_pattern);
+            RunEach<int32_t>(
+                CM_SUCCESS,
+                [this, width, height, pattern]() {
+                    return EnqueueThreadSpaces(
+                        width, height, false,
+                        [pattern](CMRT_UMD::CmThreadSpace *thread_space) {
+                            return thread_space->SelectMediaWalkingPattern(
+                                pattern); }); });
+        }
+    }
+    return;
+}//========
@@ -20,7 +20,9 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
 #include "cm_test.h"
+#include "cm_thread_space_order.h"
 
 class ThreadSpaceTest: public CmTest
 {
@@ -109,3 +111,96 @@ TEST_F(ThreadSpaceTest, MediaWalkingPattern)
         [this]() { return SelectMediaWalkingPattern(CM_WALK_DEFAULT); });
     return;
 }//========
+
+//*-----------------------------------------------------------------------------
+//| Board order of the visited-flag walkers replaced by the closed-form
+//| generators: scans the board row by row, or column by column, and from each
+//| thread not visited yet follows (step_x, step_y) until it leaves the board.
+//*-----------------------------------------------------------------------------
+static std::vector<uint32_t> WalkBoardOrder(uint32_t width,
+                                            uint32_t height,
+                                            bool column_major,
+                                            int32_t step_x,
+                                            int32_t step_y)
+{
+    std::vector<bool> visited(width*height, false);
+    std::vector<uint32_t> order;
+    uint32_t outer_count = column_major ? width : height;
+    uint32_t inner_count = column_major ? height : width;
+    for (uint32_t outer = 0; outer < outer_count; ++outer)
+    {
+        for (uint32_t inner = 0; inner < inner_count; ++inner)
+        {
+            int32_t x = static_cast<int32_t>(column_major ? outer : inner);
+            int32_t y = static_cast<int32_t>(column_major ? inner : outer);
+            while (x >= 0 && y >= 0 && x < static_cast<int32_t>(width)
+                   && y < static_cast<int32_t>(height))
+            {
+                uint32_t linear_offset = y*width + x;
+                if (!visited[linear_offset])
+                {
+                    order.push_back(linear_offset);
+                    visited[linear_offset] = true;
+                }
+                x += step_x;
+                y += step_y;
+            }
+        }
+    }
+    return order;
+}//==============
+
+//*-----------------------------------------------------------------------------
+//| Compares a closed-form generator against the visited-flag walker.
+//*-----------------------------------------------------------------------------
+template<class Generator>
+static bool SameBoardOrder(Generator Generate,
+                           uint32_t width,
+                           uint32_t height,
+                           bool column_major,
+                           int32_t step_x,
+                           int32_t step_y)
+{
+    std::vector<uint32_t> expected
+        = WalkBoardOrder(width, height, column_major, step_x, step_y);
+    // One guard entry behind the board catches writes past its end.
+    std::vector<uint32_t> generated(width*height + 1, 0xffffffff);
+    Generate(width, height, generated.data());
+    EXPECT_EQ(0xffffffff, generated.back());
+    generated.pop_back();
+    EXPECT_EQ(expected, generated) << width << "x" << height;
+    return expected == generated;
+}//==========================
+
+TEST(ThreadSpaceOrderTest, MatchesVisitedFlagWalkers)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> sizes;
+    for (uint32_t height = 1; height <= 40; ++height)
+    {
+        for (uint32_t width = 1; width <= 40; ++width)
+        {
+            sizes.push_back(std::make_pair(width, height));
+        }
+    }
+    sizes.push_back(std::make_pair(1u, 511u));
+    sizes.push_back(std::make_pair(511u, 1u));
+    sizes.push_back(std::make_pair(120u, 68u));
+    sizes.push_back(std::make_pair(68u, 120u));
+    sizes.push_back(std::make_pair(240u, 135u));
+    sizes.push_back(std::make_pair(511u, 511u));
+
+    for (const std::pair<uint32_t, uint32_t> &size : sizes)
+    {
+        uint32_t width = size.first;
+        uint32_t height = size.second;
+        ASSERT_TRUE(SameBoardOrder(CMRT_UMD::CmWavefront45Order, width, height,
+                                   false, -1, 1));
+        ASSERT_TRUE(SameBoardOrder(CMRT_UMD::CmWavefront26Order, width, height,
+                                   false, -2, 1));
+        ASSERT_TRUE(SameBoardOrder(CMRT_UMD::CmVerticalOrder, width, height,
+                                   true, 0, 1));
+        ASSERT_TRUE(SameBoardOrder(CMRT_UMD::CmHorizontalOrder, width, height,
+                                   false, 1, 0));
+    }
+    return;
+}//========
@@ -89,6 +89,13 @@ CM_RT_API int32_t CmEventRT::WaitForTaskFinished(uint32_t timeOutMs)
         m_queue->FlushTaskWithoutSync();  //Flush none if 1st task NOT finished yet
     }
 
+    if ( m_status == CM_STATUS_RESET && m_taskDriverId == -1 )
+    {
+        // the task failed to flush and never reached the driver
+        result = CM_FAILURE;
+        goto finish;
+    }
+
     CM_ASSERT(m_osData != nullptr);
 
     //Wait bo finished
@@ -937,6 +937,12 @@ VAStatus DdiMediaDecode::EndPicture(
 
     m_ddiDecodeCtx->DecodeParams.m_executeCallIndex++;
 
+    // User memory which could not be pinned gets the output on the next sync
+    DDI_MEDIA_SURFACE *curRT = (&(m_ddiDecodeCtx->RTtbl))->pCurrentRT;
+    if (curRT && curRT->bUserPtrCopy)
+    {
+        curRT->bUserPtrGpuWritten = true;
+    }
     (&(m_ddiDecodeCtx->RTtbl))->pCurrentRT = nullptr;
 
     status = m_ddiDecodeCtx->pCodecHal->EndFrame();
@@ -74,6 +74,12 @@ VAStatus DdiEncodeBase::EndPicture(
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx, "Null mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    // Raw input in user memory which could not be pinned is copied right before submission
+    if (m_encodeCtx->RTtbl.pCurrentRT)
+    {
+        DDI_CHK_RET(DdiMediaUtil_SyncUserPtrSurface(m_encodeCtx->RTtbl.pCurrentRT, true), "Failed to copy user memory to raw surface");
+    }
+
     VAStatus status = EncodeInCodecHal(m_encodeCtx->dwNumSlices);
     ClearPicParams();
     if (VA_STATUS_SUCCESS != status)
@@ -42,6 +42,7 @@
 #include "media_ddi_decode_const.h"
 #include "decode_status_report.h"
 #include "vphal_render_vebox_memdecomp.h"
+#include "media_libva_init_profiler.h"
 
 #if !defined(ANDROID) && defined(X11_FOUND)
 #include <X11/Xutil.h>
@@ -1244,6 +1245,7 @@ VAStatus DdiDecode_CreateContext (
         return va;
     }
 
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_DECODE_DDI);
     ddiDecBase = DdiDecodeFactory::CreateCodec(codecKey, nullptr);
 
     if (ddiDecBase == nullptr)
@@ -1309,12 +1311,14 @@ VAStatus DdiDecode_CreateContext (
     }
 
     /* the step three */
+    profiler.Next(MEDIA_INIT_PHASE_DECODE_CODECHAL);
     va = ddiDecBase->CodecHalInit(mediaCtx, &mosCtx);
     if (va != VA_STATUS_SUCCESS)
     {
         DdiDecodeCleanUp(ctx,decCtx);
         return va;
     }
+    profiler.Stop();
 
     DdiDecode_GetDisplayInfo(ctx);
 
@@ -35,6 +35,7 @@
 #include "media_interfaces_codechal.h"
 #include "media_interfaces_mmd.h"
 #include "cm_device_rt.h"
+#include "media_libva_init_profiler.h"
 
 typedef MediaDdiFactoryNoArg<DdiEncodeBase> DdiEncodeFactory;
 
@@ -333,6 +334,7 @@ VAStatus DdiEncode_CreateContext(
     MOS_ZeroMemory(&standardInfo, sizeof(CODECHAL_STANDARD_INFO));
     standardInfo.CodecFunction = encCtx->codecFunction;
     standardInfo.Mode          = encCtx->wModeType;
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_ENCODE_CODECHAL);
     Codechal *pCodecHal = CodechalDevice::CreateFactory(
         nullptr,
         &mosCtx,
@@ -367,6 +369,7 @@ VAStatus DdiEncode_CreateContext(
     encCtx->pCpDdiInterface->SetCpFlags(flag);
     encCtx->pCpDdiInterface->SetCpParams(CP_TYPE_NONE, encCtx->m_encode->m_codechalSettings);
 
+    profiler.Next(MEDIA_INIT_PHASE_ENCODE_ALLOCATE);
     vaStatus = encCtx->m_encode->ContextInitialize(encCtx->m_encode->m_codechalSettings);
 
     if (vaStatus != VA_STATUS_SUCCESS)
@@ -403,6 +406,7 @@ VAStatus DdiEncode_CreateContext(
         DdiEncodeCleanUp(encCtx);
         return vaStatus;
     }
+    profiler.Stop();
 
     // register the render target surfaces for this encoder instance
     // This is a must as driver has the constraint, 127 surfaces per context
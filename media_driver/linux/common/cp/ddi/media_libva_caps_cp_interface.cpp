@@ -134,6 +134,13 @@ uint16_t MediaLibvaCapsCpInterface::GetProfileEntryCount()
 {
     DDI_CHK_NULL(m_mediaCaps,   "nullptr m_mediaCaps",  0);
 
+    // The table is built on demand, a failed build is reported as an empty table
+    if (m_mediaCaps->LoadProfileEntrypointsOnDemand() != VA_STATUS_SUCCESS)
+    {
+        DDI_ASSERTMESSAGE("Failed to load profile entrypoints!");
+        return 0;
+    }
+
     return m_mediaCaps->m_profileEntryCount;
 }
 
@@ -61,6 +61,7 @@
 #include "mos_interface.h"
 #include "drm_fourcc.h"
 #include "media_libva_apo_decision.h"
+#include "media_libva_init_profiler.h"
 #include "mos_oca_interface_specific.h"
 
 #define BO_BUSY_TIMEOUT_LIMIT 100
@@ -1417,6 +1418,10 @@ static VAStatus DdiMedia_HeapInitialize(
     DdiMediaUtil_InitMutex(&mediaCtx->ProtMutex);
     DdiMediaUtil_InitMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_InitMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_InitMutex(&mediaCtx->UserPtrMutex);
+
+    mediaCtx->pUserPtrPins = MOS_New(DDI_MEDIA_USERPTR_PIN_MAP);
+    DDI_CHK_NULL(mediaCtx->pUserPtrPins, "nullptr pUserPtrPins", VA_STATUS_ERROR_ALLOCATION_FAILED);
 
     return VA_STATUS_SUCCESS;
 }
@@ -1471,6 +1476,16 @@ static VAStatus DdiMedia_HeapDestroy(
     DdiMediaUtil_DestroyMutex(&mediaCtx->ProtMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_DestroyMutex(&mediaCtx->UserPtrMutex);
+
+    if (mediaCtx->pUserPtrPins)
+    {
+        if (!mediaCtx->pUserPtrPins->empty())
+        {
+            DDI_ASSERTMESSAGE("APP does not destroy all the user memory surfaces.");
+        }
+        MOS_Delete(mediaCtx->pUserPtrPins);
+    }
 
     //resource checking
     if (mediaCtx->uiNumSurfaces != 0)
@@ -1530,6 +1545,7 @@ void FreeForMediaContext(PDDI_MEDIA_CONTEXT mediaCtx)
         MOS_FreeMemory(mediaCtx->pVpCtxHeap);
         MOS_FreeMemory(mediaCtx->pProtCtxHeap);
         MOS_FreeMemory(mediaCtx->pMfeCtxHeap);
+        MOS_Delete(mediaCtx->pUserPtrPins);
         MOS_FreeMemory(mediaCtx);
     }
 
@@ -1547,6 +1563,7 @@ void DestroyMediaContextMutex(PDDI_MEDIA_CONTEXT mediaCtx)
     DdiMediaUtil_DestroyMutex(&mediaCtx->VpMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_DestroyMutex(&mediaCtx->UserPtrMutex);
 #if !defined(ANDROID) && defined(X11_FOUND)
     DdiMediaUtil_DestroyMutex(&mediaCtx->PutSurfaceRenderMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->PutSurfaceSwapBufferMutex);
@@ -1679,7 +1696,8 @@ VAStatus DdiMedia__Initialize (
 #endif
 
     DDI_CHK_NULL(ctx,          "nullptr ctx",       VA_STATUS_ERROR_INVALID_CONTEXT);
-    
+
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_INITIALIZE);
     VAStatus status = VA_STATUS_SUCCESS;
     bool    apoDdiEnabled = false;
     int32_t devicefd = 0;
@@ -1736,7 +1754,9 @@ VAStatus DdiMedia_InitMediaContext (
         *minor_version = VA_MINOR_VERSION;
     }
 
+    MediaInitProfiler phase(MEDIA_INIT_PHASE_GLOBAL_MUTEX);
     DdiMediaUtil_LockMutex(&GlobalMutex);
+    phase.Next(MEDIA_INIT_PHASE_OS_UTILITIES);
     // media context is already created, return directly to support multiple entry
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     if(mediaCtx)
@@ -1767,6 +1787,7 @@ VAStatus DdiMedia_InitMediaContext (
 #endif
     mediaCtx->modularizedGpuCtxEnabled = true;
 
+    phase.Next(MEDIA_INIT_PHASE_DEVICE);
     if (mediaCtx->m_apoMosEnabled)
     {
         mosCtx.fd              = mediaCtx->fd;
@@ -1800,6 +1821,7 @@ VAStatus DdiMedia_InitMediaContext (
         mediaCtx->bIsAtomSOC                = mosCtx.bIsAtomSOC;
         mediaCtx->perfData                  = mosCtx.pPerfData;
 
+        phase.Next(MEDIA_INIT_PHASE_USER_SETTINGS);
         MediaUserSettingsMgr::MediaUserSettingsInit(mediaCtx->platform.eProductFamily);
 
 #ifdef _MMC_SUPPORTED
@@ -1863,8 +1885,11 @@ VAStatus DdiMedia_InitMediaContext (
         {
             MEDIA_WR_WA(waTable, WaHucStreamoutOnlyDisable, 0);
         }
+        phase.Next(MEDIA_INIT_PHASE_USER_SETTINGS);
         MediaUserSettingsMgr::MediaUserSettingsInit(platform.eProductFamily);
 
+        phase.Next(MEDIA_INIT_PHASE_GMM);
+
         GMM_SKU_FEATURE_TABLE gmmSkuTable;
         memset(&gmmSkuTable, 0, sizeof(gmmSkuTable));
 
@@ -1946,6 +1971,7 @@ VAStatus DdiMedia_InitMediaContext (
         // Create GMM page table manager
         mediaCtx->m_auxTableMgr = AuxTableMgr::CreateAuxTableMgr(mediaCtx->pDrmBufMgr, &mediaCtx->SkuTable, mediaCtx->pGmmClientContext);
 
+        phase.Next(MEDIA_INIT_PHASE_OS_CONTEXT);
         bool bSimulationEnable = false;
 #if (_DEBUG || _RELEASE_INTERNAL)
         ReadUserSettingForDebug(
@@ -2010,6 +2036,7 @@ VAStatus DdiMedia_InitMediaContext (
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
 
+    phase.Next(MEDIA_INIT_PHASE_HEAPS);
     if (DdiMedia_HeapInitialize(mediaCtx) != VA_STATUS_SUCCESS)
     {
         DestroyMediaContextMutex(mediaCtx);
@@ -2018,6 +2045,7 @@ VAStatus DdiMedia_InitMediaContext (
     }
 
     //Caps need platform and sku table, especially in MediaLibvaCapsCp::IsDecEncryptionSupported
+    phase.Next(MEDIA_INIT_PHASE_CAPS);
     mediaCtx->m_caps = MediaLibvaCaps::CreateMediaLibvaCaps(mediaCtx);
     if (!mediaCtx->m_caps)
     {
@@ -2038,6 +2066,7 @@ VAStatus DdiMedia_InitMediaContext (
     ctx->max_image_formats = mediaCtx->m_caps->GetImageFormatsMaxNum();
 
 #ifdef _MANUAL_SOFTLET_
+    phase.Next(MEDIA_INIT_PHASE_SOFTLET);
     apoDdiEnabled = MediaLibvaApoDecision::InitDdiApoState(devicefd);
     if(apoDdiEnabled)
     {
@@ -2049,6 +2078,8 @@ VAStatus DdiMedia_InitMediaContext (
     }
     mediaCtx->m_apoDdiEnabled = apoDdiEnabled;
 #endif
+    phase.Stop();
+    MediaInitProfiler::SetContextPhasesTimed(!apoDdiEnabled);
 
 #if !defined(ANDROID) && defined(X11_FOUND)
     DdiMediaUtil_InitMutex(&mediaCtx->PutSurfaceRenderMutex);
@@ -2215,6 +2246,10 @@ VAStatus DdiMedia_Terminate (
     PDDI_MEDIA_CONTEXT mediaCtx   = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
+    // Logged while the MOS message system is still up
+    MediaInitProfiler::Report();
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_TERMINATE);
+
     DdiMediaUtil_LockMutex(&GlobalMutex);
 
 #if !defined(ANDROID) && defined(X11_FOUND)
@@ -3172,6 +3207,7 @@ VAStatus DdiMedia_CreateContext (
     DDI_CHK_NULL(ctx,     "nullptr ctx",          VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(context, "nullptr context",      VA_STATUS_ERROR_INVALID_PARAMETER);
 
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_CREATE_CONTEXT);
     PDDI_MEDIA_CONTEXT mediaDrvCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaDrvCtx,     "nullptr mediaDrvCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
@@ -4180,6 +4216,10 @@ VAStatus DdiMedia_SyncSurface (
         // Just loop while gem_bo_wait times-out.
     }
 
+    // Hand decode and vpp output back to user memory which could not be pinned,
+    // only if the gpu wrote the surface since the last sync
+    DDI_CHK_RET(DdiMediaUtil_SyncUserPtrSurface(surface, false), "Failed to copy surface to user memory");
+
     MOS_TraceEventExt(EVENT_VA_SYNC, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return DdiMedia_StatusCheck(mediaCtx, surface, render_target);
 }
@@ -4252,6 +4292,10 @@ VAStatus DdiMedia_SyncSurface2 (
             }
         }
     }
+
+    // Hand decode and vpp output back to user memory which could not be pinned,
+    // only if the gpu wrote the surface since the last sync
+    DDI_CHK_RET(DdiMediaUtil_SyncUserPtrSurface(surface, false), "Failed to copy surface to user memory");
     MOS_TraceEventExt(EVENT_VA_SYNC, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return DdiMedia_StatusCheck(mediaCtx, surface, surface_id);
 }
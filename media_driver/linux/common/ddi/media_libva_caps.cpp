@@ -120,6 +120,14 @@ const uint32_t MediaLibvaCaps::m_jpegEncSurfaceAttr[m_numJpegEncSurfaceAttr] =
 MediaLibvaCaps::MediaLibvaCaps(DDI_MEDIA_CONTEXT *mediaCtx)
 {
     m_mediaCtx = mediaCtx;
+
+    // Recursive, the load may query the table through the CP interface while holding it
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&m_profileEntrypointsMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
     m_CapsCp = Create_MediaLibvaCapsCpInterface(mediaCtx, this);
     if (m_CapsCp)
     {
@@ -132,6 +140,26 @@ MediaLibvaCaps::~MediaLibvaCaps()
     FreeAttributeList();
     Delete_MediaLibvaCapsCpInterface(m_CapsCp);
     m_CapsCp = nullptr;
+    DdiMediaUtil_DestroyMutex(&m_profileEntrypointsMutex);
+}
+
+VAStatus MediaLibvaCaps::LoadProfileEntrypointsOnDemand()
+{
+    DdiMediaUtil_LockGuard guard(&m_profileEntrypointsMutex);
+
+    if (!m_profileEntrypointsLoaded)
+    {
+        // A failed load leaves a partial table behind, so it is not retried
+        m_profileEntrypointsLoaded = true;
+        m_profileEntrypointsStatus = LoadProfileEntrypoints();
+
+        for (auto attributeList : m_attributeLists)
+        {
+            attributeList->Compact();
+        }
+    }
+
+    return m_profileEntrypointsStatus;
 }
 
 bool MediaLibvaCaps::CheckEntrypointCodecType(VAEntrypoint entrypoint, CodecType codecType)
@@ -1963,6 +1991,7 @@ VAStatus MediaLibvaCaps::GetConfigAttributes(VAProfile profile,
         int32_t numAttribs)
 {
     DDI_CHK_NULL(attribList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnDemand(), "Failed to load profile entrypoints!");
     int32_t i = GetProfileTableIdx(profile, entrypoint);
 
     switch(i)
@@ -2284,6 +2313,8 @@ VAStatus MediaLibvaCaps::CreateConfig(
 
     DDI_CHK_NULL(configId, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
 
+    DDI_CHK_RET(LoadProfileEntrypointsOnDemand(), "Failed to load profile entrypoints!");
+
     DDI_CHK_RET(CheckProfile(profile),"Failed to check config!");
 
     int32_t i = GetProfileTableIdx(profile, entrypoint);
@@ -2335,6 +2366,7 @@ VAStatus MediaLibvaCaps::QueryConfigProfiles(
 {
     DDI_CHK_NULL(profileList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(numProfiles, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnDemand(), "Failed to load profile entrypoints!");
     std::set<int32_t> profiles;
     int32_t i;
     for (i = 0; i < m_profileEntryCount; i++)
@@ -2362,6 +2394,7 @@ VAStatus MediaLibvaCaps::QueryConfigEntrypoints(
 {
     DDI_CHK_NULL(entrypointList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(numEntrypoints, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_RET(LoadProfileEntrypointsOnDemand(), "Failed to load profile entrypoints!");
     int32_t j = 0;
     for (int32_t i = 0; i < m_profileEntryCount; i++)
     {
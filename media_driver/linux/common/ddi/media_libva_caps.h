@@ -29,6 +29,9 @@
 
 #include "va/va.h"
 
+#include <pthread.h>
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -39,7 +42,60 @@
 struct DDI_MEDIA_CONTEXT;
 class MediaLibvaCapsCpInterface;
 
-typedef std::map<VAConfigAttribType, uint32_t> AttribMap;
+//!
+//! \class  AttribMap
+//! \brief  Config attributes of a profile/entrypoint pair. Kept as an array
+//!         sorted by attribute type, which has the lookup and iteration
+//!         order of std::map without a heap node per attribute.
+//!
+class AttribMap
+{
+public:
+    typedef std::pair<VAConfigAttribType, uint32_t> value_type;
+    typedef std::vector<value_type>::iterator       iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return m_attribs.begin(); }
+    iterator end() { return m_attribs.end(); }
+    const_iterator begin() const { return m_attribs.begin(); }
+    const_iterator end() const { return m_attribs.end(); }
+
+    size_t size() const { return m_attribs.size(); }
+    void clear() { m_attribs.clear(); }
+
+    iterator find(VAConfigAttribType type)
+    {
+        auto it = LowerBound(type);
+        return (it != m_attribs.end() && it->first == type) ? it : m_attribs.end();
+    }
+
+    //!
+    //! \brief  Access the value of an attribute, inserting it as 0 if absent
+    //!
+    uint32_t &operator[](VAConfigAttribType type)
+    {
+        auto it = LowerBound(type);
+        if (it == m_attribs.end() || it->first != type)
+        {
+            it = m_attribs.insert(it, value_type(type, 0));
+        }
+        return it->second;
+    }
+
+    //!
+    //! \brief  Release the spare capacity once the attributes are complete
+    //!
+    void Compact() { m_attribs.shrink_to_fit(); }
+
+private:
+    iterator LowerBound(VAConfigAttribType type)
+    {
+        return std::lower_bound(m_attribs.begin(), m_attribs.end(), type,
+            [](const value_type &attrib, VAConfigAttribType t) { return attrib.first < t; });
+    }
+
+    std::vector<value_type> m_attribs;
+};
 
 //!
 //! \class  MediaLibvaCaps
@@ -722,6 +778,9 @@ public:
 
     //!
     //! \brief    Initialize the MediaLibvaCaps instance for current platform
+    //! \details  The profile/entrypoint table is not built here but on the
+    //!           first query which needs it, see LoadProfileEntrypointsOnDemand.
+    //!           A failure to build it does not fail vaInitialize any more.
     //!
     //! \return   VAStatus
     //!           return VA_STATUS_SUCCESS for success
@@ -906,6 +965,10 @@ protected:
     //!
     std::vector<AttribMap *> m_attributeLists;
 
+    bool            m_profileEntrypointsLoaded = false;               //!< If LoadProfileEntrypoints has run
+    VAStatus        m_profileEntrypointsStatus = VA_STATUS_SUCCESS;   //!< Result of LoadProfileEntrypoints
+    pthread_mutex_t m_profileEntrypointsMutex;                         //!< Serializes the on demand load, recursive
+
     bool m_isEntryptSupported = false; //!< If decode encryption is supported on current platform
 
     std::vector<EncConfig> m_encConfigs; //!< Store supported encode configs
@@ -1266,6 +1329,23 @@ protected:
     //!
     virtual VAStatus LoadProfileEntrypoints() = 0;
 
+    //!
+    //! \brief    Run LoadProfileEntrypoints once, on the first query which
+    //!           needs the profile/entrypoint table, so displays which are
+    //!           opened but never query codec caps do not build it
+    //! \details  A load failure is returned by the first query instead of
+    //!           vaInitialize, and by every later one as the load is not
+    //!           retried: vaQueryConfigProfiles, vaQueryConfigEntrypoints,
+    //!           vaGetConfigAttributes and vaCreateConfig fail, and the CP
+    //!           interface sees an empty table. Calls made by the load itself,
+    //!           e.g. from LoadCpProfileEntrypoints, return success and see the
+    //!           table built so far.
+    //!
+    //! \return   VAStatus
+    //!           result of LoadProfileEntrypoints
+    //!
+    VAStatus LoadProfileEntrypointsOnDemand();
+
     //!
     //! \brief    Create decode config by given attributes
     //!
@@ -44,6 +44,7 @@
 
 #include "mos_os.h"
 #include "mos_auxtable_mgr.h"
+#include "media_libva_userptr.h"
 
 #ifdef _MANUAL_SOFTLET_
 #include "ddi_media_functions.h"
@@ -326,6 +327,10 @@ typedef struct _DDI_MEDIA_SURFACE
 
     uint32_t                uiVariantFlag;
     int                     memType;
+
+    bool                    bUserPtrPinned;           // bo is shared through the media context userptr pin map
+    bool                    bUserPtrCopy;             // bo is a driver copy of user memory which could not be pinned
+    bool                    bUserPtrGpuWritten;       // gpu wrote the driver copy since it was last copied back to user memory
 } DDI_MEDIA_SURFACE, *PDDI_MEDIA_SURFACE;
 
 typedef struct _DDI_MEDIA_BUFFER
@@ -412,6 +417,9 @@ typedef struct _DDI_X11_FUNC_TABLE
 }DDI_X11_FUNC_TABLE, *PDDI_X11_FUNC_TABLE;
 #endif
 
+// userptr bos shared by external surfaces wrapping the same user memory
+typedef DdiMediaUserPtrPinMap<MOS_LINUX_BO> DDI_MEDIA_USERPTR_PIN_MAP;
+
 //!
 //! \struct DDI_MEDIA_CONTEXT
 //! \brief  Media heap for shared internal structures
@@ -481,6 +489,10 @@ struct DDI_MEDIA_CONTEXT
     MEDIA_MUTEX_T       ProtMutex;
     MEDIA_MUTEX_T       CmMutex;
     MEDIA_MUTEX_T       MfeMutex;
+    MEDIA_MUTEX_T       UserPtrMutex;
+
+    // userptr bos of external user memory surfaces, protected by UserPtrMutex
+    DDI_MEDIA_USERPTR_PIN_MAP *pUserPtrPins;
 
     // GT system Info
     MEDIA_SYSTEM_INFO  *pGtSystemInfo;
@@ -0,0 +1,156 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_init_profiler.cpp
+//! \brief    Timings of the vaInitialize, vaTerminate and vaCreateContext phases
+//!
+
+#include "media_libva_init_profiler.h"
+#include <time.h>
+#include <atomic>
+#include "media_libva_util.h"
+
+static std::atomic<uint64_t> s_phaseCount[MEDIA_INIT_PHASE_COUNT];
+static std::atomic<uint64_t> s_phaseTotalNs[MEDIA_INIT_PHASE_COUNT];
+static std::atomic<uint64_t> s_phaseLastNs[MEDIA_INIT_PHASE_COUNT];
+static std::atomic<uint64_t> s_phaseMaxNs[MEDIA_INIT_PHASE_COUNT];
+static std::atomic<bool>     s_contextPhasesTimed{true};
+
+MediaInitProfiler::MediaInitProfiler(MEDIA_INIT_PHASE phase)
+    : m_phase(phase),
+      m_startNs(GetTimeNs())
+{
+}
+
+MediaInitProfiler::~MediaInitProfiler()
+{
+    Stop();
+}
+
+void MediaInitProfiler::Next(MEDIA_INIT_PHASE phase)
+{
+    uint64_t now = GetTimeNs();
+    if (m_phase < MEDIA_INIT_PHASE_COUNT)
+    {
+        Record(m_phase, now - m_startNs);
+    }
+    m_phase   = phase;
+    m_startNs = now;
+}
+
+void MediaInitProfiler::Stop()
+{
+    if (m_phase < MEDIA_INIT_PHASE_COUNT)
+    {
+        Record(m_phase, GetTimeNs() - m_startNs);
+        m_phase = MEDIA_INIT_PHASE_COUNT;
+    }
+}
+
+void MediaInitProfiler::Record(MEDIA_INIT_PHASE phase, uint64_t ns)
+{
+    if (phase >= MEDIA_INIT_PHASE_COUNT)
+    {
+        return;
+    }
+
+    s_phaseCount[phase]++;
+    s_phaseTotalNs[phase] += ns;
+    s_phaseLastNs[phase] = ns;
+
+    uint64_t maxNs = s_phaseMaxNs[phase].load();
+    while (ns > maxNs && !s_phaseMaxNs[phase].compare_exchange_weak(maxNs, ns))
+    {
+    }
+}
+
+uint32_t MediaInitProfiler::GetStats(MEDIA_INIT_PHASE_STATS *stats, uint32_t count)
+{
+    if (stats == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t timed  = s_contextPhasesTimed ? MEDIA_INIT_PHASE_COUNT : MEDIA_INIT_PHASE_CREATE_CONTEXT;
+    uint32_t filled = count < timed ? count : timed;
+    for (uint32_t i = 0; i < filled; i++)
+    {
+        stats[i].count   = s_phaseCount[i];
+        stats[i].totalNs = s_phaseTotalNs[i];
+        stats[i].lastNs  = s_phaseLastNs[i];
+        stats[i].maxNs   = s_phaseMaxNs[i];
+    }
+    return filled;
+}
+
+void MediaInitProfiler::SetContextPhasesTimed(bool timed)
+{
+    s_contextPhasesTimed = timed;
+}
+
+void MediaInitProfiler::Reset()
+{
+    for (uint32_t i = 0; i < MEDIA_INIT_PHASE_COUNT; i++)
+    {
+        s_phaseCount[i]   = 0;
+        s_phaseTotalNs[i] = 0;
+        s_phaseLastNs[i]  = 0;
+        s_phaseMaxNs[i]   = 0;
+    }
+}
+
+void MediaInitProfiler::Report()
+{
+    for (uint32_t i = 0; i < MEDIA_INIT_PHASE_COUNT; i++)
+    {
+        uint64_t count = s_phaseCount[i];
+        if (count == 0)
+        {
+            continue;
+        }
+        DDI_NORMALMESSAGE("Init phase %-16s: %llu runs, avg %llu ns, last %llu ns, max %llu ns",
+            GetPhaseName((MEDIA_INIT_PHASE)i),
+            (unsigned long long)count,
+            (unsigned long long)(s_phaseTotalNs[i] / count),
+            (unsigned long long)s_phaseLastNs[i].load(),
+            (unsigned long long)s_phaseMaxNs[i].load());
+    }
+}
+
+uint64_t MediaInitProfiler::GetTimeNs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t DdiMedia_GetInitPhaseStats(
+    MEDIA_INIT_PHASE_STATS *stats,
+    uint32_t                count)
+{
+    return MediaInitProfiler::GetStats(stats, count);
+}
+
+void DdiMedia_ResetInitPhaseStats()
+{
+    MediaInitProfiler::Reset();
+}
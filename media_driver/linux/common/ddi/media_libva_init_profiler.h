@@ -0,0 +1,192 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_init_profiler.h
+//! \brief    Timings of the vaInitialize, vaTerminate and vaCreateContext phases
+//! \details  Every phase keeps a count, total, last and max duration in
+//!           nanoseconds for the life of the process. The statistics are
+//!           exported through DdiMedia_GetInitPhaseStats so that startup cost
+//!           can be tracked without a trace tool attached.
+//!
+
+#ifndef __MEDIA_LIBVA_INIT_PROFILER_H__
+#define __MEDIA_LIBVA_INIT_PROFILER_H__
+
+#include <stdint.h>
+
+//!
+//! \brief  Phases of driver initialization and context creation
+//! \details Phases from MEDIA_INIT_PHASE_CREATE_CONTEXT on are timed by the
+//!          legacy DDI vaCreateContext only, contexts created by the APO DDI
+//!          are not timed
+//!
+enum MEDIA_INIT_PHASE
+{
+    MEDIA_INIT_PHASE_INITIALIZE = 0,        //!< vaInitialize as a whole
+    MEDIA_INIT_PHASE_GLOBAL_MUTEX,          //!< waiting for GlobalMutex
+    MEDIA_INIT_PHASE_OS_UTILITIES,          //!< MOS utilities and user feature declaration
+    MEDIA_INIT_PHASE_DEVICE,                //!< buffer manager, HW info, SKU/WA tables, OS device context
+    MEDIA_INIT_PHASE_USER_SETTINGS,         //!< media user settings
+    MEDIA_INIT_PHASE_GMM,                   //!< GMM client context and AUX table manager
+    MEDIA_INIT_PHASE_OS_CONTEXT,            //!< OS context, command buffer and GPU context managers
+    MEDIA_INIT_PHASE_HEAPS,                 //!< DDI object heaps
+    MEDIA_INIT_PHASE_CAPS,                  //!< caps construction and init
+    MEDIA_INIT_PHASE_SOFTLET,               //!< APO DDI initialization
+    MEDIA_INIT_PHASE_TERMINATE,             //!< vaTerminate as a whole
+    MEDIA_INIT_PHASE_CREATE_CONTEXT,        //!< vaCreateContext as a whole
+    MEDIA_INIT_PHASE_DECODE_DDI,            //!< decode DDI object creation and basic init
+    MEDIA_INIT_PHASE_DECODE_CODECHAL,       //!< decode CodecHal with its MHW and HAL interfaces
+    MEDIA_INIT_PHASE_ENCODE_CODECHAL,       //!< encode CodecHal with its MHW and HAL interfaces
+    MEDIA_INIT_PHASE_ENCODE_ALLOCATE,       //!< encode context initialize and resource allocation
+    MEDIA_INIT_PHASE_VP_CONTEXT,            //!< VP context with its VPHAL
+    MEDIA_INIT_PHASE_COUNT
+};
+
+//!
+//! \brief  Statistics of a phase
+//!
+struct MEDIA_INIT_PHASE_STATS
+{
+    uint64_t count;                         //!< times the phase ran
+    uint64_t totalNs;                       //!< sum of the durations
+    uint64_t lastNs;                        //!< duration of the latest run
+    uint64_t maxNs;                         //!< longest duration
+};
+
+#ifdef __cplusplus
+//!
+//! \class  MediaInitProfiler
+//! \brief  Times one phase from construction to Stop or destruction, so early
+//!         returns are timed too. Next ends the running phase and starts the
+//!         following one with a single clock read.
+//!
+class MediaInitProfiler
+{
+public:
+    MediaInitProfiler(MEDIA_INIT_PHASE phase);
+
+    ~MediaInitProfiler();
+
+    //!
+    //! \brief  Record the running phase and start timing another one
+    //!
+    void Next(MEDIA_INIT_PHASE phase);
+
+    //!
+    //! \brief  Record the running phase, the destructor records nothing after it
+    //!
+    void Stop();
+
+    //!
+    //! \brief  Add a duration to the statistics of a phase
+    //!
+    static void Record(MEDIA_INIT_PHASE phase, uint64_t ns);
+
+    //!
+    //! \brief  Copy the statistics of the first count phases
+    //! \return uint32_t
+    //!         number of phases copied, the context phases are left out
+    //!         when they are not timed
+    //!
+    static uint32_t GetStats(MEDIA_INIT_PHASE_STATS *stats, uint32_t count);
+
+    //!
+    //! \brief  Set whether vaCreateContext runs through the timed legacy DDI,
+    //!         set by vaInitialize once the APO DDI decision is made
+    //!
+    static void SetContextPhasesTimed(bool timed);
+
+    //!
+    //! \brief  Clear the statistics of all phases
+    //!
+    static void Reset();
+
+    //!
+    //! \brief  Log the statistics of the phases which ran
+    //!
+    static void Report();
+
+    //!
+    //! \brief  Name of a phase, inline so tools reading the exported
+    //!         statistics can print them without linking the driver
+    //!
+    static const char *GetPhaseName(MEDIA_INIT_PHASE phase)
+    {
+        static const char *names[MEDIA_INIT_PHASE_COUNT] =
+        {
+            "Initialize",
+            "GlobalMutex",
+            "OsUtilities",
+            "Device",
+            "UserSettings",
+            "Gmm",
+            "OsContext",
+            "Heaps",
+            "Caps",
+            "Softlet",
+            "Terminate",
+            "CreateContext",
+            "DecodeDdi",
+            "DecodeCodechal",
+            "EncodeCodechal",
+            "EncodeAllocate",
+            "VpContext",
+        };
+        return phase < MEDIA_INIT_PHASE_COUNT ? names[phase] : "Unknown";
+    }
+
+    static uint64_t GetTimeNs();
+
+private:
+    MEDIA_INIT_PHASE m_phase   = MEDIA_INIT_PHASE_COUNT;
+    uint64_t         m_startNs = 0;
+};
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//!
+//! \brief  Copy the statistics of the initialization phases
+//! \param  [out] stats
+//!         Array receiving the statistics, indexed by MEDIA_INIT_PHASE
+//! \param  [in] count
+//!         Number of entries in stats
+//! \return uint32_t
+//!         number of entries filled, at most MEDIA_INIT_PHASE_CREATE_CONTEXT
+//!         when the APO DDI creates the contexts as those phases are not timed
+//!
+__attribute__((visibility("default"))) uint32_t DdiMedia_GetInitPhaseStats(
+    MEDIA_INIT_PHASE_STATS *stats,
+    uint32_t                count);
+
+//!
+//! \brief  Clear the statistics of the initialization phases
+//!
+__attribute__((visibility("default"))) void DdiMedia_ResetInitPhaseStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MEDIA_LIBVA_INIT_PROFILER_H__
@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_userptr.h
+//! \brief    Pin map and copy fallback of external user memory surfaces
+//!
+
+#ifndef __MEDIA_LIBVA_USERPTR_H__
+#define __MEDIA_LIBVA_USERPTR_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include "mos_defs.h"
+
+//!
+//! \struct DDI_MEDIA_USERPTR_KEY
+//! \brief  Page aligned user memory range and layout a userptr bo was created with
+//!
+struct DDI_MEDIA_USERPTR_KEY
+{
+    uintptr_t           start;
+    uint64_t            size;
+    uint32_t            tile;
+    uint32_t            pitch;
+
+    bool operator<(const DDI_MEDIA_USERPTR_KEY &other) const
+    {
+        if (start != other.start) return start < other.start;
+        if (size  != other.size)  return size  < other.size;
+        if (tile  != other.tile)  return tile  < other.tile;
+        return pitch < other.pitch;
+    }
+};
+
+//!
+//! \brief  Build the pin map key of a user memory range
+//! \details The kernel pins whole pages only, so the size is rounded up to
+//!         whole pages and a range starting inside a page can't be pinned.
+//!
+//! \param  [in] addr
+//!         Start of the user memory
+//! \param  [in] size
+//!         Size of the user memory
+//! \param  [in] tile
+//!         Tiling of the user memory
+//! \param  [in] pitch
+//!         Pitch of the user memory
+//! \param  [out] key
+//!         Pin map key
+//!
+//! \return bool
+//!     true if the user memory can be pinned, false if it has to be copied
+//!
+inline bool DdiMediaUserPtr_GetKey(uintptr_t addr, uint64_t size, uint32_t tile, uint32_t pitch, DDI_MEDIA_USERPTR_KEY &key)
+{
+    key.start = addr;
+    key.size  = MOS_ALIGN_CEIL(size, MOS_PAGE_SIZE);
+    key.tile  = tile;
+    key.pitch = pitch;
+    return addr != 0 && size != 0 && (addr & (MOS_PAGE_SIZE - 1)) == 0;
+}
+
+//!
+//! \brief  Whether a driver copy of user memory has to be synchronized
+//! \details User memory is copied to the driver copy before every read by
+//!         the gpu, the application may have changed it. The driver copy is
+//!         copied back only if the gpu wrote it since the last copy back.
+//!
+//! \param  [in] upload
+//!         true to copy user memory to the driver copy, false for the other way
+//! \param  [in] gpuWritten
+//!         The gpu wrote the driver copy since it was last copied back
+//!
+//! \return bool
+//!     true if the copy is needed
+//!
+inline bool DdiMediaUserPtr_NeedSync(bool upload, bool gpuWritten)
+{
+    return upload || gpuWritten;
+}
+
+//!
+//! \brief  Copy between user memory and its mapped driver copy
+//!
+//! \param  [in] copy
+//!         Mapped driver copy
+//! \param  [in] userPtr
+//!         User memory
+//! \param  [in] size
+//!         Size of the user memory
+//! \param  [in] upload
+//!         true to copy user memory to the driver copy, false for the other way
+//!
+inline void DdiMediaUserPtr_Copy(void *copy, void *userPtr, size_t size, bool upload)
+{
+    if (upload)
+    {
+        memcpy(copy, userPtr, size);
+    }
+    else
+    {
+        memcpy(userPtr, copy, size);
+    }
+}
+
+//!
+//! \class  DdiMediaUserPtrPinMap
+//! \brief  Userptr bos shared by all external surfaces wrapping the same user
+//!         memory. Not thread safe, the media context guards it with
+//!         UserPtrMutex.
+//!
+template<class Bo>
+class DdiMediaUserPtrPinMap
+{
+public:
+    //!
+    //! \brief  Get the bo pinning a user memory range, pinning it on first use
+    //!
+    //! \param  [in] key
+    //!         User memory range and layout
+    //! \param  [in] Pin
+    //!         Called with the key if the range is not pinned yet, returns
+    //!         the new bo or nullptr if the kernel rejects the memory
+    //!
+    //! \return Bo*
+    //!     Bo shared by all the users of the range, nullptr if it can't be pinned
+    //!
+    template<class PinFunction>
+    Bo *Acquire(const DDI_MEDIA_USERPTR_KEY &key, PinFunction Pin)
+    {
+        auto it = m_pins.find(key);
+        if (it != m_pins.end())
+        {
+            it->second.refCount++;
+            return it->second.bo;
+        }
+
+        Bo *bo = Pin(key);
+        if (bo == nullptr)
+        {
+            return nullptr;
+        }
+
+        UserPtrPin pin;
+        pin.bo       = bo;
+        pin.refCount = 1;
+        m_pins.insert(std::make_pair(key, pin));
+        return bo;
+    }
+
+    //!
+    //! \brief  Drop one user of a pinned user memory range
+    //! \details The pages are unpinned as soon as the last user is gone: the
+    //!         bo is unsynchronized, so it must not outlive the application's
+    //!         allocation.
+    //!
+    //! \param  [in] key
+    //!         User memory range and layout
+    //! \param  [out] unknown
+    //!         Set if the range is not pinned
+    //!
+    //! \return Bo*
+    //!     Bo to unpin if this was its last user, else nullptr
+    //!
+    Bo *Release(const DDI_MEDIA_USERPTR_KEY &key, bool &unknown)
+    {
+        auto it = m_pins.find(key);
+        unknown = (it == m_pins.end());
+        if (unknown || --it->second.refCount != 0)
+        {
+            return nullptr;
+        }
+
+        Bo *bo = it->second.bo;
+        m_pins.erase(it);
+        return bo;
+    }
+
+    //!
+    //! \brief  Number of users of a pinned user memory range, 0 if not pinned
+    //!
+    uint32_t GetRefCount(const DDI_MEDIA_USERPTR_KEY &key) const
+    {
+        auto it = m_pins.find(key);
+        return (it == m_pins.end()) ? 0 : it->second.refCount;
+    }
+
+    bool empty() const { return m_pins.empty(); }
+
+    size_t size() const { return m_pins.size(); }
+
+private:
+    struct UserPtrPin
+    {
+        Bo                 *bo;
+        uint32_t            refCount;
+    };
+
+    std::map<DDI_MEDIA_USERPTR_KEY, UserPtrPin> m_pins;
+};
+
+#endif //__MEDIA_LIBVA_USERPTR_H__
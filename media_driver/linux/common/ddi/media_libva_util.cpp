@@ -388,30 +388,25 @@ VAStatus DdiMediaUtil_AllocateSurface(
         }
         else if( mediaSurface->pSurfDesc->uiVaMemType == VA_SURFACE_ATTRIB_MEM_TYPE_USER_PTR )
         {
-#ifdef DRM_IOCTL_I915_GEM_USERPTR
-            bo = mos_bo_alloc_userptr( mediaDrvCtx->pDrmBufMgr,
-                                          "SysSurface",
-                                          (void *)mediaSurface->pSurfDesc->ulBuffer,
-                                          mediaSurface->pSurfDesc->uiTile,
-                                          pitch,
-                                          mediaSurface->pSurfDesc->uiBuffserSize,
-                                          I915_USERPTR_UNSYNCHRONIZED
-                                         );
-#else
-            bo = mos_bo_alloc_vmap( mediaDrvCtx->pDrmBufMgr,
-                                          "SysSurface",
-                                          (void *)mediaSurface->pSurfDesc->ulBuffer,
-                                          mediaSurface->pSurfDesc->uiTile,
-                                          pitch,
-                                          mediaSurface->pSurfDesc->uiBuffserSize,
-                                          0
-                                         );
-#endif
+            bo = DdiMediaUtil_ImportUserPtr(mediaDrvCtx,
+                                            mediaSurface->pSurfDesc->ulBuffer,
+                                            mediaSurface->pSurfDesc->uiBuffserSize,
+                                            mediaSurface->pSurfDesc->uiTile,
+                                            pitch);
             if (bo != nullptr)
             {
                 uint32_t swizzle_mode;
                 //Overwrite the tile format that matches the exteral buffer
                 mos_bo_get_tiling(bo, &tileformat, &swizzle_mode);
+                mediaSurface->bUserPtrPinned = true;
+            }
+            else if (mediaSurface->pSurfDesc->uiTile == I915_TILING_NONE)
+            {
+                // The user memory can't be pinned (unaligned or rejected by the kernel),
+                // so back the surface with driver memory and copy at submission and sync.
+                bo = mos_bo_alloc(mediaDrvCtx->pDrmBufMgr, "SysSurfaceCopy", mediaSurface->pSurfDesc->uiBuffserSize, 4096, mem_type);
+                DDI_CHK_NULL(bo, "Failed to create copy buffer for user memory.", VA_STATUS_ERROR_ALLOCATION_FAILED);
+                mediaSurface->bUserPtrCopy = true;
             }
             else
             {
@@ -1494,6 +1489,15 @@ void DdiMediaUtil_FreeSurface(DDI_MEDIA_SURFACE *surface)
         DDI_VERBOSEMESSAGE("DDI: try to free a locked surface.");
     }
     mos_bo_unreference(surface->bo);
+    if (surface->bUserPtrPinned && surface->pSurfDesc)
+    {
+        DdiMediaUtil_ReleaseUserPtr(surface->pMediaCtx,
+                                    surface->pSurfDesc->ulBuffer,
+                                    surface->pSurfDesc->uiBuffserSize,
+                                    surface->pSurfDesc->uiTile,
+                                    surface->pSurfDesc->uiPitches[0]);
+        surface->bUserPtrPinned = false;
+    }
     // For External Buffer, only needs to destory SurfaceDescriptor
     if (surface->pSurfDesc)
     {
@@ -1509,6 +1513,105 @@ void DdiMediaUtil_FreeSurface(DDI_MEDIA_SURFACE *surface)
 }
 
 
+MOS_LINUX_BO *DdiMediaUtil_ImportUserPtr(PDDI_MEDIA_CONTEXT mediaCtx, uintptr_t addr, uint64_t size, uint32_t tile, uint32_t pitch)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", nullptr);
+    DDI_CHK_NULL(mediaCtx->pUserPtrPins, "nullptr pUserPtrPins", nullptr);
+
+    // A surface starting inside a page has to be copied
+    DDI_MEDIA_USERPTR_KEY key;
+    if (!DdiMediaUserPtr_GetKey(addr, size, tile, pitch, key))
+    {
+        return nullptr;
+    }
+
+    DdiMediaUtil_LockGuard guard(&mediaCtx->UserPtrMutex);
+
+    auto pin = [mediaCtx](const DDI_MEDIA_USERPTR_KEY &key) -> MOS_LINUX_BO * {
+#ifdef DRM_IOCTL_I915_GEM_USERPTR
+        return mos_bo_alloc_userptr(mediaCtx->pDrmBufMgr,
+                                    "SysSurface",
+                                    (void *)key.start,
+                                    key.tile,
+                                    key.pitch,
+                                    key.size,
+                                    I915_USERPTR_UNSYNCHRONIZED);
+#else
+        return mos_bo_alloc_vmap(mediaCtx->pDrmBufMgr,
+                                 "SysSurface",
+                                 (void *)key.start,
+                                 key.tile,
+                                 key.pitch,
+                                 key.size,
+                                 0);
+#endif
+    };
+
+    // The pin map holds the reference taken by the allocation, the caller
+    // gets another one
+    MOS_LINUX_BO *bo = mediaCtx->pUserPtrPins->Acquire(key, pin);
+    if (bo == nullptr)
+    {
+        DDI_VERBOSEMESSAGE("DDI: failed to pin user memory, falling back to copy.");
+        return nullptr;
+    }
+    mos_bo_reference(bo);
+    return bo;
+}
+
+void DdiMediaUtil_ReleaseUserPtr(PDDI_MEDIA_CONTEXT mediaCtx, uintptr_t addr, uint64_t size, uint32_t tile, uint32_t pitch)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", );
+    DDI_CHK_NULL(mediaCtx->pUserPtrPins, "nullptr pUserPtrPins", );
+
+    DDI_MEDIA_USERPTR_KEY key;
+    DdiMediaUserPtr_GetKey(addr, size, tile, pitch, key);
+
+    DdiMediaUtil_LockGuard guard(&mediaCtx->UserPtrMutex);
+
+    bool unknown = false;
+    MOS_LINUX_BO *bo = mediaCtx->pUserPtrPins->Release(key, unknown);
+    if (unknown)
+    {
+        DDI_ASSERTMESSAGE("DDI: release of user memory which is not pinned.");
+        return;
+    }
+    if (bo)
+    {
+        mos_bo_unreference(bo);
+    }
+}
+
+VAStatus DdiMediaUtil_SyncUserPtrSurface(DDI_MEDIA_SURFACE *surface, bool upload)
+{
+    DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
+
+    // Nothing to copy back unless the gpu wrote the driver copy since the last sync
+    if (!surface->bUserPtrCopy || !DdiMediaUserPtr_NeedSync(upload, surface->bUserPtrGpuWritten))
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    DDI_CHK_NULL(surface->bo, "nullptr surface->bo", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_NULL(surface->pSurfDesc, "nullptr surface->pSurfDesc", VA_STATUS_ERROR_INVALID_SURFACE);
+
+    if (mos_bo_map(surface->bo, upload) != 0)
+    {
+        DDI_ASSERTMESSAGE("DDI: failed to map the copy of user memory.");
+        return VA_STATUS_ERROR_OPERATION_FAILED;
+    }
+
+    DdiMediaUserPtr_Copy(surface->bo->virt, (void *)surface->pSurfDesc->ulBuffer, surface->pSurfDesc->uiBuffserSize, upload);
+
+    mos_bo_unmap(surface->bo);
+
+    if (!upload)
+    {
+        surface->bUserPtrGpuWritten = false;
+    }
+    return VA_STATUS_SUCCESS;
+}
+
 // should ref_count added for bo?
 void DdiMediaUtil_FreeBuffer(DDI_MEDIA_BUFFER  *buf)
 {
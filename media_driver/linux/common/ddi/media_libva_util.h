@@ -134,6 +134,61 @@ void     DdiMediaUtil_UnlockBuffer(DDI_MEDIA_BUFFER *buf);
 //!
 void     DdiMediaUtil_FreeSurface(DDI_MEDIA_SURFACE *surface);
 
+//!
+//! \brief  Import user memory as a userptr bo
+//! \details Surfaces wrapping the same page range share one pinned bo. Returns
+//!         nullptr if the memory can't be pinned, in which case the caller
+//!         falls back to a driver copy.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] addr
+//!         Start of the user memory, must be page aligned
+//! \param  [in] size
+//!         Size of the user memory, rounded up to whole pages
+//! \param  [in] tile
+//!         Tiling of the user memory
+//! \param  [in] pitch
+//!         Pitch of the user memory
+//!
+//! \return MOS_LINUX_BO*
+//!     Referenced bo if success, else nullptr
+//!
+MOS_LINUX_BO *DdiMediaUtil_ImportUserPtr(PDDI_MEDIA_CONTEXT mediaCtx, uintptr_t addr, uint64_t size, uint32_t tile, uint32_t pitch);
+
+//!
+//! \brief  Drop one surface from a pinned user memory range
+//! \details The pin is released together with the last surface using it.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] addr
+//!         Start of the user memory
+//! \param  [in] size
+//!         Size of the user memory
+//! \param  [in] tile
+//!         Tiling of the user memory
+//! \param  [in] pitch
+//!         Pitch of the user memory
+//!
+void     DdiMediaUtil_ReleaseUserPtr(PDDI_MEDIA_CONTEXT mediaCtx, uintptr_t addr, uint64_t size, uint32_t tile, uint32_t pitch);
+
+//!
+//! \brief  Synchronize a user memory surface with its driver copy
+//! \details No-op for surfaces whose user memory is pinned. The driver copy
+//!         is copied back to user memory only if the gpu wrote it since the
+//!         last copy back.
+//!
+//! \param  [in] surface
+//!         Ddi media surface
+//! \param  [in] upload
+//!         true to copy user memory to the gpu copy, false for the other way
+//!
+//! \return VAStatus
+//!     VA_STATUS_SUCCESS if success, else fail reason
+//!
+VAStatus DdiMediaUtil_SyncUserPtrSurface(DDI_MEDIA_SURFACE *surface, bool upload);
+
 //!
 //! \brief  Free buffer
 //! 
@@ -25,6 +25,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_init_profiler.cpp
 )
 
 set(TMP_HEADERS_
@@ -36,7 +37,9 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_factory.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_userptr.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_init_profiler.h
 )
 
 if(NOT ${PLATFORM} STREQUAL "android" AND X11_FOUND)
@@ -37,6 +37,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_commandbuffer_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_mgr.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_updater.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_interface.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific_ext.cpp
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager_specific.cpp
@@ -55,6 +56,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_commandbuffer_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_mgr.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_auxtable_updater.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_vma.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_interface_specific.h
 )
@@ -118,7 +118,7 @@ static void WaitFromCpuCb(void *bo)
     }
 }
 
-AuxTableMgr::AuxTableMgr(MOS_BUFMGR *bufMgr, GMM_CLIENT_CONTEXT *gmmClientContext)
+AuxTableMgr::AuxTableMgr(MOS_BUFMGR *bufMgr, GMM_CLIENT_CONTEXT *gmmClientContext) : m_updater(this)
 {
     if (bufMgr)
     {
@@ -147,6 +147,9 @@ AuxTableMgr::AuxTableMgr(MOS_BUFMGR *bufMgr, GMM_CLIENT_CONTEXT *gmmClientContex
 
 AuxTableMgr::~AuxTableMgr()
 {
+    // Deferred unmaps hold bo references and resource info copies
+    m_updater.RetireUnmaps(true);
+
     if (m_gmmPageTableMgr != nullptr)
     {
         m_gmmClientContext->DestroyPageTblMgrObject((GMM_PAGETABLE_MGR *)m_gmmPageTableMgr);
@@ -179,31 +182,40 @@ MOS_STATUS  AuxTableMgr::MapResource(GMM_RESOURCE_INFO *gmmResInfo, MOS_LINUX_BO
         return MOS_STATUS_NULL_POINTER;
     }
 
-    GMM_RESOURCE_FLAG flags = gmmResInfo->GetResFlags(); 
-    if ((flags.Info.MediaCompressed || flags.Info.RenderCompressed) && 
-        (flags.Gpu.MMC && flags.Gpu.CCS)                            &&
-        (bo->aux_mapped == false))
+    AuxTableResource res = {gmmResInfo, bo};
+    return m_updater.MapResources(&res, 1);
+}
+
+MOS_STATUS  AuxTableMgr::MapResources(const ALLOCATION_LIST *allocationList, uint32_t count)
+{
+    if (allocationList == nullptr && count > 0)
     {
-        int ret = 0;
+        return MOS_STATUS_NULL_POINTER;
+    }
 
-        ret = mos_bo_set_softpin(bo);
-        if (ret != 0)
+    // Mapped in chunks, without allocating on every submission
+    const uint32_t   chunkSize = 64;
+    AuxTableResource resources[chunkSize];
+    uint32_t         i = 0;
+    while (i < count)
+    {
+        uint32_t num = 0;
+        for (; i < count && num < chunkSize; i++)
         {
-            MOS_OS_ASSERTMESSAGE("Aux mapping failed: softpin failed");
-            return MOS_STATUS_UNKNOWN;
+            auto osResource = (PMOS_RESOURCE)allocationList[i].hAllocation;
+            if (osResource == nullptr || osResource->pGmmResInfo == nullptr || osResource->bo == nullptr)
+            {
+                return MOS_STATUS_NULL_POINTER;
+            }
+            resources[num++] = {osResource->pGmmResInfo, osResource->bo};
         }
 
-        GMM_DDI_UPDATEAUXTABLE  updateReq = {};
-
-        updateReq.BaseResInfo = gmmResInfo;
-        updateReq.BaseGpuVA = bo->offset64;
-        updateReq.Map = 1;
-        if (GMM_SUCCESS != ((GMM_PAGETABLE_MGR *)m_gmmPageTableMgr)->UpdateAuxTable(&updateReq))
+        MOS_STATUS status = m_updater.MapResources(resources, num);
+        if (status != MOS_STATUS_SUCCESS)
         {
-            MOS_OS_ASSERTMESSAGE("update AuxTable failed");
-            return MOS_STATUS_UNKNOWN;
+            MOS_OS_ASSERTMESSAGE("Aux mapping failed");
+            return status;
         }
-        bo->aux_mapped = true;
     }
     return MOS_STATUS_SUCCESS;
 }
@@ -212,46 +224,126 @@ MOS_STATUS  AuxTableMgr::UnmapResource(GMM_RESOURCE_INFO *gmmResInfo, MOS_LINUX_
 {
     if (gmmResInfo && bo && bo->aux_mapped)
     {
-        GMM_DDI_UPDATEAUXTABLE  updateReq = {};
-
         MOS_OS_ASSERT(gmmResInfo->GetResFlags().Info.MediaCompressed ||
                 gmmResInfo->GetResFlags().Info.RenderCompressed);
 
-        updateReq.BaseResInfo   = gmmResInfo;
-        updateReq.BaseGpuVA     = bo->offset64;
-        updateReq.Map           = 0;
-        ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->UpdateAuxTable(&updateReq);
-        bo->aux_mapped = false;
+        AuxTableResource res = {gmmResInfo, bo};
+        m_updater.UnmapResource(res);
     }
     return MOS_STATUS_SUCCESS;
 }
 
 MOS_STATUS  AuxTableMgr::EmitAuxTableBOList(MOS_LINUX_BO *cmd_bo)
 {
-    // Retrieve aux table bo list from GMM and emit it to exec buffer bo list
-    int boCnt = ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->GetNumOfPageTableBOs(AUXTT);
-    if (boCnt <= 0) {
-        return MOS_STATUS_SUCCESS;
-    }
+    MOS_OS_CHK_NULL_RETURN(cmd_bo);
 
-    mos_linux_bo **boList = (MOS_LINUX_BO **)MOS_AllocAndZeroMemory(boCnt * sizeof(mos_linux_bo*));
-    if (boList == nullptr)
-        return MOS_STATUS_NO_SPACE;
-
-    ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->GetPageTableBOList(AUXTT, boList);
-    for (int i=0; i<boCnt; i++)
-    {
-        int ret = mos_bo_add_softpin_target(cmd_bo, boList[i], false);
+    // Emit the cached aux table bo list to exec buffer bo list
+    return m_updater.EmitTableBOs([cmd_bo](void *bo) {
+        int ret = mos_bo_add_softpin_target(cmd_bo, (MOS_LINUX_BO *)bo, false);
         if (ret != 0)
         {
             MOS_OS_ASSERTMESSAGE("Error patching alloc_bo = 0x%x, cmd_bo = 0x%x.",
-                (uintptr_t)boList[i],
+                (uintptr_t)bo,
                 (uintptr_t)cmd_bo);
             return MOS_STATUS_UNKNOWN;
         }
+        return MOS_STATUS_SUCCESS;
+    });
+}
+
+bool AuxTableMgr::NeedsMap(const AuxTableResource &res)
+{
+    GMM_RESOURCE_FLAG flags = ((GMM_RESOURCE_INFO *)res.resInfo)->GetResFlags();
+    return (flags.Info.MediaCompressed || flags.Info.RenderCompressed) &&
+           (flags.Gpu.MMC && flags.Gpu.CCS)                            &&
+           (((MOS_LINUX_BO *)res.bo)->aux_mapped == false);
+}
+
+bool AuxTableMgr::IsMapped(const AuxTableResource &res)
+{
+    return ((MOS_LINUX_BO *)res.bo)->aux_mapped;
+}
+
+MOS_STATUS AuxTableMgr::Map(const AuxTableResource &res)
+{
+    MOS_OS_CHK_NULL_RETURN(m_gmmPageTableMgr);
+    MOS_LINUX_BO *bo = (MOS_LINUX_BO *)res.bo;
+
+    int ret = mos_bo_set_softpin(bo);
+    if (ret != 0)
+    {
+        MOS_OS_ASSERTMESSAGE("Aux mapping failed: softpin failed");
+        return MOS_STATUS_UNKNOWN;
+    }
+
+    GMM_DDI_UPDATEAUXTABLE  updateReq = {};
+
+    updateReq.BaseResInfo = (GMM_RESOURCE_INFO *)res.resInfo;
+    updateReq.BaseGpuVA = bo->offset64;
+    updateReq.Map = 1;
+    if (GMM_SUCCESS != ((GMM_PAGETABLE_MGR *)m_gmmPageTableMgr)->UpdateAuxTable(&updateReq))
+    {
+        MOS_OS_ASSERTMESSAGE("update AuxTable failed");
+        return MOS_STATUS_UNKNOWN;
+    }
+    bo->aux_mapped = true;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS AuxTableMgr::Unmap(const AuxTableResource &res)
+{
+    MOS_OS_CHK_NULL_RETURN(m_gmmPageTableMgr);
+    MOS_LINUX_BO *bo = (MOS_LINUX_BO *)res.bo;
+
+    GMM_DDI_UPDATEAUXTABLE  updateReq = {};
+
+    updateReq.BaseResInfo   = (GMM_RESOURCE_INFO *)res.resInfo;
+    updateReq.BaseGpuVA     = bo->offset64;
+    updateReq.Map           = 0;
+    ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->UpdateAuxTable(&updateReq);
+    bo->aux_mapped = false;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS AuxTableMgr::Hold(const AuxTableResource &res, AuxTableResource &held)
+{
+    MOS_OS_CHK_NULL_RETURN(m_gmmClientContext);
+
+    // The owner destroys its resource info right after, the bo reference keeps the GPU VA
+    GMM_RESOURCE_INFO *resInfo = m_gmmClientContext->CopyResInfoObject((GMM_RESOURCE_INFO *)res.resInfo);
+    MOS_OS_CHK_NULL_RETURN(resInfo);
+
+    mos_bo_reference((MOS_LINUX_BO *)res.bo);
+    held.resInfo = resInfo;
+    held.bo      = res.bo;
+    held.size    = ((MOS_LINUX_BO *)res.bo)->size;
+    return MOS_STATUS_SUCCESS;
+}
+
+void AuxTableMgr::Release(const AuxTableResource &held)
+{
+    m_gmmClientContext->DestroyResInfoObject((GMM_RESOURCE_INFO *)held.resInfo);
+    mos_bo_unreference((MOS_LINUX_BO *)held.bo);
+}
+
+bool AuxTableMgr::IsIdle(const AuxTableResource &res)
+{
+    return !mos_bo_busy((MOS_LINUX_BO *)res.bo);
+}
+
+MOS_STATUS AuxTableMgr::GetTableBOs(std::vector<void *> &bos)
+{
+    MOS_OS_CHK_NULL_RETURN(m_gmmPageTableMgr);
+
+    // Retrieve aux table bo list from GMM
+    int boCnt = ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->GetNumOfPageTableBOs(AUXTT);
+    if (boCnt <= 0) {
+        bos.clear();
+        return MOS_STATUS_SUCCESS;
     }
-    MOS_FreeMemory(boList);
 
+    bos.assign(boCnt, nullptr);
+    ((GMM_PAGETABLE_MGR*)m_gmmPageTableMgr)->GetPageTableBOList(AUXTT, bos.data());
     return MOS_STATUS_SUCCESS;
 }
 
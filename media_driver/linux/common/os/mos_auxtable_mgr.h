@@ -32,12 +32,17 @@
 #include "i915_drm.h"
 #include "mos_bufmgr.h"
 #include "mos_os.h"
+#include "mos_auxtable_updater.h"
 
 //!
 //! \class  AuxTableMgr
 //! \brief  Aux Table Manager
+//! \details Updates the GMM aux table through an AuxTableUpdater: the
+//!          resources of a submission are mapped together, unmaps wait until
+//!          the GPU is done with the buffer object and the aux table BO list
+//!          is only queried again after the table changed.
 //!
-class AuxTableMgr
+class AuxTableMgr : public AuxTableBackend
 {
 public:
     //!
@@ -76,9 +81,24 @@ public:
     //!
     MOS_STATUS  MapResource(GMM_RESOURCE_INFO *gmmResInfo, MOS_LINUX_BO *bo);
 
+    //!
+    //! \brief    Map the resources of a submission to aux table
+    //! \details  Unmaps of resources the GPU is done with are retired first, then
+    //!           the compressed resources not mapped yet are mapped.
+    //! \param    [in] allocationList
+    //!           Allocation list of the submission, of PMOS_RESOURCE
+    //! \param    [in] count
+    //!           Number of allocations
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS  MapResources(const ALLOCATION_LIST *allocationList, uint32_t count);
+
     //!
     //! \brief    Unmap resource from aux table
     //! \details  Unmap resource from aux table if it was mapped and unmark it in bo.
+    //!           The unmap is deferred until the GPU is done with the bo, which is
+    //!           referenced meanwhile along with a copy of the resource info.
     //! \param    [in] gmmResInfo
     //!           GMM_RESOURCE_INFO pointer
     //! \param    [in] bo
@@ -91,7 +111,8 @@ public:
     //!
     //! \brief    Insert aux table BOs into specific execute buffer
     //! \details  Retrieve all BOs allocated for aux table and attach them to execute buffer 
-    //!           so that they are pinned before h/w access it.
+    //!           so that they are pinned before h/w access it. The list is cached until
+    //!           the table changes.
     //! \param    [out] cmd_bo
     //!           execute buffer bo to be attached
     //! \return   MOS_STATUS
@@ -107,9 +128,21 @@ public:
     //!
     uint64_t    GetAuxTableBase();
 
+protected:
+    // AuxTableBackend on the GMM page table manager, AuxTableResource holds GMM_RESOURCE_INFO and MOS_LINUX_BO
+    bool        NeedsMap(const AuxTableResource &res) override;
+    bool        IsMapped(const AuxTableResource &res) override;
+    MOS_STATUS  Map(const AuxTableResource &res) override;
+    MOS_STATUS  Unmap(const AuxTableResource &res) override;
+    MOS_STATUS  Hold(const AuxTableResource &res, AuxTableResource &held) override;
+    void        Release(const AuxTableResource &held) override;
+    bool        IsIdle(const AuxTableResource &res) override;
+    MOS_STATUS  GetTableBOs(std::vector<void *> &bos) override;
+
 private:
     GMM_CLIENT_CONTEXT *m_gmmClientContext = nullptr;     //!<  GMM Client Context for GMM Page table manager
     void *m_gmmPageTableMgr = nullptr;                    //!<  The GMM Page Table Manager
+    AuxTableUpdater m_updater;                            //!<  Batches and defers the page table updates
 };
 
 #endif //MOS_AUXTABLE_MGR_H
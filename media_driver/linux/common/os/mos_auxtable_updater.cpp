@@ -0,0 +1,201 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file    mos_auxtable_updater.cpp
+//! \brief   Batches and defers the aux table updates of compressed resources
+//!
+
+#include <iterator>
+#include "mos_auxtable_updater.h"
+
+MOS_STATUS AuxTableUpdater::MapResources(const AuxTableResource *resources, uint32_t count)
+{
+    if (m_backend == nullptr || (resources == nullptr && count > 0))
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    // A resource used again keeps its mapping, it was not freed after all
+    if (!m_deferredByBo.empty())
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto pending = m_deferredByBo.find(resources[i].bo);
+            if (pending != m_deferredByBo.end())
+            {
+                DropDeferred(pending->second);
+            }
+        }
+        MOS_STATUS status = RetireUnmapsLocked(false);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const AuxTableResource &res = resources[i];
+        if (res.resInfo == nullptr || res.bo == nullptr)
+        {
+            return MOS_STATUS_NULL_POINTER;
+        }
+
+        // Mapping marks the resource, its duplicates are skipped
+        if (m_backend->NeedsMap(res))
+        {
+            MOS_STATUS status = m_backend->Map(res);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                return status;
+            }
+            m_tableChanged = true;
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS AuxTableUpdater::UnmapResource(const AuxTableResource &res)
+{
+    if (m_backend == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+    if (res.resInfo == nullptr || res.bo == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (!m_backend->IsMapped(res) || m_deferredByBo.find(res.bo) != m_deferredByBo.end())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    AuxTableResource held = {};
+    if (m_maxDeferredUnmaps == 0 || m_backend->Hold(res, held) != MOS_STATUS_SUCCESS)
+    {
+        m_tableChanged = true;
+        return m_backend->Unmap(res);
+    }
+
+    m_deferred.push_back(held);
+    m_deferredByBo[held.bo] = std::prev(m_deferred.end());
+    m_deferredBytes += held.size;
+
+    // Without this an app which stops submitting would keep its freed surfaces allocated
+    MOS_STATUS status = RetireUnmapsLocked(false);
+
+    // Still too many: the oldest ones are unmapped at once, which waits for the table
+    while (!m_deferred.empty() &&
+           (m_deferred.size() > m_maxDeferredUnmaps || m_deferredBytes > m_maxDeferredBytes))
+    {
+        MOS_STATUS unmapStatus = UnmapDeferred(m_deferred.begin());
+        status = (status == MOS_STATUS_SUCCESS) ? unmapStatus : status;
+    }
+
+    return status;
+}
+
+MOS_STATUS AuxTableUpdater::RetireUnmaps(bool wait)
+{
+    if (m_backend == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    return RetireUnmapsLocked(wait);
+}
+
+MOS_STATUS AuxTableUpdater::RetireUnmapsLocked(bool wait)
+{
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+
+    for (auto it = m_deferred.begin(); it != m_deferred.end();)
+    {
+        auto next = std::next(it);
+        if (wait || m_backend->IsIdle(*it))
+        {
+            MOS_STATUS unmapStatus = UnmapDeferred(it);
+            status = (status == MOS_STATUS_SUCCESS) ? unmapStatus : status;
+        }
+        it = next;
+    }
+
+    return status;
+}
+
+MOS_STATUS AuxTableUpdater::UnmapDeferred(DeferredList::iterator it)
+{
+    // The resource is released even if the unmap failed, nobody else would
+    MOS_STATUS status = m_backend->Unmap(*it);
+    m_tableChanged    = true;
+
+    DropDeferred(it);
+    return status;
+}
+
+void AuxTableUpdater::DropDeferred(DeferredList::iterator it)
+{
+    m_deferredBytes -= it->size;
+    m_backend->Release(*it);
+    m_deferredByBo.erase(it->bo);
+    m_deferred.erase(it);
+}
+
+MOS_STATUS AuxTableUpdater::EmitTableBOs(const std::function<MOS_STATUS(void *bo)> &emit)
+{
+    if (m_backend == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_tableChanged)
+    {
+        m_tableBOs.clear();
+        MOS_STATUS status = m_backend->GetTableBOs(m_tableBOs);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            m_tableBOs.clear();
+            return status;
+        }
+        m_tableChanged = false;
+    }
+
+    for (void *bo : m_tableBOs)
+    {
+        MOS_STATUS status = emit(bo);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
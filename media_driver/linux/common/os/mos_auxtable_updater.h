@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file    mos_auxtable_updater.h
+//! \brief   Batches and defers the aux table updates of compressed resources
+//!
+
+#ifndef MOS_AUXTABLE_UPDATER_H
+#define MOS_AUXTABLE_UPDATER_H
+
+#include <stdint.h>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "mos_defs.h"
+
+//!
+//! \brief  A resource of the aux table, the updater does not look into it
+//!
+struct AuxTableResource
+{
+    void     *resInfo;  //!< GMM resource info
+    void     *bo;       //!< buffer object, identifies the resource
+    uint64_t  size;     //!< bytes kept allocated while held, set by Hold
+};
+
+//!
+//! \class  AuxTableBackend
+//! \brief  Page table manager updating the aux table, one resource at a time
+//!
+class AuxTableBackend
+{
+public:
+    virtual ~AuxTableBackend() {}
+
+    //!
+    //! \brief  Whether the resource is compressed and not mapped yet
+    //!
+    virtual bool NeedsMap(const AuxTableResource &res) = 0;
+
+    //!
+    //! \brief  Whether the resource is mapped
+    //!
+    virtual bool IsMapped(const AuxTableResource &res) = 0;
+
+    //!
+    //! \brief  Map the resource into the aux table
+    //!
+    virtual MOS_STATUS Map(const AuxTableResource &res) = 0;
+
+    //!
+    //! \brief  Unmap the resource from the aux table
+    //!
+    virtual MOS_STATUS Unmap(const AuxTableResource &res) = 0;
+
+    //!
+    //! \brief  Keep what the unmap needs once the owner of the resource freed it
+    //! \param  [in] res
+    //!         Resource being freed
+    //! \param  [out] held
+    //!         Resource kept until Release, its address range stays allocated;
+    //!         its size is what stays allocated meanwhile
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS Hold(const AuxTableResource &res, AuxTableResource &held) = 0;
+
+    //!
+    //! \brief  Drop a resource kept by Hold
+    //!
+    virtual void Release(const AuxTableResource &held) = 0;
+
+    //!
+    //! \brief  Whether the GPU is done with the resource
+    //!
+    virtual bool IsIdle(const AuxTableResource &res) = 0;
+
+    //!
+    //! \brief  Get the buffer objects of the aux table
+    //!
+    virtual MOS_STATUS GetTableBOs(std::vector<void *> &bos) = 0;
+};
+
+//!
+//! \class  AuxTableUpdater
+//! \brief  Updates the aux table for a set of resources at a time.
+//!
+//! \detail The resources of a submission are mapped in one pass. Unmaps are
+//!         deferred until the GPU is done with the resource, which is kept
+//!         alive meanwhile so its address cannot be reused; a resource mapped
+//!         again before then only drops its pending unmap. The pending unmaps
+//!         are retired on each submission and each free, and are bounded by
+//!         count and by the bytes they keep allocated. The buffer objects
+//!         of the aux table are only queried again after the table changed.
+//!
+class AuxTableUpdater
+{
+public:
+    //!
+    //! \brief  Constructor
+    //! \param  [in] backend
+    //!         Page table manager doing the updates
+    //! \param  [in] maxDeferredUnmaps
+    //!         Unmaps kept pending at most, 0 to unmap at once
+    //! \param  [in] maxDeferredBytes
+    //!         Bytes the pending unmaps keep allocated at most
+    //!
+    AuxTableUpdater(
+        AuxTableBackend *backend,
+        uint32_t         maxDeferredUnmaps = m_defaultMaxDeferredUnmaps,
+        uint64_t         maxDeferredBytes  = m_defaultMaxDeferredBytes)
+        : m_backend(backend), m_maxDeferredUnmaps(maxDeferredUnmaps), m_maxDeferredBytes(maxDeferredBytes)
+    {
+    }
+
+    //!
+    //! \brief  Map the resources of a submission, after retiring the unmaps the GPU is done with
+    //! \param  [in] resources
+    //!         Resources of the submission, each one may show up more than once
+    //! \param  [in] count
+    //!         Number of resources
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS MapResources(const AuxTableResource *resources, uint32_t count);
+
+    //!
+    //! \brief  Unmap a resource being freed once the GPU is done with it, retiring the idle pending ones
+    //! \param  [in] res
+    //!         Resource being freed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS UnmapResource(const AuxTableResource &res);
+
+    //!
+    //! \brief  Unmap the resources pending the GPU
+    //! \param  [in] wait
+    //!         Unmap them all, else only the ones the GPU is done with
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS RetireUnmaps(bool wait);
+
+    //!
+    //! \brief  Emit the buffer objects of the aux table, queried again only after the table changed
+    //! \param  [in] emit
+    //!         Called on each buffer object
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else the first failure of emit
+    //!
+    MOS_STATUS EmitTableBOs(const std::function<MOS_STATUS(void *bo)> &emit);
+
+    uint32_t GetDeferredUnmapNum()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return (uint32_t)m_deferred.size();
+    }
+
+    uint64_t GetDeferredUnmapBytes()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_deferredBytes;
+    }
+
+    static const uint32_t m_defaultMaxDeferredUnmaps = 64;
+    static const uint64_t m_defaultMaxDeferredBytes  = 256 * 1024 * 1024;
+
+protected:
+    using DeferredList = std::list<AuxTableResource>;
+
+    MOS_STATUS RetireUnmapsLocked(bool wait);
+
+    MOS_STATUS UnmapDeferred(DeferredList::iterator it);
+
+    //!
+    //! \brief  Release a pending unmap without unmapping
+    //!
+    void DropDeferred(DeferredList::iterator it);
+
+    AuxTableBackend                                    *m_backend           = nullptr;
+    uint32_t                                            m_maxDeferredUnmaps = 0;
+    uint64_t                                            m_maxDeferredBytes  = 0;
+    uint64_t                                            m_deferredBytes     = 0;    //!< bytes kept allocated by the pending unmaps
+    std::mutex                                          m_lock;
+    DeferredList                                        m_deferred;             //!< resources pending their unmap, oldest first
+    std::unordered_map<void *, DeferredList::iterator>  m_deferredByBo;
+    std::vector<void *>                                 m_tableBOs;             //!< buffer objects of the table when last queried
+    bool                                                m_tableChanged      = true;
+};
+
+#endif  // MOS_AUXTABLE_UPDATER_H
@@ -3000,6 +3000,16 @@ bool MosInterface::MosResourceIsNull(PMOS_RESOURCE   resource)
     );
 }
 
+bool MosInterface::MosResourceIsBusy(PMOS_RESOURCE   resource)
+{
+    if (nullptr == resource || nullptr == resource->bo)
+    {
+        return false;
+    }
+
+    return mos_bo_busy(resource->bo) != 0;
+}
+
 MOS_STATUS MosInterface::GetGmmResourceInfo(PMOS_RESOURCE resource)
 {
     return MOS_STATUS_SUCCESS;
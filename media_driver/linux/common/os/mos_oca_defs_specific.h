@@ -29,6 +29,10 @@
 
 #include "mos_oca_defs.h"
 #include <cstdint>
+#include <cstring>
+#include <atomic>
+
+#define OCA_RES_INFO_INDEX_SIZE 128     //!< Entries of the resource info index, a power of 2 at least twice OCA_MAX_RESOURCE_INFO_COUNT_MAX.
 
 typedef struct _MOS_OCA_BUFFER_CONFIG
 {
@@ -73,9 +77,125 @@ typedef struct _MOS_OCA_RESOURCE_INFO
     } flags;
 }MOS_OCA_RESOURCE_INFO, *PMOS_OCA_RESOURCE_INFO;
 
+//!
+//! \brief   Open addressed index of the resource info list by allocation handle.
+//!          An entry holds the list index + 1, 0 marks a free entry.
+//!
+class MosOcaResInfoIndex
+{
+public:
+    static_assert((OCA_RES_INFO_INDEX_SIZE & (OCA_RES_INFO_INDEX_SIZE - 1)) == 0, "Index size must be a power of 2");
+    static_assert(OCA_RES_INFO_INDEX_SIZE >= 2 * OCA_MAX_RESOURCE_INFO_COUNT_MAX && OCA_MAX_RESOURCE_INFO_COUNT_MAX < 255,
+        "Index too small for the resource info list");
+
+    void Reset()
+    {
+        memset(m_table, 0, sizeof(m_table));
+    }
+
+    //!
+    //! \brief  Find the resource info of the allocation.
+    //! \param  [in] list
+    //!         Resource info list the index is built for.
+    //! \param  [in] handle
+    //!         Allocation handle.
+    //! \param  [out] entry
+    //!         Index entry to insert the allocation at if not found, OCA_RES_INFO_INDEX_SIZE if the index is full.
+    //! \return int32_t
+    //!         Index in the list, -1 if not found.
+    //!
+    int32_t Find(const MOS_OCA_RESOURCE_INFO *list, uint64_t handle, uint32_t &entry) const
+    {
+        uint32_t hash = (uint32_t)(handle * 0x9E3779B97F4A7C15ull >> 32);
+        for (uint32_t probe = 0; probe < OCA_RES_INFO_INDEX_SIZE; ++probe)
+        {
+            entry = (hash + probe) & (OCA_RES_INFO_INDEX_SIZE - 1);
+            if (0 == m_table[entry])
+            {
+                return -1;
+            }
+            if (list[m_table[entry] - 1].allocationHandle == handle)
+            {
+                return m_table[entry] - 1;
+            }
+        }
+        entry = OCA_RES_INFO_INDEX_SIZE;
+        return -1;
+    }
+
+    //!
+    //! \brief  Record the list index of an allocation at the entry returned by Find.
+    //!
+    void Insert(uint32_t entry, uint32_t index)
+    {
+        if (entry < OCA_RES_INFO_INDEX_SIZE && index < OCA_MAX_RESOURCE_INFO_COUNT_MAX)
+        {
+            m_table[entry] = (uint8_t)(index + 1);
+        }
+    }
+
+    uint8_t m_table[OCA_RES_INFO_INDEX_SIZE] = {};
+};
+
+//!
+//! \brief   Bitmap of the oca buffer contexts in use, slots are taken and
+//!          given back with atomic operations only.
+//!
+class MosOcaBufSlots
+{
+public:
+    static_assert(MAX_NUM_OF_OCA_BUF_CONTEXT <= 32, "Oca buffer contexts do not fit the bitmap");
+
+    //!
+    //! \brief  Take the first free slot, starting the search at the given one.
+    //! \return int32_t
+    //!         The slot taken, -1 if all of them are in use.
+    //!
+    int32_t Acquire(uint32_t first)
+    {
+        uint32_t bits = m_bits.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < MAX_NUM_OF_OCA_BUF_CONTEXT; ++i)
+        {
+            uint32_t slot = (first + i) % MAX_NUM_OF_OCA_BUF_CONTEXT;
+            uint32_t mask = 1u << slot;
+            // A failed exchange reloads the bits, so a slot taken meanwhile is skipped
+            while (0 == (bits & mask))
+            {
+                if (m_bits.compare_exchange_weak(bits, bits | mask, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return (int32_t)slot;
+                }
+            }
+        }
+        return -1;
+    }
+
+    //!
+    //! \brief  Give the slot back.
+    //! \return bool
+    //!         true if the slot was in use.
+    //!
+    bool Release(uint32_t slot)
+    {
+        if (slot >= MAX_NUM_OF_OCA_BUF_CONTEXT)
+        {
+            return false;
+        }
+        uint32_t mask = 1u << slot;
+        return 0 != (m_bits.fetch_and(~mask, std::memory_order_release) & mask);
+    }
+
+    bool IsInUse(uint32_t slot) const
+    {
+        return slot < MAX_NUM_OF_OCA_BUF_CONTEXT && 0 != (m_bits.load(std::memory_order_relaxed) & (1u << slot));
+    }
+
+private:
+    std::atomic<uint32_t> m_bits{0};
+};
+
 struct MOS_OCA_BUF_CONTEXT
 {
-    bool                                inUse                 = false;
     bool                                is1stLevelBBStarted   = false;
     struct
     {
@@ -86,6 +206,7 @@ struct MOS_OCA_BUF_CONTEXT
             MOS_OCA_RESOURCE_INFO       *resInfoList          = nullptr;
             uint32_t                    resCount              = 0;
             uint32_t                    resCountSkipped       = 0;
+            MosOcaResInfoIndex          index;                          //!< resInfoList by allocation handle.
         } resInfo;   
     } logSection;
            
@@ -307,8 +307,9 @@ private:
     bool                            m_isInitialized                                 = false;
     MOS_OCA_RESOURCE_INFO           *m_resInfoPool                                  = nullptr;  
     MOS_OCA_BUF_CONTEXT             m_ocaBufContextList[MAX_NUM_OF_OCA_BUF_CONTEXT] = {};
+    MosOcaBufSlots                  m_ocaBufSlots;                                  //!< Oca buffer contexts in use.
     MOS_OCA_BUFFER_CONFIG           m_config;
-    uint32_t                        m_indexOfNextOcaBufContext                      = 0;
+    std::atomic<uint32_t>           m_indexOfNextOcaBufContext{0};                  //!< Slot the next search for a free oca buffer context starts at.
     uint32_t                        m_ocaLogSectionSizeLimit                        = OCA_LOG_SECTION_SIZE_MAX;
 
     static MOS_STATUS               s_ocaStatus;                    //!< The status for first oca error encounterred.
@@ -81,31 +81,16 @@ int32_t MosOcaInterfaceSpecific::s_refCount               = 0;
 //!
 MOS_OCA_BUFFER_HANDLE MosOcaInterfaceSpecific::LockOcaBufAvailable(PMOS_CONTEXT pMosContext, uint32_t CurrentGpuContextHandle)
 {
-    for (int i = m_indexOfNextOcaBufContext; i < MAX_NUM_OF_OCA_BUF_CONTEXT; ++i)
+    int32_t i = m_ocaBufSlots.Acquire(m_indexOfNextOcaBufContext.load(std::memory_order_relaxed));
+    if (i < 0)
     {
-        if (m_ocaBufContextList[i].inUse)
-        {
-            continue;
-        }
-        m_ocaBufContextList[i].inUse = true;
-        m_ocaBufContextList[i].logSection.resInfo.maxResInfoCount = m_config.maxResInfoCount;
-        m_indexOfNextOcaBufContext = (i + 1) % MAX_NUM_OF_OCA_BUF_CONTEXT;
-        return i;
+        MosOcaInterfaceSpecific::OnOcaError(pMosContext, MOS_STATUS_INVALID_PARAMETER, __FUNCTION__, __LINE__);
+        return MOS_OCA_INVALID_BUFFER_HANDLE;
     }
 
-    for (int i = 0; i < m_indexOfNextOcaBufContext; ++i)
-    {
-        if (m_ocaBufContextList[i].inUse)
-        {
-            continue;
-        }
-        m_ocaBufContextList[i].inUse = true;
-        m_ocaBufContextList[i].logSection.resInfo.maxResInfoCount = m_config.maxResInfoCount;
-        m_indexOfNextOcaBufContext = (i + 1) % MAX_NUM_OF_OCA_BUF_CONTEXT;
-        return i;
-    }
-    MosOcaInterfaceSpecific::OnOcaError(pMosContext, MOS_STATUS_INVALID_PARAMETER, __FUNCTION__, __LINE__);
-    return MOS_OCA_INVALID_BUFFER_HANDLE;
+    m_ocaBufContextList[i].logSection.resInfo.maxResInfoCount = m_config.maxResInfoCount;
+    m_indexOfNextOcaBufContext.store((i + 1) % MAX_NUM_OF_OCA_BUF_CONTEXT, std::memory_order_relaxed);
+    return i;
 }
 
 //!
@@ -121,9 +106,9 @@ MOS_STATUS MosOcaInterfaceSpecific::UnlockOcaBuf(MOS_OCA_BUFFER_HANDLE ocaBufHan
     {
         return MOS_STATUS_INVALID_PARAMETER;
     }
-    m_ocaBufContextList[ocaBufHandle].inUse               = false;
     m_ocaBufContextList[ocaBufHandle].logSection.offset   = 0;
     m_ocaBufContextList[ocaBufHandle].logSection.base     = nullptr;
+    m_ocaBufSlots.Release(ocaBufHandle);
     return MOS_STATUS_SUCCESS;
 }
 
@@ -350,22 +335,25 @@ MOS_STATUS MosOcaInterfaceSpecific::AddResourceToDumpList(MOS_OCA_BUFFER_HANDLE
         return MOS_STATUS_INVALID_PARAMETER;
     }
 
-    for (i = 0; i < m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount; ++i)
+    // Resources are referenced by many commands, so they are looked up by handle
+    // instead of scanning all the resources dumped for the batch buffer
+    uint32_t entry = 0;
+    int32_t  found = m_ocaBufContextList[ocaBufHandle].logSection.resInfo.index.Find(
+        m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList, resource.bo->handle, entry);
+    if (found >= 0)
     {
-        if (m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].allocationHandle == resource.bo->handle)
+        if (offsetInRes > m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[found].offsetInRes)
         {
-            if (offsetInRes > m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].offsetInRes)
-            {
-                // Only update resource info for the largest offsetInRes case.
-                m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].hwCmdType     = (uint32_t)hwCmdType;
-                m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].offsetInRes   = offsetInRes;
-                m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].locationInCmd = locationInCmd;
-            }
-            return MOS_STATUS_SUCCESS;
+            // Only update resource info for the largest offsetInRes case.
+            m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[found].hwCmdType     = (uint32_t)hwCmdType;
+            m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[found].offsetInRes   = offsetInRes;
+            m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[found].locationInCmd = locationInCmd;
         }
+        return MOS_STATUS_SUCCESS;
     }
 
-    if (m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount >= m_ocaBufContextList[ocaBufHandle].logSection.resInfo.maxResInfoCount)
+    i = m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount;
+    if (i >= m_ocaBufContextList[ocaBufHandle].logSection.resInfo.maxResInfoCount)
     {
         // Not reture error but record the resource count skipped.
         ++m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCountSkipped;
@@ -410,6 +398,7 @@ MOS_STATUS MosOcaInterfaceSpecific::AddResourceToDumpList(MOS_OCA_BUFFER_HANDLE
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].flags.isCameraCapture    = resource.pGmmResInfo->GetResFlags().Gpu.CameraCapture;
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resInfoList[i].flags.isRenderTarget     = resource.pGmmResInfo->GetResFlags().Gpu.RenderTarget;
 
+    m_ocaBufContextList[ocaBufHandle].logSection.resInfo.index.Insert(entry, i);
     ++m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount;
 
     return MOS_STATUS_SUCCESS;
@@ -444,6 +433,7 @@ void MosOcaInterfaceSpecific::AddResourceInfoToLogSection(MOS_OCA_BUFFER_HANDLE
     }
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount        = 0;
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCountSkipped = 0;
+    m_ocaBufContextList[ocaBufHandle].logSection.resInfo.index.Reset();
     return;
 }
 
@@ -554,6 +544,7 @@ void MosOcaInterfaceSpecific::InitLogSection(MOS_OCA_BUFFER_HANDLE ocaBufHandle,
     m_ocaBufContextList[ocaBufHandle].logSection.offset                  = sizeof(uint64_t);
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCount        = 0;
     m_ocaBufContextList[ocaBufHandle].logSection.resInfo.resCountSkipped = 0;
+    m_ocaBufContextList[ocaBufHandle].logSection.resInfo.index.Reset();
 }
 
 bool MosOcaInterfaceSpecific::IsLogSectionEnabled(MOS_OCA_BUFFER_HANDLE ocaBufHandle)
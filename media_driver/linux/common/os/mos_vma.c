@@ -26,11 +26,228 @@
 
 #include "mos_vma.h"
 
+static uint32_t
+mos_vma_heap_next_priority(mos_vma_heap *heap)
+{
+    /* xorshift32, the treap only needs the priorities to be well spread */
+    uint32_t x = heap->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    heap->seed = x;
+    return x;
+}
+
+static void
+mos_vma_hole_update(mos_vma_hole *hole)
+{
+    uint64_t max_size = hole->size;
+
+    if (hole->left && hole->left->max_size > max_size)
+        max_size = hole->left->max_size;
+    if (hole->right && hole->right->max_size > max_size)
+        max_size = hole->right->max_size;
+
+    hole->max_size = max_size;
+}
+
+static mos_vma_hole *
+mos_vma_tree_insert(mos_vma_hole *root, mos_vma_hole *hole)
+{
+    if (root == NULL) {
+        hole->left = NULL;
+        hole->right = NULL;
+        mos_vma_hole_update(hole);
+        return hole;
+    }
+
+    if (hole->offset < root->offset) {
+        root->left = mos_vma_tree_insert(root->left, hole);
+        if (root->left->priority > root->priority) {
+            /* Rotate right */
+            mos_vma_hole *pivot = root->left;
+            root->left = pivot->right;
+            pivot->right = root;
+            mos_vma_hole_update(root);
+            mos_vma_hole_update(pivot);
+            return pivot;
+        }
+    } else {
+        root->right = mos_vma_tree_insert(root->right, hole);
+        if (root->right->priority > root->priority) {
+            /* Rotate left */
+            mos_vma_hole *pivot = root->right;
+            root->right = pivot->left;
+            pivot->left = root;
+            mos_vma_hole_update(root);
+            mos_vma_hole_update(pivot);
+            return pivot;
+        }
+    }
+
+    mos_vma_hole_update(root);
+    return root;
+}
+
+/* Join two treaps where every hole of low is below every hole of high. */
+static mos_vma_hole *
+mos_vma_tree_join(mos_vma_hole *low, mos_vma_hole *high)
+{
+    if (low == NULL)
+        return high;
+    if (high == NULL)
+        return low;
+
+    if (low->priority > high->priority) {
+        low->right = mos_vma_tree_join(low->right, high);
+        mos_vma_hole_update(low);
+        return low;
+    }
+
+    high->left = mos_vma_tree_join(low, high->left);
+    mos_vma_hole_update(high);
+    return high;
+}
+
+static mos_vma_hole *
+mos_vma_tree_remove(mos_vma_hole *root, mos_vma_hole *hole)
+{
+    assert(root);
+
+    if (root == hole)
+        return mos_vma_tree_join(hole->left, hole->right);
+
+    if (hole->offset < root->offset)
+        root->left = mos_vma_tree_remove(root->left, hole);
+    else
+        root->right = mos_vma_tree_remove(root->right, hole);
+
+    mos_vma_hole_update(root);
+    return root;
+}
+
+/* Update the subtree sizes above a hole whose size changed.  Its offset may
+ * have moved too, as long as it stayed between its neighbours.
+ */
+static void
+mos_vma_tree_refresh(mos_vma_hole *root, mos_vma_hole *hole)
+{
+    assert(root);
+
+    if (root != hole) {
+        mos_vma_tree_refresh(hole->offset < root->offset ? root->left : root->right, hole);
+    }
+    mos_vma_hole_update(root);
+}
+
+/* Find the highest hole starting at or below offset. */
+static mos_vma_hole *
+mos_vma_tree_floor(mos_vma_hole *root, uint64_t offset)
+{
+    mos_vma_hole *floor = NULL;
+
+    while (root) {
+        if (root->offset <= offset) {
+            floor = root;
+            root = root->right;
+        } else {
+            root = root->left;
+        }
+    }
+    return floor;
+}
+
+static bool
+mos_vma_hole_fit_high(const mos_vma_hole *hole, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (size > hole->size)
+        return false;
+
+    /* Compute the offset as the highest address where a chunk of the
+    * given size can be without going over the top of the hole.
+    *
+    * This calculation is known to not overflow because we know that
+    * hole->size + hole->offset can only overflow to 0 and size > 0.
+    */
+    uint64_t top = (hole->size - size) + hole->offset;
+
+    /* Align the offset.  We align down and not up because we are
+    * allocating from the top of the hole and not the bottom.
+    */
+    top = (top / alignment) * alignment;
+
+    if (top < hole->offset)
+        return false;
+
+    *offset = top;
+    return true;
+}
+
+static bool
+mos_vma_hole_fit_low(const mos_vma_hole *hole, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (size > hole->size)
+        return false;
+
+    uint64_t bottom = hole->offset;
+
+    /* Align the offset */
+    uint64_t misalign = bottom % alignment;
+    if (misalign) {
+        uint64_t pad = alignment - misalign;
+        if (pad > hole->size - size)
+            return false;
+
+        bottom += pad;
+    }
+
+    *offset = bottom;
+    return true;
+}
+
+/* Find the highest hole the allocation fits in, skipping every subtree
+ * without a hole large enough.
+ */
+static mos_vma_hole *
+mos_vma_tree_find_high(mos_vma_hole *root, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (root == NULL || root->max_size < size)
+        return NULL;
+
+    mos_vma_hole *hole = mos_vma_tree_find_high(root->right, size, alignment, offset);
+    if (hole)
+        return hole;
+
+    if (mos_vma_hole_fit_high(root, size, alignment, offset))
+        return root;
+
+    return mos_vma_tree_find_high(root->left, size, alignment, offset);
+}
+
+/* Find the lowest hole the allocation fits in. */
+static mos_vma_hole *
+mos_vma_tree_find_low(mos_vma_hole *root, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (root == NULL || root->max_size < size)
+        return NULL;
+
+    mos_vma_hole *hole = mos_vma_tree_find_low(root->left, size, alignment, offset);
+    if (hole)
+        return hole;
+
+    if (mos_vma_hole_fit_low(root, size, alignment, offset))
+        return root;
+
+    return mos_vma_tree_find_low(root->right, size, alignment, offset);
+}
+
 void
 mos_vma_heap_init(mos_vma_heap *heap, uint64_t start, uint64_t size)
 {
     assert(heap);
     list_inithead(&heap->holes);
+    heap->root = NULL;
+    heap->seed = 0x9e3779b9;
     mos_vma_heap_free(heap, start, size);
 
     /* Default to using high addresses */
@@ -45,14 +262,39 @@ mos_vma_heap_finish(mos_vma_heap *heap)
     {
         free(hole);
     }
+    list_inithead(&heap->holes);
+    heap->root = NULL;
+}
+
+/* Walking the whole heap makes every allocation O(n) again, so validation
+ * is only built in on request.
+ */
+#ifdef MOS_VMA_HEAP_VALIDATE
+static uint32_t
+mos_vma_tree_validate(mos_vma_hole *root, mos_vma_hole *low, mos_vma_hole *high)
+{
+    if (root == NULL)
+        return 0;
+
+    assert(low == NULL || low->offset < root->offset);
+    assert(high == NULL || root->offset < high->offset);
+    assert(root->left == NULL || root->left->priority <= root->priority);
+    assert(root->right == NULL || root->right->priority <= root->priority);
+
+    uint64_t max_size = root->max_size;
+    mos_vma_hole_update(root);
+    assert(max_size == root->max_size);
+
+    return 1 + mos_vma_tree_validate(root->left, low, root) +
+               mos_vma_tree_validate(root->right, root, high);
 }
 
-#ifdef _DEBUG
 static void
 mos_vma_heap_validate(mos_vma_heap *heap)
 {
     assert(heap);
     uint64_t prev_offset = 0;
+    uint32_t count = 0;
 
     list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
     {
@@ -78,21 +320,26 @@ mos_vma_heap_validate(mos_vma_heap *heap)
                     hole->size + hole->offset < prev_offset);
         }
         prev_offset = hole->offset;
+        count++;
    }
+
+   assert(count == mos_vma_tree_validate(heap->root, NULL, NULL));
 }
 #else
 #define mos_vma_heap_validate(heap)
 #endif
 
 static void
-mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
+mos_vma_hole_alloc(mos_vma_heap *heap, mos_vma_hole *hole, uint64_t offset, uint64_t size)
 {
+    assert(heap);
     assert(hole);
     assert(hole->offset <= offset);
     assert(hole->size >= offset - hole->offset + size);
 
     if (offset == hole->offset && size == hole->size) {
         /* Just get rid of the hole. */
+        heap->root = mos_vma_tree_remove(heap->root, hole);
         list_del(&hole->link);
         free(hole);
         return;
@@ -102,6 +349,7 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
     if (waste == 0) {
         /* We allocated at the top.  Shrink the hole down. */
         hole->size -= size;
+        mos_vma_tree_refresh(heap->root, hole);
         return;
     }
 
@@ -109,6 +357,7 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
         /* We allocated at the bottom. Shrink the hole up. */
         hole->offset += size;
         hole->size -= size;
+        mos_vma_tree_refresh(heap->root, hole);
         return;
     }
 
@@ -125,11 +374,14 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
 
     high_hole->offset = offset + size;
     high_hole->size = waste;
+    high_hole->priority = mos_vma_heap_next_priority(heap);
 
     /* Adjust the hole to be the amount of space left at he bottom of the
     * original hole.
     */
     hole->size = offset - hole->offset;
+    mos_vma_tree_refresh(heap->root, hole);
+    heap->root = mos_vma_tree_insert(heap->root, high_hole);
 
     /* Place the new hole before the old hole so that the list is in order
     * from high to low.
@@ -147,57 +399,19 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
 
     mos_vma_heap_validate(heap);
 
-    if (heap->alloc_high) {
-        list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
-        {
-            if (size > hole->size)
-                continue;
-
-            /* Compute the offset as the highest address where a chunk of the
-            * given size can be without going over the top of the hole.
-            *
-            * This calculation is known to not overflow because we know that
-            * hole->size + hole->offset can only overflow to 0 and size > 0.
-            */
-            uint64_t offset = (hole->size - size) + hole->offset;
+    uint64_t offset = 0;
+    mos_vma_hole *hole = heap->alloc_high ?
+        mos_vma_tree_find_high(heap->root, size, alignment, &offset) :
+        mos_vma_tree_find_low(heap->root, size, alignment, &offset);
 
-            /* Align the offset.  We align down and not up because we are
-            * allocating from the top of the hole and not the bottom.
-            */
-            offset = (offset / alignment) * alignment;
-
-            if (offset < hole->offset)
-            continue;
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
-    } else {
-        list_for_each_entry_safe_rev(mos_vma_hole, hole, &heap->holes, link) {
-            if (size > hole->size)
-                continue;
-
-            uint64_t offset = hole->offset;
-
-            /* Align the offset */
-            uint64_t misalign = offset % alignment;
-            if (misalign) {
-                uint64_t pad = alignment - misalign;
-                if (pad > hole->size - size)
-                    continue;
-
-                offset += pad;
-            }
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
+    if (hole == NULL) {
+        /* Failed to allocate */
+        return 0;
     }
 
-    /* Failed to allocate */
-    return 0;
+    mos_vma_hole_alloc(heap, hole, offset, size);
+    mos_vma_heap_validate(heap);
+    return offset;
 }
 
 bool
@@ -217,26 +431,20 @@ mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     */
     assert(offset + size == 0 || offset + size > offset);
 
-    /* Find the hole if one exists. */
-    list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
-    {
-        if (hole->offset > offset)
-            continue;
-
-        /* Holes are ordered high-to-low so the first hole we find with
-        * hole->offset <= is our hole.  If it's not big enough to contain the
-        * requested range, then the allocation fails.
-        */
-        assert(hole->offset <= offset);
-        if (hole->size < offset - hole->offset + size)
-            return false;
+    /* The highest hole starting at or below offset is the only one which
+    * can contain the range.  If it's not big enough to contain the
+    * requested range, then the allocation fails.
+    */
+    mos_vma_hole *hole = mos_vma_tree_floor(heap->root, offset);
+    if (hole == NULL)
+        return false;
 
-        mos_vma_hole_alloc(hole, offset, size);
-        return true;
-    }
+    assert(hole->offset <= offset);
+    if (hole->size < offset - hole->offset + size)
+        return false;
 
-    /* We didn't find a suitable hole */
-    return false;
+    mos_vma_hole_alloc(heap, hole, offset, size);
+    return true;
 }
 
 void
@@ -258,15 +466,16 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
 
     mos_vma_heap_validate(heap);
 
-    /* Find immediately higher and lower holes if they exist. */
-    mos_vma_hole *high_hole = NULL, *low_hole = NULL;
-    list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
-    {
-        if (hole->offset <= offset) {
-            low_hole = hole;
-            break;
-        }
-        high_hole = hole;
+    /* Find immediately higher and lower holes if they exist.  The list is
+    * ordered high to low, so the higher hole precedes the lower one.
+    */
+    mos_vma_hole *high_hole = NULL;
+    mos_vma_hole *low_hole = mos_vma_tree_floor(heap->root, offset);
+    if (low_hole) {
+        if (low_hole->link.prev != &heap->holes)
+            high_hole = LIST_ENTRY(mos_vma_hole, low_hole->link.prev, link);
+    } else if (!list_is_empty(&heap->holes)) {
+        high_hole = list_last_entry(&heap->holes, mos_vma_hole, link);
     }
 
     if (high_hole)
@@ -285,15 +494,19 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     if (low_adjacent && high_adjacent) {
         /* Merge the two holes */
         low_hole->size += size + high_hole->size;
+        heap->root = mos_vma_tree_remove(heap->root, high_hole);
         list_del(&high_hole->link);
         free(high_hole);
+        mos_vma_tree_refresh(heap->root, low_hole);
     } else if (low_adjacent) {
         /* Merge into the low hole */
         low_hole->size += size;
+        mos_vma_tree_refresh(heap->root, low_hole);
     } else if (high_adjacent) {
         /* Merge into the high hole */
         high_hole->offset = offset;
         high_hole->size += size;
+        mos_vma_tree_refresh(heap->root, high_hole);
     } else {
         /* Neither hole is adjacent; make a new one */
         mos_vma_hole *hole = (mos_vma_hole*)calloc(1, sizeof(*hole));
@@ -302,6 +515,8 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
         {
             hole->offset = offset;
             hole->size = size;
+            hole->priority = mos_vma_heap_next_priority(heap);
+            heap->root = mos_vma_tree_insert(heap->root, hole);
 
             /* Add it after the high hole so we maintain high-to-low ordering */
             if (high_hole)
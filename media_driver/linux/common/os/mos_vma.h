@@ -37,9 +37,31 @@
 extern "C" {
 #endif
 
+typedef struct _mos_vma_hole {
+   struct list_head link;
+   uint64_t offset;
+   uint64_t size;
+
+   /** Treap of the holes ordered by offset, each node tracking the largest
+    * hole size in its subtree so allocations find a fitting hole in
+    * O(log n) instead of walking the list.
+    */
+   struct _mos_vma_hole *left;
+   struct _mos_vma_hole *right;
+   uint64_t max_size;
+   uint32_t priority;
+} mos_vma_hole;
+
 typedef struct _mos_vma_heap {
+   /** Holes ordered from high to low addresses */
    struct list_head holes;
 
+   /** Root of the hole treap */
+   mos_vma_hole *root;
+
+   /** State of the priority generator of the treap */
+   uint32_t seed;
+
    /** If true, util_vma_heap_alloc will prefer high addresses
     *
     * Default is true.
@@ -47,12 +69,6 @@ typedef struct _mos_vma_heap {
    bool alloc_high;
 } mos_vma_heap;
 
-typedef struct _mos_vma_hole {
-   struct list_head link;
-   uint64_t offset;
-   uint64_t size;
-} mos_vma_hole;
-
 //!
 //! \brief  Initialize vma heap
 //!
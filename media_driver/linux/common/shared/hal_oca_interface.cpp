@@ -96,13 +96,14 @@ void HalOcaInterface::On1stLevelBBStart(MOS_COMMAND_BUFFER &cmdBuffer, MOS_CONTE
     }
     else
     {
-        MosOcaAutoLock autoLock(mutex);
+        // Oca buffers are taken lock free, the mutex only protects the handle map
         ocaBufHandle = pOcaInterface->LockOcaBufAvailable(&mosContext, gpuContextHandle);
         if (MOS_OCA_INVALID_BUFFER_HANDLE == ocaBufHandle)
         {
             OnOcaError(&mosContext, MOS_STATUS_INVALID_HANDLE, __FUNCTION__, __LINE__);
             return;
         }
+        MosOcaAutoLock autoLock(mutex);
         auto success = s_hOcaMap.insert(std::make_pair(cmdBuffer.pCmdBase, ocaBufHandle));
         if (!success.second)
         {
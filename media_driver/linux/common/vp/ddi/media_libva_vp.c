@@ -38,6 +38,7 @@
 #include "media_libva_util.h"
 #include "hwinfo_linux.h"
 #include "mos_solo_generic.h"
+#include "media_libva_init_profiler.h"
 
 #include "media_libva_vp_tools.h"
 #if (_DEBUG || _RELEASE_INTERNAL)
@@ -1012,6 +1013,7 @@ DdiVp_SetProcPipelineParams(
 
     DDI_CHK_NULL(pMediaSrcSurf, "Null pMediaSrcSurf.", VA_STATUS_ERROR_INVALID_BUFFER);
     DDI_CHK_NULL(pOsInterface, "Null pOsInterface.", VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_RET(DdiMediaUtil_SyncUserPtrSurface(pMediaSrcSurf, true), "Failed to copy user memory to source surface.");
 
     // increment surface count
     pVpHalRenderParams->uSrcCount++;
@@ -3286,7 +3288,9 @@ VAStatus DdiVp_CreateContext (
     DDI_CHK_NULL(pVpCtx, "Null pVpCtx.", VA_STATUS_ERROR_ALLOCATION_FAILED);
 
     // init pVpCtx
+    MediaInitProfiler profiler(MEDIA_INIT_PHASE_VP_CONTEXT);
     vaStatus = DdiVp_InitCtx(pVaDrvCtx, pVpCtx);
+    profiler.Stop();
     DDI_CHK_RET(vaStatus, "VA_STATUS_ERROR_OPERATION_FAILED");
 
     DdiMediaUtil_LockMutex(&pMediaCtx->VpMutex);
@@ -3736,6 +3740,7 @@ VAStatus DdiVp_EndPicture (
     uint32_t                uiCtxType;
     VpBase                  *pVpHal;
     MOS_STATUS              eStatus;
+    PDDI_MEDIA_SURFACE      pMediaTgtSurf;
 
     VP_DDI_FUNCTION_ENTER;
     DDI_CHK_NULL(pVaDrvCtx,
@@ -3772,6 +3777,14 @@ VAStatus DdiVp_EndPicture (
         return VA_STATUS_ERROR_OPERATION_FAILED;
     }
 
+    // User memory which could not be pinned gets the output on the next sync
+    pMediaTgtSurf = DdiMedia_GetSurfaceFromVASurfaceID(DdiMedia_GetMediaContext(pVaDrvCtx),
+                                                       pVpCtx->pVpHalRenderParams->StatusFeedBackID);
+    if (pMediaTgtSurf && pMediaTgtSurf->bUserPtrCopy)
+    {
+        pMediaTgtSurf->bUserPtrGpuWritten = true;
+    }
+
     return VA_STATUS_SUCCESS;
 
 }
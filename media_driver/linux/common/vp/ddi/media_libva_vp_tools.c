@@ -665,6 +665,18 @@ void VpFeatureReport(
         pConfig->dwCurrentHdrMode,
         MediaUserSetting::Group::Sequence);
 
+    ReportUserSettingForDebug(
+        nullptr,
+        __VPHAL_COMP_BB_HITS,
+        pConfig->dwCompBbHits,
+        MediaUserSetting::Group::Sequence);
+
+    ReportUserSettingForDebug(
+        nullptr,
+        __VPHAL_COMP_BB_MISSES,
+        pConfig->dwCompBbMisses,
+        MediaUserSetting::Group::Sequence);
+
 #ifdef _MMC_SUPPORTED
     //VP MMC In Use
     WriteUserFeature(__VPHAL_ENABLE_MMC_IN_USE_ID,             pConfig->dwVPMMCInUse, (MOS_CONTEXT_HANDLE)nullptr);
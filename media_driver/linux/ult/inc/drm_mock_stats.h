@@ -0,0 +1,42 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __DRM_MOCK_STATS_H__
+#define __DRM_MOCK_STATS_H__
+
+#include <stdint.h>
+
+// What the driver asked of libdrm_mock since it was loaded
+struct DrmMockStats
+{
+    uint64_t execCount;       // batch buffer submissions
+    uint64_t batchBytes;      // bytes of the submitted batch buffers
+    uint64_t execObjects;     // buffers on the validation lists, batch buffers included
+    uint64_t relocs;          // relocations of the buffers on the validation lists
+    uint64_t softpinTargets;  // softpin targets of the buffers on the validation lists
+    uint64_t boAllocs;        // buffer objects allocated
+};
+
+#define DRM_MOCK_GET_STATS "DrmMock_GetStats"
+
+typedef void (*DrmMockGetStatsFunc)(struct DrmMockStats *stats);
+
+#endif // __DRM_MOCK_STATS_H__
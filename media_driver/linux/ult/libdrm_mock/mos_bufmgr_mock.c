@@ -64,6 +64,7 @@
 
 #include "i915_drm.h"
 #include "mos_vma.h"
+#include "drm_mock_stats.h"
 
 #ifdef HAVE_VALGRIND
 #include <valgrind.h>
@@ -217,6 +218,9 @@ struct mos_bo_gem {
     int softpin_target_count;
     /** Maximum amount of softpinned BOs that are referenced by this buffer */
     int softpin_target_size;
+    /** First relocation and softpin target of the next execution, libdrm_mock only */
+    int mock_exec_reloc_start;
+    int mock_exec_softpin_start;
 
     /** Mapped address for the buffer, saved across map/unmap cycles */
     void *mem_virtual;
@@ -338,6 +342,26 @@ static inline struct mos_bo_gem *to_bo_gem(struct mos_linux_bo *bo)
 {
         return (struct mos_bo_gem *)bo;
 }
+static pthread_mutex_t drm_mock_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct DrmMockStats drm_mock_stats;
+
+#ifdef __cplusplus
+extern "C"
+#endif
+drm_export void DrmMock_GetStats(struct DrmMockStats *stats)
+{
+    pthread_mutex_lock(&drm_mock_stats_lock);
+    *stats = drm_mock_stats;
+    pthread_mutex_unlock(&drm_mock_stats_lock);
+}
+
+static void drm_mock_count(uint64_t *counter)
+{
+    pthread_mutex_lock(&drm_mock_stats_lock);
+    (*counter)++;
+    pthread_mutex_unlock(&drm_mock_stats_lock);
+}
+
 static int GetDrmMode()
 {
     return 1;//We always use SW Mode in libdrm mock.
@@ -903,6 +927,7 @@ mos_gem_bo_alloc_internal(struct mos_bufmgr *bufmgr,
     }
     if(GetDrmMode())//libdrm_mock
     {
+        drm_mock_count(&drm_mock_stats.boAllocs);
         pthread_mutex_lock(&bufmgr_gem->lock);
 
         bo_gem = (struct mos_bo_gem *)calloc(1, sizeof(*bo_gem));
@@ -2289,6 +2314,7 @@ do_bo_emit_reloc(struct mos_linux_bo *bo, uint32_t offset,
     bo_gem->relocs[bo_gem->reloc_count].write_domain = write_domain;
     bo_gem->relocs[bo_gem->reloc_count].presumed_offset = target_bo->offset64;
     bo_gem->reloc_count++;
+    drm_mock_count(&drm_mock_stats.relocs);
 
     return 0;
 }
@@ -2361,6 +2387,7 @@ do_bo_emit_reloc2(struct mos_linux_bo *bo, uint32_t offset,
     bo_gem->relocs[bo_gem->reloc_count].write_domain = write_domain;
     bo_gem->relocs[bo_gem->reloc_count].presumed_offset = presumed_offset;
     bo_gem->reloc_count++;
+    drm_mock_count(&drm_mock_stats.relocs);
 
     return 0;
 }
@@ -2442,6 +2469,7 @@ mos_gem_bo_add_softpin_target(struct mos_linux_bo *bo, struct mos_linux_bo *targ
     bo_gem->softpin_target[bo_gem->softpin_target_count].flags = flags;
     mos_gem_bo_reference(target_bo);
     bo_gem->softpin_target_count++;
+    drm_mock_count(&drm_mock_stats.softpinTargets);
 
     return 0;
 }
@@ -2770,13 +2798,59 @@ mos_gem_bo_exec(struct mos_linux_bo *bo, int used,
     return ret;
 }
 
+static bool
+drm_mock_add_exec_object(struct mos_linux_bo **bos, int *count, struct mos_linux_bo *bo)
+{
+    for (int i = 0; i < *count; i++) {
+        if (bos[i] == bo)
+            return false;
+    }
+    bos[(*count)++] = bo;
+    return true;
+}
+
+/* Counts the buffers the execution would validate: the batch buffer and the
+ * targets it got since its last execution. The mock never clears relocations,
+ * and the targets of second level batch buffers are not followed.
+ */
+static void
+drm_mock_record_exec(struct mos_linux_bo *bo, int used)
+{
+    struct mos_bo_gem *bo_gem = to_bo_gem(bo);
+    int relocs = bo_gem->reloc_count - bo_gem->mock_exec_reloc_start;
+    int softpins = bo_gem->softpin_target_count - bo_gem->mock_exec_softpin_start;
+    struct mos_linux_bo **bos = (struct mos_linux_bo **)malloc((1 + relocs + softpins) * sizeof(*bos));
+    int count = 0;
+    int i;
+
+    if (bos) {
+        drm_mock_add_exec_object(bos, &count, bo);
+        for (i = bo_gem->mock_exec_reloc_start; i < bo_gem->reloc_count; i++)
+            drm_mock_add_exec_object(bos, &count, bo_gem->reloc_target_info[i].bo);
+        for (i = bo_gem->mock_exec_softpin_start; i < bo_gem->softpin_target_count; i++)
+            drm_mock_add_exec_object(bos, &count, bo_gem->softpin_target[i].bo);
+        free(bos);
+    }
+    bo_gem->mock_exec_reloc_start = bo_gem->reloc_count;
+    bo_gem->mock_exec_softpin_start = bo_gem->softpin_target_count;
+
+    pthread_mutex_lock(&drm_mock_stats_lock);
+    drm_mock_stats.execCount++;
+    drm_mock_stats.batchBytes += used;
+    drm_mock_stats.execObjects += count;
+    pthread_mutex_unlock(&drm_mock_stats_lock);
+}
+
 drm_export int
 do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
      drm_clip_rect_t *cliprects, int num_cliprects, int DR4,
      unsigned int flags, int *fence)
 {
     if(GetDrmMode())
+    {
+        drm_mock_record_exec(bo, used);
         return 0; //libdrm_mock
+    }
 
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bo->bufmgr;
     struct drm_i915_gem_execbuffer2 execbuf;
@@ -0,0 +1,414 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_auxtable_updater.h"
+
+using namespace std;
+
+// Page table manager keeping the mapped resources in a map, with one table
+// buffer object per 4 resources mapped at once, like the GMM pools growing
+class MockAuxTableBackend : public AuxTableBackend
+{
+public:
+    struct Resource
+    {
+        bool compressed = true;
+        bool mapped     = false;
+        bool     busy       = false;
+        int      holds      = 0;
+        uint64_t size       = 0x10000;
+    };
+
+    AuxTableResource Add(bool compressed = true)
+    {
+        m_resources.emplace_back(new Resource);
+        m_resources.back()->compressed = compressed;
+        return {&m_resInfoTag, m_resources.back().get()};
+    }
+
+    static Resource &Get(const AuxTableResource &res) { return *(Resource *)res.bo; }
+
+    bool NeedsMap(const AuxTableResource &res) override { return Get(res).compressed && !Get(res).mapped; }
+
+    bool IsMapped(const AuxTableResource &res) override { return Get(res).mapped; }
+
+    MOS_STATUS Map(const AuxTableResource &res) override
+    {
+        m_maps++;
+        m_table.insert(res.bo);
+        Get(res).mapped = true;
+        while (m_tableBOs.size() * 4 < m_table.size())
+        {
+            m_tableBOs.push_back((void *)(uintptr_t)(0x1000 + m_tableBOs.size()));
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS Unmap(const AuxTableResource &res) override
+    {
+        m_unmaps++;
+        m_busyUnmaps += Get(res).busy;
+        EXPECT_EQ(1u, m_table.erase(res.bo));
+        Get(res).mapped = false;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS Hold(const AuxTableResource &res, AuxTableResource &held) override
+    {
+        Get(res).holds++;
+        held = {&m_heldResInfoTag, res.bo, Get(res).size};
+        return MOS_STATUS_SUCCESS;
+    }
+
+    void Release(const AuxTableResource &held) override
+    {
+        EXPECT_EQ(&m_heldResInfoTag, held.resInfo);
+        Get(held).holds--;
+    }
+
+    bool IsIdle(const AuxTableResource &res) override { return !Get(res).busy; }
+
+    MOS_STATUS GetTableBOs(vector<void *> &bos) override
+    {
+        m_boListQueries++;
+        bos = m_tableBOs;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    int HoldCount() const
+    {
+        int holds = 0;
+        for (const auto &res : m_resources)
+        {
+            holds += res->holds;
+        }
+        return holds;
+    }
+
+    set<void *>                  m_table;
+    vector<void *>               m_tableBOs;
+    vector<unique_ptr<Resource>> m_resources;
+    uint32_t                     m_maps          = 0;
+    uint32_t                     m_unmaps        = 0;
+    uint32_t                     m_busyUnmaps    = 0;  // unmaps while the GPU may still use the resource
+    uint32_t                     m_boListQueries = 0;
+
+private:
+    int m_resInfoTag     = 0;
+    int m_heldResInfoTag = 0;
+};
+
+static vector<void *> EmitBOs(AuxTableUpdater &updater)
+{
+    vector<void *> bos;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, updater.EmitTableBOs([&](void *bo) {
+        bos.push_back(bo);
+        return MOS_STATUS_SUCCESS;
+    }));
+    return bos;
+}
+
+TEST(AuxTableUpdaterTest, MapsOnceAndCachesBOList)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend);
+
+    vector<AuxTableResource> resources = {backend.Add(), backend.Add(), backend.Add(false)};
+    resources.push_back(resources[0]);
+
+    for (int submit = 0; submit < 10; submit++)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(resources.data(), (uint32_t)resources.size()));
+        EXPECT_EQ(backend.m_tableBOs, EmitBOs(updater));
+    }
+    EXPECT_EQ(2u, backend.m_maps);
+    EXPECT_EQ(1u, backend.m_boListQueries);
+
+    // Mapping more resources grows the table
+    for (int i = 0; i < 8; i++)
+    {
+        resources.push_back(backend.Add());
+    }
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(resources.data(), (uint32_t)resources.size()));
+    EXPECT_EQ(backend.m_tableBOs, EmitBOs(updater));
+    EXPECT_EQ(3u, backend.m_tableBOs.size());
+    EXPECT_EQ(2u, backend.m_boListQueries);
+
+    AuxTableResource null = {nullptr, nullptr};
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, updater.MapResources(&null, 1));
+}
+
+TEST(AuxTableUpdaterTest, UnmapWaitsForTheGpu)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend);
+
+    AuxTableResource res   = backend.Add();
+    AuxTableResource other = backend.Add();
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(&res, 1));
+    EmitBOs(updater);
+
+    // Still in use: the unmap waits, the table does not change
+    MockAuxTableBackend::Get(res).busy = true;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+    EXPECT_EQ(1u, updater.GetDeferredUnmapNum());
+    EXPECT_EQ(1, backend.HoldCount());
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(&other, 1));
+    EXPECT_EQ(0u, backend.m_unmaps);
+    EXPECT_EQ(1u, backend.m_table.count(res.bo));
+
+    // Retired on the next submission once idle
+    MockAuxTableBackend::Get(res).busy = false;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(&other, 1));
+    EXPECT_EQ(1u, backend.m_unmaps);
+    EXPECT_EQ(0u, backend.m_busyUnmaps);
+    EXPECT_EQ(0u, backend.m_table.count(res.bo));
+    EXPECT_EQ(0, backend.HoldCount());
+    EXPECT_EQ(0u, updater.GetDeferredUnmapNum());
+
+    EXPECT_EQ(backend.m_tableBOs, EmitBOs(updater));
+    EXPECT_EQ(2u, backend.m_boListQueries);
+}
+
+TEST(AuxTableUpdaterTest, RemapCancelsPendingUnmap)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend);
+
+    AuxTableResource res = backend.Add();
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(&res, 1));
+
+    // Still in use when freed, else the free would unmap it at once
+    MockAuxTableBackend::Get(res).busy = true;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(&res, 1));
+
+    EXPECT_EQ(1u, backend.m_maps);
+    EXPECT_EQ(0u, backend.m_unmaps);
+    EXPECT_EQ(0, backend.HoldCount());
+    EXPECT_TRUE(MockAuxTableBackend::Get(res).mapped);
+}
+
+TEST(AuxTableUpdaterTest, DeferredUnmapLimit)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend, 4);
+
+    vector<AuxTableResource> resources;
+    for (int i = 0; i < 6; i++)
+    {
+        resources.push_back(backend.Add());
+        MockAuxTableBackend::Get(resources.back()).busy = true;
+    }
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(resources.data(), (uint32_t)resources.size()));
+
+    // Over the limit the oldest ones are unmapped at once
+    for (const auto &res : resources)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+    }
+    EXPECT_EQ(4u, updater.GetDeferredUnmapNum());
+    EXPECT_EQ(2u, backend.m_unmaps);
+    EXPECT_FALSE(MockAuxTableBackend::Get(resources[0]).mapped);
+    EXPECT_FALSE(MockAuxTableBackend::Get(resources[1]).mapped);
+    EXPECT_TRUE(MockAuxTableBackend::Get(resources[2]).mapped);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.RetireUnmaps(true));
+    EXPECT_TRUE(backend.m_table.empty());
+    EXPECT_EQ(0, backend.HoldCount());
+
+    // Without deferral the unmap is immediate
+    AuxTableUpdater immediate(&backend, 0);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, immediate.MapResources(&resources[0], 1));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, immediate.UnmapResource(resources[0]));
+    EXPECT_EQ(0u, immediate.GetDeferredUnmapNum());
+    EXPECT_TRUE(backend.m_table.empty());
+    EXPECT_EQ(0, backend.HoldCount());
+}
+
+TEST(AuxTableUpdaterTest, FreeRetiresIdleUnmaps)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend);
+
+    AuxTableResource first  = backend.Add();
+    AuxTableResource second = backend.Add();
+    AuxTableResource third  = backend.Add();
+    AuxTableResource resources[] = {first, second, third};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(resources, 3));
+    MockAuxTableBackend::Get(first).busy  = true;
+    MockAuxTableBackend::Get(second).busy = true;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(first));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(second));
+    EXPECT_EQ(2u, updater.GetDeferredUnmapNum());
+    EXPECT_EQ(2 * MockAuxTableBackend::Get(first).size, updater.GetDeferredUnmapBytes());
+
+    // No submission follows: the next free retires what the GPU is done with, itself included
+    MockAuxTableBackend::Get(first).busy = false;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(third));
+    EXPECT_EQ(1u, updater.GetDeferredUnmapNum());
+    EXPECT_EQ(MockAuxTableBackend::Get(second).size, updater.GetDeferredUnmapBytes());
+    EXPECT_EQ(2u, backend.m_unmaps);
+    EXPECT_EQ(0u, backend.m_busyUnmaps);
+    EXPECT_EQ(1, backend.HoldCount());
+}
+
+TEST(AuxTableUpdaterTest, DeferredUnmapByteLimit)
+{
+    MockAuxTableBackend backend;
+    AuxTableUpdater     updater(&backend, 64, 0x30000);
+
+    vector<AuxTableResource> resources;
+    for (int i = 0; i < 4; i++)
+    {
+        resources.push_back(backend.Add());
+        MockAuxTableBackend::Get(resources.back()).busy = true;
+    }
+    MockAuxTableBackend::Get(resources[3]).size = 0x20000;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(resources.data(), (uint32_t)resources.size()));
+
+    // Few unmaps but large ones: the oldest are unmapped until the bytes fit
+    for (const auto &res : resources)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+    }
+    EXPECT_EQ(2u, updater.GetDeferredUnmapNum());
+    EXPECT_EQ(0x30000u, updater.GetDeferredUnmapBytes());
+    EXPECT_FALSE(MockAuxTableBackend::Get(resources[1]).mapped);
+    EXPECT_TRUE(MockAuxTableBackend::Get(resources[2]).mapped);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, updater.RetireUnmaps(true));
+    EXPECT_EQ(0u, updater.GetDeferredUnmapBytes());
+    EXPECT_EQ(0, backend.HoldCount());
+}
+
+// Transcoding like churn: every frame allocates compressed surfaces, submits
+// them with long lived ones, and frees the oldest once they are a few frames
+// old; the GPU is done with a frame by the time the next one is submitted.
+// Returns the compressed resources still alive at the end
+static set<void *> RunSurfaceChurn(MockAuxTableBackend &backend, uint32_t frameNum)
+{
+    AuxTableUpdater          updater(&backend);
+    mt19937                  rng(1);
+    vector<AuxTableResource> longLived = {backend.Add(), backend.Add(), backend.Add(false)};
+    vector<AuxTableResource> inFlight;
+    vector<AuxTableResource> busy;
+    set<void *>              freed;
+
+    for (uint32_t frame = 0; frame < frameNum; frame++)
+    {
+        vector<AuxTableResource> submission = longLived;
+        for (uint32_t i = rng() % 4 + 1; i > 0; i--)
+        {
+            inFlight.push_back(backend.Add(rng() % 4 != 0));
+            submission.push_back(inFlight.back());
+        }
+        for (uint32_t i = rng() % 3; i > 0 && !inFlight.empty(); i--)
+        {
+            submission.push_back(inFlight[rng() % inFlight.size()]);
+        }
+
+        for (const auto &res : busy)
+        {
+            MockAuxTableBackend::Get(res).busy = false;
+        }
+        EXPECT_EQ(MOS_STATUS_SUCCESS, updater.MapResources(submission.data(), (uint32_t)submission.size()));
+        EXPECT_EQ(backend.m_tableBOs, EmitBOs(updater));
+        busy = submission;
+        for (const auto &res : busy)
+        {
+            MockAuxTableBackend::Get(res).busy = true;
+        }
+
+        while (inFlight.size() > 8)
+        {
+            AuxTableResource res = inFlight.front();
+            inFlight.erase(inFlight.begin());
+            EXPECT_EQ(MOS_STATUS_SUCCESS, updater.UnmapResource(res));
+            freed.insert(res.bo);
+        }
+
+        // Whatever happens to the freed resources, the live ones stay mapped
+        for (const auto &res : submission)
+        {
+            if (freed.count(res.bo) == 0)
+            {
+                EXPECT_EQ(MockAuxTableBackend::Get(res).compressed, backend.m_table.count(res.bo) == 1);
+            }
+        }
+    }
+
+    for (const auto &res : busy)
+    {
+        MockAuxTableBackend::Get(res).busy = false;
+    }
+    EXPECT_EQ(MOS_STATUS_SUCCESS, updater.RetireUnmaps(true));
+    set<void *> live;
+    for (const auto &res : longLived)
+    {
+        if (MockAuxTableBackend::Get(res).compressed)
+        {
+            live.insert(res.bo);
+        }
+    }
+    for (const auto &res : inFlight)
+    {
+        if (MockAuxTableBackend::Get(res).compressed)
+        {
+            live.insert(res.bo);
+        }
+    }
+    return live;
+}
+
+TEST(AuxTableUpdaterTest, SurfaceChurn)
+{
+    const uint32_t frameNum = 300;
+
+    MockAuxTableBackend backend;
+    set<void *>         live = RunSurfaceChurn(backend, frameNum);
+
+    EXPECT_EQ(live, backend.m_table);
+    EXPECT_EQ(0, backend.HoldCount());
+    EXPECT_EQ(0u, backend.m_busyUnmaps);
+    EXPECT_EQ(backend.m_maps, backend.m_unmaps + backend.m_table.size());
+    EXPECT_LE(backend.m_boListQueries, frameNum);
+}
+
+// Counts only, run with --gtest_also_run_disabled_tests
+TEST(AuxTableUpdaterTest, DISABLED_SurfaceChurnCounts)
+{
+    const uint32_t frameNum = 300;
+
+    MockAuxTableBackend backend;
+    RunSurfaceChurn(backend, frameNum);
+
+    // Unmapping at free would have waited for the GPU every time
+    printf("[ AUX TABLE ] %u frames: %u maps, %u unmaps, %u while in use, %u BO list queries\n",
+        frameNum, backend.m_maps, backend.m_unmaps, backend.m_busyUnmaps, backend.m_boListQueries);
+}
@@ -0,0 +1,264 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "bitstream_writer.h"
+#include "bitstream_writer_fast.h"
+
+using namespace std;
+
+// Room for the bytes BitstreamWriter writes ahead of its position
+static const uint32_t writerSlack = 8;
+
+static vector<mfxU8> Bytes(const vector<mfxU8> &buf, uint32_t bitOffset, uint32_t bits)
+{
+    return vector<mfxU8>(buf.begin(), buf.begin() + (bitOffset + bits + 7) / 8);
+}
+
+static mfxU32 RandomCode(mt19937 &rng)
+{
+    // Mostly short codes, like the header syntax elements
+    return rng() >> (rng() % 32);
+}
+
+TEST(BitstreamWriterFastTest, GolombCodes)
+{
+    vector<mfxU8>       buf(16 + writerSlack, 0xFF);
+    BitstreamWriterFast bs(buf.data(), 16);
+
+    bs.PutUE(0);   // 1
+    bs.PutUE(3);   // 00100
+    bs.PutSE(-2);  // 00101
+    bs.PutSE(1);   // 010
+    bs.PutTrailingBits();
+    bs.Flush();
+
+    EXPECT_EQ(16u, bs.GetOffset());
+    EXPECT_EQ(0x90, buf[0]);
+    EXPECT_EQ(0xAA, buf[1]);
+
+    // Aligned: nothing to add
+    bs.PutTrailingBits(true);
+    EXPECT_EQ(16u, bs.GetOffset());
+
+    // The largest code before b + 1 wraps: 31 zeros, then 32 bits
+    bs.Reset();
+    bs.PutUE(0xFFFFFFFE);
+    bs.Flush();
+    EXPECT_EQ(63u, bs.GetOffset());
+    EXPECT_EQ(0x00, buf[0]);
+    EXPECT_EQ(0x01, buf[3]);
+    EXPECT_EQ(0xFE, buf[7]);
+}
+
+TEST(BitstreamWriterFastTest, FuzzMatchesBitstreamWriter)
+{
+    const uint32_t size = 4096;
+
+    for (uint32_t seed = 0; seed < 500; seed++)
+    {
+        mt19937 rng(seed);
+        mfxU8   bitOffset = (mfxU8)(rng() % 8);
+        mfxU8   first     = (mfxU8)rng();
+
+        vector<mfxU8> ref(size + writerSlack, 0xCD);
+        vector<mfxU8> fast(size + writerSlack, 0xCD);
+        ref[0] = fast[0] = first;
+
+        BitstreamWriter     refBs(ref.data(), size, bitOffset);
+        BitstreamWriterFast fastBs(fast.data(), size, bitOffset);
+
+        for (uint32_t op = 0; op < 400 && refBs.GetOffset() < (size - writerSlack) * 8 - 96; op++)
+        {
+            switch (rng() % 6)
+            {
+            case 0:
+            {
+                mfxU32 n = rng() % 32 + 1;
+                mfxU32 b = rng();
+                refBs.PutBits(n, b);
+                fastBs.PutBits(n, b);
+                break;
+            }
+            case 1:
+            {
+                mfxU32 b = rng();
+                refBs.PutBit(b);
+                fastBs.PutBit(b);
+                break;
+            }
+            case 2:
+            {
+                // BitstreamWriter only finds the length of codes below 2^31
+                mfxU32 b = RandomCode(rng) >> 1;
+                b -= (b == 0x7FFFFFFF);
+                refBs.PutUE(b);
+                fastBs.PutUE(b);
+                break;
+            }
+            case 3:
+            {
+                // Within the range the existing writer doubles without overflow
+                mfxI32 b = (mfxI32)(RandomCode(rng) >> 2) * ((rng() & 1) ? 1 : -1);
+                refBs.PutSE(b);
+                fastBs.PutSE(b);
+                break;
+            }
+            case 4:
+            {
+                bool aligned = rng() & 1;
+                refBs.PutTrailingBits(aligned);
+                fastBs.PutTrailingBits(aligned);
+                break;
+            }
+            default:
+            {
+                mfxU32 n = rng() % 8 + 1;
+                refBs.PutBits(n, 0);
+                fastBs.PutBits(n, 0);
+                break;
+            }
+            }
+
+            ASSERT_EQ(refBs.GetOffset(), fastBs.GetOffset()) << "seed " << seed << ", op " << op;
+            if (op % 37 == 0)
+            {
+                fastBs.Flush();
+                ASSERT_EQ(Bytes(ref, bitOffset, refBs.GetOffset()), Bytes(fast, bitOffset, fastBs.GetOffset())) << "seed " << seed << ", op " << op;
+            }
+        }
+
+        fastBs.Flush();
+        ASSERT_EQ(Bytes(ref, bitOffset, refBs.GetOffset()), Bytes(fast, bitOffset, fastBs.GetOffset())) << "seed " << seed;
+    }
+}
+
+// The syntax elements HevcHeaderPacker::PackSSH writes for a P slice with
+// SAO, per slice segment of a picture of 8160 CTUs
+template <class BsWriter>
+static void PackSliceHeader(BsWriter &bs, mfxU32 slice, mfxU32 sliceNum)
+{
+    bs.PutBits(24, 0x000001);
+    bs.PutBit(0);
+    bs.PutBits(6, 1);
+    bs.PutBits(6, 0);
+    bs.PutBits(3, 1);
+
+    bs.PutBit(slice == 0);
+    bs.PutUE(0);
+    if (slice)
+        bs.PutBits(13, slice * 8160 / sliceNum);
+
+    bs.PutUE(1);
+    bs.PutBits(8, slice & 0xFF);
+    bs.PutBit(0);
+    bs.PutUE(1);
+    bs.PutUE(1);
+    bs.PutUE(0);
+    bs.PutBit(1);
+    bs.PutBit(1);
+    bs.PutBit(1);
+    bs.PutBit(1);
+    bs.PutUE(3);
+    bs.PutBit(0);
+    bs.PutBit(0);
+    bs.PutBit(1);
+    bs.PutUE(0);
+    bs.PutUE(3);
+    bs.PutSE((mfxI32)(slice % 13) - 6);
+    bs.PutSE(-1);
+    bs.PutSE(2);
+    bs.PutBit(1);
+    bs.PutTrailingBits();
+}
+
+template <class BsWriter>
+static double PackStreamNs(BsWriter &bs, mfxU8 *buf, uint32_t size, mfxU32 sliceNum, uint32_t frameNum, uint32_t &bytes)
+{
+    auto start = chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frameNum; frame++)
+    {
+        bs.Reset(buf, size);
+        for (mfxU32 slice = 0; slice < sliceNum; slice++)
+        {
+            PackSliceHeader(bs, slice, sliceNum);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    bytes = bs.GetOffset() / 8;
+    return (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count() / frameNum;
+}
+
+TEST(BitstreamWriterFastTest, SliceHeadersMatch)
+{
+    const uint32_t size = MAX_SLICES * 32;
+
+    for (mfxU32 sliceNum : {1u, 68u, (mfxU32)MAX_SLICES})
+    {
+        vector<mfxU8> ref(size + writerSlack, 0);
+        vector<mfxU8> fast(size + writerSlack, 0);
+
+        BitstreamWriter     refBs(ref.data(), size);
+        BitstreamWriterFast fastBs(fast.data(), size);
+        for (mfxU32 slice = 0; slice < sliceNum; slice++)
+        {
+            PackSliceHeader(refBs, slice, sliceNum);
+            PackSliceHeader(fastBs, slice, sliceNum);
+        }
+        fastBs.Flush();
+
+        uint32_t refBytes = refBs.GetOffset() / 8;
+        ASSERT_EQ(refBs.GetOffset(), fastBs.GetOffset()) << sliceNum << " slices";
+        EXPECT_EQ(vector<mfxU8>(ref.begin(), ref.begin() + refBytes), vector<mfxU8>(fast.begin(), fast.begin() + refBytes))
+            << sliceNum << " slices";
+    }
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST(BitstreamWriterFastTest, DISABLED_SliceHeaderBenchmark)
+{
+    const uint32_t size     = MAX_SLICES * 32;
+    const uint32_t frameNum = 200;
+
+    for (mfxU32 sliceNum : {1u, 68u, (mfxU32)MAX_SLICES})
+    {
+        vector<mfxU8> ref(size + writerSlack, 0);
+        vector<mfxU8> fast(size + writerSlack, 0);
+
+        BitstreamWriter     refBs(ref.data(), size);
+        BitstreamWriterFast fastBs(fast.data(), size);
+        uint32_t            refBytes = 0, fastBytes = 0;
+
+        double refNs  = PackStreamNs(refBs, ref.data(), size, sliceNum, frameNum, refBytes);
+        double fastNs = PackStreamNs(fastBs, fast.data(), size, sliceNum, frameNum, fastBytes);
+        fastBs.Flush();
+
+        ASSERT_EQ(refBytes, fastBytes);
+        EXPECT_EQ(vector<mfxU8>(ref.begin(), ref.begin() + refBytes), vector<mfxU8>(fast.begin(), fast.begin() + fastBytes));
+        printf("[ BITSTREAM WRITER ] %3u slices, %5u bytes: BitstreamWriter %9.0f ns, BitstreamWriterFast %9.0f ns per frame\n",
+            sliceNum, refBytes, refNs, fastNs);
+    }
+}
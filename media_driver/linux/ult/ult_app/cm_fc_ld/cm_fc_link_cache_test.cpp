@@ -0,0 +1,254 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "cm_fc_ld.h"
+#include "LinkCache.h"
+#include "PatchInfoLinker.h"
+#include "vpkrnheader.h"
+#include "igvpkrn_g12_tgllp.h"
+#include "igvpkrn_g12_tgllp_cmfcpatch.h"
+
+using namespace std;
+
+// Fast composition kernels of TGL with their patch info, the kernel and the
+// patch blobs both start with the offsets of all the kernels
+class CmFcKernels
+{
+public:
+    CmFcKernels()
+    {
+        const uint32_t offsetsSize = (IDR_VP_TOTAL_NUM_KERNELS + 1) * sizeof(uint32_t);
+        if (IGVPKRN_G12_TGLLP_SIZE <= offsetsSize || IGVPKRN_G12_TGLLP_CMFCPATCH_SIZE <= offsetsSize)
+        {
+            return;
+        }
+
+        for (int32_t id = 0; id < IDR_VP_TOTAL_NUM_KERNELS; id++)
+        {
+            cm_fc_kernel_t kernel = Get(id);
+            if (kernel.binary_size && kernel.patch_size)
+            {
+                m_ids.push_back(id);
+            }
+        }
+    }
+
+    cm_fc_kernel_t Get(int32_t id) const
+    {
+        const uint32_t *binOffsets   = IGVPKRN_G12_TGLLP;
+        const uint32_t *patchOffsets = IGVPKRN_G12_TGLLP_CMFCPATCH;
+
+        cm_fc_kernel_t kernel = {};
+        kernel.binary_buf  = (const char *)(binOffsets + IDR_VP_TOTAL_NUM_KERNELS + 1) + binOffsets[id];
+        kernel.binary_size = binOffsets[id + 1] - binOffsets[id];
+        kernel.patch_buf   = (const char *)(patchOffsets + IDR_VP_TOTAL_NUM_KERNELS + 1) + patchOffsets[id];
+        kernel.patch_size  = patchOffsets[id + 1] - patchOffsets[id];
+        return kernel;
+    }
+
+    // Every kernel alone, then windows of four kernels in a row
+    vector<vector<cm_fc_kernel_t>> GetLists() const
+    {
+        vector<vector<cm_fc_kernel_t>> lists;
+        for (auto id : m_ids)
+        {
+            lists.push_back(vector<cm_fc_kernel_t>(1, Get(id)));
+        }
+        for (size_t i = 0; i + 4 <= m_ids.size(); i += 4)
+        {
+            vector<cm_fc_kernel_t> list;
+            for (size_t j = i; j < i + 4; j++)
+            {
+                list.push_back(Get(m_ids[j]));
+            }
+            lists.push_back(list);
+        }
+        return lists;
+    }
+
+    bool Empty() const { return m_ids.empty(); }
+
+protected:
+    vector<int32_t> m_ids;
+};
+
+// Link the way cm_fc_combine_kernels did before the cache
+static bool LinkReference(vector<cm_fc_kernel_t> &list, string &binary)
+{
+    cm::patch::Collection C;
+    if (linkPatchInfo(C, list.size(), list.data(), nullptr))
+    {
+        return false;
+    }
+    binary = C.getLinkedBinary();
+    return true;
+}
+
+static int Combine(vector<cm_fc_kernel_t> &list, string &binary)
+{
+    vector<char> buf(256 * 1024);
+    size_t       size = buf.size();
+    int          ret  = cm_fc_combine_kernels(list.size(), list.data(), buf.data(), &size, nullptr);
+    if (ret == CM_FC_OK)
+    {
+        binary.assign(buf.data(), size);
+    }
+    return ret;
+}
+
+TEST(CmFcLinkCacheTest, SameBinaryAsLinker)
+{
+    CmFcKernels kernels;
+    if (kernels.Empty())
+    {
+        printf("No fast composition kernels with patch info, skipped\n");
+        return;
+    }
+
+    cm::patch::LinkCache::getInstance().clear();
+    auto     lists  = kernels.GetLists();
+    uint32_t linked = 0;
+    for (auto &list : lists)
+    {
+        string reference, cold, cached;
+        bool   ok = LinkReference(list, reference);
+        if (ok)
+        {
+            linked++;
+        }
+
+        // Failures are not cached, they fail again the same way
+        ASSERT_EQ(ok ? CM_FC_OK : CM_FC_FAILURE, Combine(list, cold));
+        ASSERT_EQ(ok ? CM_FC_OK : CM_FC_FAILURE, Combine(list, cached));
+        EXPECT_TRUE(cold == reference);
+        EXPECT_TRUE(cached == reference);
+    }
+
+    EXPECT_GT(linked, 0u);
+    EXPECT_EQ(linked, cm::patch::LinkCache::getInstance().getHits());
+}
+
+TEST(CmFcLinkCacheTest, NoBufsRetry)
+{
+    CmFcKernels kernels;
+    if (kernels.Empty())
+    {
+        return;
+    }
+
+    cm::patch::LinkCache::getInstance().clear();
+    vector<cm_fc_kernel_t> list = kernels.GetLists().front();
+    string                 reference;
+    if (!LinkReference(list, reference))
+    {
+        return;
+    }
+
+    // The caller asks for the size first, the retry is served from the cache
+    size_t size = 0;
+    char   byte;
+    EXPECT_EQ(CM_FC_NOBUFS, cm_fc_combine_kernels(list.size(), list.data(), &byte, &size, nullptr));
+    EXPECT_EQ(reference.size(), size);
+
+    vector<char> buf(size);
+    EXPECT_EQ(CM_FC_OK, cm_fc_combine_kernels(list.size(), list.data(), buf.data(), &size, nullptr));
+    EXPECT_TRUE(string(buf.data(), size) == reference);
+    EXPECT_EQ(1u, cm::patch::LinkCache::getInstance().getMisses());
+    EXPECT_EQ(1u, cm::patch::LinkCache::getInstance().getHits());
+}
+
+TEST(CmFcLinkCacheTest, WorkingSetServedFromCache)
+{
+    CmFcKernels kernels;
+    if (kernels.Empty())
+    {
+        return;
+    }
+
+    // The working set of the benchmark below, without the lists which fail to link
+    auto lists = kernels.GetLists();
+    lists.erase(lists.begin(), lists.end() - min<size_t>(lists.size(), 32));
+    vector<vector<cm_fc_kernel_t>> linkable;
+    for (auto &list : lists)
+    {
+        string reference;
+        if (LinkReference(list, reference))
+        {
+            linkable.push_back(list);
+        }
+    }
+
+    cm::patch::LinkCache::getInstance().clear();
+    for (int32_t round = 0; round < 3; round++)
+    {
+        for (auto &list : linkable)
+        {
+            string binary;
+            ASSERT_EQ(CM_FC_OK, Combine(list, binary));
+        }
+    }
+
+    // Every list is linked once, the later rounds fit in the cache
+    EXPECT_EQ(linkable.size(), cm::patch::LinkCache::getInstance().getMisses());
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST(CmFcLinkCacheTest, DISABLED_Benchmark)
+{
+    CmFcKernels kernels;
+    if (kernels.Empty())
+    {
+        return;
+    }
+
+    // A composition-like working set, a few dozen kernel lists built over and over
+    auto lists = kernels.GetLists();
+    lists.erase(lists.begin(), lists.end() - min<size_t>(lists.size(), 32));
+
+    auto link = [&](bool cold) {
+        const int32_t rounds = 10;
+        auto          start  = chrono::steady_clock::now();
+        for (int32_t i = 0; i < rounds; i++)
+        {
+            for (auto &list : lists)
+            {
+                if (cold)
+                {
+                    cm::patch::LinkCache::getInstance().clear();
+                }
+                string binary;
+                Combine(list, binary);
+            }
+        }
+        auto end = chrono::steady_clock::now();
+        return (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count() / 1000 / (rounds * lists.size());
+    };
+
+    double cold   = link(true);
+    double cached = link(false);
+    printf("[ CMFC BENCHMARK ] %zu kernel lists: %.1f us per link, %.1f us per cached link, %zu bytes cached\n",
+        lists.size(), cold, cached, cm::patch::LinkCache::getInstance().getBytes());
+}
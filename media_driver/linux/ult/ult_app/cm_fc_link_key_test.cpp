@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "cm_fc_ld.h"
+#include "LinkCache.h"
+
+using namespace std;
+
+// The keys and the LRU of the fast composition link cache, they do not need
+// the kernels and are tested without the non-free ones
+
+static cm_fc_kernel_t MakeKernel(const char *buf, size_t size)
+{
+    cm_fc_kernel_t kernel = {};
+    kernel.binary_buf     = buf;
+    kernel.binary_size    = size;
+    kernel.patch_buf      = buf;
+    kernel.patch_size     = size;
+    return kernel;
+}
+
+// Key with a fixed hash, so that different inputs collide
+class CollidingLinkKey : public cm::patch::LinkKey
+{
+public:
+    CollidingLinkKey(size_t numKernels, const cm_fc_kernel_t *kernels)
+        : LinkKey(numKernels, kernels, nullptr)
+    {
+        Hash = 0x5A5A5A5A5A5A5A5AULL;
+    }
+};
+
+TEST(CmFcLinkCacheTest, LeastRecentlyUsedEvicted)
+{
+    // Keys only depend on the content, not on where the kernels are
+    const char blobs[4][64] = {{1}, {2}, {3}, {4}};
+    vector<cm::patch::LinkKey> keys;
+    for (auto &blob : blobs)
+    {
+        cm_fc_kernel_t kernel = MakeKernel(blob, sizeof(blob));
+        keys.push_back(cm::patch::LinkKey(1, &kernel, nullptr));
+    }
+
+    char           copy[64] = {1};
+    cm_fc_kernel_t kernel   = MakeKernel(copy, sizeof(copy));
+    EXPECT_TRUE(cm::patch::LinkKey(1, &kernel, nullptr) == keys[0]);
+    EXPECT_FALSE(cm::patch::LinkKey(1, &kernel, "-O0") == keys[0]);
+
+    // Room for three binaries of 100 bytes and their keys
+    const size_t         keySize = keys[0].getSize();
+    const size_t         entry   = keySize + 100;
+    cm::patch::LinkCache cache(3 * entry);
+    string               binary;
+    EXPECT_EQ(2 * sizeof(copy), keySize);
+    cache.insert(keys[0], string(100, 'a'));
+    cache.insert(keys[1], string(100, 'b'));
+    cache.insert(keys[2], string(100, 'c'));
+    EXPECT_EQ(3 * entry, cache.getBytes());
+
+    // Binary 0 is used again, binary 1 goes for binary 3
+    EXPECT_TRUE(cache.find(keys[0], binary));
+    EXPECT_EQ(string(100, 'a'), binary);
+    cache.insert(keys[3], string(100, 'd'));
+    EXPECT_FALSE(cache.find(keys[1], binary));
+    EXPECT_TRUE(cache.find(keys[2], binary));
+    EXPECT_TRUE(cache.find(keys[3], binary));
+    EXPECT_EQ(3 * entry, cache.getBytes());
+
+    // Binaries above the budget are not kept
+    cache.insert(keys[1], string(3 * entry - keySize + 1, 'b'));
+    EXPECT_FALSE(cache.find(keys[1], binary));
+    EXPECT_EQ(3 * entry, cache.getBytes());
+
+    // A larger binary takes the room of the two oldest ones
+    cache.insert(keys[1], string(entry + 100, 'b'));
+    EXPECT_FALSE(cache.find(keys[0], binary));
+    EXPECT_FALSE(cache.find(keys[2], binary));
+    EXPECT_TRUE(cache.find(keys[1], binary));
+    EXPECT_EQ(string(entry + 100, 'b'), binary);
+    EXPECT_EQ(3 * entry, cache.getBytes());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getBytes());
+    EXPECT_FALSE(cache.find(keys[3], binary));
+}
+
+TEST(CmFcLinkCacheTest, HashCollision)
+{
+    // Same sizes and options, one byte apart, forced to the same hash
+    char first[64]  = {1};
+    char second[64] = {1};
+    second[63]      = 2;
+
+    cm_fc_kernel_t   firstKernel  = MakeKernel(first, sizeof(first));
+    cm_fc_kernel_t   secondKernel = MakeKernel(second, sizeof(second));
+    CollidingLinkKey firstKey(1, &firstKernel);
+    CollidingLinkKey secondKey(1, &secondKernel);
+    ASSERT_EQ(firstKey.getHash(), secondKey.getHash());
+    EXPECT_FALSE(firstKey == secondKey);
+
+    cm::patch::LinkCache cache;
+    string               binary;
+    cache.insert(firstKey, "first");
+    EXPECT_FALSE(cache.find(secondKey, binary));
+
+    // Both binaries are kept under the same hash and found by their input
+    cache.insert(secondKey, "second");
+    EXPECT_TRUE(cache.find(firstKey, binary));
+    EXPECT_EQ("first", binary);
+    EXPECT_TRUE(cache.find(secondKey, binary));
+    EXPECT_EQ("second", binary);
+
+    // The same input at another place is still a hit
+    char             copy[64]   = {1};
+    cm_fc_kernel_t   copyKernel = MakeKernel(copy, sizeof(copy));
+    CollidingLinkKey copyKey(1, &copyKernel);
+    EXPECT_TRUE(copyKey == firstKey);
+    EXPECT_TRUE(cache.find(copyKey, binary));
+    EXPECT_EQ("first", binary);
+
+    // Replacing one of them leaves the other alone
+    cache.insert(secondKey, "second again");
+    EXPECT_TRUE(cache.find(firstKey, binary));
+    EXPECT_EQ("first", binary);
+    EXPECT_TRUE(cache.find(secondKey, binary));
+    EXPECT_EQ("second again", binary);
+    EXPECT_EQ(firstKey.getSize() + secondKey.getSize() + strlen("first") + strlen("second again"), cache.getBytes());
+
+    // The patch info and the binary are compared apart
+    char           swapped[2][32] = {{1}, {2}};
+    cm_fc_kernel_t kernel         = {};
+    kernel.patch_buf              = swapped[0];
+    kernel.patch_size             = sizeof(swapped[0]);
+    kernel.binary_buf             = swapped[1];
+    kernel.binary_size            = sizeof(swapped[1]);
+    CollidingLinkKey patchFirst(1, &kernel);
+    kernel.patch_buf  = swapped[1];
+    kernel.binary_buf = swapped[0];
+    CollidingLinkKey binaryFirst(1, &kernel);
+    EXPECT_FALSE(patchFirst == binaryFirst);
+}
@@ -20,6 +20,7 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "cmd_validator.h"
+#include "submit_benchmark.h"
 
 using namespace std;
 
@@ -27,6 +28,7 @@ void UltGetCmdBuf(PMOS_COMMAND_BUFFER pCmdBuffer)
 {
     auto cmdValidator = CmdValidator::GetInstance();
     cmdValidator->Validate(pCmdBuffer);
+    SubmitBenchmark::GetInstance()->RecordCmdBuf(pCmdBuffer);
 }
 
 CmdValidator *CmdValidator::m_instance = nullptr;
@@ -26,6 +26,7 @@
 #include "driver_loader.h"
 #include "gtest/gtest.h"
 #include "memory_leak_detector.h"
+#include "submit_benchmark.h"
 #include "test_data_caps.h"
 #include "test_data_decode.h"
 
@@ -84,8 +84,14 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
 
+    // Contexts and surfaces are set up, what follows is the submit path
+    string caseName = string(testing::UnitTest::GetInstance()->current_test_info()->name()) + "/" + g_platformName[platform];
+    SubmitBenchmark::GetInstance()->Begin(caseName, m_driverLoader.GetDriverSymbols());
+
     for (int i = 0; i < pEncData->m_num_frames; i++)
     {
+        SubmitBenchmark::GetInstance()->BeginFrame();
+
         ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id,resources[0]);
 
         vector<vector<CompBufConif>> &compBufs = pEncData->GetCompBuffers();
@@ -132,8 +138,16 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
             EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
                 << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
         }
+
+        SubmitBenchmark::GetInstance()->EndFrame();
       }
 
+    // Only reported until the golden values are recorded from real devult runs
+    for (const auto &regression : SubmitBenchmark::GetInstance()->End())
+    {
+        printf("[ SUBMIT BENCHMARK ] Platform = %s, regression: %s\n", g_platformName[platform], regression.c_str());
+    }
+
     ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx,
         &resources[0], resources.size());
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
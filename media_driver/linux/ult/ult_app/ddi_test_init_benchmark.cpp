@@ -0,0 +1,162 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+#include "ddi_test_init_benchmark.h"
+
+using namespace std;
+
+static uint64_t NowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool MediaInitBenchmark::RunCycle(Platform_t platform, InitBenchmarkTimes &times, MEDIA_INIT_PHASE_STATS *phaseStats)
+{
+    VADriverContextP ctx       = &m_driverLoader.m_ctx;
+    VAConfigID       configId  = VA_INVALID_ID;
+    VAContextID      contextId = VA_INVALID_ID;
+    VASurfaceID      surface   = VA_INVALID_ID;
+    VAProfile        profiles[64];
+    int              numProfiles = 0;
+
+    uint64_t start = NowNs();
+    if (m_driverLoader.InitDriver(platform) != VA_STATUS_SUCCESS)
+    {
+        return false;
+    }
+    uint64_t initialized = NowNs();
+
+    // The first caps query builds the profile table
+    bool ok = ctx->max_profiles <= 64 &&
+              ctx->vtable->vaQueryConfigProfiles(ctx, profiles, &numProfiles) == VA_STATUS_SUCCESS;
+    uint64_t queried = NowNs();
+
+    ok = ok &&
+         ctx->vtable->vaCreateConfig(ctx, VAProfileH264Main, VAEntrypointVLD, nullptr, 0, &configId) == VA_STATUS_SUCCESS &&
+         ctx->vtable->vaCreateSurfaces2(ctx, VA_RT_FORMAT_YUV420, 1920, 1080, &surface, 1, nullptr, 0) == VA_STATUS_SUCCESS;
+    uint64_t contextStart = NowNs();
+    ok = ok &&
+         ctx->vtable->vaCreateContext(ctx, configId, 1920, 1080, VA_PROGRESSIVE, &surface, 1, &contextId) == VA_STATUS_SUCCESS;
+    uint64_t contextCreated = NowNs();
+
+    if (m_driverLoader.m_drvSyms.DdiMedia_GetInitPhaseStats)
+    {
+        m_driverLoader.m_drvSyms.DdiMedia_GetInitPhaseStats(phaseStats, MEDIA_INIT_PHASE_COUNT);
+    }
+
+    if (contextId != VA_INVALID_ID)
+    {
+        ctx->vtable->vaDestroyContext(ctx, contextId);
+    }
+    if (surface != VA_INVALID_ID)
+    {
+        ctx->vtable->vaDestroySurfaces(ctx, &surface, 1);
+    }
+    if (configId != VA_INVALID_ID)
+    {
+        ctx->vtable->vaDestroyConfig(ctx, configId);
+    }
+
+    uint64_t terminateStart = NowNs();
+    ok = m_driverLoader.CloseDriver(false) == VA_STATUS_SUCCESS && ok;
+    uint64_t terminated = NowNs();
+
+    times.initializeNs    = initialized - start;
+    times.firstQueryNs    = queried - initialized;
+    times.createContextNs = contextCreated - contextStart;
+    times.terminateNs     = terminated - terminateStart;
+    return ok;
+}
+
+TEST_F(MediaInitBenchmark, PhaseStats)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        InitBenchmarkTimes     times                              = {};
+        MEDIA_INIT_PHASE_STATS phaseStats[MEDIA_INIT_PHASE_COUNT] = {};
+
+        EXPECT_TRUE(RunCycle(platforms[i], times, phaseStats)) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = RunCycle" << endl;
+        EXPECT_GT(phaseStats[MEDIA_INIT_PHASE_INITIALIZE].count, 0u) << "Platform = " << g_platformName[platforms[i]]
+            << ", vaInitialize not timed" << endl;
+    }
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(MediaInitBenchmark, DISABLED_ColdStart)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        InitBenchmarkTimes     total                              = {};
+        MEDIA_INIT_PHASE_STATS phaseTotal[MEDIA_INIT_PHASE_COUNT] = {};
+
+        for (int cycle = 0; cycle < INIT_BENCHMARK_CYCLES; cycle++)
+        {
+            InitBenchmarkTimes     times                              = {};
+            MEDIA_INIT_PHASE_STATS phaseStats[MEDIA_INIT_PHASE_COUNT] = {};
+
+            EXPECT_TRUE(RunCycle(platforms[i], times, phaseStats)) << "Platform = " << g_platformName[platforms[i]]
+                << ", Failed function = RunCycle, cycle " << cycle << endl;
+
+            total.initializeNs    += times.initializeNs;
+            total.firstQueryNs    += times.firstQueryNs;
+            total.createContextNs += times.createContextNs;
+            total.terminateNs     += times.terminateNs;
+
+            // The driver is unloaded every cycle, so its statistics hold this cycle only
+            for (int phase = 0; phase < MEDIA_INIT_PHASE_COUNT; phase++)
+            {
+                phaseTotal[phase].count   += phaseStats[phase].count;
+                phaseTotal[phase].totalNs += phaseStats[phase].totalNs;
+            }
+        }
+
+        printf("[ INIT BENCHMARK ] %s, %d cycles, average us: vaInitialize %.1f, first query %.1f, vaCreateContext %.1f, vaTerminate %.1f\n",
+            g_platformName[platforms[i]], INIT_BENCHMARK_CYCLES,
+            total.initializeNs / 1000.0 / INIT_BENCHMARK_CYCLES,
+            total.firstQueryNs / 1000.0 / INIT_BENCHMARK_CYCLES,
+            total.createContextNs / 1000.0 / INIT_BENCHMARK_CYCLES,
+            total.terminateNs / 1000.0 / INIT_BENCHMARK_CYCLES);
+
+        for (int phase = 0; phase < MEDIA_INIT_PHASE_COUNT; phase++)
+        {
+            if (phaseTotal[phase].count == 0)
+            {
+                continue;
+            }
+            printf("[ INIT BENCHMARK ]     %-16s %10.1f us\n",
+                MediaInitProfiler::GetPhaseName((MEDIA_INIT_PHASE)phase),
+                phaseTotal[phase].totalNs / 1000.0 / phaseTotal[phase].count);
+        }
+
+        RecordProperty(string(g_platformName[platforms[i]]) + "_vaInitialize_ns",
+            to_string(total.initializeNs / INIT_BENCHMARK_CYCLES));
+        RecordProperty(string(g_platformName[platforms[i]]) + "_vaCreateContext_ns",
+            to_string(total.createContextNs / INIT_BENCHMARK_CYCLES));
+    }
+}
@@ -0,0 +1,55 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __DDI_TEST_INIT_BENCHMARK_H__
+#define __DDI_TEST_INIT_BENCHMARK_H__
+
+#include "driver_loader.h"
+#include "gtest/gtest.h"
+#include "media_libva_init_profiler.h"
+
+// Cold start cycles timed per platform, each one loads and unloads the driver
+#define INIT_BENCHMARK_CYCLES   10
+
+struct InitBenchmarkTimes
+{
+    uint64_t initializeNs    = 0;
+    uint64_t firstQueryNs    = 0;
+    uint64_t createContextNs = 0;
+    uint64_t terminateNs     = 0;
+};
+
+class MediaInitBenchmark : public testing::Test
+{
+protected:
+
+    virtual void SetUp() { }
+
+    virtual void TearDown() { }
+
+    bool RunCycle(Platform_t platform, InitBenchmarkTimes &times, MEDIA_INIT_PHASE_STATS *phaseStats);
+
+protected:
+
+    DriverDllLoader m_driverLoader;
+};
+
+#endif // __DDI_TEST_INIT_BENCHMARK_H__
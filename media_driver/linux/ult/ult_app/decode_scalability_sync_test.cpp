@@ -0,0 +1,299 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "decode_scalability_sync.h"
+
+using namespace std;
+using namespace decode;
+
+// Sync with a short shared epoch, so the counter reset is exercised
+class ShortEpochSync : public DecodeScalabilitySync
+{
+public:
+    void SetMaxEpoch(uint32_t maxEpoch) { m_maxEpoch = maxEpoch; }
+};
+
+// Runs the command streams the pipes get for their syncs the way the engines
+// would: one command of one pipe at a time, in a random order. A semaphore
+// wait only checks memory when its pipe runs, so values only seen for a while
+// may be missed, unless every wait is woken up on each write.
+class SyncSimulator
+{
+public:
+    struct Op
+    {
+        DecodeScalabilitySyncCmd cmd;
+        uint32_t                 set;
+        uint32_t                 sync;  // sync point of the pipe
+        bool                     last;  // last command of the sync
+    };
+
+    SyncSimulator(DecodeScalabilitySync &sync, uint32_t pipeNum, uint32_t setNum, uint32_t frameNum, uint32_t syncsPerFrame)
+        : m_pipeNum(pipeNum), m_streams(pipeNum), m_memory(setNum * sync.GetSemaphoreNum(), 0), m_semaphoreNum(sync.GetSemaphoreNum())
+    {
+        vector<DecodeScalabilitySyncCmd> cmds;
+        for (uint32_t frame = 0; frame < frameNum; frame++)
+        {
+            for (uint32_t i = 0; i < syncsPerFrame; i++)
+            {
+                for (uint32_t pipe = 0; pipe < pipeNum; pipe++)
+                {
+                    EXPECT_EQ(MOS_STATUS_SUCCESS, sync.GetSyncCmds(frame % setNum, pipe, cmds));
+                    m_cmdNum += (uint32_t)cmds.size();
+                    for (uint32_t c = 0; c < cmds.size(); c++)
+                    {
+                        m_streams[pipe].push_back({cmds[c], frame % setNum, frame * syncsPerFrame + i, c + 1 == cmds.size()});
+                    }
+                }
+            }
+        }
+        m_syncNum = frameNum * syncsPerFrame;
+    }
+
+    // Returns false on a deadlock, checks no pipe leaves a sync before all the pipes reached it
+    bool Run(uint32_t seed, bool wakeOnWrite)
+    {
+        mt19937            rng(seed);
+        vector<size_t>     pc(m_pipeNum, 0);
+        vector<uint32_t>   reached(m_pipeNum, 0);
+        fill(m_memory.begin(), m_memory.end(), 0);
+
+        auto done = [&](uint32_t pipe) { return pc[pipe] >= m_streams[pipe].size(); };
+        auto passes = [&](const Op &op) {
+            uint32_t value = m_memory[op.set * m_semaphoreNum + op.cmd.semaphore];
+            return op.cmd.waitEqual ? value == op.cmd.value : value >= op.cmd.value;
+        };
+        auto step = [&](uint32_t pipe) {
+            const Op &op = m_streams[pipe][pc[pipe]];
+            if (pc[pipe] == 0 || m_streams[pipe][pc[pipe] - 1].sync != op.sync)
+            {
+                reached[pipe] = op.sync + 1;
+            }
+            uint32_t &value = m_memory[op.set * m_semaphoreNum + op.cmd.semaphore];
+            if (op.cmd.type == DecodeScalabilitySyncCmd::atomicInc)
+            {
+                value++;
+            }
+            else if (op.cmd.type == DecodeScalabilitySyncCmd::storeData)
+            {
+                value = op.cmd.value;
+            }
+            if (op.last)
+            {
+                for (uint32_t other = 0; other < m_pipeNum; other++)
+                {
+                    EXPECT_GT(reached[other], op.sync) << "pipe " << pipe << " left sync " << op.sync << " before pipe " << other << " reached it";
+                }
+            }
+            pc[pipe]++;
+        };
+        auto ready = [&](uint32_t pipe) {
+            const Op &op = m_streams[pipe][pc[pipe]];
+            return op.cmd.type != DecodeScalabilitySyncCmd::semaphoreWait || passes(op);
+        };
+
+        while (true)
+        {
+            vector<uint32_t> running;
+            bool             progress = false;
+            for (uint32_t pipe = 0; pipe < m_pipeNum; pipe++)
+            {
+                if (!done(pipe))
+                {
+                    running.push_back(pipe);
+                    progress |= ready(pipe);
+                }
+            }
+            if (running.empty())
+            {
+                return true;
+            }
+            if (!progress)
+            {
+                return false;
+            }
+
+            // A waiting pipe keeps its turn, it just polls again
+            uint32_t pipe = running[rng() % running.size()];
+            if (!ready(pipe))
+            {
+                continue;
+            }
+            step(pipe);
+
+            for (bool woken = wakeOnWrite; woken;)
+            {
+                woken = false;
+                for (uint32_t other = 0; other < m_pipeNum; other++)
+                {
+                    const Op *op = done(other) ? nullptr : &m_streams[other][pc[other]];
+                    if (op && op->cmd.type == DecodeScalabilitySyncCmd::semaphoreWait && passes(*op))
+                    {
+                        step(other);
+                        woken = true;
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t GetCmdNum() const { return m_cmdNum; }
+    uint32_t GetSyncNum() const { return m_syncNum; }
+    uint32_t GetMemory(uint32_t set, uint32_t semaphore) const { return m_memory[set * m_semaphoreNum + semaphore]; }
+
+private:
+    uint32_t           m_pipeNum;
+    vector<vector<Op>> m_streams;
+    vector<uint32_t>   m_memory;
+    uint32_t           m_semaphoreNum;
+    uint32_t           m_cmdNum  = 0;
+    uint32_t           m_syncNum = 0;
+};
+
+TEST(DecodeScalabilitySyncTest, DefaultScheme)
+{
+    // The other schemes are only taken on request
+    for (uint32_t pipeNum = 1; pipeNum <= 8; pipeNum++)
+    {
+        EXPECT_EQ(scalabilitySyncPerPipeFlags, DecodeScalabilitySync::SelectScheme(scalabilitySyncAuto, pipeNum));
+    }
+    EXPECT_EQ(scalabilitySyncSharedEpoch, DecodeScalabilitySync::SelectScheme(scalabilitySyncSharedEpoch, 2));
+    EXPECT_EQ(scalabilitySyncLeader, DecodeScalabilitySync::SelectScheme(scalabilitySyncLeader, 4));
+
+    DecodeScalabilitySync sync;
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, sync.Init(scalabilitySyncAuto, 0, 16));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, sync.Init(scalabilitySyncAuto, 2, 0));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, sync.Init(scalabilitySyncAuto, 3, 16));
+    EXPECT_EQ(scalabilitySyncPerPipeFlags, sync.GetScheme());
+    EXPECT_EQ(3u, sync.GetSemaphoreNum());
+
+    vector<DecodeScalabilitySyncCmd> cmds;
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, sync.GetSyncCmds(0, 3, cmds));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, sync.GetSyncCmds(16, 0, cmds));
+}
+
+TEST(DecodeScalabilitySyncTest, CommandCount)
+{
+    const ScalabilitySyncScheme schemes[] = {scalabilitySyncPerPipeFlags, scalabilitySyncSharedEpoch, scalabilitySyncLeader};
+    const char                 *names[]   = {"per pipe flags", "shared epoch", "leader"};
+
+    for (uint32_t pipeNum = 2; pipeNum <= 8; pipeNum *= 2)
+    {
+        for (uint32_t s = 0; s < 3; s++)
+        {
+            DecodeScalabilitySync sync;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, sync.Init(schemes[s], pipeNum, 16));
+            SyncSimulator sim(sync, pipeNum, 16, 32, 2);
+
+            uint32_t expected = (schemes[s] == scalabilitySyncPerPipeFlags) ? pipeNum * (pipeNum + 2) :
+                                (schemes[s] == scalabilitySyncSharedEpoch)  ? 2 * pipeNum : 2 * pipeNum + 1;
+            EXPECT_EQ(expected * sim.GetSyncNum(), sim.GetCmdNum()) << names[s];
+            printf("[ SCALABILITY SYNC ] %u pipes, %-14s: %2u MI commands per sync\n", pipeNum, names[s], sim.GetCmdNum() / sim.GetSyncNum());
+        }
+    }
+}
+
+TEST(DecodeScalabilitySyncTest, AllPipesSynced)
+{
+    for (uint32_t pipeNum = 1; pipeNum <= 5; pipeNum++)
+    {
+        // The per pipe flags only hold while a pipe cannot increment the flags
+        // for the next sync before the others left the previous one: every sync
+        // gets its own set and waits see every value written
+        DecodeScalabilitySync flags;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, flags.Init(scalabilitySyncPerPipeFlags, pipeNum, 12));
+        SyncSimulator flagsSim(flags, pipeNum, 12, 12, 1);
+        for (uint32_t seed = 0; seed < 200; seed++)
+        {
+            ASSERT_TRUE(flagsSim.Run(seed, true)) << "deadlock, per pipe flags, " << pipeNum << " pipes, seed " << seed;
+        }
+
+        // The new schemes only wait for values which stay until all the pipes
+        // passed: back to back syncs on the same set, waits polling at any time
+        for (auto scheme : {scalabilitySyncSharedEpoch, scalabilitySyncLeader})
+        {
+            DecodeScalabilitySync sync;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, sync.Init(scheme, pipeNum, 4));
+            SyncSimulator sim(sync, pipeNum, 4, 12, 3);
+            for (uint32_t seed = 0; seed < 200; seed++)
+            {
+                ASSERT_TRUE(sim.Run(seed, false)) << "deadlock, scheme " << scheme << ", " << pipeNum << " pipes, seed " << seed;
+            }
+        }
+    }
+}
+
+TEST(DecodeScalabilitySyncTest, SharedEpochCounterReset)
+{
+    for (uint32_t pipeNum = 2; pipeNum <= 4; pipeNum++)
+    {
+        ShortEpochSync sync;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, sync.Init(scalabilitySyncSharedEpoch, pipeNum, 2));
+        sync.SetMaxEpoch(3);
+
+        // 2 frames per set with 3 syncs each: the counter is reset on the 3rd and 6th sync of each set
+        SyncSimulator sim(sync, pipeNum, 2, 4, 3);
+        EXPECT_EQ(2 * pipeNum * sim.GetSyncNum() + 2 * 4, sim.GetCmdNum());
+        for (uint32_t seed = 0; seed < 200; seed++)
+        {
+            ASSERT_TRUE(sim.Run(seed, false)) << "deadlock, " << pipeNum << " pipes, seed " << seed;
+            EXPECT_EQ(0u, sim.GetMemory(0, 0));
+            EXPECT_EQ(2u, sim.GetMemory(0, 1));
+        }
+    }
+}
+
+TEST(DecodeScalabilitySyncTest, DroppedFrameResync)
+{
+    for (uint32_t pipeNum = 2; pipeNum <= 4; pipeNum++)
+    {
+        for (auto scheme : {scalabilitySyncSharedEpoch, scalabilitySyncLeader})
+        {
+            // The syncs of a frame are planned for some pipes, then the frame
+            // is dropped before its commands run
+            DecodeScalabilitySync stale;
+            DecodeScalabilitySync resync;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, stale.Init(scheme, pipeNum, 1));
+            ASSERT_EQ(MOS_STATUS_SUCCESS, resync.Init(scheme, pipeNum, 1));
+            vector<DecodeScalabilitySyncCmd> cmds;
+            for (auto sync : {&stale, &resync})
+            {
+                ASSERT_EQ(MOS_STATUS_SUCCESS, sync->GetSyncCmds(0, 0, cmds));
+                ASSERT_EQ(MOS_STATUS_SUCCESS, sync->GetSyncCmds(0, 0, cmds));
+                ASSERT_EQ(MOS_STATUS_SUCCESS, sync->GetSyncCmds(0, 1, cmds));
+            }
+
+            // Without Init the pipes wait for values the dropped commands would have written
+            ASSERT_EQ(MOS_STATUS_SUCCESS, resync.Init(scheme, pipeNum, 1));
+            SyncSimulator staleSim(stale, pipeNum, 1, 4, 2);
+            SyncSimulator resyncSim(resync, pipeNum, 1, 4, 2);
+            for (uint32_t seed = 0; seed < 50; seed++)
+            {
+                EXPECT_FALSE(staleSim.Run(seed, false)) << "scheme " << scheme << ", " << pipeNum << " pipes, seed " << seed;
+                ASSERT_TRUE(resyncSim.Run(seed, false)) << "deadlock, scheme " << scheme << ", " << pipeNum << " pipes, seed " << seed;
+            }
+        }
+    }
+}
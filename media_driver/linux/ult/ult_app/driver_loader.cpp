@@ -162,6 +162,7 @@ VAStatus DriverDllLoader::LoadDriverSymbols()
             m_drvSyms.MOS_GetMemNinjaCounter    = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounter");
             m_drvSyms.MOS_GetMemNinjaCounterGfx = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounterGfx");
             m_drvSyms.ppfnUltGetCmdBuf          = (UltGetCmdBufFunc *)dlsym(m_umdhandle, "pfnUltGetCmdBuf");
+            m_drvSyms.DdiMedia_GetInitPhaseStats = (GetInitPhaseStatsFunc)dlsym(m_umdhandle, "DdiMedia_GetInitPhaseStats");
             break;
         }
     }
@@ -80,6 +80,10 @@ typedef int32_t (*MOS_GetMemNinjaCounterFunc)();
 
 typedef void (*UltGetCmdBufFunc)(PMOS_COMMAND_BUFFER pCmdBuffer);
 
+struct MEDIA_INIT_PHASE_STATS;
+
+typedef uint32_t (*GetInitPhaseStatsFunc)(MEDIA_INIT_PHASE_STATS *stats, uint32_t count);
+
 struct DriverSymbols
 {
     bool Initialized() const
@@ -102,6 +106,7 @@ struct DriverSymbols
     MOS_SetUltFlagFunc          MOS_SetUltFlag;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounter;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounterGfx;
+    GetInitPhaseStatsFunc       DdiMedia_GetInitPhaseStats;  // optional, not checked by Initialized()
 
     // Data
     UltGetCmdBufFunc            *ppfnUltGetCmdBuf;
@@ -0,0 +1,180 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "mos_engine_load_tracker.h"
+
+static const MOS_GPU_NODE g_vdboxNodes[] = {MOS_GPU_NODE_VIDEO, MOS_GPU_NODE_VIDEO2};
+static const uint32_t     g_vdboxCount   = sizeof(g_vdboxNodes) / sizeof(g_vdboxNodes[0]);
+
+class EngineLoadTrackerTest : public testing::Test
+{
+protected:
+    virtual void SetUp() { m_tracker.Reset(); }
+
+    virtual void TearDown() { m_tracker.Reset(); }
+
+    // Picks a VDBox for a new session and creates its context there, the way
+    // GPU context creation does
+    MOS_GPU_NODE StartSession()
+    {
+        MOS_GPU_NODE node = m_tracker.SelectNode(g_vdboxNodes, g_vdboxCount);
+        m_tracker.BindSession(node);
+        return node;
+    }
+
+    // Runs frames of a session to completion, each one keeping the engine busy for busyNs
+    void RunFrames(MOS_GPU_NODE node, uint32_t frames, uint64_t busyNs)
+    {
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            m_tracker.Submitted(node);
+            m_tracker.Completed(node, busyNs);
+        }
+    }
+
+    MosEngineLoadTracker &m_tracker = MosEngineLoadTracker::Instance();
+};
+
+TEST_F(EngineLoadTrackerTest, EqualSessionsAlternate)
+{
+    uint32_t sessions[MOS_GPU_NODE_MAX] = {};
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        MOS_GPU_NODE node = StartSession();
+        ASSERT_TRUE(node == MOS_GPU_NODE_VIDEO || node == MOS_GPU_NODE_VIDEO2);
+        sessions[node]++;
+    }
+
+    EXPECT_EQ(4u, sessions[MOS_GPU_NODE_VIDEO]);
+    EXPECT_EQ(4u, sessions[MOS_GPU_NODE_VIDEO2]);
+}
+
+TEST_F(EngineLoadTrackerTest, HeavySessionsSpread)
+{
+    // Two 4K decodes taking 30 ms a frame, then two 1080p decodes taking 4 ms,
+    // the running sessions take turns on their engines
+    const uint64_t busyNs[] = {30000000, 30000000, 4000000, 4000000};
+    MOS_GPU_NODE   nodes[4];
+
+    for (uint32_t session = 0; session < 4; session++)
+    {
+        nodes[session] = StartSession();
+        for (uint32_t frame = 0; frame < 16; frame++)
+        {
+            for (uint32_t running = 0; running <= session; running++)
+            {
+                RunFrames(nodes[running], 1, busyNs[running]);
+            }
+        }
+    }
+
+    EXPECT_NE(nodes[0], nodes[1]);
+    EXPECT_NE(nodes[2], nodes[3]);
+    EXPECT_EQ(2u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).sessions);
+    EXPECT_EQ(2u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO2).sessions);
+}
+
+TEST_F(EngineLoadTrackerTest, BusyEngineAvoided)
+{
+    // The first engine runs a heavy stream with frames queued, the second a light one
+    m_tracker.BindSession(MOS_GPU_NODE_VIDEO);
+    RunFrames(MOS_GPU_NODE_VIDEO, 8, 30000000);
+    m_tracker.Submitted(MOS_GPU_NODE_VIDEO);
+    m_tracker.Submitted(MOS_GPU_NODE_VIDEO);
+
+    m_tracker.BindSession(MOS_GPU_NODE_VIDEO2);
+    RunFrames(MOS_GPU_NODE_VIDEO2, 8, 2000000);
+
+    // Counting sessions alone would call this a tie
+    EXPECT_EQ(m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).sessions, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO2).sessions);
+    EXPECT_GT(m_tracker.GetCost(MOS_GPU_NODE_VIDEO), m_tracker.GetCost(MOS_GPU_NODE_VIDEO2));
+
+    // Light sessions go to the second engine until it carries as much work
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(MOS_GPU_NODE_VIDEO2, StartSession());
+    }
+}
+
+TEST_F(EngineLoadTrackerTest, SessionsEndedFreeEngine)
+{
+    MOS_GPU_NODE first  = StartSession();
+    MOS_GPU_NODE second = StartSession();
+    EXPECT_NE(first, second);
+    RunFrames(first, 4, 10000000);
+    RunFrames(second, 4, 10000000);
+
+    m_tracker.UnbindSession(first);
+    EXPECT_EQ(first, StartSession());
+}
+
+TEST_F(EngineLoadTrackerTest, BusyTimeAverage)
+{
+    RunFrames(MOS_GPU_NODE_VIDEO, 1, 8000000);
+    EXPECT_EQ(8000000u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).busyNs);
+
+    // Every sample moves the average by 1/8 of its distance
+    RunFrames(MOS_GPU_NODE_VIDEO, 1, 16000000);
+    EXPECT_EQ(9000000u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).busyNs);
+    RunFrames(MOS_GPU_NODE_VIDEO, 1, 1000000);
+    EXPECT_EQ(8000000u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).busyNs);
+
+    MOS_ENGINE_LOAD load = m_tracker.GetLoad(MOS_GPU_NODE_VIDEO);
+    EXPECT_EQ(3u, load.samples);
+    EXPECT_EQ(0u, load.outstanding);
+}
+
+TEST_F(EngineLoadTrackerTest, OutstandingFrames)
+{
+    m_tracker.BindSession(MOS_GPU_NODE_VIDEO);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        m_tracker.Submitted(MOS_GPU_NODE_VIDEO);
+    }
+    EXPECT_EQ(5u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).outstanding);
+    EXPECT_EQ(6 * MosEngineLoadTracker::m_defaultBusyNs, m_tracker.GetCost(MOS_GPU_NODE_VIDEO));
+
+    m_tracker.Completed(MOS_GPU_NODE_VIDEO, 2000000);
+    m_tracker.Abandoned(MOS_GPU_NODE_VIDEO, 3);
+    EXPECT_EQ(1u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).outstanding);
+
+    // Counters never wrap below zero
+    m_tracker.Abandoned(MOS_GPU_NODE_VIDEO, 8);
+    m_tracker.Completed(MOS_GPU_NODE_VIDEO, 2000000);
+    m_tracker.UnbindSession(MOS_GPU_NODE_VIDEO);
+    m_tracker.UnbindSession(MOS_GPU_NODE_VIDEO);
+    EXPECT_EQ(0u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).outstanding);
+    EXPECT_EQ(0u, m_tracker.GetLoad(MOS_GPU_NODE_VIDEO).sessions);
+    EXPECT_EQ(0u, m_tracker.GetCost(MOS_GPU_NODE_VIDEO));
+}
+
+TEST_F(EngineLoadTrackerTest, InvalidNodes)
+{
+    m_tracker.BindSession(MOS_GPU_NODE_MAX);
+    m_tracker.Submitted(MOS_GPU_NODE_MAX);
+    m_tracker.Completed(MOS_GPU_NODE_MAX, 1000);
+    EXPECT_EQ(0u, m_tracker.GetLoad(MOS_GPU_NODE_MAX).sessions);
+    EXPECT_EQ(MOS_GPU_NODE_MAX, m_tracker.SelectNode(nullptr, 0));
+
+    const MOS_GPU_NODE nodes[] = {MOS_GPU_NODE_MAX, MOS_GPU_NODE_VIDEO2};
+    EXPECT_EQ(MOS_GPU_NODE_VIDEO2, m_tracker.SelectNode(nodes, 2));
+}
@@ -0,0 +1,196 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include "gtest/gtest.h"
+#include "media_copy_cost_model.h"
+
+using namespace std;
+
+// Engines in the order MediaCopyBaseState::CopyEnigneSelect prefers them for performance
+static const MCPY_ENGINE perfOrder[] = {MCPY_ENGINE_RENDER, MCPY_ENGINE_BLT, MCPY_ENGINE_VEBOX};
+
+static const char *EngineName(MCPY_ENGINE engine)
+{
+    switch (engine)
+    {
+    case MCPY_ENGINE_VEBOX:
+        return "VEBOX";
+    case MCPY_ENGINE_BLT:
+        return "BLT";
+    case MCPY_ENGINE_RENDER:
+        return "RENDER";
+    default:
+        return "NONE";
+    }
+}
+
+static MCPY_COPY_DESC Copy(uint64_t size, MOS_TILE_TYPE tileMode, MOS_RESOURCE_MMC_MODE compressionMode)
+{
+    MCPY_COPY_DESC copy     = {};
+    copy.size               = size;
+    copy.srcTileMode        = tileMode;
+    copy.dstTileMode        = tileMode;
+    copy.srcCompressionMode = compressionMode;
+    return copy;
+}
+
+TEST(MediaCopyCostModelTest, CostOfCopy)
+{
+    MediaCopyCostModel model;
+    MCPY_COST_TABLE    table = {};
+    table.engine[MCPY_ENGINE_BLT] = {16000, 12000, 15};
+    table.resolveBytesPerUs       = 30000;
+    model.SetTable(table);
+
+    // Setup, then the copy at the linear rate
+    MCPY_COPY_DESC copy = Copy(1200000, MOS_TILE_LINEAR, MOS_MMC_DISABLED);
+    EXPECT_EQ(15000u + 75000u, model.GetCostNs(MCPY_ENGINE_BLT, copy));
+
+    // One tiled surface is enough for the tiled rate
+    copy.dstTileMode = MOS_TILE_Y;
+    EXPECT_EQ(15000u + 100000u, model.GetCostNs(MCPY_ENGINE_BLT, copy));
+
+    // A compressed tiled source is resolved first, then the queued work is waited for
+    copy.srcTileMode        = MOS_TILE_Y;
+    copy.srcCompressionMode = MOS_MMC_MC;
+    copy.queuedNs[MCPY_ENGINE_BLT] = 2000000;
+    EXPECT_EQ(15000u + 100000u + 40000u + 2000000u, model.GetCostNs(MCPY_ENGINE_BLT, copy));
+
+    // Engines without throughput cannot be estimated
+    EXPECT_EQ(UINT64_MAX, model.GetCostNs(MCPY_ENGINE_RENDER, copy));
+    EXPECT_EQ(UINT64_MAX, model.GetCostNs(MCPY_ENGINE_MAX, copy));
+}
+
+TEST(MediaCopyCostModelTest, SelectionMatrix)
+{
+    struct Case
+    {
+        const char           *name;
+        uint64_t              size;
+        MOS_TILE_TYPE         tileMode;
+        MOS_RESOURCE_MMC_MODE compressionMode;
+        MCPY_ENGINE_CAPS      caps;
+        uint64_t              renderQueuedNs;
+        MCPY_ENGINE           expected;
+    };
+
+    const MCPY_ENGINE_CAPS all      = {1, 1, 1, 0};
+    const MCPY_ENGINE_CAPS noRender = {1, 1, 0, 0};
+    const MCPY_ENGINE_CAPS bltOnly  = {0, 1, 0, 0};
+    const MCPY_ENGINE_CAPS none     = {0, 0, 0, 0};
+
+    // With this example table BLT starts first, render is the fastest once the
+    // copy is large and vebox is the next best on tiled surfaces
+    const Case cases[] =
+    {
+        {"4KB linear",                   4096,    MOS_TILE_LINEAR, MOS_MMC_DISABLED, all,      0,       MCPY_ENGINE_BLT},
+        {"2MB linear",                   2 << 20, MOS_TILE_LINEAR, MOS_MMC_DISABLED, all,      0,       MCPY_ENGINE_BLT},
+        {"4MB linear",                   4 << 20, MOS_TILE_LINEAR, MOS_MMC_DISABLED, all,      0,       MCPY_ENGINE_RENDER},
+        {"16KB tiled",                   16384,   MOS_TILE_Y,      MOS_MMC_DISABLED, all,      0,       MCPY_ENGINE_BLT},
+        {"8MB tiled",                    8 << 20, MOS_TILE_Y,      MOS_MMC_DISABLED, all,      0,       MCPY_ENGINE_RENDER},
+        {"8MB tiled, compressed",        8 << 20, MOS_TILE_Y,      MOS_MMC_MC,       all,      0,       MCPY_ENGINE_RENDER},
+        {"8MB tiled, no render",         8 << 20, MOS_TILE_Y,      MOS_MMC_DISABLED, noRender, 0,       MCPY_ENGINE_VEBOX},
+        {"1MB tiled, no render",         1 << 20, MOS_TILE_Y,      MOS_MMC_DISABLED, noRender, 0,       MCPY_ENGINE_VEBOX},
+        {"64KB tiled, no render",        65536,   MOS_TILE_Y,      MOS_MMC_DISABLED, noRender, 0,       MCPY_ENGINE_BLT},
+        {"64KB tiled, compressed",       65536,   MOS_TILE_Y,      MOS_MMC_RC,       noRender, 0,       MCPY_ENGINE_BLT},
+        {"256KB tiled, compressed",      262144,  MOS_TILE_Y,      MOS_MMC_RC,       noRender, 0,       MCPY_ENGINE_VEBOX},
+        {"8MB linear, render queued",    8 << 20, MOS_TILE_LINEAR, MOS_MMC_DISABLED, all,      1000000, MCPY_ENGINE_BLT},
+        {"8MB tiled, render queued",     8 << 20, MOS_TILE_Y,      MOS_MMC_DISABLED, all,      2000000, MCPY_ENGINE_VEBOX},
+        {"8MB tiled, blt only",          8 << 20, MOS_TILE_Y,      MOS_MMC_MC,       bltOnly,  0,       MCPY_ENGINE_BLT},
+        {"no engine",                    4096,    MOS_TILE_LINEAR, MOS_MMC_DISABLED, none,     0,       MCPY_ENGINE_MAX},
+    };
+
+    MediaCopyCostModel model;
+    MCPY_COST_TABLE    table = {};
+    table.engine[MCPY_ENGINE_VEBOX]  = {10000, 20000, 30};
+    table.engine[MCPY_ENGINE_BLT]    = {16000, 12000, 15};
+    table.engine[MCPY_ENGINE_RENDER] = {20000, 40000, 60};
+    table.resolveBytesPerUs          = 30000;
+    model.SetTable(table);
+    ASSERT_TRUE(model.IsCalibrated());
+
+    printf("[ MCPY COST MODEL ] %-28s %12s %12s %12s  %s\n", "copy", "render us", "blt us", "vebox us", "engine");
+    for (auto &c : cases)
+    {
+        MCPY_COPY_DESC copy = Copy(c.size, c.tileMode, c.compressionMode);
+        copy.queuedNs[MCPY_ENGINE_RENDER] = c.renderQueuedNs;
+
+        MCPY_ENGINE engine = model.SelectEngine(c.caps, copy, perfOrder, sizeof(perfOrder) / sizeof(perfOrder[0]));
+        printf("[ MCPY COST MODEL ] %-28s %12.1f %12.1f %12.1f  %s\n",
+            c.name,
+            model.GetCostNs(MCPY_ENGINE_RENDER, copy) / 1000.0,
+            model.GetCostNs(MCPY_ENGINE_BLT, copy) / 1000.0,
+            model.GetCostNs(MCPY_ENGINE_VEBOX, copy) / 1000.0,
+            EngineName(engine));
+        EXPECT_EQ(c.expected, engine) << c.name;
+    }
+}
+
+TEST(MediaCopyCostModelTest, NotCalibratedKeepsPreferredOrder)
+{
+    MediaCopyCostModel model;
+    EXPECT_FALSE(model.IsCalibrated());
+
+    const MCPY_ENGINE_CAPS all      = {1, 1, 1, 0};
+    const MCPY_ENGINE_CAPS noRender = {1, 1, 0, 0};
+    const MCPY_ENGINE_CAPS veboxOnly = {1, 0, 0, 0};
+
+    // Queued work does not move the copy without throughput to weigh it against
+    MCPY_COPY_DESC copy = Copy(8 << 20, MOS_TILE_Y, MOS_MMC_MC);
+    copy.queuedNs[MCPY_ENGINE_RENDER] = 10000000;
+    EXPECT_EQ(MCPY_ENGINE_RENDER, model.SelectEngine(all, copy, perfOrder, 3));
+    EXPECT_EQ(MCPY_ENGINE_BLT, model.SelectEngine(noRender, copy, perfOrder, 3));
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, model.SelectEngine(veboxOnly, copy, perfOrder, 3));
+
+    const MCPY_ENGINE balanceOrder[] = {MCPY_ENGINE_VEBOX, MCPY_ENGINE_BLT, MCPY_ENGINE_RENDER};
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, model.SelectEngine(all, copy, balanceOrder, 3));
+}
+
+TEST(MediaCopyCostModelTest, TiesKeepPreferredOrder)
+{
+    MediaCopyCostModel model;
+    MCPY_COST_TABLE    table = {};
+    for (auto &engine : table.engine)
+    {
+        engine = {10000, 10000, 10};
+    }
+    model.SetTable(table);
+
+    const MCPY_ENGINE_CAPS all  = {1, 1, 1, 0};
+    MCPY_COPY_DESC         copy = Copy(1 << 20, MOS_TILE_LINEAR, MOS_MMC_DISABLED);
+    EXPECT_EQ(MCPY_ENGINE_RENDER, model.SelectEngine(all, copy, perfOrder, 3));
+
+    const MCPY_ENGINE balanceOrder[] = {MCPY_ENGINE_VEBOX, MCPY_ENGINE_BLT, MCPY_ENGINE_RENDER};
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, model.SelectEngine(all, copy, balanceOrder, 3));
+
+    // Work queued on the preferred engine moves the copy
+    copy.queuedNs[MCPY_ENGINE_RENDER] = 1;
+    EXPECT_EQ(MCPY_ENGINE_BLT, model.SelectEngine(all, copy, perfOrder, 3));
+
+    // An engine without throughput is only taken when it is the only one able to copy
+    table.engine[MCPY_ENGINE_BLT] = {};
+    model.SetTable(table);
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, model.SelectEngine(all, copy, perfOrder, 3));
+    const MCPY_ENGINE_CAPS bltOnly = {0, 1, 0, 0};
+    EXPECT_EQ(MCPY_ENGINE_BLT, model.SelectEngine(bltOnly, copy, perfOrder, 3));
+    EXPECT_EQ(MCPY_ENGINE_MAX, model.SelectEngine(bltOnly, copy, perfOrder, 0));
+}
@@ -0,0 +1,163 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "mos_engine_load_tracker.h"
+#include "media_copy_load_tracker.h"
+
+class MediaCopyLoadTrackerTest : public testing::Test
+{
+protected:
+    virtual void SetUp() { m_tracker.Reset(); }
+
+    virtual void TearDown() { m_tracker.Reset(); }
+
+    uint32_t Outstanding(MCPY_ENGINE engine)
+    {
+        return m_tracker.GetLoad(MediaCopyLoadTracker::GetNode(engine)).outstanding;
+    }
+
+    uint64_t BusyNs(MCPY_ENGINE engine)
+    {
+        return m_tracker.GetLoad(MediaCopyLoadTracker::GetNode(engine)).busyNs;
+    }
+
+    MosEngineLoadTracker &m_tracker = MosEngineLoadTracker::Instance();
+};
+
+TEST_F(MediaCopyLoadTrackerTest, Nodes)
+{
+    EXPECT_EQ(MOS_GPU_NODE_VE, MediaCopyLoadTracker::GetNode(MCPY_ENGINE_VEBOX));
+    EXPECT_EQ(MOS_GPU_NODE_BLT, MediaCopyLoadTracker::GetNode(MCPY_ENGINE_BLT));
+    EXPECT_EQ(MOS_GPU_NODE_3D, MediaCopyLoadTracker::GetNode(MCPY_ENGINE_RENDER));
+    EXPECT_EQ(MOS_GPU_NODE_MAX, MediaCopyLoadTracker::GetNode(MCPY_ENGINE_MAX));
+}
+
+TEST_F(MediaCopyLoadTrackerTest, TaggedCopiesComplete)
+{
+    MediaCopyLoadTracker copies;
+
+    // Three BLT copies back to back, the engine takes 300 us for all of them
+    copies.Submitted(MCPY_ENGINE_BLT, true, 10, 1000000);
+    copies.Submitted(MCPY_ENGINE_BLT, true, 11, 1000000);
+    copies.Submitted(MCPY_ENGINE_BLT, true, 12, 1000000);
+    EXPECT_EQ(3u, Outstanding(MCPY_ENGINE_BLT));
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_VEBOX));
+
+    // Not reached yet
+    copies.Poll(MCPY_ENGINE_BLT, 9, 1100000);
+    EXPECT_EQ(3u, copies.GetPending(MCPY_ENGINE_BLT));
+    EXPECT_EQ(0u, BusyNs(MCPY_ENGINE_BLT));
+
+    // The first two are done, they share the time since the submission
+    copies.Poll(MCPY_ENGINE_BLT, 11, 1200000);
+    EXPECT_EQ(1u, copies.GetPending(MCPY_ENGINE_BLT));
+    EXPECT_EQ(1u, Outstanding(MCPY_ENGINE_BLT));
+    EXPECT_EQ(100000u, BusyNs(MCPY_ENGINE_BLT));
+
+    // The last one only counts the time since the previous ones were seen done
+    copies.Poll(MCPY_ENGINE_BLT, 12, 1300000);
+    EXPECT_EQ(0u, copies.GetPending(MCPY_ENGINE_BLT));
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_BLT));
+    EXPECT_EQ(100000u, BusyNs(MCPY_ENGINE_BLT));
+}
+
+TEST_F(MediaCopyLoadTrackerTest, TagWraps)
+{
+    MediaCopyLoadTracker copies;
+
+    copies.Submitted(MCPY_ENGINE_VEBOX, true, 0xFFFFFFFF, 0);
+    copies.Submitted(MCPY_ENGINE_VEBOX, true, 0, 0);
+    copies.Submitted(MCPY_ENGINE_VEBOX, true, 1, 0);
+
+    copies.Poll(MCPY_ENGINE_VEBOX, 0xFFFFFFFE, 1000);
+    EXPECT_EQ(3u, copies.GetPending(MCPY_ENGINE_VEBOX));
+
+    copies.Poll(MCPY_ENGINE_VEBOX, 0, 2000);
+    EXPECT_EQ(1u, copies.GetPending(MCPY_ENGINE_VEBOX));
+    EXPECT_EQ(1u, Outstanding(MCPY_ENGINE_VEBOX));
+}
+
+TEST_F(MediaCopyLoadTrackerTest, UntaggedCopiesTimeOut)
+{
+    MediaCopyLoadTracker copies;
+
+    // Without sample, copies which do not write the tag are dropped after the default busy time
+    copies.Submitted(MCPY_ENGINE_BLT, false, 0, 0);
+    copies.Poll(MCPY_ENGINE_BLT, 0, MosEngineLoadTracker::m_defaultBusyNs - 1);
+    EXPECT_EQ(1u, Outstanding(MCPY_ENGINE_BLT));
+    copies.Poll(MCPY_ENGINE_BLT, 0, MosEngineLoadTracker::m_defaultBusyNs);
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_BLT));
+    EXPECT_EQ(0u, BusyNs(MCPY_ENGINE_BLT));
+
+    // With a sample they are dropped after the average frame, in order with the tagged ones
+    m_tracker.Submitted(MOS_GPU_NODE_BLT);
+    m_tracker.Completed(MOS_GPU_NODE_BLT, 50000);
+    copies.Submitted(MCPY_ENGINE_BLT, false, 0, 0);
+    copies.Submitted(MCPY_ENGINE_BLT, true, 5, 0);
+    copies.Poll(MCPY_ENGINE_BLT, 5, 40000);
+    EXPECT_EQ(2u, copies.GetPending(MCPY_ENGINE_BLT));
+    copies.Poll(MCPY_ENGINE_BLT, 5, 50000);
+    EXPECT_EQ(0u, copies.GetPending(MCPY_ENGINE_BLT));
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_BLT));
+}
+
+TEST_F(MediaCopyLoadTrackerTest, PendingIsBounded)
+{
+    MediaCopyLoadTracker copies;
+
+    // Copies never seen done do not pile up
+    for (uint32_t i = 0; i < MediaCopyLoadTracker::m_maxPending + 10; i++)
+    {
+        copies.Submitted(MCPY_ENGINE_RENDER, true, i, 0);
+    }
+    EXPECT_EQ(MediaCopyLoadTracker::m_maxPending, copies.GetPending(MCPY_ENGINE_RENDER));
+    EXPECT_EQ(MediaCopyLoadTracker::m_maxPending, Outstanding(MCPY_ENGINE_RENDER));
+
+    // The dropped ones are not completed again
+    copies.Poll(MCPY_ENGINE_RENDER, MediaCopyLoadTracker::m_maxPending + 9, 1000);
+    EXPECT_EQ(0u, copies.GetPending(MCPY_ENGINE_RENDER));
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_RENDER));
+}
+
+TEST_F(MediaCopyLoadTrackerTest, DestroyedStateDropsPending)
+{
+    {
+        MediaCopyLoadTracker copies;
+        copies.Submitted(MCPY_ENGINE_VEBOX, true, 1, 0);
+        copies.Submitted(MCPY_ENGINE_BLT, true, 1, 0);
+        copies.Submitted(MCPY_ENGINE_BLT, false, 0, 0);
+        copies.Submitted(MCPY_ENGINE_MAX, true, 1, 0);
+        EXPECT_EQ(1u, Outstanding(MCPY_ENGINE_VEBOX));
+        EXPECT_EQ(2u, Outstanding(MCPY_ENGINE_BLT));
+    }
+
+    // Other users of the nodes keep their frames
+    m_tracker.Submitted(MOS_GPU_NODE_3D);
+    {
+        MediaCopyLoadTracker copies;
+        copies.Submitted(MCPY_ENGINE_RENDER, true, 1, 0);
+        EXPECT_EQ(2u, Outstanding(MCPY_ENGINE_RENDER));
+    }
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_VEBOX));
+    EXPECT_EQ(0u, Outstanding(MCPY_ENGINE_BLT));
+    EXPECT_EQ(1u, Outstanding(MCPY_ENGINE_RENDER));
+}
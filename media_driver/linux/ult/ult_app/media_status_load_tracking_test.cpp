@@ -0,0 +1,103 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "media_status_load_tracking.h"
+
+static const uint32_t g_frameNum = 4;
+
+TEST(MediaStatusLoadTrackingTest, BusyUntilCompletionSeen)
+{
+    MediaStatusLoadTracking<g_frameNum> tracking;
+    uint64_t                            busyNs = 0;
+
+    tracking.Start(0);
+    tracking.Submitted(0, 1000);
+    EXPECT_EQ(1u, tracking.GetPending());
+    EXPECT_EQ(0u, tracking.Completed(0, 2000, busyNs));
+
+    EXPECT_EQ(1u, tracking.Completed(1, 5000, busyNs));
+    EXPECT_EQ(4000u, busyNs);
+    EXPECT_EQ(0u, tracking.GetPending());
+}
+
+// There are no GPU timestamps in the status report, the frame is busy until
+// the CPU reads the completed count, so reading it late makes it look longer
+TEST(MediaStatusLoadTrackingTest, BusyDependsOnPolling)
+{
+    MediaStatusLoadTracking<g_frameNum> early;
+    MediaStatusLoadTracking<g_frameNum> late;
+    uint64_t                            earlyNs = 0;
+    uint64_t                            lateNs  = 0;
+
+    early.Submitted(0, 1000);
+    late.Submitted(0, 1000);
+
+    // Completed at 3000 on the GPU, seen right away or 10 us later
+    EXPECT_EQ(1u, early.Completed(1, 3000, earlyNs));
+    EXPECT_EQ(1u, late.Completed(1, 13000, lateNs));
+    EXPECT_EQ(2000u, earlyNs);
+    EXPECT_EQ(12000u, lateNs);
+}
+
+TEST(MediaStatusLoadTrackingTest, CompletionsSeenTogetherShareTime)
+{
+    MediaStatusLoadTracking<g_frameNum> tracking;
+    uint64_t                            busyNs = 0;
+
+    tracking.Start(10);
+    tracking.Submitted(10, 1000);
+    tracking.Submitted(11, 1500);
+    tracking.Submitted(12, 2000);
+    EXPECT_EQ(2u, tracking.Completed(12, 7000, busyNs));
+    EXPECT_EQ(3000u, busyNs);
+
+    // Back to back frames start when the previous one was seen done
+    EXPECT_EQ(1u, tracking.Completed(13, 9000, busyNs));
+    EXPECT_EQ(2000u, busyNs);
+}
+
+TEST(MediaStatusLoadTrackingTest, UntrackedFramesIgnored)
+{
+    MediaStatusLoadTracking<g_frameNum> tracking;
+    uint64_t                            busyNs = 0;
+
+    // Frames submitted before tracking started complete without being counted
+    tracking.Start(5);
+    EXPECT_EQ(0u, tracking.Completed(3, 1000, busyNs));
+    tracking.Submitted(5, 2000);
+    EXPECT_EQ(1u, tracking.Completed(9, 3000, busyNs));
+    EXPECT_EQ(1000u, busyNs);
+    EXPECT_EQ(0u, tracking.GetPending());
+}
+
+TEST(MediaStatusLoadTrackingTest, CounterWraps)
+{
+    MediaStatusLoadTracking<g_frameNum> tracking;
+    uint64_t                            busyNs = 0;
+
+    tracking.Start(0xFFFFFFFF);
+    tracking.Submitted(0xFFFFFFFF, 1000);
+    tracking.Submitted(0, 1000);
+    EXPECT_EQ(2u, tracking.GetPending());
+    EXPECT_EQ(2u, tracking.Completed(1, 5000, busyNs));
+    EXPECT_EQ(2000u, busyNs);
+}
@@ -0,0 +1,233 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_oca_defs_specific.h"
+
+using namespace std;
+
+static uint64_t NowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Adds the resource to the list the way AddResourceToDumpList does, returns its index
+static int32_t AddResource(MosOcaResInfoIndex &index, MOS_OCA_RESOURCE_INFO *list, uint32_t &count, uint64_t handle)
+{
+    uint32_t entry = 0;
+    int32_t  found = index.Find(list, handle, entry);
+    if (found >= 0 || count >= OCA_MAX_RESOURCE_INFO_COUNT_MAX)
+    {
+        return found;
+    }
+    list[count].allocationHandle = handle;
+    index.Insert(entry, count);
+    return count++;
+}
+
+TEST(OcaBufIndexTest, ResInfoIndexFindsEveryResource)
+{
+    MOS_OCA_RESOURCE_INFO list[OCA_MAX_RESOURCE_INFO_COUNT_MAX] = {};
+    MosOcaResInfoIndex    index;
+    uint32_t              count = 0;
+
+    // GEM handles are small and dense, some also collide in the low bits
+    for (uint64_t handle = 1; handle <= OCA_MAX_RESOURCE_INFO_COUNT_MAX; ++handle)
+    {
+        uint64_t h        = (handle % 2) ? handle : handle * OCA_RES_INFO_INDEX_SIZE;
+        int32_t  expected = (int32_t)count;
+        EXPECT_EQ(expected, AddResource(index, list, count, h));
+    }
+    EXPECT_EQ((uint32_t)OCA_MAX_RESOURCE_INFO_COUNT_MAX, count);
+
+    for (uint64_t handle = 1; handle <= OCA_MAX_RESOURCE_INFO_COUNT_MAX; ++handle)
+    {
+        uint64_t h     = (handle % 2) ? handle : handle * OCA_RES_INFO_INDEX_SIZE;
+        uint32_t entry = 0;
+        EXPECT_EQ((int32_t)(handle - 1), index.Find(list, h, entry));
+    }
+
+    // The list is full, new resources are not found and not added
+    EXPECT_EQ(-1, AddResource(index, list, count, 100000));
+
+    index.Reset();
+    uint32_t entry = 0;
+    EXPECT_EQ(-1, index.Find(list, 1, entry));
+    EXPECT_LT(entry, (uint32_t)OCA_RES_INFO_INDEX_SIZE);
+}
+
+TEST(OcaBufIndexTest, SlotsRotate)
+{
+    MosOcaBufSlots slots;
+    EXPECT_EQ(0, slots.Acquire(0));
+    EXPECT_EQ(1, slots.Acquire(0));
+    EXPECT_EQ(5, slots.Acquire(5));
+    EXPECT_TRUE(slots.IsInUse(5));
+
+    // The search wraps around
+    EXPECT_EQ(MAX_NUM_OF_OCA_BUF_CONTEXT - 1, slots.Acquire(MAX_NUM_OF_OCA_BUF_CONTEXT - 1));
+    EXPECT_EQ(2, slots.Acquire(MAX_NUM_OF_OCA_BUF_CONTEXT - 1));
+
+    EXPECT_TRUE(slots.Release(1));
+    EXPECT_FALSE(slots.Release(1));
+    EXPECT_FALSE(slots.Release(MAX_NUM_OF_OCA_BUF_CONTEXT));
+    EXPECT_EQ(1, slots.Acquire(0));
+
+    for (int32_t i = 0; i < MAX_NUM_OF_OCA_BUF_CONTEXT - 5; ++i)
+    {
+        EXPECT_GE(slots.Acquire(0), 0);
+    }
+    EXPECT_EQ(-1, slots.Acquire(0));
+}
+
+TEST(OcaBufIndexTest, SlotsConcurrent)
+{
+    MosOcaBufSlots slots;
+    const int32_t  threadNum = 8;
+    const int32_t  loops     = 20000;
+    vector<thread> threads;
+    int32_t        failures[threadNum] = {};
+
+    // Every thread keeps 4 slots at a time, so the contexts are never all in use
+    for (int32_t t = 0; t < threadNum; ++t)
+    {
+        threads.push_back(thread([&slots, &failures, t]() {
+            for (int32_t i = 0; i < loops; ++i)
+            {
+                int32_t held[4];
+                for (auto &slot : held)
+                {
+                    slot = slots.Acquire(t * 4);
+                }
+                for (auto slot : held)
+                {
+                    if (slot < 0 || !slots.Release(slot))
+                    {
+                        failures[t]++;
+                    }
+                }
+            }
+        }));
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+
+    for (int32_t t = 0; t < threadNum; ++t)
+    {
+        EXPECT_EQ(0, failures[t]);
+    }
+    for (uint32_t slot = 0; slot < MAX_NUM_OF_OCA_BUF_CONTEXT; ++slot)
+    {
+        EXPECT_FALSE(slots.IsInUse(slot));
+    }
+}
+
+TEST(OcaBufIndexTest, IndexMatchesScan)
+{
+    // Resources referenced repeatedly get the index the linear scan finds
+    MOS_OCA_RESOURCE_INFO scanList[OCA_MAX_RESOURCE_INFO_COUNT_MAX]  = {};
+    MOS_OCA_RESOURCE_INFO indexList[OCA_MAX_RESOURCE_INFO_COUNT_MAX] = {};
+    MosOcaResInfoIndex    index;
+    uint32_t              scanCount  = 0;
+    uint32_t              indexCount = 0;
+    uint32_t              mismatches = 0;
+
+    for (uint32_t r = 0; r < 4; ++r)
+    {
+        for (uint64_t handle = 1; handle <= OCA_MAX_RESOURCE_INFO_COUNT_MAX; ++handle)
+        {
+            uint32_t i = 0;
+            for (; i < scanCount && scanList[i].allocationHandle != handle; ++i);
+            if (i == scanCount)
+            {
+                scanList[scanCount++].allocationHandle = handle;
+            }
+            mismatches += (AddResource(index, indexList, indexCount, handle) != (int32_t)i);
+        }
+    }
+    EXPECT_EQ(0u, mismatches);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST(OcaBufIndexTest, DISABLED_Benchmark)
+{
+    // A submission dumps 60 resources, each one referenced by 16 commands
+    const uint32_t submissions = 2000;
+    const uint32_t references  = 16;
+
+    MOS_OCA_RESOURCE_INFO list[OCA_MAX_RESOURCE_INFO_COUNT_MAX] = {};
+    MosOcaResInfoIndex    index;
+    uint64_t              checksum[2] = {};
+
+    uint64_t start = NowNs();
+    for (uint32_t s = 0; s < submissions; ++s)
+    {
+        uint32_t count = 0;
+        for (uint32_t r = 0; r < references; ++r)
+        {
+            for (uint64_t handle = 1; handle <= OCA_MAX_RESOURCE_INFO_COUNT_MAX; ++handle)
+            {
+                uint32_t i = 0;
+                for (; i < count && list[i].allocationHandle != handle; ++i);
+                if (i == count)
+                {
+                    list[count++].allocationHandle = handle;
+                }
+                checksum[0] += i;
+            }
+        }
+    }
+    uint64_t scanned = NowNs();
+    for (uint32_t s = 0; s < submissions; ++s)
+    {
+        uint32_t count = 0;
+        index.Reset();
+        for (uint32_t r = 0; r < references; ++r)
+        {
+            for (uint64_t handle = 1; handle <= OCA_MAX_RESOURCE_INFO_COUNT_MAX; ++handle)
+            {
+                checksum[1] += AddResource(index, list, count, handle);
+            }
+        }
+    }
+    uint64_t indexed = NowNs();
+
+    MosOcaBufSlots slots;
+    for (uint32_t s = 0; s < submissions; ++s)
+    {
+        slots.Release(slots.Acquire(s % MAX_NUM_OF_OCA_BUF_CONTEXT));
+    }
+    uint64_t allocated = NowNs();
+
+    EXPECT_EQ(checksum[0], checksum[1]);
+    printf("[ OCA BENCHMARK ] %u submissions, average ns: resource scan %.1f, resource index %.1f, slot acquire and release %.1f\n",
+        submissions,
+        (double)(scanned - start) / submissions,
+        (double)(indexed - scanned) / submissions,
+        (double)(allocated - indexed) / submissions);
+}
@@ -0,0 +1,160 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_recycle_list.h"
+
+using namespace std;
+
+// Stands in for MOS_RESOURCE, the list only copies items around
+struct MockResource
+{
+    uint32_t id;
+    bool     busy;
+};
+
+class RecycleListTest : public testing::Test
+{
+protected:
+    RecycleListTest() : m_list(1000) {}
+
+    bool Acquire(uint32_t key, MockResource &item)
+    {
+        return m_list.Acquire(key, item, [](MockResource &pooled) { return pooled.busy; });
+    }
+
+    void Recycle(uint32_t key, uint32_t id, uint64_t size, bool busy = false)
+    {
+        ASSERT_TRUE(m_list.Fits(size));
+        m_list.Recycle(key, MockResource{id, busy}, size, [this](MockResource &trimmed) {
+            m_freed.push_back(trimmed.id);
+        });
+    }
+
+    MediaRecycleList<uint32_t, MockResource> m_list;
+    vector<uint32_t>                         m_freed;
+};
+
+TEST_F(RecycleListTest, HitAndMiss)
+{
+    MockResource item = {};
+    EXPECT_FALSE(Acquire(1, item));
+
+    Recycle(1, 10, 100);
+    EXPECT_FALSE(Acquire(2, item));
+    EXPECT_TRUE(Acquire(1, item));
+    EXPECT_EQ(item.id, 10u);
+    EXPECT_FALSE(Acquire(1, item));
+
+    const MEDIA_RECYCLE_POOL_STATS &stats = m_list.GetStatistics();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.recycled, 1u);
+    EXPECT_EQ(stats.cachedBytes, 0u);
+    EXPECT_EQ(stats.peakBytes, 100u);
+}
+
+TEST_F(RecycleListTest, OldestOfKeyFirst)
+{
+    Recycle(1, 10, 100);
+    Recycle(2, 20, 100);
+    Recycle(1, 11, 100);
+
+    MockResource item = {};
+    EXPECT_TRUE(Acquire(1, item));
+    EXPECT_EQ(item.id, 10u);
+    EXPECT_TRUE(Acquire(1, item));
+    EXPECT_EQ(item.id, 11u);
+    EXPECT_TRUE(Acquire(2, item));
+    EXPECT_EQ(item.id, 20u);
+}
+
+TEST_F(RecycleListTest, SkipsBusy)
+{
+    Recycle(1, 10, 100, true);
+    Recycle(1, 11, 100);
+
+    MockResource item = {};
+    EXPECT_TRUE(Acquire(1, item));
+    EXPECT_EQ(item.id, 11u);
+
+    // only the busy one is left, the caller has to allocate
+    EXPECT_FALSE(Acquire(1, item));
+
+    const MEDIA_RECYCLE_POOL_STATS &stats = m_list.GetStatistics();
+    EXPECT_EQ(stats.busySkips, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.cachedBytes, 100u);
+}
+
+TEST_F(RecycleListTest, TrimsPastHighWaterMark)
+{
+    for (uint32_t id = 0; id < 10; id++)
+    {
+        Recycle(id % 3, id, 100);
+    }
+    EXPECT_TRUE(m_freed.empty());
+    EXPECT_EQ(m_list.GetStatistics().cachedBytes, 1000u);
+
+    // going past the mark frees the least recently recycled down to half of it
+    Recycle(0, 10, 100);
+    EXPECT_EQ(m_freed, (vector<uint32_t>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(m_list.GetStatistics().cachedBytes, 500u);
+    EXPECT_EQ(m_list.GetStatistics().trimmed, 6u);
+    EXPECT_EQ(m_list.GetStatistics().peakBytes, 1100u);
+
+    // the trimmed ones are gone from the index as well
+    MockResource item = {};
+    EXPECT_TRUE(Acquire(0, item));
+    EXPECT_EQ(item.id, 6u);
+    EXPECT_TRUE(Acquire(1, item));
+    EXPECT_EQ(item.id, 7u);
+    EXPECT_TRUE(Acquire(2, item));
+    EXPECT_EQ(item.id, 8u);
+    EXPECT_TRUE(Acquire(0, item));
+    EXPECT_EQ(item.id, 9u);
+}
+
+TEST_F(RecycleListTest, RejectsOversize)
+{
+    EXPECT_TRUE(m_list.Fits(1000));
+    EXPECT_FALSE(m_list.Fits(1001));
+    m_list.Reject();
+    EXPECT_EQ(m_list.GetStatistics().rejected, 1u);
+}
+
+TEST_F(RecycleListTest, LoweringHighWaterMark)
+{
+    Recycle(1, 10, 300);
+    Recycle(1, 11, 300);
+    Recycle(1, 12, 300);
+
+    m_list.SetHighWaterMark(600, [this](MockResource &trimmed) { m_freed.push_back(trimmed.id); });
+    EXPECT_EQ(m_freed, (vector<uint32_t>{10, 11}));
+    EXPECT_EQ(m_list.GetStatistics().cachedBytes, 300u);
+
+    m_list.SetHighWaterMark(0, [this](MockResource &trimmed) { m_freed.push_back(trimmed.id); });
+    EXPECT_EQ(m_freed, (vector<uint32_t>{10, 11, 12}));
+    EXPECT_EQ(m_list.GetStatistics().cachedBytes, 0u);
+    EXPECT_FALSE(m_list.Fits(1));
+}
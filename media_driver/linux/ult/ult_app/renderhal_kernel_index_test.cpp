@@ -0,0 +1,205 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+#include "gtest/gtest.h"
+#include "renderhal_kernel_index.h"
+
+using namespace std;
+
+// Kernel allocation table the way RenderHal_LoadKernel drives the index: a hit
+// is touched, a miss takes a free entry or evicts the least recently used kernel
+class KernelHeap
+{
+public:
+    KernelHeap(int32_t kernelCount) : m_kuids(kernelCount, -1)
+    {
+        m_index.Reset(kernelCount);
+    }
+
+    int32_t Load(int32_t kuid)
+    {
+        int32_t id = m_index.Find(kuid, -1);
+        if (id < 0)
+        {
+            id = m_index.GetFreeEntry();
+            if (id < 0)
+            {
+                id = m_index.GetLeastRecentlyUsed();
+                m_index.Unloaded(id, 64);
+                m_evictions++;
+            }
+            m_kuids[id] = kuid;
+            m_index.Loaded(id, kuid, -1);
+        }
+        m_index.Touch(id);
+        return id;
+    }
+
+    RenderHalKernelIndex m_index;
+    vector<int32_t>      m_kuids;
+    uint32_t             m_evictions = 0;
+};
+
+TEST(RenderHalKernelIndexTest, FindLoadedKernels)
+{
+    KernelHeap heap(8);
+    for (int32_t kuid = 0; kuid < 8; kuid++)
+    {
+        EXPECT_EQ(kuid, heap.Load(100 + kuid));
+    }
+    for (int32_t kuid = 0; kuid < 8; kuid++)
+    {
+        EXPECT_EQ(kuid, heap.m_index.Find(100 + kuid, -1));
+    }
+
+    // The cache ID is part of the key
+    EXPECT_EQ(-1, heap.m_index.Find(100, 0));
+    EXPECT_EQ(-1, heap.m_index.GetFreeEntry());
+    EXPECT_EQ(0u, heap.m_evictions);
+}
+
+TEST(RenderHalKernelIndexTest, LeastRecentlyUsedEvicted)
+{
+    KernelHeap heap(4);
+    for (int32_t kuid = 0; kuid < 4; kuid++)
+    {
+        heap.Load(kuid);
+    }
+
+    // Kernel 0 is used again, kernel 1 is now the oldest
+    heap.Load(0);
+    EXPECT_EQ(1, heap.m_index.GetLeastRecentlyUsed());
+
+    int32_t id = heap.Load(4);
+    EXPECT_EQ(1, id);
+    EXPECT_EQ(-1, heap.m_index.Find(1, -1));
+    EXPECT_EQ(1u, heap.m_evictions);
+
+    // From the oldest to the newest: kernels 2, 3, 0 and kernel 4 in entry 1
+    const int32_t order[] = {2, 3, 0, 1};
+    int32_t       i       = 0;
+    for (id = heap.m_index.GetLeastRecentlyUsed(); id >= 0; id = heap.m_index.GetNextRecentlyUsed(id))
+    {
+        ASSERT_LT(i, 4);
+        EXPECT_EQ(order[i++], id);
+    }
+    EXPECT_EQ(4, i);
+}
+
+TEST(RenderHalKernelIndexTest, FreeEntries)
+{
+    RenderHalKernelIndex index;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, index.Reset(6));
+    for (int32_t id = 0; id < 6; id++)
+    {
+        index.Loaded(id, id, 0);
+    }
+
+    // Unloaded kernels keep their blocks, the smallest one large enough is taken
+    index.Unloaded(1, 512);
+    index.Unloaded(3, 128);
+    index.Unloaded(4, 256);
+    EXPECT_FALSE(index.IsLoaded(3));
+    EXPECT_EQ(3, index.GetFreeBlock(100));
+    EXPECT_EQ(4, index.GetFreeBlock(129));
+    EXPECT_EQ(1, index.GetFreeBlock(512));
+    EXPECT_EQ(-1, index.GetFreeBlock(513));
+
+    // Entries without a block go first for blocks from the end of the heap
+    EXPECT_EQ(3, index.GetFreeEntry());
+    index.Unloaded(5, 0);
+    EXPECT_EQ(5, index.GetFreeEntry());
+
+    index.Loaded(3, 10, 0);
+    EXPECT_EQ(4, index.GetFreeBlock(100));
+    EXPECT_EQ(3, index.Find(10, 0));
+    EXPECT_EQ(-1, index.Find(3, 0));
+
+    // Touching free or unknown entries does nothing
+    index.Touch(5);
+    index.Touch(-1);
+    index.Touch(6);
+    EXPECT_EQ(0, index.GetLeastRecentlyUsed());
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, index.Reset(2));
+    EXPECT_EQ(-1, index.Find(10, 0));
+    EXPECT_EQ(-1, index.GetLeastRecentlyUsed());
+    EXPECT_EQ(0, index.GetFreeEntry());
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, index.Reset(-1));
+}
+
+TEST(RenderHalKernelIndexTest, WorkingSetStaysLoaded)
+{
+    // The stream of the benchmark below on a full heap: kernels 0-6 and 8-14
+    // are used every 16 loads, a new kernel comes every 8 loads
+    KernelHeap heap(32);
+    for (int32_t kuid = 0; kuid < 32; kuid++)
+    {
+        heap.Load(1000000 + kuid);
+    }
+
+    int32_t next = 0;
+    for (int32_t i = 0; i < 2000; i++)
+    {
+        int32_t kuid = (i % 8 == 7) ? 2000000 + next++ : i % 16;
+        ASSERT_GE(heap.Load(kuid), 0);
+    }
+
+    // Only the first load of a kernel evicts, the working set is never pushed out
+    EXPECT_EQ(14u + next, heap.m_evictions);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST(RenderHalKernelIndexTest, DISABLED_Benchmark)
+{
+    // A composition-like stream: a working set of 16 kernels loaded over and
+    // over, with one new kernel every 8 loads pushing the oldest ones out
+    const int32_t kernelCounts[] = {32, 256, 2048};
+    const int32_t loads          = 200000;
+
+    for (auto kernelCount : kernelCounts)
+    {
+        KernelHeap heap(kernelCount);
+
+        // Fill the heap before timing, loads always run on a full heap
+        for (int32_t kuid = 0; kuid < kernelCount; kuid++)
+        {
+            heap.Load(1000000 + kuid);
+        }
+
+        int32_t next  = 0;
+        auto    start = chrono::steady_clock::now();
+        for (int32_t i = 0; i < loads; i++)
+        {
+            int32_t kuid = (i % 8 == 7) ? 2000000 + next++ : i % 16;
+            ASSERT_GE(heap.Load(kuid), 0);
+        }
+        auto end = chrono::steady_clock::now();
+
+        printf("[ RENDERHAL BENCHMARK ] %d kernel entries: %.1f ns per load, %u evictions\n",
+            kernelCount,
+            (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count() / loads,
+            heap.m_evictions);
+    }
+}
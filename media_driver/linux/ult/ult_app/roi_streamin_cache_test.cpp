@@ -0,0 +1,185 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_hevc_vdenc_roi_streamin_cache.h"
+
+using namespace encode;
+
+// 1080p stream-in: 60 LCUs of 32x32 a row, 34 + 8 rows, 64 bytes an LCU
+static const uint32_t g_lcuWidth   = 60;
+static const uint32_t g_lcuHeight  = 42;
+static const uint32_t g_lcuSize    = 64;
+static const uint32_t g_spanSize   = g_lcuWidth * 2 * g_lcuSize;
+static const uint32_t g_size       = g_lcuWidth * g_lcuHeight * g_lcuSize;
+static const uint32_t g_bufferNum  = 6;
+
+class RoiStreamInCacheTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, m_cache.Init(g_size, g_spanSize));
+        for (auto &buffer : m_buffers)
+        {
+            buffer.assign(g_size, 0xCD);
+        }
+    }
+
+    // Writes the stream-in data of a frame the way the ROI strategies do,
+    // every LCU of the region gets its own record, the others the background one
+    void MakeFrame(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom, uint8_t qp, std::vector<uint8_t> &frame)
+    {
+        frame.assign(g_size, 0);
+        for (uint32_t lcu = 0; lcu < g_lcuWidth * g_lcuHeight; lcu++)
+        {
+            uint32_t x      = lcu % g_lcuWidth;
+            uint32_t y      = lcu / g_lcuWidth;
+            bool     inRoi  = x >= left && x < right && y >= top && y < bottom;
+            uint8_t *record = &frame[lcu * g_lcuSize];
+            record[0]       = inRoi ? 0x12 : 0;
+            record[1]       = 0x0F;
+            record[56]      = inRoi ? qp : 0;
+            record[27]      = 0x43;
+        }
+    }
+
+    // Runs a frame through the cache into the buffer of the frame number,
+    // returns whether the buffer had to be locked
+    bool RunFrame(uint32_t frameNum, const std::vector<uint8_t> &frame)
+    {
+        uint8_t *data = m_cache.BeginFrame();
+        EXPECT_NE(nullptr, data);
+        memcpy(data, frame.data(), g_size);
+        m_cache.EndFrame();
+
+        std::vector<uint8_t> &buffer = m_buffers[frameNum % g_bufferNum];
+        if (m_cache.IsUpToDate(&buffer))
+        {
+            return false;
+        }
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_cache.Write(&buffer, buffer.data()));
+        return true;
+    }
+
+    RoiStreamInCache     m_cache;
+    std::vector<uint8_t> m_buffers[g_bufferNum];
+};
+
+TEST_F(RoiStreamInCacheTest, BuffersMatchFrames)
+{
+    std::vector<uint8_t> frame;
+    for (uint32_t frameNum = 0; frameNum < 64; frameNum++)
+    {
+        // The region moves every 5 frames and its QP changes every 3
+        uint32_t pos = (frameNum / 5) * 3;
+        MakeFrame(pos % g_lcuWidth, pos % g_lcuHeight, pos % g_lcuWidth + 8, pos % g_lcuHeight + 4, (uint8_t)(20 + frameNum / 3), frame);
+
+        RunFrame(frameNum, frame);
+        ASSERT_EQ(0, memcmp(frame.data(), m_buffers[frameNum % g_bufferNum].data(), g_size)) << "frame " << frameNum;
+        ASSERT_EQ(0, memcmp(frame.data(), m_cache.GetData(), g_size));
+    }
+}
+
+TEST_F(RoiStreamInCacheTest, StaticFramesSkipWrite)
+{
+    std::vector<uint8_t> frame;
+    MakeFrame(4, 4, 20, 10, 26, frame);
+
+    // Every buffer of the ring is written once, then left alone
+    for (uint32_t frameNum = 0; frameNum < g_bufferNum; frameNum++)
+    {
+        EXPECT_TRUE(RunFrame(frameNum, frame));
+        EXPECT_EQ(g_size, m_cache.GetWrittenBytes());
+    }
+    for (uint32_t frameNum = g_bufferNum; frameNum < 4 * g_bufferNum; frameNum++)
+    {
+        EXPECT_FALSE(RunFrame(frameNum, frame));
+    }
+
+    for (auto &buffer : m_buffers)
+    {
+        EXPECT_EQ(0, memcmp(frame.data(), buffer.data(), g_size));
+    }
+}
+
+TEST_F(RoiStreamInCacheTest, ChangedRowsOnly)
+{
+    std::vector<uint8_t> frame;
+    MakeFrame(0, 0, 8, 2, 26, frame);
+    for (uint32_t frameNum = 0; frameNum < g_bufferNum; frameNum++)
+    {
+        RunFrame(frameNum, frame);
+    }
+
+    // The QP of a region inside one CTU row changes
+    MakeFrame(0, 0, 8, 2, 30, frame);
+    EXPECT_TRUE(RunFrame(g_bufferNum, frame));
+    EXPECT_EQ(g_spanSize, m_cache.GetWrittenBytes());
+    EXPECT_EQ(0, memcmp(frame.data(), m_buffers[0].data(), g_size));
+
+    // The next buffer also gets only the row, its other rows are unchanged
+    EXPECT_TRUE(RunFrame(g_bufferNum + 1, frame));
+    EXPECT_EQ(g_spanSize, m_cache.GetWrittenBytes());
+    EXPECT_EQ(0, memcmp(frame.data(), m_buffers[1].data(), g_size));
+
+    // Rows changed by several frames since a buffer was written add up
+    MakeFrame(0, 6, 8, 8, 30, frame);
+    EXPECT_TRUE(RunFrame(g_bufferNum + 2, frame));
+    EXPECT_EQ(2 * g_spanSize, m_cache.GetWrittenBytes());
+    EXPECT_EQ(0, memcmp(frame.data(), m_buffers[2].data(), g_size));
+}
+
+TEST_F(RoiStreamInCacheTest, InvalidatedBufferRewritten)
+{
+    std::vector<uint8_t> frame;
+    MakeFrame(2, 2, 6, 6, 22, frame);
+    EXPECT_TRUE(RunFrame(0, frame));
+    EXPECT_FALSE(RunFrame(g_bufferNum, frame));
+
+    m_buffers[0].assign(g_size, 0);
+    m_cache.Invalidate(&m_buffers[0]);
+    EXPECT_TRUE(RunFrame(2 * g_bufferNum, frame));
+    EXPECT_EQ(g_size, m_cache.GetWrittenBytes());
+    EXPECT_EQ(0, memcmp(frame.data(), m_buffers[0].data(), g_size));
+}
+
+TEST_F(RoiStreamInCacheTest, InvalidUse)
+{
+    RoiStreamInCache cache;
+    uint8_t          data[64] = {};
+    EXPECT_EQ(nullptr, cache.BeginFrame());
+    EXPECT_FALSE(cache.IsUpToDate(data));
+    EXPECT_EQ(MOS_STATUS_UNINITIALIZED, cache.Write(data, data));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, cache.Init(0, 64));
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, m_cache.Write(nullptr, data));
+
+    // The last span may be shorter than the others
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Init(100, 64));
+    memset(cache.BeginFrame(), 0x5A, 100);
+    EXPECT_TRUE(cache.EndFrame());
+    uint8_t buffer[100] = {};
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.Write(buffer, buffer));
+    EXPECT_EQ(100u, cache.GetWrittenBytes());
+    EXPECT_EQ(0x5A, buffer[99]);
+}
@@ -0,0 +1,427 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_hevc_vdenc_roi_streamin_cache.h"
+#include "encode_hevc_vdenc_roi_streamin_params_cache.h"
+
+using namespace encode;
+
+// Runs the ROI, dirty ROI and QP map stream-in of frame sequences through the
+// old path, where every LCU evaluates the settings and the whole frame is
+// copied to the stream-in buffer, and through the per frame parameters and
+// the stream-in cache, and compares the stream-in buffers
+
+// 1080p stream-in: 60 LCUs of 32x32 a row, 34 + 8 rows, 64 bytes an LCU
+static const uint32_t g_lcuWidth  = 60;
+static const uint32_t g_lcuHeight = 42;
+static const uint32_t g_lcuNum    = g_lcuWidth * g_lcuHeight;
+static const uint32_t g_lcuSize   = 64;
+static const uint32_t g_spanSize  = g_lcuWidth * 2 * g_lcuSize;
+static const uint32_t g_size      = g_lcuNum * g_lcuSize;
+static const uint32_t g_bufferNum = 6;
+
+// Fields of the stream-in parameters the settings and the strategies set
+struct TestStreamInParams
+{
+    uint8_t maxTuSize;
+    uint8_t maxCuSize;
+    uint8_t numImePredictors;
+    uint8_t puTypeCtrl;
+    uint8_t numMergeCandidateCu64x64;
+    uint8_t numMergeCandidateCu32x32;
+    uint8_t numMergeCandidateCu16x16;
+    uint8_t numMergeCandidateCu8x8;
+    bool    setQpRoiCtrl;
+    int8_t  forceQp;
+};
+
+enum TestMode
+{
+    testModeRoi,
+    testModeDirty,
+    testModeQpMap,
+};
+
+struct TestRect
+{
+    uint32_t left;
+    uint32_t top;
+    uint32_t right;
+    uint32_t bottom;
+    int8_t   qp;
+
+    bool Contains(uint32_t x, uint32_t y) const
+    {
+        return x >= left && x < right && y >= top && y < bottom;
+    }
+};
+
+struct TestFrame
+{
+    TestMode              mode;
+    uint8_t               targetUsage;
+    std::vector<TestRect> rects;
+    std::vector<int8_t>   qpMap;
+};
+
+class RoiStreamInParamsCacheTest : public testing::Test
+{
+protected:
+    using Setting = std::function<MOS_STATUS(TestStreamInParams &, bool)>;
+
+    virtual void SetUp()
+    {
+        // Same shape as the vdencStreaminStateSettings, the values only
+        // depend on the target usage of the frame and the CU alignment
+        m_settings.push_back([this](TestStreamInParams &params, bool cu64Align) {
+            m_evaluations++;
+            params.maxTuSize = 3;
+            params.maxCuSize = cu64Align ? 3 : 2;
+            return MOS_STATUS_SUCCESS;
+        });
+        m_settings.push_back([this](TestStreamInParams &params, bool cu64Align) {
+            params.numImePredictors = m_targetUsage <= 2 ? 8 : (m_targetUsage <= 4 ? 4 : 2);
+            params.puTypeCtrl       = m_targetUsage == 7 ? 0xFF : 0;
+            return MOS_STATUS_SUCCESS;
+        });
+        m_settings.push_back([this](TestStreamInParams &params, bool cu64Align) {
+            params.numMergeCandidateCu64x64 = cu64Align ? 4 : 2;
+            params.numMergeCandidateCu32x32 = m_targetUsage == 7 ? 2 : 3;
+            params.numMergeCandidateCu16x16 = 2;
+            params.numMergeCandidateCu8x8   = m_targetUsage < 4 ? 1 : 0;
+            return MOS_STATUS_SUCCESS;
+        });
+
+        ASSERT_EQ(MOS_STATUS_SUCCESS, m_cache.Init(g_size, g_spanSize));
+        for (uint32_t i = 0; i < g_bufferNum; i++)
+        {
+            m_oldBuffers[i].assign(g_size, 0xCD);
+            m_newBuffers[i].assign(g_size, 0xCD);
+        }
+    }
+
+    MOS_STATUS Evaluate(TestStreamInParams &params, bool cu64Align)
+    {
+        for (const auto &setting : m_settings)
+        {
+            MOS_STATUS status = setting(params, cu64Align);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // SetStreaminParamByTU before the cache
+    void SetParamByTUOld(bool cu64Align, TestStreamInParams &params)
+    {
+        memset(&params, 0, sizeof(params));
+        Evaluate(params, cu64Align);
+    }
+
+    // SetStreaminParamByTU with the cache
+    void SetParamByTUNew(bool cu64Align, TestStreamInParams &params)
+    {
+        memset(&params, 0, sizeof(params));
+        m_paramsCache.Get(cu64Align, params, [this](TestStreamInParams &params, bool cu64Align) {
+            return Evaluate(params, cu64Align);
+        });
+    }
+
+    // Same packing as SetStreaminDataPerLcu and SetQpRoiCtrlPerLcu
+    static void SetDataPerLcu(const TestStreamInParams &params, uint8_t *data)
+    {
+        data[0]  = (uint8_t)((params.maxTuSize & 3) | ((params.maxCuSize & 3) << 2) | ((params.numImePredictors & 0xF) << 4));
+        data[3]  = params.puTypeCtrl;
+        data[24] = (uint8_t)((params.numMergeCandidateCu64x64 & 0xF) | ((params.numMergeCandidateCu32x32 & 0xF) << 4));
+        data[25] = (uint8_t)((params.numMergeCandidateCu16x16 & 0xF) | ((params.numMergeCandidateCu8x8 & 0xF) << 4));
+        if (params.setQpRoiCtrl)
+        {
+            data[56] = (uint8_t)params.forceQp;
+            data[57] = 0x1;
+        }
+    }
+
+    // Writes the LCUs of the frame the way the ROI strategies do
+    template <class SetParamByTU>
+    void WriteFrame(const TestFrame &frame, uint8_t *data, SetParamByTU setParamByTU)
+    {
+        TestStreamInParams params;
+        for (uint32_t lcu = 0; lcu < g_lcuNum; lcu++)
+        {
+            uint32_t x = lcu % g_lcuWidth;
+            uint32_t y = lcu / g_lcuWidth;
+
+            if (frame.mode == testModeRoi)
+            {
+                setParamByTU(true, params);
+                for (const auto &rect : frame.rects)
+                {
+                    if (rect.Contains(x, y))
+                    {
+                        params.setQpRoiCtrl = true;
+                        params.forceQp      = rect.qp;
+                        break;
+                    }
+                }
+                SetDataPerLcu(params, data + lcu * g_lcuSize);
+            }
+            else if (frame.mode == testModeDirty)
+            {
+                bool dirty = false;
+                for (const auto &rect : frame.rects)
+                {
+                    dirty |= rect.Contains(x, y);
+                }
+                if (dirty)
+                {
+                    // Dirty regions not starting on a 64x64 boundary lose the alignment
+                    setParamByTU(x % 2 == 0 && y % 2 == 0, params);
+                }
+                else
+                {
+                    // Background data does not go through the settings
+                    memset(&params, 0, sizeof(params));
+                    params.maxTuSize = 3;
+                    params.maxCuSize = 3;
+                }
+                SetDataPerLcu(params, data + lcu * g_lcuSize);
+            }
+            else
+            {
+                // The QP map is walked in groups of 4 LCUs, 64 aligned if all
+                // of them share the QP
+                memset(&params, 0, sizeof(params));
+                params.setQpRoiCtrl = true;
+                params.forceQp      = frame.qpMap[lcu];
+                SetDataPerLcu(params, data + lcu * g_lcuSize);
+                if (lcu % 4 == 3)
+                {
+                    bool cu64Align = frame.qpMap[lcu - 3] == frame.qpMap[lcu - 2] &&
+                                     frame.qpMap[lcu - 2] == frame.qpMap[lcu - 1] &&
+                                     frame.qpMap[lcu - 1] == frame.qpMap[lcu];
+                    for (uint32_t i = 0; i < 4; i++)
+                    {
+                        setParamByTU(cu64Align, params);
+                        SetDataPerLcu(params, data + (lcu - i) * g_lcuSize);
+                    }
+                }
+            }
+        }
+    }
+
+    void RunOld(uint32_t frameNum, const TestFrame &frame)
+    {
+        m_targetUsage = frame.targetUsage;
+        std::vector<uint8_t> temp(g_size, 0);
+        WriteFrame(frame, temp.data(), [this](bool cu64Align, TestStreamInParams &params) {
+            SetParamByTUOld(cu64Align, params);
+        });
+        memcpy(m_oldBuffers[frameNum % g_bufferNum].data(), temp.data(), g_size);
+    }
+
+    void RunNew(uint32_t frameNum, const TestFrame &frame)
+    {
+        m_targetUsage = frame.targetUsage;
+        m_paramsCache.Reset();
+        uint8_t *data = m_cache.BeginFrame();
+        ASSERT_NE(nullptr, data);
+        WriteFrame(frame, data, [this](bool cu64Align, TestStreamInParams &params) {
+            SetParamByTUNew(cu64Align, params);
+        });
+        m_cache.EndFrame();
+
+        std::vector<uint8_t> &buffer = m_newBuffers[frameNum % g_bufferNum];
+        if (!m_cache.IsUpToDate(&buffer))
+        {
+            ASSERT_EQ(MOS_STATUS_SUCCESS, m_cache.Write(&buffer, buffer.data()));
+        }
+    }
+
+    void MakeRects(std::mt19937 &rng, TestFrame &frame)
+    {
+        frame.rects.clear();
+        uint32_t num = rng() % 4 + 1;
+        for (uint32_t i = 0; i < num; i++)
+        {
+            TestRect rect;
+            rect.left   = rng() % g_lcuWidth;
+            rect.top    = rng() % g_lcuHeight;
+            rect.right  = rect.left + rng() % (g_lcuWidth - rect.left) + 1;
+            rect.bottom = rect.top + rng() % (g_lcuHeight - rect.top) + 1;
+            rect.qp     = (int8_t)(rng() % 52 - 26);
+            frame.rects.push_back(rect);
+        }
+    }
+
+    void MakeQpMap(std::mt19937 &rng, TestFrame &frame)
+    {
+        // Blocks of the same QP so that some groups are 64 aligned
+        frame.qpMap.resize(g_lcuNum);
+        int8_t qp = 0;
+        for (uint32_t lcu = 0; lcu < g_lcuNum; lcu++)
+        {
+            if (rng() % 6 == 0)
+            {
+                qp = (int8_t)(rng() % 52 - 26);
+            }
+            frame.qpMap[lcu] = qp;
+        }
+    }
+
+    // Runs a sequence through both paths, the frames repeat or change a
+    // little at random like a real ROI stream does
+    void RunSequence(TestMode mode, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        TestFrame    frame;
+        frame.mode        = mode;
+        frame.targetUsage = 4;
+        MakeRects(rng, frame);
+        MakeQpMap(rng, frame);
+
+        for (uint32_t frameNum = 0; frameNum < 96; frameNum++)
+        {
+            uint32_t change = rng() % 8;
+            if (change == 0)
+            {
+                MakeRects(rng, frame);
+            }
+            else if (change == 1 && !frame.rects.empty())
+            {
+                frame.rects[0].qp = (int8_t)(rng() % 52 - 26);
+            }
+            else if (change == 2)
+            {
+                MakeQpMap(rng, frame);
+            }
+            else if (change == 3)
+            {
+                frame.qpMap[rng() % g_lcuNum] = (int8_t)(rng() % 52 - 26);
+            }
+            else if (change == 4)
+            {
+                frame.targetUsage = (uint8_t)(rng() % 7 + 1);
+            }
+
+            RunOld(frameNum, frame);
+            m_evaluations = 0;
+            RunNew(frameNum, frame);
+
+            // At most one evaluation per CU alignment and frame
+            EXPECT_LE(m_evaluations, 2u) << "frame " << frameNum;
+            ASSERT_EQ(0, memcmp(m_oldBuffers[frameNum % g_bufferNum].data(), m_newBuffers[frameNum % g_bufferNum].data(), g_size))
+                << "mode " << mode << " seed " << seed << " frame " << frameNum;
+        }
+    }
+
+    std::vector<Setting>                        m_settings;
+    RoiStreamInParamsCache<TestStreamInParams> m_paramsCache;
+    RoiStreamInCache                            m_cache;
+    std::vector<uint8_t>                        m_oldBuffers[g_bufferNum];
+    std::vector<uint8_t>                        m_newBuffers[g_bufferNum];
+    uint8_t                                     m_targetUsage = 4;
+    uint32_t                                    m_evaluations = 0;
+};
+
+TEST_F(RoiStreamInParamsCacheTest, RoiMatchesPerLcu)
+{
+    for (uint32_t seed = 1; seed <= 4; seed++)
+    {
+        RunSequence(testModeRoi, seed);
+    }
+}
+
+TEST_F(RoiStreamInParamsCacheTest, DirtyRoiMatchesPerLcu)
+{
+    for (uint32_t seed = 1; seed <= 4; seed++)
+    {
+        RunSequence(testModeDirty, seed);
+    }
+}
+
+TEST_F(RoiStreamInParamsCacheTest, QpMapMatchesPerLcu)
+{
+    for (uint32_t seed = 1; seed <= 4; seed++)
+    {
+        RunSequence(testModeQpMap, seed);
+    }
+}
+
+TEST_F(RoiStreamInParamsCacheTest, MixedModesMatchPerLcu)
+{
+    // The strategy can change between frames, the buffers carry over
+    std::mt19937 rng(7);
+    TestFrame    frame;
+    frame.targetUsage = 4;
+    for (uint32_t frameNum = 0; frameNum < 96; frameNum++)
+    {
+        frame.mode        = (TestMode)(rng() % 3);
+        frame.targetUsage = (uint8_t)(rng() % 7 + 1);
+        MakeRects(rng, frame);
+        MakeQpMap(rng, frame);
+
+        RunOld(frameNum, frame);
+        RunNew(frameNum, frame);
+        ASSERT_EQ(0, memcmp(m_oldBuffers[frameNum % g_bufferNum].data(), m_newBuffers[frameNum % g_bufferNum].data(), g_size))
+            << "frame " << frameNum;
+    }
+}
+
+TEST_F(RoiStreamInParamsCacheTest, FailedEvaluationNotCached)
+{
+    TestStreamInParams params = {};
+    uint32_t           calls  = 0;
+    auto fail = [&calls](TestStreamInParams &params, bool cu64Align) {
+        calls++;
+        return MOS_STATUS_NULL_POINTER;
+    };
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, m_paramsCache.Get(true, params, fail));
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, m_paramsCache.Get(true, params, fail));
+    EXPECT_EQ(2u, calls);
+
+    // The alignments are cached apart and dropped by the reset
+    auto set = [&calls](TestStreamInParams &params, bool cu64Align) {
+        calls++;
+        params.maxCuSize = cu64Align ? 3 : 2;
+        return MOS_STATUS_SUCCESS;
+    };
+    calls = 0;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        memset(&params, 0, sizeof(params));
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_paramsCache.Get(true, params, set));
+        EXPECT_EQ(3, params.maxCuSize);
+        memset(&params, 0, sizeof(params));
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_paramsCache.Get(false, params, set));
+        EXPECT_EQ(2, params.maxCuSize);
+    }
+    EXPECT_EQ(2u, calls);
+    m_paramsCache.Reset();
+    EXPECT_EQ(MOS_STATUS_SUCCESS, m_paramsCache.Get(true, params, set));
+    EXPECT_EQ(3u, calls);
+}
@@ -0,0 +1,434 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <ctype.h>
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include "submit_benchmark.h"
+
+using namespace std;
+
+static uint64_t NowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Names of the MI commands a submission is usually made of, others are keyed by opcode
+static const char *MiCmdName(uint32_t opcode)
+{
+    switch (opcode)
+    {
+    case 0x00: return "MI_NOOP";
+    case 0x0A: return "MI_BATCH_BUFFER_END";
+    case 0x1A: return "MI_MATH";
+    case 0x1C: return "MI_SEMAPHORE_WAIT";
+    case 0x20: return "MI_STORE_DATA_IMM";
+    case 0x22: return "MI_LOAD_REGISTER_IMM";
+    case 0x24: return "MI_STORE_REGISTER_MEM";
+    case 0x26: return "MI_FLUSH_DW";
+    case 0x29: return "MI_LOAD_REGISTER_MEM";
+    case 0x2A: return "MI_LOAD_REGISTER_REG";
+    case 0x2F: return "MI_ATOMIC";
+    case 0x31: return "MI_BATCH_BUFFER_START";
+    case 0x36: return "MI_CONDITIONAL_BATCH_BUFFER_END";
+    default:   return nullptr;
+    }
+}
+
+class JsonReader
+{
+public:
+
+    JsonReader(const string &json, SubmitBenchmark::Metrics &values) : m_json(json), m_values(values) { }
+
+    bool Parse()
+    {
+        return ParseValue("") && (SkipSpaces(), m_pos == m_json.size());
+    }
+
+private:
+
+    void SkipSpaces()
+    {
+        while (m_pos < m_json.size() && isspace((unsigned char)m_json[m_pos]))
+        {
+            m_pos++;
+        }
+    }
+
+    bool Expect(char c)
+    {
+        SkipSpaces();
+        if (m_pos < m_json.size() && m_json[m_pos] == c)
+        {
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParseString(string &str)
+    {
+        if (!Expect('"'))
+        {
+            return false;
+        }
+        str.clear();
+        while (m_pos < m_json.size() && m_json[m_pos] != '"')
+        {
+            // Escapes are kept as they are, the keys only need to match
+            if (m_json[m_pos] == '\\' && m_pos + 1 < m_json.size())
+            {
+                str += m_json[m_pos++];
+            }
+            str += m_json[m_pos++];
+        }
+        return Expect('"');
+    }
+
+    bool ParseValue(const string &key)
+    {
+        SkipSpaces();
+        if (m_pos >= m_json.size())
+        {
+            return false;
+        }
+
+        char c = m_json[m_pos];
+        if (c == '{')
+        {
+            m_pos++;
+            if (Expect('}'))
+            {
+                return true;
+            }
+            do
+            {
+                string name;
+                if (!ParseString(name) || !Expect(':') || !ParseValue(key.empty() ? name : key + "." + name))
+                {
+                    return false;
+                }
+            } while (Expect(','));
+            return Expect('}');
+        }
+        if (c == '[')
+        {
+            m_pos++;
+            if (Expect(']'))
+            {
+                return true;
+            }
+            do
+            {
+                if (!ParseValue(""))
+                {
+                    return false;
+                }
+            } while (Expect(','));
+            return Expect(']');
+        }
+        if (c == '"')
+        {
+            string str;
+            return ParseString(str);
+        }
+        for (const char *word : {"true", "false", "null"})
+        {
+            if (m_json.compare(m_pos, strlen(word), word) == 0)
+            {
+                m_pos += strlen(word);
+                return true;
+            }
+        }
+
+        char  *end   = nullptr;
+        double value = strtod(m_json.c_str() + m_pos, &end);
+        if (end == m_json.c_str() + m_pos)
+        {
+            return false;
+        }
+        m_pos = end - m_json.c_str();
+        if (!key.empty())
+        {
+            m_values[key] = value;
+        }
+        return true;
+    }
+
+    const string             &m_json;
+    SubmitBenchmark::Metrics &m_values;
+    size_t                    m_pos = 0;
+};
+
+SubmitBenchmark *SubmitBenchmark::m_instance = nullptr;
+
+SubmitBenchmark *SubmitBenchmark::GetInstance()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = new SubmitBenchmark();
+    }
+
+    return m_instance;
+}
+
+void SubmitBenchmark::Begin(const string &caseName, const DriverSymbols &drvSyms)
+{
+    m_active   = true;
+    m_caseName = caseName;
+    m_drvSyms  = drvSyms;
+    m_frames   = 0;
+    m_frameNs  = 0;
+    m_metrics.clear();
+
+    // libdrm_mock is preloaded, without it there is nothing to count the submissions with
+    m_getDrmStats = (DrmMockGetStatsFunc)dlsym(RTLD_DEFAULT, DRM_MOCK_GET_STATS);
+    m_drmStats    = {};
+    if (m_getDrmStats)
+    {
+        m_getDrmStats(&m_drmStats);
+    }
+    m_memNinja    = m_drvSyms.MOS_GetMemNinjaCounter ? m_drvSyms.MOS_GetMemNinjaCounter() : 0;
+    m_memNinjaGfx = m_drvSyms.MOS_GetMemNinjaCounterGfx ? m_drvSyms.MOS_GetMemNinjaCounterGfx() : 0;
+}
+
+void SubmitBenchmark::BeginFrame()
+{
+    m_frameStart = NowNs();
+}
+
+void SubmitBenchmark::EndFrame()
+{
+    m_frameNs += NowNs() - m_frameStart;
+    m_frames++;
+}
+
+void SubmitBenchmark::RecordCmdBuf(const PMOS_COMMAND_BUFFER pCmdBuffer)
+{
+    if (!m_active || pCmdBuffer == nullptr || pCmdBuffer->pCmdBase == nullptr)
+    {
+        return;
+    }
+
+    uint32_t dwords = (uint32_t)(pCmdBuffer->pCmdPtr - pCmdBuffer->pCmdBase);
+    m_metrics["submits"]++;
+    m_metrics["cmdBufBytes"] += dwords * sizeof(uint32_t);
+    CountCmds(pCmdBuffer->pCmdBase, dwords, m_metrics);
+}
+
+uint32_t SubmitBenchmark::CountCmds(const uint32_t *cmds, uint32_t dwords, Metrics &metrics)
+{
+    uint32_t i = 0;
+    while (i < dwords)
+    {
+        uint32_t header = cmds[i];
+        uint32_t type   = header >> 29;
+        uint32_t length = 0;
+        char     key[40];
+
+        if (type == 0)
+        {
+            // MI commands up to 0x0F have no length field
+            uint32_t    opcode = (header >> 23) & 0x3F;
+            const char *name   = MiCmdName(opcode);
+            length             = (opcode < 0x10) ? 1 : (header & 0xFF) + 2;
+            if (name)
+            {
+                snprintf(key, sizeof(key), "cmd.%s", name);
+            }
+            else
+            {
+                snprintf(key, sizeof(key), "cmd.MI_0x%02X", opcode);
+            }
+            if (opcode == 0x0A)
+            {
+                metrics[key]++;
+                i++;
+                break;
+            }
+        }
+        else if (type == 3)
+        {
+            // Media pipeline commands have 12 bit lengths, the others 8 bits
+            uint32_t pipeline = (header >> 27) & 3;
+            length            = ((pipeline == 2) ? (header & 0xFFF) : (header & 0xFF)) + 2;
+            snprintf(key, sizeof(key), "cmd.0x%04X", header >> 16);
+        }
+        else if (type == 2)
+        {
+            length = (header & 0xFF) + 2;
+            snprintf(key, sizeof(key), "cmd.BLT_0x%02X", (header >> 22) & 0x7F);
+        }
+        else
+        {
+            metrics["cmdUnknown"]++;
+            break;
+        }
+
+        metrics[key]++;
+        i += length;
+    }
+
+    return ((i < dwords) ? i : dwords) * sizeof(uint32_t);
+}
+
+bool SubmitBenchmark::ParseJson(const string &json, Metrics &values)
+{
+    JsonReader reader(json, values);
+    return reader.Parse();
+}
+
+// The wall time depends on the machine running the test, it is only reported
+static bool IsReportOnly(const string &metric)
+{
+    return metric == "usPerFrame";
+}
+
+vector<string> SubmitBenchmark::Compare(const string &caseName, const Metrics &metrics, const Metrics &golden)
+{
+    vector<string> regressions;
+    string         prefix    = "cases." + caseName + ".";
+    string         cmdPrefix = prefix + "cmd.";
+    auto           firstCmd  = golden.lower_bound(cmdPrefix);
+    bool           cmdGolden = firstCmd != golden.end() && firstCmd->first.compare(0, cmdPrefix.size(), cmdPrefix) == 0;
+
+    auto tolerance = [&](const string &metric) {
+        auto t = golden.find("tolerances." + metric);
+        if (t == golden.end())
+        {
+            t = golden.find("tolerances.default");
+        }
+        return (t == golden.end()) ? 0.0 : t->second;
+    };
+
+    // Metrics are checked once they have a golden value. Commands are checked
+    // once the case has golden command counts, a command without one was not
+    // sent before.
+    for (const auto &m : metrics)
+    {
+        auto g     = golden.find(prefix + m.first);
+        bool isCmd = m.first.compare(0, 4, "cmd.") == 0;
+        if (IsReportOnly(m.first) || (g == golden.end() && !(isCmd && cmdGolden)))
+        {
+            continue;
+        }
+
+        double expected = (g == golden.end()) ? 0.0 : g->second;
+        double limit    = expected * (1.0 + tolerance(m.first));
+        if (m.second > limit + 1e-9)
+        {
+            ostringstream msg;
+            msg << caseName << ": " << m.first << " " << m.second << ", golden " << expected << ", limit " << limit;
+            regressions.push_back(msg.str());
+        }
+    }
+    return regressions;
+}
+
+vector<string> SubmitBenchmark::End()
+{
+    if (!m_active)
+    {
+        return {};
+    }
+    m_active = false;
+
+    if (m_getDrmStats)
+    {
+        DrmMockStats stats = {};
+        m_getDrmStats(&stats);
+        m_metrics["execs"]          = (double)(stats.execCount - m_drmStats.execCount);
+        m_metrics["batchBytes"]     = (double)(stats.batchBytes - m_drmStats.batchBytes);
+        m_metrics["execObjects"]    = (double)(stats.execObjects - m_drmStats.execObjects);
+        m_metrics["relocs"]         = (double)(stats.relocs - m_drmStats.relocs);
+        m_metrics["softpinTargets"] = (double)(stats.softpinTargets - m_drmStats.softpinTargets);
+        m_metrics["boAllocs"]       = (double)(stats.boAllocs - m_drmStats.boAllocs);
+    }
+
+    // Allocations still alive after the frames, the ones freed within are not counted
+    if (m_drvSyms.MOS_GetMemNinjaCounter && m_drvSyms.MOS_GetMemNinjaCounterGfx)
+    {
+        m_metrics["sysAllocs"] = (double)(m_drvSyms.MOS_GetMemNinjaCounter() - m_memNinja);
+        m_metrics["gfxAllocs"] = (double)(m_drvSyms.MOS_GetMemNinjaCounterGfx() - m_memNinjaGfx);
+    }
+    m_metrics["frames"]     = m_frames;
+    m_metrics["usPerFrame"] = m_frames ? m_frameNs / 1000.0 / m_frames : 0.0;
+
+    m_results[m_caseName] = m_metrics;
+    WriteResults();
+
+    const char *goldenPath = getenv("SUBMIT_BENCHMARK_GOLDEN");
+    ifstream    file(goldenPath ? goldenPath : SUBMIT_BENCHMARK_GOLDEN);
+    Metrics     golden;
+    if (!file)
+    {
+        printf("[ SUBMIT BENCHMARK ] %s: no golden values, recorded to %s\n", m_caseName.c_str(), SUBMIT_BENCHMARK_RESULTS);
+        return {};
+    }
+
+    stringstream json;
+    json << file.rdbuf();
+    if (!ParseJson(json.str(), golden))
+    {
+        return {"cannot parse " + string(goldenPath ? goldenPath : SUBMIT_BENCHMARK_GOLDEN)};
+    }
+    if (golden.find("cases." + m_caseName + ".frames") == golden.end())
+    {
+        printf("[ SUBMIT BENCHMARK ] %s: no golden values, recorded to %s\n", m_caseName.c_str(), SUBMIT_BENCHMARK_RESULTS);
+        return {};
+    }
+
+    printf("[ SUBMIT BENCHMARK ] %s: %.0f submits, %.0f command bytes, %.0f relocs, %.1f us per frame\n",
+        m_caseName.c_str(), m_metrics["submits"], m_metrics["cmdBufBytes"], m_metrics["relocs"], m_metrics["usPerFrame"]);
+    return Compare(m_caseName, m_metrics, golden);
+}
+
+void SubmitBenchmark::WriteResults() const
+{
+    FILE *file = fopen(SUBMIT_BENCHMARK_RESULTS, "w");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    fprintf(file, "{\n    \"cases\": {");
+    const char *caseSep = "\n";
+    for (const auto &c : m_results)
+    {
+        fprintf(file, "%s        \"%s\": {", caseSep, c.first.c_str());
+        const char *sep = "\n";
+        for (const auto &m : c.second)
+        {
+            fprintf(file, "%s            \"%s\": %.*f", sep, m.first.c_str(), (m.first == "usPerFrame") ? 1 : 0, m.second);
+            sep = ",\n";
+        }
+        fprintf(file, "\n        }");
+        caseSep = ",\n";
+    }
+    fprintf(file, "\n    }\n}\n");
+    fclose(file);
+}
@@ -0,0 +1,92 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __SUBMIT_BENCHMARK_H__
+#define __SUBMIT_BENCHMARK_H__
+
+#include <map>
+#include <string>
+#include <vector>
+#include "driver_loader.h"
+#include "drm_mock_stats.h"
+
+// Checked in golden values, overridden by the environment variable of the same name
+#ifndef SUBMIT_BENCHMARK_GOLDEN
+#define SUBMIT_BENCHMARK_GOLDEN "./submit_benchmark_golden.json"
+#endif
+#define SUBMIT_BENCHMARK_RESULTS "./submit_benchmark_results.json"
+
+// Records what the submit path of a test case costs: the command buffers the
+// driver hands to UltGetCmdBuf, what it asks of libdrm_mock and the memory it
+// keeps allocated, per frame. Metrics above their golden value plus tolerance
+// are returned as regressions, cases without golden values are only recorded.
+// Commands are checked once the case has golden command counts, the time per
+// frame is only reported.
+class SubmitBenchmark
+{
+public:
+
+    using Metrics = std::map<std::string, double>;
+
+    static SubmitBenchmark *GetInstance();
+
+    void Begin(const std::string &caseName, const DriverSymbols &drvSyms);
+
+    void BeginFrame();
+
+    void EndFrame();
+
+    void RecordCmdBuf(const PMOS_COMMAND_BUFFER pCmdBuffer);
+
+    // Compares the case against the golden values, returns the metrics above their tolerance
+    std::vector<std::string> End();
+
+    // Counts the commands by opcode, returns the bytes parsed
+    static uint32_t CountCmds(const uint32_t *cmds, uint32_t dwords, Metrics &metrics);
+
+    // Flattens the objects of a JSON document to dotted keys, only numbers are kept
+    static bool ParseJson(const std::string &json, Metrics &values);
+
+    static std::vector<std::string> Compare(const std::string &caseName, const Metrics &metrics, const Metrics &golden);
+
+private:
+
+    void WriteResults() const;
+
+private:
+
+    static SubmitBenchmark *m_instance;
+
+    bool                           m_active = false;
+    std::string                    m_caseName;
+    DriverSymbols                  m_drvSyms     = {};
+    DrmMockGetStatsFunc            m_getDrmStats = nullptr;  // from the preloaded libdrm_mock
+    DrmMockStats                   m_drmStats    = {};       // at the start of the case
+    int32_t                        m_memNinja    = 0;
+    int32_t                        m_memNinjaGfx = 0;
+    uint64_t                       m_frameStart  = 0;
+    uint64_t                       m_frameNs     = 0;
+    uint32_t                       m_frames      = 0;
+    Metrics                        m_metrics;
+    std::map<std::string, Metrics> m_results;                // all the cases run, by name
+};
+
+#endif // __SUBMIT_BENCHMARK_H__
@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+#include "submit_benchmark.h"
+
+using namespace std;
+
+TEST(SubmitBenchmarkTest, CountCmds)
+{
+    const vector<uint32_t> cmds = {
+        0x00000000,                                      // MI_NOOP
+        0x11000001, 0x2000, 0,                           // MI_LOAD_REGISTER_IMM
+        0x7A000004, 0, 0, 0, 0, 0,                       // PIPE_CONTROL
+        0x73890003, 0, 0, 0, 0,                          // media pipeline, 12 bit length
+        0x05000000,                                      // MI_BATCH_BUFFER_END
+        0xFFFFFFFF};                                     // not parsed
+
+    SubmitBenchmark::Metrics metrics;
+    EXPECT_EQ(16 * sizeof(uint32_t), SubmitBenchmark::CountCmds(cmds.data(), cmds.size(), metrics));
+    EXPECT_EQ(1, metrics["cmd.MI_NOOP"]);
+    EXPECT_EQ(1, metrics["cmd.MI_LOAD_REGISTER_IMM"]);
+    EXPECT_EQ(1, metrics["cmd.0x7A00"]);
+    EXPECT_EQ(1, metrics["cmd.0x7389"]);
+    EXPECT_EQ(1, metrics["cmd.MI_BATCH_BUFFER_END"]);
+    EXPECT_EQ(5u, metrics.size());
+}
+
+TEST(SubmitBenchmarkTest, GoldenCompare)
+{
+    const string json =
+        "{\n"
+        "    \"tolerances\": { \"default\": 0, \"relocs\": 0.5 },\n"
+        "    \"comment\": \"escaped \\\" quote\",\n"
+        "    \"cases\": {\n"
+        "        \"DecodeAVCLong/SKL\": { \"frames\": 2, \"cmd.MI_NOOP\": 3, \"relocs\": 10, \"usPerFrame\": 100 },\n"
+        "        \"DecodeAVCLong/BXT\": { \"frames\": 2 }\n"
+        "    }\n"
+        "}\n";
+
+    SubmitBenchmark::Metrics golden;
+    ASSERT_TRUE(SubmitBenchmark::ParseJson(json, golden));
+    EXPECT_EQ(3, golden["cases.DecodeAVCLong/SKL.cmd.MI_NOOP"]);
+    EXPECT_EQ(0.5, golden["tolerances.relocs"]);
+
+    SubmitBenchmark::Metrics broken;
+    EXPECT_FALSE(SubmitBenchmark::ParseJson("{\"frames\": }", broken));
+    EXPECT_FALSE(SubmitBenchmark::ParseJson("{\"frames\": 1", broken));
+
+    // Less is never a regression, the relocations have their tolerance and the time is only reported
+    SubmitBenchmark::Metrics metrics = {{"frames", 2}, {"cmd.MI_NOOP", 2}, {"relocs", 15}, {"usPerFrame", 1000}};
+    EXPECT_TRUE(SubmitBenchmark::Compare("DecodeAVCLong/SKL", metrics, golden).empty());
+
+    // A command the golden values do not have was not sent before
+    metrics["cmd.MI_NOOP"]     = 4;
+    metrics["cmd.MI_FLUSH_DW"] = 1;
+    metrics["relocs"]          = 16;
+    EXPECT_EQ(3u, SubmitBenchmark::Compare("DecodeAVCLong/SKL", metrics, golden).size());
+
+    // Without golden command counts, only the metrics with a golden value are checked
+    EXPECT_TRUE(SubmitBenchmark::Compare("DecodeAVCLong/BXT", metrics, golden).empty());
+    metrics["frames"] = 3;
+    EXPECT_EQ(1u, SubmitBenchmark::Compare("DecodeAVCLong/BXT", metrics, golden).size());
+}
+
+TEST(SubmitBenchmarkTest, CheckedInGolden)
+{
+    ifstream file(SUBMIT_BENCHMARK_GOLDEN);
+    ASSERT_TRUE(file.good());
+    stringstream json;
+    json << file.rdbuf();
+
+    SubmitBenchmark::Metrics golden;
+    ASSERT_TRUE(SubmitBenchmark::ParseJson(json.str(), golden));
+    EXPECT_EQ(0, golden["tolerances.default"]);
+    EXPECT_TRUE(golden.find("tolerances.usPerFrame") == golden.end());
+    for (const char *caseName : {"DecodeHEVCLong/SKL", "DecodeAVCLong/BDW", "EncodeHEVC_DualPipe/BXT", "EncodeAVC_DualPipe/BDW"})
+    {
+        EXPECT_EQ(3, golden[string("cases.") + caseName + ".frames"]) << caseName;
+    }
+}
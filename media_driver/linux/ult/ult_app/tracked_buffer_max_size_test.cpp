@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <string.h>
+#include "gtest/gtest.h"
+#include "encode_tracked_buffer_max_size.h"
+
+using namespace encode;
+
+static MOS_ALLOC_GFXRES_PARAMS SurfaceParam(uint32_t width, uint32_t height, MOS_FORMAT format = Format_NV12)
+{
+    MOS_ALLOC_GFXRES_PARAMS param;
+    memset(&param, 0, sizeof(param));
+    param.Type     = MOS_GFXRES_2D;
+    param.TileType = MOS_TILE_Y;
+    param.Format   = format;
+    param.dwWidth  = width;
+    param.dwHeight = height;
+    return param;
+}
+
+static MOS_ALLOC_GFXRES_PARAMS BufferParam(uint32_t bytes)
+{
+    MOS_ALLOC_GFXRES_PARAMS param;
+    memset(&param, 0, sizeof(param));
+    param.Type     = MOS_GFXRES_BUFFER;
+    param.TileType = MOS_TILE_LINEAR;
+    param.Format   = Format_Buffer;
+    param.dwBytes  = bytes;
+    return param;
+}
+
+// Lays out an NV12 surface like the allocator would for the parameter
+static MOS_SURFACE AllocateSurface(const MOS_ALLOC_GFXRES_PARAMS &param)
+{
+    MOS_SURFACE surface;
+    memset(&surface, 0, sizeof(surface));
+    surface.Type                        = param.Type;
+    surface.Format                      = param.Format;
+    surface.TileType                    = param.TileType;
+    surface.dwWidth                     = param.dwWidth;
+    surface.dwHeight                    = param.dwHeight;
+    surface.dwPitch                     = MOS_ALIGN_CEIL(param.dwWidth, 128);
+    surface.UPlaneOffset.iSurfaceOffset = surface.dwPitch * MOS_ALIGN_CEIL(param.dwHeight, 32);
+    surface.VPlaneOffset.iSurfaceOffset = surface.UPlaneOffset.iSurfaceOffset;
+    surface.dwSize                      = surface.UPlaneOffset.iSurfaceOffset * 3 / 2;
+    return surface;
+}
+
+TEST(TrackedBufferMaxSizeTest, DownAndBackUp)
+{
+    MaxSizeParam maxSize;
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(1920, 1080)));
+    MOS_SURFACE allocated = AllocateSurface(maxSize.GetAllocParam());
+    MOS_SURFACE surface   = allocated;
+
+    // a smaller size reuses the allocation, only the size of the view changes
+    EXPECT_FALSE(maxSize.Register(SurfaceParam(1280, 720)));
+    EXPECT_EQ(maxSize.GetAllocParam().dwWidth, 1920u);
+    EXPECT_EQ(maxSize.GetAllocParam().dwHeight, 1080u);
+    EXPECT_TRUE(MaxSizeParam::Contains(maxSize.GetAllocParam(), maxSize.GetViewParam()));
+    MaxSizeParam::ApplyView(surface, maxSize.GetViewParam().dwWidth, maxSize.GetViewParam().dwHeight);
+    EXPECT_EQ(surface.dwWidth, 1280u);
+    EXPECT_EQ(surface.dwHeight, 720u);
+    EXPECT_EQ(surface.dwPitch, allocated.dwPitch);
+    EXPECT_EQ(surface.dwSize, allocated.dwSize);
+    EXPECT_EQ(surface.UPlaneOffset.iSurfaceOffset, allocated.UPlaneOffset.iSurfaceOffset);
+    EXPECT_EQ(surface.VPlaneOffset.iSurfaceOffset, allocated.VPlaneOffset.iSurfaceOffset);
+
+    // back up to the allocated size gives the allocated descriptor again
+    EXPECT_FALSE(maxSize.Register(SurfaceParam(1920, 1080)));
+    MaxSizeParam::ApplyView(surface, maxSize.GetViewParam().dwWidth, maxSize.GetViewParam().dwHeight);
+    EXPECT_EQ(memcmp(&surface, &allocated, sizeof(surface)), 0);
+}
+
+TEST(TrackedBufferMaxSizeTest, GrowsOnlyWhenOutgrown)
+{
+    MaxSizeParam maxSize;
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(1280, 720)));
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(1920, 1080)));
+    EXPECT_FALSE(maxSize.Register(SurfaceParam(1280, 1072)));
+    EXPECT_FALSE(maxSize.Register(SurfaceParam(1920, 1080)));
+
+    // the grown allocation covers the old and new sizes
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(2048, 720)));
+    EXPECT_EQ(maxSize.GetAllocParam().dwWidth, 2048u);
+    EXPECT_EQ(maxSize.GetAllocParam().dwHeight, 1080u);
+    EXPECT_EQ(maxSize.GetViewParam().dwWidth, 2048u);
+    EXPECT_EQ(maxSize.GetViewParam().dwHeight, 720u);
+    EXPECT_FALSE(maxSize.Register(SurfaceParam(1920, 1080)));
+}
+
+TEST(TrackedBufferMaxSizeTest, LayoutChangeReallocates)
+{
+    MaxSizeParam maxSize;
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(1920, 1080)));
+    EXPECT_TRUE(maxSize.Register(SurfaceParam(1280, 720, Format_P010)));
+    EXPECT_EQ(maxSize.GetAllocParam().Format, Format_P010);
+    EXPECT_EQ(maxSize.GetAllocParam().dwWidth, 1280u);
+    EXPECT_EQ(maxSize.GetAllocParam().dwHeight, 720u);
+
+    MOS_ALLOC_GFXRES_PARAMS linear = SurfaceParam(640, 480, Format_P010);
+    linear.TileType                = MOS_TILE_LINEAR;
+    EXPECT_FALSE(MaxSizeParam::Contains(maxSize.GetAllocParam(), linear));
+    EXPECT_TRUE(maxSize.Register(linear));
+}
+
+TEST(TrackedBufferMaxSizeTest, Buffers)
+{
+    MaxSizeParam maxSize;
+    EXPECT_TRUE(maxSize.Register(BufferParam(4096)));
+    EXPECT_FALSE(maxSize.Register(BufferParam(1024)));
+    EXPECT_EQ(maxSize.GetAllocParam().dwBytes, 4096u);
+    EXPECT_TRUE(maxSize.Register(BufferParam(8192)));
+    EXPECT_EQ(maxSize.GetAllocParam().dwBytes, 8192u);
+}
+
+TEST(TrackedBufferMaxSizeTest, ReslicesWithinMaxSize)
+{
+    // stream allocated at its max size never reallocates while the frame size
+    // changes within it, every view keeps the allocated layout
+    const uint32_t sizes[][2] = {
+        {1920, 1080}, {960, 540}, {1280, 720}, {1920, 1080}, {640, 360},
+        {1920, 544}, {16, 16}, {1920, 1080}, {1904, 1072}, {1920, 1080}};
+
+    MaxSizeParam maxSize;
+    uint32_t     allocations = 0;
+    MOS_SURFACE  allocated   = {};
+    for (auto size : sizes)
+    {
+        if (maxSize.Register(SurfaceParam(size[0], size[1])))
+        {
+            allocations++;
+            allocated = AllocateSurface(maxSize.GetAllocParam());
+        }
+
+        MOS_SURFACE surface = allocated;
+        MaxSizeParam::ApplyView(surface, maxSize.GetViewParam().dwWidth, maxSize.GetViewParam().dwHeight);
+        EXPECT_EQ(surface.dwWidth, size[0]);
+        EXPECT_EQ(surface.dwHeight, size[1]);
+        EXPECT_EQ(surface.dwPitch, allocated.dwPitch);
+        EXPECT_EQ(surface.UPlaneOffset.iSurfaceOffset, allocated.UPlaneOffset.iSurfaceOffset);
+        EXPECT_LE(surface.dwPitch * surface.dwHeight * 3 / 2, allocated.dwSize);
+    }
+    EXPECT_EQ(allocations, 1u);
+}
@@ -0,0 +1,226 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_user_setting_read_cache.h"
+
+using namespace std;
+using namespace MediaUserSetting::Internal;
+
+struct MockResult
+{
+    int32_t value;
+};
+
+// Follows Configure::Read and Configure::Write on a single item, the registry is one
+// integer guarded by the same lock as the cache
+class UserSettingReadCacheTest : public testing::Test
+{
+protected:
+    ~UserSettingReadCacheTest()
+    {
+        delete m_cache.Withdraw();
+        m_stale.Reclaim([](MockResult *stale) { delete stale; });
+    }
+
+    int32_t Read()
+    {
+        m_stale.Enter();
+        const MockResult *cached = m_cache.Get();
+        if (cached != nullptr)
+        {
+            int32_t value = cached->value;
+            m_stale.Leave();
+            return value;
+        }
+        m_stale.Leave();
+
+        m_lock.lock();
+        uint64_t generation = m_cache.GetGeneration();
+        m_stale.Reclaim([](MockResult *stale) { delete stale; });
+        m_lock.unlock();
+
+        m_lock.lock();
+        int32_t value = m_registry;
+        m_lock.unlock();
+        m_parseCount++;
+
+        MockResult *result = new MockResult{value};
+        m_lock.lock();
+        bool published = m_cache.Publish(result, generation);
+        m_lock.unlock();
+        if (!published)
+        {
+            delete result;
+        }
+        return value;
+    }
+
+    void Write(int32_t value)
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_registry = value;
+        m_stale.Retire(m_cache.Withdraw());
+        m_stale.Reclaim([](MockResult *stale) { delete stale; });
+    }
+
+    ReadCache<MockResult> m_cache;
+    mutex                 m_lock;
+    int32_t               m_registry = 0;
+    atomic<uint32_t>      m_parseCount{0};
+    RetiredResults<MockResult> m_stale;
+};
+
+TEST_F(UserSettingReadCacheTest, ParsesOnce)
+{
+    m_registry = 7;
+    EXPECT_EQ(Read(), 7);
+    EXPECT_EQ(Read(), 7);
+    EXPECT_EQ(m_parseCount, 1u);
+}
+
+TEST_F(UserSettingReadCacheTest, ReadAfterWrite)
+{
+    EXPECT_EQ(Read(), 0);
+    Write(1);
+    EXPECT_EQ(m_cache.Get(), nullptr);
+    EXPECT_EQ(Read(), 1);
+    Write(2);
+    Write(3);
+    EXPECT_EQ(Read(), 3);
+    EXPECT_EQ(Read(), 3);
+    EXPECT_EQ(m_parseCount, 3u);
+}
+
+TEST_F(UserSettingReadCacheTest, WriteDuringReadDropsResult)
+{
+    m_lock.lock();
+    uint64_t generation = m_cache.GetGeneration();
+    m_lock.unlock();
+
+    // The read parsed the old value, then a write lands before it publishes
+    MockResult *result = new MockResult{m_registry};
+    Write(1);
+
+    m_lock.lock();
+    EXPECT_FALSE(m_cache.Publish(result, generation));
+    m_lock.unlock();
+    delete result;
+
+    EXPECT_EQ(m_cache.Get(), nullptr);
+    EXPECT_EQ(Read(), 1);
+}
+
+TEST_F(UserSettingReadCacheTest, FirstPublishWins)
+{
+    uint64_t generation = m_cache.GetGeneration();
+    MockResult *first  = new MockResult{1};
+    MockResult *second = new MockResult{2};
+
+    EXPECT_TRUE(m_cache.Publish(first, generation));
+    EXPECT_FALSE(m_cache.Publish(second, generation));
+    EXPECT_EQ(m_cache.Get(), first);
+    delete second;
+}
+
+TEST_F(UserSettingReadCacheTest, WithdrawnResultsFreed)
+{
+    // Without readers inside every write frees what it withdrew
+    for (int32_t i = 1; i <= 100; i++)
+    {
+        EXPECT_EQ(Read(), i - 1);
+        Write(i);
+        lock_guard<mutex> guard(m_lock);
+        EXPECT_EQ(m_stale.GetCount(), 0u);
+    }
+}
+
+TEST_F(UserSettingReadCacheTest, ReaderInsideKeepsResult)
+{
+    EXPECT_EQ(Read(), 0);
+
+    // A reader got the result, then a write withdraws it
+    m_stale.Enter();
+    const MockResult *held = m_cache.Get();
+    ASSERT_NE(held, nullptr);
+    Write(1);
+    {
+        lock_guard<mutex> guard(m_lock);
+        EXPECT_EQ(m_stale.GetCount(), 1u);
+    }
+    EXPECT_EQ(held->value, 0);
+    m_stale.Leave();
+
+    // The next parsing read frees it
+    EXPECT_EQ(Read(), 1);
+    lock_guard<mutex> guard(m_lock);
+    EXPECT_EQ(m_stale.GetCount(), 0u);
+}
+
+TEST_F(UserSettingReadCacheTest, ConcurrentReadWrite)
+{
+    const int32_t  writes  = 2000;
+    const uint32_t readers = 4;
+
+    atomic<bool>   done{false};
+    atomic<bool>   goingBack{false};
+    vector<thread> threads;
+    for (uint32_t i = 0; i < readers; i++)
+    {
+        threads.emplace_back([&]() {
+            // Values only grow, a read older than the last one seen was published stale
+            int32_t last = 0;
+            while (!done)
+            {
+                int32_t value = Read();
+                if (value < last)
+                {
+                    goingBack = true;
+                }
+                last = value;
+            }
+        });
+    }
+
+    for (int32_t i = 1; i <= writes; i++)
+    {
+        Write(i);
+        if (i % 16 == 0)
+        {
+            this_thread::yield();
+        }
+    }
+    done = true;
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_FALSE(goingBack);
+    EXPECT_EQ(Read(), writes);
+    const MockResult *cached = m_cache.Get();
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->value, writes);
+}
@@ -0,0 +1,225 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_libva_userptr.h"
+
+using namespace std;
+
+// Stands in for MOS_LINUX_BO, the pin map only hands the pointers around
+struct MockBo
+{
+    DDI_MEDIA_USERPTR_KEY key;
+};
+
+class UserPtrPinMapTest : public testing::Test
+{
+protected:
+    ~UserPtrPinMapTest()
+    {
+        for (MockBo *bo : m_bos)
+        {
+            delete bo;
+        }
+    }
+
+    MockBo *Acquire(uintptr_t addr, uint64_t size, uint32_t tile = 0, uint32_t pitch = 256)
+    {
+        DDI_MEDIA_USERPTR_KEY key;
+        if (!DdiMediaUserPtr_GetKey(addr, size, tile, pitch, key))
+        {
+            return nullptr;
+        }
+        return m_pins.Acquire(key, [this](const DDI_MEDIA_USERPTR_KEY &key) -> MockBo * {
+            m_pinCount++;
+            if (m_rejectPins)
+            {
+                return nullptr;
+            }
+            MockBo *bo = new MockBo;
+            bo->key    = key;
+            m_bos.push_back(bo);
+            return bo;
+        });
+    }
+
+    MockBo *Release(uintptr_t addr, uint64_t size, bool &unknown, uint32_t tile = 0, uint32_t pitch = 256)
+    {
+        DDI_MEDIA_USERPTR_KEY key;
+        DdiMediaUserPtr_GetKey(addr, size, tile, pitch, key);
+        return m_pins.Release(key, unknown);
+    }
+
+    uint32_t GetRefCount(uintptr_t addr, uint64_t size, uint32_t tile = 0, uint32_t pitch = 256)
+    {
+        DDI_MEDIA_USERPTR_KEY key;
+        DdiMediaUserPtr_GetKey(addr, size, tile, pitch, key);
+        return m_pins.GetRefCount(key);
+    }
+
+    DdiMediaUserPtrPinMap<MockBo> m_pins;
+    vector<MockBo *>              m_bos;
+    uint32_t                      m_pinCount   = 0;
+    bool                          m_rejectPins = false;
+};
+
+TEST_F(UserPtrPinMapTest, KeyRoundsUpToPages)
+{
+    DDI_MEDIA_USERPTR_KEY key;
+    EXPECT_TRUE(DdiMediaUserPtr_GetKey(0x10000, 1, 0, 64, key));
+    EXPECT_EQ(0x10000u, key.start);
+    EXPECT_EQ(uint64_t(MOS_PAGE_SIZE), key.size);
+    EXPECT_TRUE(DdiMediaUserPtr_GetKey(0x10000, MOS_PAGE_SIZE, 0, 64, key));
+    EXPECT_EQ(uint64_t(MOS_PAGE_SIZE), key.size);
+    EXPECT_TRUE(DdiMediaUserPtr_GetKey(0x10000, MOS_PAGE_SIZE + 1, 0, 64, key));
+    EXPECT_EQ(uint64_t(2 * MOS_PAGE_SIZE), key.size);
+}
+
+TEST_F(UserPtrPinMapTest, UnpinnableMemoryFallsBack)
+{
+    DDI_MEDIA_USERPTR_KEY key;
+    // Unaligned start, null memory and empty ranges have to be copied
+    EXPECT_FALSE(DdiMediaUserPtr_GetKey(0x10010, MOS_PAGE_SIZE, 0, 64, key));
+    EXPECT_FALSE(DdiMediaUserPtr_GetKey(0, MOS_PAGE_SIZE, 0, 64, key));
+    EXPECT_FALSE(DdiMediaUserPtr_GetKey(0x10000, 0, 0, 64, key));
+
+    EXPECT_EQ(nullptr, Acquire(0x10010, MOS_PAGE_SIZE));
+    EXPECT_EQ(0u, m_pinCount);
+    EXPECT_TRUE(m_pins.empty());
+}
+
+TEST_F(UserPtrPinMapTest, SurfacesShareOnePin)
+{
+    MockBo *bo = Acquire(0x10000, 3 * MOS_PAGE_SIZE);
+    ASSERT_NE(nullptr, bo);
+    // Sizes rounding up to the same pages share the pin
+    EXPECT_EQ(bo, Acquire(0x10000, 3 * MOS_PAGE_SIZE - 100));
+    EXPECT_EQ(bo, Acquire(0x10000, 3 * MOS_PAGE_SIZE));
+    EXPECT_EQ(1u, m_pinCount);
+    EXPECT_EQ(1u, m_pins.size());
+    EXPECT_EQ(3u, GetRefCount(0x10000, 3 * MOS_PAGE_SIZE));
+
+    // The pin goes away with its last surface only
+    bool unknown = true;
+    EXPECT_EQ(nullptr, Release(0x10000, 3 * MOS_PAGE_SIZE, unknown));
+    EXPECT_FALSE(unknown);
+    EXPECT_EQ(nullptr, Release(0x10000, 3 * MOS_PAGE_SIZE, unknown));
+    EXPECT_FALSE(unknown);
+    EXPECT_EQ(bo, Release(0x10000, 3 * MOS_PAGE_SIZE, unknown));
+    EXPECT_FALSE(unknown);
+    EXPECT_TRUE(m_pins.empty());
+
+    // A later surface pins the memory again
+    MockBo *repinned = Acquire(0x10000, 3 * MOS_PAGE_SIZE);
+    EXPECT_NE(nullptr, repinned);
+    EXPECT_NE(bo, repinned);
+    EXPECT_EQ(2u, m_pinCount);
+}
+
+TEST_F(UserPtrPinMapTest, LayoutsArePinnedApart)
+{
+    MockBo *linear = Acquire(0x10000, 2 * MOS_PAGE_SIZE, 0, 256);
+    MockBo *pitch  = Acquire(0x10000, 2 * MOS_PAGE_SIZE, 0, 512);
+    MockBo *tiled  = Acquire(0x10000, 2 * MOS_PAGE_SIZE, 1, 256);
+    MockBo *larger = Acquire(0x10000, 4 * MOS_PAGE_SIZE, 0, 256);
+    MockBo *other  = Acquire(0x20000, 2 * MOS_PAGE_SIZE, 0, 256);
+    vector<MockBo *> bos = {linear, pitch, tiled, larger, other};
+    for (size_t i = 0; i < bos.size(); i++)
+    {
+        ASSERT_NE(nullptr, bos[i]);
+        for (size_t j = 0; j < i; j++)
+        {
+            EXPECT_NE(bos[i], bos[j]);
+        }
+    }
+    EXPECT_EQ(5u, m_pinCount);
+    EXPECT_EQ(512u, pitch->key.pitch);
+    EXPECT_EQ(1u, tiled->key.tile);
+
+    bool unknown = true;
+    EXPECT_EQ(pitch, Release(0x10000, 2 * MOS_PAGE_SIZE, unknown, 0, 512));
+    EXPECT_EQ(4u, m_pins.size());
+    EXPECT_EQ(1u, GetRefCount(0x10000, 2 * MOS_PAGE_SIZE, 0, 256));
+}
+
+TEST_F(UserPtrPinMapTest, RejectedPinIsNotKept)
+{
+    m_rejectPins = true;
+    EXPECT_EQ(nullptr, Acquire(0x10000, MOS_PAGE_SIZE));
+    EXPECT_TRUE(m_pins.empty());
+
+    // The kernel is asked again for the next surface
+    m_rejectPins = false;
+    EXPECT_NE(nullptr, Acquire(0x10000, MOS_PAGE_SIZE));
+    EXPECT_EQ(2u, m_pinCount);
+    EXPECT_EQ(1u, GetRefCount(0x10000, MOS_PAGE_SIZE));
+}
+
+TEST_F(UserPtrPinMapTest, ReleaseOfUnknownMemory)
+{
+    bool unknown = false;
+    EXPECT_EQ(nullptr, Release(0x10000, MOS_PAGE_SIZE, unknown));
+    EXPECT_TRUE(unknown);
+
+    ASSERT_NE(nullptr, Acquire(0x10000, MOS_PAGE_SIZE));
+    EXPECT_EQ(nullptr, Release(0x10000, MOS_PAGE_SIZE, unknown, 0, 128));
+    EXPECT_TRUE(unknown);
+    EXPECT_EQ(1u, GetRefCount(0x10000, MOS_PAGE_SIZE));
+}
+
+TEST(UserPtrCopyTest, UploadAlwaysDownloadAfterGpuWrite)
+{
+    // Input is copied before every gpu read, the application may have changed it
+    EXPECT_TRUE(DdiMediaUserPtr_NeedSync(true, false));
+    EXPECT_TRUE(DdiMediaUserPtr_NeedSync(true, true));
+    // Output is copied back only if the gpu wrote the driver copy
+    EXPECT_FALSE(DdiMediaUserPtr_NeedSync(false, false));
+    EXPECT_TRUE(DdiMediaUserPtr_NeedSync(false, true));
+}
+
+TEST(UserPtrCopyTest, CopiesUnalignedUserMemory)
+{
+    const size_t size = 3 * MOS_PAGE_SIZE + 123;
+    vector<uint8_t> storage(size + 16);
+    // User memory starting inside a page, as it can't be pinned
+    uint8_t *user = storage.data() + 7;
+    vector<uint8_t> copy(size, 0);
+    for (size_t i = 0; i < size; i++)
+    {
+        user[i] = uint8_t(i * 7 + 1);
+    }
+
+    DdiMediaUserPtr_Copy(copy.data(), user, size, true);
+    EXPECT_EQ(0, memcmp(copy.data(), user, size));
+
+    for (size_t i = 0; i < size; i++)
+    {
+        copy[i] = uint8_t(i * 13 + 5);
+    }
+    DdiMediaUserPtr_Copy(copy.data(), user, size, false);
+    EXPECT_EQ(0, memcmp(copy.data(), user, size));
+    // Nothing around the user memory is touched
+    EXPECT_EQ(0, storage[0]);
+    EXPECT_EQ(0, storage[size + 7]);
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "vp_vebox_statistics.h"
+
+TEST(VpVeboxStatisticsTest, SliceCombine)
+{
+    const uint32_t slice0[VpVeboxStatistics::m_gneDwords] = {100, 200, 300, 10, 20, 30};
+    const uint32_t slice1[VpVeboxStatistics::m_gneDwords] = {1, 2, 3, 4, 5, 6};
+
+    VP_VEBOX_GNE_STAT gne = VpVeboxStatistics::CombineGne(slice0, slice1);
+    EXPECT_EQ(101u, gne.luma);
+    EXPECT_EQ(202u, gne.chromaU);
+    EXPECT_EQ(303u, gne.chromaV);
+    EXPECT_EQ(14u, gne.countLuma);
+    EXPECT_EQ(25u, gne.countChromaU);
+    EXPECT_EQ(36u, gne.countChromaV);
+    EXPECT_TRUE(VpVeboxStatistics::IsValid(gne));
+}
+
+TEST(VpVeboxStatisticsTest, TgneCountMask)
+{
+    // The valid flag in bit 31 of the counts is dropped, the sums are kept whole
+    const uint32_t slice0[VpVeboxStatistics::m_gneDwords] = {0x80000001, 2, 3, 0x80000010, 0x80000020, 0x80000030};
+    const uint32_t slice1[VpVeboxStatistics::m_gneDwords] = {1, 2, 3, 0x80000001, 0x80000002, 0x80000003};
+
+    VP_VEBOX_GNE_STAT gne = VpVeboxStatistics::CombineGne(slice0, slice1, VpVeboxStatistics::m_tgneCountMask);
+    EXPECT_EQ(0x80000002u, gne.luma);
+    EXPECT_EQ(0x11u, gne.countLuma);
+    EXPECT_EQ(0x22u, gne.countChromaU);
+    EXPECT_EQ(0x33u, gne.countChromaV);
+}
+
+TEST(VpVeboxStatisticsTest, InvalidSum)
+{
+    const uint32_t valid[VpVeboxStatistics::m_gneDwords] = {100, 200, 300, 10, 20, 30};
+    const uint32_t empty[VpVeboxStatistics::m_gneDwords] = {};
+
+    // Any sum or count combined to all ones is reported invalid
+    for (uint32_t i = 0; i < VpVeboxStatistics::m_gneDwords; i++)
+    {
+        uint32_t slice0[VpVeboxStatistics::m_gneDwords] = {100, 200, 300, 10, 20, 30};
+        slice0[i] = 0xFFFFFFFF;
+
+        EXPECT_FALSE(VpVeboxStatistics::IsValid(VpVeboxStatistics::CombineGne(slice0, empty))) << "dword " << i;
+        EXPECT_TRUE(VpVeboxStatistics::IsValid(VpVeboxStatistics::CombineGne(slice0, valid))) << "dword " << i;
+    }
+
+    // Only all ones is invalid, not 0xFFFFFFF
+    const uint32_t large[VpVeboxStatistics::m_gneDwords] = {0xFFFFFFF, 0xFFFFFFF, 0xFFFFFFF, 0xFFFFFFF, 0xFFFFFFF, 0xFFFFFFF};
+    EXPECT_TRUE(VpVeboxStatistics::IsValid(VpVeboxStatistics::CombineGne(large, empty)));
+}
+
+TEST(VpVeboxStatisticsTest, NoiseLevel)
+{
+    EXPECT_EQ(0u, VpVeboxStatistics::GetNoiseLevel(0, 0));
+    EXPECT_EQ(500u, VpVeboxStatistics::GetNoiseLevel(50, 9));
+    EXPECT_EQ(100u, VpVeboxStatistics::GetNoiseLevel(100, 99));
+}
@@ -0,0 +1,183 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vphal_render_composite_bb_index.h"
+
+// Compares the compositing batch buffer index with the walk of the whole
+// table CompositeState::GetBestMatchBB did before, the first entry in table
+// order which matches the arguments must be chosen either way
+
+class VphalCompBbIndexTest : public testing::Test
+{
+protected:
+    // Few distinct values for every field so that random arguments often
+    // match, partly match or share all but one field
+    VPHAL_BB_COMP_ARGS MakeArgs()
+    {
+        VPHAL_BB_COMP_ARGS args;
+        // Padding and unused layers must not matter
+        memset(&args, Rand(2) ? 0 : 0x5A, sizeof(args));
+
+        args.iMediaID    = Rand(2);
+        args.fStepX      = Rand(3) == 0 ? -0.0f : (Rand(2) ? 0.0f : 0.5f);
+        args.iLayers     = 1 + Rand(VPHAL_COMP_MAX_LAYERS);
+        args.rcOutput    = {0, 0, 64 * (1 + Rand(2)), 64};
+        args.bSkipBlocks = Rand(2);
+        args.bEnableNLAS = Rand(3) == 0;
+        args.NLASParams  = {0.0f, 0.0f, (float)Rand(2)};
+        for (int32_t i = 0; i < args.iLayers; i++)
+        {
+            args.rcDst[i]    = {i, 0, 64 * (1 + Rand(2)), 64};
+            args.Rotation[i] = Rand(4) == 0 ? VPHAL_ROTATION_90 : VPHAL_ROTATION_IDENTITY;
+        }
+        return args;
+    }
+
+    int32_t Rand(int32_t n)
+    {
+        return (int32_t)(m_rng() % n);
+    }
+
+    void SetEntry(int32_t index, const VPHAL_BB_COMP_ARGS &args)
+    {
+        m_table[index] = args;
+        m_index.Update(index, args);
+    }
+
+    // The table walk, the first match of the valid entries
+    int32_t Walk(const VPHAL_BB_COMP_ARGS &args, int32_t count)
+    {
+        for (int32_t i = 0; i < count; i++)
+        {
+            if (VphalCompBbIndex::IsMatch(m_table[i], args))
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // The indexed search of GetBestMatchBB
+    int32_t Search(const VPHAL_BB_COMP_ARGS &args, int32_t count)
+    {
+        int32_t match = -1;
+        for (auto index : m_index.Find(args))
+        {
+            if (index < count && VphalCompBbIndex::IsMatch(m_table[index], args))
+            {
+                match = index;
+                break;
+            }
+        }
+        m_index.Record(match >= 0);
+        return match;
+    }
+
+    std::mt19937                    m_rng{1};
+    std::vector<VPHAL_BB_COMP_ARGS> m_table;
+    VphalCompBbIndex                m_index;
+};
+
+TEST_F(VphalCompBbIndexTest, SameEntryAsTableWalk)
+{
+    const int32_t tableSize = 32;
+    m_table.resize(tableSize);
+    for (int32_t i = 0; i < tableSize; i++)
+    {
+        SetEntry(i, MakeArgs());
+    }
+
+    uint32_t hits = 0;
+    for (uint32_t search = 0; search < 200000; search++)
+    {
+        // Batch buffers are reallocated with new arguments in place
+        if (Rand(4) == 0)
+        {
+            SetEntry(Rand(tableSize), MakeArgs());
+        }
+
+        // Either new arguments or those of an entry with fewer layers
+        VPHAL_BB_COMP_ARGS args = MakeArgs();
+        if (Rand(2))
+        {
+            args         = m_table[Rand(tableSize)];
+            args.iLayers = 1 + Rand(args.iLayers);
+        }
+
+        // Entries past the batch buffer count are not searched
+        int32_t count    = Rand(8) ? tableSize : Rand(tableSize);
+        int32_t expected = Walk(args, count);
+        ASSERT_EQ(expected, Search(args, count)) << "search " << search;
+        hits += expected >= 0;
+    }
+
+    EXPECT_GT(hits, 0u);
+    EXPECT_EQ(hits, m_index.GetHits());
+    EXPECT_EQ(200000u - hits, m_index.GetMisses());
+}
+
+TEST_F(VphalCompBbIndexTest, FewerLayersAndSignedZero)
+{
+    m_table.resize(2);
+    VPHAL_BB_COMP_ARGS args = MakeArgs();
+    args.iLayers            = 4;
+    args.fStepX             = 0.0f;
+    SetEntry(1, args);
+
+    // An entry with more layers serves the first ones
+    for (int32_t layers = 1; layers <= 4; layers++)
+    {
+        VPHAL_BB_COMP_ARGS input = args;
+        input.iLayers            = layers;
+        EXPECT_EQ(1, Search(input, 2));
+    }
+
+    // -0.0 compares equal to 0.0
+    VPHAL_BB_COMP_ARGS input = args;
+    input.fStepX             = -0.0f;
+    EXPECT_EQ(1, Search(input, 2));
+
+    // More layers or another rotation do not match
+    input.iLayers = 5;
+    EXPECT_EQ(-1, Search(input, 2));
+    input             = args;
+    input.Rotation[3] = VPHAL_ROTATION_180;
+    EXPECT_EQ(-1, Search(input, 2));
+
+    // The first entry in table order is taken
+    SetEntry(0, args);
+    EXPECT_EQ(0, Search(args, 2));
+
+    // An entry rewritten with other arguments is no longer found by the old ones
+    VPHAL_BB_COMP_ARGS other = args;
+    other.iMediaID ^= 1;
+    SetEntry(0, other);
+    SetEntry(1, other);
+    EXPECT_EQ(-1, Search(args, 2));
+    EXPECT_EQ(0, Search(other, 2));
+
+    m_index.Clear();
+    EXPECT_TRUE(m_index.Find(other).empty());
+}
@@ -122,6 +122,8 @@ MOS_STATUS HevcPipelineM12::InitScalabOption(HevcBasicFeature &basicFeature)
 
     scalPars.userPipeNum =
         uint8_t(ReadUserFeature(m_userSettingPtr, "HCP Decode User Pipe Num", MediaUserSetting::Group::Sequence).Get<uint32_t>());
+    scalPars.syncScheme = ScalabilitySyncScheme(
+        ReadUserFeature(m_userSettingPtr, "Decode Scalability Sync Scheme", MediaUserSetting::Group::Sequence).Get<uint32_t>());
 #endif
     // Long format real tile requires subset params
     if (!basicFeature.m_shortFormatInUse && basicFeature.m_hevcSubsetParams == nullptr)
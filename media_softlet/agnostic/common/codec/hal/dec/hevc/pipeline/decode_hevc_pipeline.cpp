@@ -169,6 +169,7 @@ MOS_STATUS HevcPipeline::InitContexOption(HevcScalabilityPars& scalPars)
     scalPars.usingHcp = true;
     scalPars.enableVE = MOS_VE_SUPPORTED(m_osInterface);
     scalPars.disableScalability = m_hwInterface->IsDisableScalability();
+    scalPars.numOtherVdboxSessions = m_mediaContext->GetOtherVdboxSessions();
     if (m_osInterface->pfnIsMultipleCodecDevicesInUse(m_osInterface))
     {
         scalPars.disableScalability = true;
@@ -40,7 +40,7 @@ DecodeInputBitstream::DecodeInputBitstream(DecodePipeline* pipeline, MediaTask*
 
 DecodeInputBitstream::~DecodeInputBitstream()
 {
-    m_allocator->Destroy(m_catenatedBuffer);
+    m_allocator->Destroy(m_catenatedBuffers);
 }
 
 MOS_STATUS DecodeInputBitstream::Init(CodechalSetting& settings)
@@ -103,15 +103,20 @@ MOS_STATUS DecodeInputBitstream::AllocateCatenatedBuffer()
 
     uint32_t allocSize = MOS_ALIGN_CEIL(m_requiredSize, MHW_CACHELINE_SIZE);
 
-    if (m_catenatedBuffer == nullptr)
+    if (m_catenatedBuffers == nullptr)
     {
-        m_catenatedBuffer = m_allocator->AllocateBuffer(
-            allocSize, "bitstream", resourceInputBitstream, notLockableVideoMem);
-        DECODE_CHK_NULL(m_catenatedBuffer);
-        return MOS_STATUS_SUCCESS;
+        m_catenatedBuffers = m_allocator->AllocateBufferArray(
+            allocSize, "bitstream", m_catenatedBufferNum, resourceInputBitstream, notLockableVideoMem);
+        DECODE_CHK_NULL(m_catenatedBuffers);
     }
 
-    DECODE_CHK_STATUS(m_allocator->Resize(m_catenatedBuffer, allocSize, notLockableVideoMem));
+    // Every frame takes the next buffer of the ring, so the copy of this frame
+    // neither waits for nor resizes the bitstream which frames in flight decode
+    PMOS_BUFFER &buffer = m_catenatedBuffers->Fetch();
+    DECODE_CHK_NULL(buffer);
+    DECODE_CHK_STATUS(m_allocator->Resize(buffer, allocSize, notLockableVideoMem));
+    m_catenatedBuffer = buffer;
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -131,18 +131,22 @@ protected:
     virtual void InitScalabilityPars(PMOS_INTERFACE osInterface) override;
 
     //!
-    //! \brief  Allocate catenated bitstream buffer
+    //! \brief  Allocate catenated bitstream buffer, each frame takes the next
+    //!         buffer of the ring
     //! \return MOS_STATUS
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS AllocateCatenatedBuffer();
 
 protected:
+    static constexpr uint32_t m_catenatedBufferNum = 3; //!< Frames which may have their bitstream in flight
+
     DecodeBasicFeature*  m_basicFeature   = nullptr; //!< Decode basic feature
     DecodeAllocator *    m_allocator      = nullptr; //!< Resource allocator
 
     HucCopyPktItf * m_concatPkt         = nullptr;   //!< Bitstream concat packet
-    PMOS_BUFFER     m_catenatedBuffer   = nullptr;   //!< Catenated bitstream for decode
+    BufferArray *   m_catenatedBuffers  = nullptr;   //!< Ring of catenated bitstream buffers
+    PMOS_BUFFER     m_catenatedBuffer   = nullptr;   //!< Catenated bitstream for decode of current frame
     uint32_t        m_requiredSize      = 0;         //!< Size of bitstream in bytes of current frame
     uint32_t        m_segmentsTotalSize = 0;         //!< Total size of segments in m_segments
 
@@ -196,6 +196,12 @@ MOS_STATUS DecodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         MediaUserSetting::Group::Sequence,
         int32_t(0),
         true);
+    DeclareUserSettingKeyForDebug(
+        userSettingPtr,
+        "Decode Scalability Sync Scheme",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
         "Decode SFC RGB Format Output",
@@ -29,6 +29,7 @@
 #include "mos_os.h"
 #include "mhw_vdbox.h"
 #include "media_scalability_defs.h"
+#include "decode_scalability_sync.h"
 
 namespace decode
 {
@@ -51,6 +52,8 @@ struct DecodeScalabilityPars : public ScalabilityPars
 
     MOS_FORMAT surfaceFormat = Format_NV12;
 
+    ScalabilitySyncScheme syncScheme = scalabilitySyncPerPipeFlags;
+
     uint8_t maxTileColumn = 0;
     uint8_t maxTileRow = 0;
 
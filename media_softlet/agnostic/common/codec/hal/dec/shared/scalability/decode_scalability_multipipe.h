@@ -242,6 +242,14 @@ protected:
     //!
     MOS_STATUS AllocateSemaphore();
 
+    //! \brief  Restart the syncs of all pipes on zeroed semaphores
+    //! \detail The sync commands of a frame dropped before its submission
+    //!         never run, which only matters to the shared epoch and leader schemes
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ResetSync();
+
     //!
     //! \brief  Send Cmd buffer Attributes with frame tracking info
     //!
@@ -265,6 +273,7 @@ protected:
     std::vector<std::vector<MOS_RESOURCE>> m_resSemaphoreAllPipes;    //!< The sync semaphore between all pipes
     std::vector<std::vector<MOS_RESOURCE>> m_resSemaphoreOnePipeWait; //!< The sync semaphore between main pipe and other pipes
     uint8_t                                m_semaphoreIndex = 0;      //!< The index for semaphore using by current frame
+    DecodeScalabilitySync                  m_sync;                    //!< The commands syncing all pipes
 
     DecodePhase                    *m_phase = nullptr;
 
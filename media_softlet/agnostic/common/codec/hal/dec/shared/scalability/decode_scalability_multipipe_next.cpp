@@ -66,10 +66,15 @@ MOS_STATUS DecodeScalabilityMultiPipeNext::AllocateSemaphore()
     allocParamsForBufferLinear.dwBytes  = sizeof(uint32_t);
     allocParamsForBufferLinear.pBufName = "Sync All Pipes SemaphoreMemory";
 
+    DecodeScalabilityOption *decodeScalabilityOption = dynamic_cast<DecodeScalabilityOption *>(m_scalabilityOption);
+    SCALABILITY_CHK_NULL_RETURN(decodeScalabilityOption);
+    SCALABILITY_CHK_STATUS_RETURN(m_sync.Init(
+        decodeScalabilityOption->GetSyncScheme(), m_scalabilityOption->GetNumPipe(), m_maxCmdBufferSetsNum));
+
     m_resSemaphoreAllPipes.resize(m_maxCmdBufferSetsNum);
     for (auto &semaphoreBufferVec : m_resSemaphoreAllPipes)
     {
-        semaphoreBufferVec.resize(m_scalabilityOption->GetNumPipe());
+        semaphoreBufferVec.resize(m_sync.GetSemaphoreNum());
         for (auto &semaphoreBuffer : semaphoreBufferVec)
         {
             memset(&semaphoreBuffer, 0, sizeof(MOS_RESOURCE));
@@ -349,6 +354,19 @@ MOS_STATUS DecodeScalabilityMultiPipeNext::GetCmdBuffer(PMOS_COMMAND_BUFFER cmdB
 
     SCALABILITY_CHK_STATUS_RETURN(m_osInterface->pfnGetCommandBuffer(m_osInterface, &m_primaryCmdBuffer, 0));
 
+    // The command buffers of a frame not submitted are reset with the OS
+    // states, the next frame then starts on an empty primary command buffer
+    // and the syncs of the dropped frame never run. Only the shared epoch and
+    // leader schemes carry semaphore values from one sync to the next, per
+    // pipe flags are back to zero after every sync.
+    ScalabilitySyncScheme scheme = m_sync.GetScheme();
+    bool syncStateful = scheme == scalabilitySyncSharedEpoch || scheme == scalabilitySyncLeader;
+    if (syncStateful && m_attrReady && m_primaryCmdBuffer.iOffset == 0)
+    {
+        SCALABILITY_CHK_STATUS_RETURN(ResetSync());
+        m_attrReady = false;
+    }
+
     uint32_t bufIdx = m_phase->GetCmdBufIndex();
     SCALABILITY_ASSERT(bufIdx >= DecodePhase::m_secondaryCmdBufIdxBase);
     uint32_t secondaryIdx = bufIdx - DecodePhase::m_secondaryCmdBufIdxBase;
@@ -490,6 +508,48 @@ MOS_STATUS DecodeScalabilityMultiPipeNext::SubmitCmdBuffer(PMOS_COMMAND_BUFFER c
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS DecodeScalabilityMultiPipeNext::ResetSync()
+{
+    SCALABILITY_FUNCTION_ENTER;
+    SCALABILITY_CHK_NULL_RETURN(m_osInterface);
+
+    DecodeScalabilityOption *decodeScalabilityOption = dynamic_cast<DecodeScalabilityOption *>(m_scalabilityOption);
+    SCALABILITY_CHK_NULL_RETURN(decodeScalabilityOption);
+    SCALABILITY_CHK_STATUS_RETURN(m_sync.Init(
+        decodeScalabilityOption->GetSyncScheme(), m_scalabilityOption->GetNumPipe(), m_maxCmdBufferSetsNum));
+
+    // The lock waits for the frames already submitted to be done with the semaphores
+    MOS_LOCK_PARAMS lockFlagsWriteOnly;
+    MOS_ZeroMemory(&lockFlagsWriteOnly, sizeof(MOS_LOCK_PARAMS));
+    lockFlagsWriteOnly.WriteOnly = 1;
+    for (auto semaphores : {&m_resSemaphoreAllPipes, &m_resSemaphoreOnePipeWait})
+    {
+        for (auto &semaphoreBufferVec : *semaphores)
+        {
+            for (auto &semaphoreBuffer : semaphoreBufferVec)
+            {
+                if (Mos_ResourceIsNull(&semaphoreBuffer))
+                {
+                    continue;
+                }
+                uint32_t *data = (uint32_t *)m_osInterface->pfnLockResource(
+                    m_osInterface,
+                    &semaphoreBuffer,
+                    &lockFlagsWriteOnly);
+                SCALABILITY_CHK_NULL_RETURN(data);
+                *data = 0;
+                SCALABILITY_CHK_STATUS_RETURN(m_osInterface->pfnUnlockResource(
+                    m_osInterface,
+                    &semaphoreBuffer));
+            }
+        }
+    }
+
+    m_semaphoreIndex = 0;
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS DecodeScalabilityMultiPipeNext::SyncAllPipes(PMOS_COMMAND_BUFFER cmdBuffer)
 {
     SCALABILITY_FUNCTION_ENTER;
@@ -498,34 +558,42 @@ MOS_STATUS DecodeScalabilityMultiPipeNext::SyncAllPipes(PMOS_COMMAND_BUFFER cmdB
 
     SCALABILITY_ASSERT(m_semaphoreIndex < m_resSemaphoreAllPipes.size());
     auto &semaphoreBufs = m_resSemaphoreAllPipes[m_semaphoreIndex];
-    SCALABILITY_ASSERT(semaphoreBufs.size() >= m_scalabilityOption->GetNumPipe());
+    SCALABILITY_ASSERT(semaphoreBufs.size() >= m_sync.GetSemaphoreNum());
 
     //Not stop watch dog here, expect to stop it in the packet when needed.
     //HW Semaphore cmd to make sure all pipes start encode at the same time
 
-    // Increment all pipe flags
-    for (uint32_t i = 0; i < m_pipeNum; i++)
+    std::vector<DecodeScalabilitySyncCmd> syncCmds;
+    SCALABILITY_CHK_STATUS_RETURN(m_sync.GetSyncCmds(m_semaphoreIndex, m_currentPipe, syncCmds));
+
+    for (auto &syncCmd : syncCmds)
     {
-        if (!Mos_ResourceIsNull(&semaphoreBufs[i]))
+        if (syncCmd.semaphore >= semaphoreBufs.size() || Mos_ResourceIsNull(&semaphoreBufs[syncCmd.semaphore]))
         {
-            SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->SendMiAtomicDwordCmd(
-                &semaphoreBufs[i], 1, MHW_MI_ATOMIC_INC, cmdBuffer));
+            continue;
         }
-    }
 
-    if (!Mos_ResourceIsNull(&semaphoreBufs[m_currentPipe]))
-    {
-        // Waiting current pipe flag euqal to pipe number which means other pipes are executing
-        SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->SendHwSemaphoreWaitCmd(
-            &semaphoreBufs[m_currentPipe], m_pipeNum, MHW_MI_SAD_EQUAL_SDD, cmdBuffer));
-
-        // Reset current pipe flag for next frame
-        MHW_MI_STORE_DATA_PARAMS    dataParams;
-        dataParams.pOsResource      = &semaphoreBufs[m_currentPipe];
-        dataParams.dwResourceOffset = 0;
-        dataParams.dwValue          = 0;
-        SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->GetMiInterface()->AddMiStoreDataImmCmd(
-            cmdBuffer, &dataParams));
+        PMOS_RESOURCE semaphoreBuf = &semaphoreBufs[syncCmd.semaphore];
+        if (syncCmd.type == DecodeScalabilitySyncCmd::atomicInc)
+        {
+            SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->SendMiAtomicDwordCmd(
+                semaphoreBuf, 1, MHW_MI_ATOMIC_INC, cmdBuffer));
+        }
+        else if (syncCmd.type == DecodeScalabilitySyncCmd::semaphoreWait)
+        {
+            SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->SendHwSemaphoreWaitCmd(
+                semaphoreBuf, syncCmd.value,
+                syncCmd.waitEqual ? MHW_MI_SAD_EQUAL_SDD : MHW_MI_SAD_GREATER_THAN_OR_EQUAL_SDD, cmdBuffer));
+        }
+        else
+        {
+            MHW_MI_STORE_DATA_PARAMS    dataParams;
+            dataParams.pOsResource      = semaphoreBuf;
+            dataParams.dwResourceOffset = 0;
+            dataParams.dwValue          = syncCmd.value;
+            SCALABILITY_CHK_STATUS_RETURN(m_hwInterface->GetMiInterface()->AddMiStoreDataImmCmd(
+                cmdBuffer, &dataParams));
+        }
     }
 
     return MOS_STATUS_SUCCESS;
@@ -37,6 +37,7 @@ DecodeScalabilityOption::DecodeScalabilityOption(const DecodeScalabilityOption &
     m_usingSFC              = option.m_usingSFC;
     m_usingSlimVdbox        = option.m_usingSlimVdbox;
     m_FESeparateSubmission  = option.m_FESeparateSubmission;
+    m_syncScheme            = option.m_syncScheme;
     m_raMode                = option.m_raMode;
     m_protectMode           = option.m_protectMode;
 }
@@ -49,6 +50,7 @@ MOS_STATUS DecodeScalabilityOption::SetScalabilityOption(ScalabilityPars *params
 
     m_numPipe        = 1;
     m_mode           = scalabilitySingleMode;
+    m_syncScheme     = scalabilitySyncPerPipeFlags;
     m_usingSFC       = decPars->usingSfc;
     m_usingSlimVdbox = decPars->usingSlimVdbox;
     m_raMode         = decPars->raMode;
@@ -85,18 +87,28 @@ MOS_STATUS DecodeScalabilityOption::SetScalabilityOption(ScalabilityPars *params
     {
         m_numPipe = (decPars->numVdbox >= m_maxNumMultiPipe) ? m_maxNumMultiPipe : m_typicalNumMultiPipe;
     }
-    else if (isRealTileDecode ||
-             (!decPars->disableVirtualTile &&
-              IsResolutionMatchMultiPipeThreshold1(decPars->frameWidth, decPars->frameHeight, decPars->surfaceFormat)))
+    else if (isRealTileDecode)
     {
         m_numPipe = m_typicalNumMultiPipe;
     }
+    else if (!decPars->disableVirtualTile &&
+             IsResolutionMatchMultiPipeThreshold1(decPars->frameWidth, decPars->frameHeight, decPars->surfaceFormat))
+    {
+        // Virtual tiles only pay off on idle VDBoxes, when the other sessions
+        // already keep them busy the extra pipe just adds synchronization
+        if (decPars->numOtherVdboxSessions + m_typicalNumMultiPipe <= decPars->numVdbox)
+        {
+            m_numPipe = m_typicalNumMultiPipe;
+        }
+    }
 
     if (m_numPipe >= m_typicalNumMultiPipe)
     {
         m_mode = isRealTileDecode ? scalabilityRealTileMode : scalabilityVirtualTileMode;
     }
 
+    m_syncScheme = DecodeScalabilitySync::SelectScheme(decPars->syncScheme, m_numPipe);
+
     if (m_mode == scalabilityVirtualTileMode && decPars->numVdbox >= m_maxNumMultiPipe)
     {
         m_FESeparateSubmission = true;
@@ -107,10 +119,10 @@ MOS_STATUS DecodeScalabilityOption::SetScalabilityOption(ScalabilityPars *params
     }
 
     SCALABILITY_VERBOSEMESSAGE(
-        "Tile Column = %d, System VDBOX Num = %d, Decided Pipe Num = %d, "
-        "Using SFC = %d, Using Slim Vdbox = %d, Scalability Mode = %d, FE separate submission = %d.",
-        decPars->numTileColumns, decPars->numVdbox, m_numPipe,
-        m_usingSFC, m_usingSlimVdbox, m_mode, m_FESeparateSubmission);
+        "Tile Column = %d, System VDBOX Num = %d, Other VDBOX Sessions = %d, Decided Pipe Num = %d, "
+        "Using SFC = %d, Using Slim Vdbox = %d, Scalability Mode = %d, FE separate submission = %d, Sync Scheme = %d.",
+        decPars->numTileColumns, decPars->numVdbox, decPars->numOtherVdboxSessions, m_numPipe,
+        m_usingSFC, m_usingSlimVdbox, m_mode, m_FESeparateSubmission, m_syncScheme);
     return MOS_STATUS_SUCCESS;
 }
 
@@ -132,6 +144,7 @@ bool DecodeScalabilityOption::IsScalabilityOptionMatched(ScalabilityPars *params
         m_usingSlimVdbox       != newOption.IsUsingSlimVdbox()       ||
         m_mode                 != newOption.GetMode()                ||
         m_FESeparateSubmission != newOption.IsFESeparateSubmission() ||
+        m_syncScheme           != newOption.GetSyncScheme()          ||
         m_raMode               != newOption.GetRAMode()              ||
         m_protectMode          != newOption.GetProtectMode())
     {
@@ -157,6 +170,7 @@ bool DecodeScalabilityOption::IsScalabilityOptionMatched(MediaScalabilityOption
         m_usingSlimVdbox       != decodeOption->IsUsingSlimVdbox()       ||
         m_mode                 != decodeOption->GetMode()                ||
         m_FESeparateSubmission != decodeOption->IsFESeparateSubmission() ||
+        m_syncScheme           != decodeOption->GetSyncScheme()          ||
         m_raMode               != decodeOption->GetRAMode()              ||
         m_protectMode          != decodeOption->GetProtectMode())
     {
@@ -113,6 +113,12 @@ public:
     //!
     bool IsFESeparateSubmission() { return m_FESeparateSubmission; }
 
+    //! \brief  Get the semaphore scheme syncing all pipes
+    //! \return ScalabilitySyncScheme
+    //!         Return the sync scheme, never scalabilitySyncAuto
+    //!
+    ScalabilitySyncScheme GetSyncScheme() { return m_syncScheme; }
+
     //! \brief  Get LRCA count
     //! \return uint32_t
     //!         Return LRCA count
@@ -147,6 +153,7 @@ protected:
 
     bool            m_FESeparateSubmission = false;
     ScalabilityMode m_mode                 = scalabilitySingleMode;
+    ScalabilitySyncScheme m_syncScheme = scalabilitySyncPerPipeFlags;
 
 MEDIA_CLASS_DEFINE_END(decode__DecodeScalabilityOption)
 };
@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     decode_scalability_sync.cpp
+//! \brief    Implements the semaphore schemes syncing all the pipes of decode scalability
+//!
+
+#include "decode_scalability_sync.h"
+
+namespace decode
+{
+MOS_STATUS DecodeScalabilitySync::Init(ScalabilitySyncScheme scheme, uint32_t pipeNum, uint32_t setNum)
+{
+    if (pipeNum == 0 || setNum == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    m_scheme   = SelectScheme(scheme, pipeNum);
+    m_pipeNum  = pipeNum;
+    m_maxEpoch = UINT32_MAX / pipeNum;
+    m_pipes.assign(setNum * pipeNum, PipeState());
+
+    return MOS_STATUS_SUCCESS;
+}
+
+ScalabilitySyncScheme DecodeScalabilitySync::SelectScheme(ScalabilitySyncScheme scheme, uint32_t pipeNum)
+{
+    // The shared epoch and leader schemes are not validated on hardware yet,
+    // they are only taken on request
+    return (scheme == scalabilitySyncAuto) ? scalabilitySyncPerPipeFlags : scheme;
+}
+
+void DecodeScalabilitySync::AddCmd(std::vector<DecodeScalabilitySyncCmd> &cmds, DecodeScalabilitySyncCmd::Type type,
+    uint32_t semaphore, uint32_t value, bool waitEqual)
+{
+    DecodeScalabilitySyncCmd cmd;
+    cmd.type      = type;
+    cmd.semaphore = semaphore;
+    cmd.value     = value;
+    cmd.waitEqual = waitEqual;
+    cmds.push_back(cmd);
+}
+
+void DecodeScalabilitySync::AddLeadSync(std::vector<DecodeScalabilitySyncCmd> &cmds, uint32_t pipeIdx, uint32_t arrivals, uint32_t release)
+{
+    if (pipeIdx != 0)
+    {
+        AddCmd(cmds, DecodeScalabilitySyncCmd::atomicInc, m_counterSemaphore);
+        AddCmd(cmds, DecodeScalabilitySyncCmd::semaphoreWait, m_releaseSemaphore, release);
+        return;
+    }
+
+    // Nobody increments the counter again before the release, so it can be
+    // waited for exactly and reset
+    AddCmd(cmds, DecodeScalabilitySyncCmd::semaphoreWait, m_counterSemaphore, arrivals);
+    AddCmd(cmds, DecodeScalabilitySyncCmd::storeData, m_counterSemaphore, 0);
+    AddCmd(cmds, DecodeScalabilitySyncCmd::storeData, m_releaseSemaphore, release);
+}
+
+MOS_STATUS DecodeScalabilitySync::GetSyncCmds(uint32_t setIdx, uint32_t pipeIdx, std::vector<DecodeScalabilitySyncCmd> &cmds)
+{
+    if (pipeIdx >= m_pipeNum || (setIdx + 1) * m_pipeNum > m_pipes.size())
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    PipeState &pipe = m_pipes[setIdx * m_pipeNum + pipeIdx];
+    cmds.clear();
+
+    switch (m_scheme)
+    {
+    case scalabilitySyncSharedEpoch:
+        pipe.epoch++;
+        if (pipe.epoch < m_maxEpoch)
+        {
+            // Pipes already through this sync may increment for the next one
+            AddCmd(cmds, DecodeScalabilitySyncCmd::atomicInc, m_counterSemaphore);
+            AddCmd(cmds, DecodeScalabilitySyncCmd::semaphoreWait, m_counterSemaphore, pipe.epoch * m_pipeNum, false);
+        }
+        else
+        {
+            // The counter is about to wrap, this sync resets it
+            if (pipeIdx == 0)
+            {
+                AddCmd(cmds, DecodeScalabilitySyncCmd::atomicInc, m_counterSemaphore);
+            }
+            AddLeadSync(cmds, pipeIdx, pipe.epoch * m_pipeNum, ++pipe.release);
+            pipe.epoch = 0;
+        }
+        break;
+    case scalabilitySyncLeader:
+        AddLeadSync(cmds, pipeIdx, m_pipeNum - 1, ++pipe.release);
+        break;
+    case scalabilitySyncPerPipeFlags:
+    default:
+        for (uint32_t i = 0; i < m_pipeNum; i++)
+        {
+            AddCmd(cmds, DecodeScalabilitySyncCmd::atomicInc, i);
+        }
+        AddCmd(cmds, DecodeScalabilitySyncCmd::semaphoreWait, pipeIdx, m_pipeNum);
+        AddCmd(cmds, DecodeScalabilitySyncCmd::storeData, pipeIdx, 0);
+        break;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+}  // namespace decode
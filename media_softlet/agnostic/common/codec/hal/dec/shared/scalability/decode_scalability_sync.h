@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     decode_scalability_sync.h
+//! \brief    Defines the semaphore schemes syncing all the pipes of decode scalability
+//!
+
+#ifndef __DECODE_SCALABILITY_SYNC_H__
+#define __DECODE_SCALABILITY_SYNC_H__
+#include <stdint.h>
+#include <vector>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+namespace decode
+{
+enum ScalabilitySyncScheme
+{
+    scalabilitySyncAuto,          //!< per pipe flags, the other schemes are only taken on request
+    scalabilitySyncPerPipeFlags,  //!< every pipe increments the flag of every pipe, waits for its own and resets it
+    scalabilitySyncSharedEpoch,   //!< every pipe increments one shared counter and waits for the epoch of the sync
+    scalabilitySyncLeader,        //!< every pipe reports to the first pipe, which releases them all
+};
+
+//!
+//! \brief  One MI command of a sync, on a semaphore of the semaphore set of the frame
+//!
+struct DecodeScalabilitySyncCmd
+{
+    enum Type
+    {
+        atomicInc,      //!< MI_ATOMIC increment
+        semaphoreWait,  //!< MI_SEMAPHORE_WAIT
+        storeData,      //!< MI_STORE_DATA_IMM
+    };
+
+    Type     type;
+    uint32_t semaphore;  //!< index of the semaphore in the set
+    uint32_t value;      //!< value waited for or stored
+    bool     waitEqual;  //!< wait for the value, else for at least the value
+};
+
+//!
+//! \class  DecodeScalabilitySync
+//!
+//! \brief  Plans the commands each pipe sends to sync all the pipes.
+//!
+//! \detail With per pipe flags every pipe sends pipeNum + 2 commands. The
+//!         shared epoch scheme sends 2 commands per pipe: the counter is never
+//!         reset, the n-th sync of a set waits for n * pipeNum increments. Only
+//!         before the counter would wrap, one sync is led by the first pipe,
+//!         which resets the counter once all the pipes arrived. The leader
+//!         scheme has all the pipes but the first one increment an arrival
+//!         counter and wait for the release value of the sync, which the first
+//!         pipe stores once all arrived, after resetting the arrival counter.
+//!         Every pipe has to go through the same number of syncs on a set.
+//!
+class DecodeScalabilitySync
+{
+public:
+    DecodeScalabilitySync() = default;
+
+    virtual ~DecodeScalabilitySync() = default;
+
+    //!
+    //! \brief  Reset the sync state of all the pipes, the semaphores have to be zeroed as well
+    //! \detail Has to be called again whenever commands got from GetSyncCmds are
+    //!         dropped before running, or the semaphores lost their values
+    //! \param  [in] scheme
+    //!         Sync scheme
+    //! \param  [in] pipeNum
+    //!         Number of pipes
+    //! \param  [in] setNum
+    //!         Number of semaphore sets
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Init(ScalabilitySyncScheme scheme, uint32_t pipeNum, uint32_t setNum);
+
+    //!
+    //! \brief  Get the commands the pipe sends for its next sync on the semaphore set
+    //! \param  [in] setIdx
+    //!         Index of the semaphore set
+    //! \param  [in] pipeIdx
+    //!         Index of the pipe
+    //! \param  [out] cmds
+    //!         Commands of the sync, in order
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS GetSyncCmds(uint32_t setIdx, uint32_t pipeIdx, std::vector<DecodeScalabilitySyncCmd> &cmds);
+
+    //!
+    //! \brief  Resolve scalabilitySyncAuto to the default scheme, per pipe flags
+    //!
+    static ScalabilitySyncScheme SelectScheme(ScalabilitySyncScheme scheme, uint32_t pipeNum);
+
+    ScalabilitySyncScheme GetScheme() const { return m_scheme; }
+
+    //!
+    //! \brief  Get the number of semaphores of a set
+    //!
+    uint32_t GetSemaphoreNum() const
+    {
+        return (m_scheme == scalabilitySyncPerPipeFlags) ? m_pipeNum : m_semaphoreNum;
+    }
+
+protected:
+    enum
+    {
+        m_counterSemaphore = 0,  //!< shared counter, or arrival counter of the leader
+        m_releaseSemaphore = 1,  //!< release value stored by the leader
+        m_semaphoreNum     = 2
+    };
+
+    struct PipeState
+    {
+        uint32_t epoch   = 0;  //!< syncs done on the set since the counter was reset
+        uint32_t release = 0;  //!< syncs led on the set
+    };
+
+    void AddCmd(std::vector<DecodeScalabilitySyncCmd> &cmds, DecodeScalabilitySyncCmd::Type type,
+        uint32_t semaphore, uint32_t value = 0, bool waitEqual = true);
+
+    void AddLeadSync(std::vector<DecodeScalabilitySyncCmd> &cmds, uint32_t pipeIdx, uint32_t arrivals, uint32_t release);
+
+    ScalabilitySyncScheme  m_scheme   = scalabilitySyncPerPipeFlags;
+    uint32_t               m_pipeNum  = 0;
+    uint32_t               m_maxEpoch = 0;   //!< shared epoch syncs before the counter is reset
+    std::vector<PipeState> m_pipes;          //!< by set, then by pipe
+
+MEDIA_CLASS_DEFINE_END(decode__DecodeScalabilitySync)
+};
+}  // namespace decode
+#endif  // !__DECODE_SCALABILITY_SYNC_H__
@@ -26,6 +26,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_singlepipe_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_multipipe.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_multipipe_next.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_sync.cpp
 )
 
 set(TMP_HEADERS_
@@ -36,6 +37,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_singlepipe_next.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_multipipe.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_multipipe_next.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_scalability_sync.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_phase.h
 )
 endif()
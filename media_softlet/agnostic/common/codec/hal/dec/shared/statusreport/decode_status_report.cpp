@@ -137,6 +137,7 @@ namespace decode {
 
         MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+        TrackSubmission();
         m_submittedCount++;
         uint32_t submitIndex = CounterToIndex(m_submittedCount);
 
@@ -190,6 +190,7 @@ MOS_STATUS Vp9Pipeline::InitContexOption(Vp9BasicFeature &basicFeature)
     scalPars.frameWidth         = basicFeature.m_frameWidthAlignedMinBlk;
     scalPars.frameHeight        = basicFeature.m_frameHeightAlignedMinBlk;
     scalPars.numVdbox           = m_numVdbox;
+    scalPars.numOtherVdboxSessions = m_mediaContext->GetOtherVdboxSessions();
     if (m_osInterface->pfnIsMultipleCodecDevicesInUse(m_osInterface))
     {
         scalPars.disableScalability = true;
@@ -211,6 +212,8 @@ MOS_STATUS Vp9Pipeline::InitContexOption(Vp9BasicFeature &basicFeature)
         ReadUserFeature(m_userSettingPtr, "HCP Decode Always Frame Split", MediaUserSetting::Group::Sequence).Get<bool>();
     scalPars.userPipeNum =
         ReadUserFeature(m_userSettingPtr, "HCP Decode User Pipe Num", MediaUserSetting::Group::Sequence).Get<uint8_t>();
+    scalPars.syncScheme = ScalabilitySyncScheme(
+        ReadUserFeature(m_userSettingPtr, "Decode Scalability Sync Scheme", MediaUserSetting::Group::Sequence).Get<uint32_t>());
 #endif
 
 #ifdef _DECODE_PROCESSING_SUPPORTED
@@ -216,6 +216,11 @@ MOS_STATUS Av1BasicFeature::Update(void *params)
 
     if (m_resolutionChanged)
     {
+        if (m_frameNum == 0)
+        {
+            ENCODE_CHK_STATUS_RETURN(RegisterMaxSizeTrackedBuffers());
+        }
+
         m_picWidthInMb  = (uint16_t)CODECHAL_GET_WIDTH_IN_MACROBLOCKS(m_oriFrameWidth);
         m_picHeightInMb = (uint16_t)CODECHAL_GET_HEIGHT_IN_MACROBLOCKS(m_oriFrameHeight);
         m_frameWidth    = m_picWidthInMb * CODECHAL_MACROBLOCK_WIDTH;
@@ -304,6 +309,42 @@ MOS_STATUS Av1BasicFeature::UpdateTrackedBufferParameters()
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS Av1BasicFeature::RegisterMaxSizeTrackedBuffers()
+{
+    ENCODE_FUNC_CALL();
+    ENCODE_CHK_NULL_RETURN(m_trackedBuf);
+
+    if (!m_trackedBuf->IsMaxSizeMode() ||
+        (m_maxFrameWidth <= m_oriFrameWidth && m_maxFrameHeight <= m_oriFrameHeight))
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint32_t frameWidth    = m_frameWidth;
+    uint32_t frameHeight   = m_frameHeight;
+    int32_t  picWidthInSb  = m_picWidthInSb;
+    int32_t  picHeightInSb = m_picHeightInSb;
+
+    int32_t mibSizeLog2 = m_isSb128x128 ? av1MaxMibSizeLog2 : av1MinMibSizeLog2;
+    int32_t miCols      = MOS_ALIGN_CEIL(MOS_ALIGN_CEIL(m_maxFrameWidth, 8) >> av1MiSizeLog2, 1 << mibSizeLog2);
+    int32_t miRows      = MOS_ALIGN_CEIL(MOS_ALIGN_CEIL(m_maxFrameHeight, 8) >> av1MiSizeLog2, 1 << mibSizeLog2);
+
+    m_frameWidth    = m_maxFrameWidth;
+    m_frameHeight   = m_maxFrameHeight;
+    m_picWidthInSb  = miCols >> mibSizeLog2;
+    m_picHeightInSb = miRows >> mibSizeLog2;
+
+    MOS_STATUS status = UpdateTrackedBufferParameters();
+
+    // the frame size parameters are registered by the caller right after
+    m_frameWidth    = frameWidth;
+    m_frameHeight   = frameHeight;
+    m_picWidthInSb  = picWidthInSb;
+    m_picHeightInSb = picHeightInSb;
+
+    return status;
+}
+
 uint32_t Av1BasicFeature::GetProfileLevelMaxFrameSize()
 {
     ENCODE_FUNC_CALL();
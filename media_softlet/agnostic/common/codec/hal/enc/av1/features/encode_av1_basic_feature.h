@@ -79,6 +79,14 @@ public:
 
     MOS_STATUS UpdateTrackedBufferParameters() override;
 
+    //!
+    //! \brief  Register the tracked buffers for the max frame size of the stream,
+    //!         so that smaller frames reinterpret them instead of reallocating
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS RegisterMaxSizeTrackedBuffers();
+
     virtual MOS_STATUS UpdateFormat(void *params) override;
 
     virtual MOS_STATUS UpdateDefaultCdfTable();
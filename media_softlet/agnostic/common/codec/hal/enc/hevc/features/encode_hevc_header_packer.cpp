@@ -136,13 +136,14 @@ MOS_STATUS HevcHeaderPacker::GetSliceParams(const CODEC_HEVC_ENCODE_SLICE_PARAMS
     return MOS_STATUS_SUCCESS;
 }
 
+template <class BsWriter>
 void HevcHeaderPacker::PackSSH(
-    BitstreamWriter &bs,
+    BsWriter &       bs,
     HevcNALU const & nalu,
     HevcSPS const &  sps,
     HevcPPS const &  pps,
     HevcSlice const &slice,
-    bool             dyn_slice_size = false)
+    bool             dyn_slice_size)
 {
     PackNALU(bs, nalu);
 
@@ -165,7 +166,8 @@ void HevcHeaderPacker::PackSSH(
         bs.PutTrailingBits();
 }
 
-void HevcHeaderPacker::PackNALU(BitstreamWriter &bs, NALU const &h)
+template <class BsWriter>
+void HevcHeaderPacker::PackNALU(BsWriter &bs, NALU const &h)
 {
     bool bLong_SC =
         h.nal_unit_type == VPS_NUT || h.nal_unit_type == SPS_NUT || h.nal_unit_type == PPS_NUT || h.nal_unit_type == AUD_NUT || h.nal_unit_type == PREFIX_SEI_NUT || h.long_start_code;
@@ -181,8 +183,9 @@ void HevcHeaderPacker::PackNALU(BitstreamWriter &bs, NALU const &h)
     bs.PutBits(3, h.nuh_temporal_id_plus1);
 }
 
+template <class BsWriter>
 void HevcHeaderPacker::PackSSHPartIdAddr(
-    BitstreamWriter &bs,
+    BsWriter &       bs,
     NALU const &     nalu,
     SPS const &      sps,
     PPS const &      pps,
@@ -209,8 +212,9 @@ void HevcHeaderPacker::PackSSHPartIdAddr(
     }
 }
 
+template <class BsWriter>
 void HevcHeaderPacker::PackSSHPartIndependent(
-    BitstreamWriter &bs,
+    BsWriter &       bs,
     NALU const &     nalu,
     SPS const &      sps,
     PPS const &      pps,
@@ -260,8 +264,9 @@ void HevcHeaderPacker::PackSSHPartIndependent(
     ENCODE_ASSERT(nSE >= 2);
 }
 
+template <class BsWriter>
 void HevcHeaderPacker::PackSSHPartNonIDR(
-    BitstreamWriter &bs,
+    BsWriter &       bs,
     SPS const &      sps,
     Slice const &    slice)
 {
@@ -305,7 +310,8 @@ void HevcHeaderPacker::PackSSHPartNonIDR(
     ENCODE_ASSERT(nSE >= 2);
 }
 
-void HevcHeaderPacker::PackSTRPS(BitstreamWriter &bs, const STRPS *sets, mfxU32 num, mfxU32 idx)
+template <class BsWriter>
+void HevcHeaderPacker::PackSTRPS(BsWriter &bs, const STRPS *sets, mfxU32 num, mfxU32 idx)
 {
     //This function is not needed for I frame.
     STRPS const &strps = sets[idx];
@@ -345,8 +351,9 @@ void HevcHeaderPacker::PackSTRPS(BitstreamWriter &bs, const STRPS *sets, mfxU32
     }
 };
 
+template <class BsWriter>
 void HevcHeaderPacker::PackSSHPartPB(
-    BitstreamWriter &bs,
+    BsWriter &       bs,
     SPS const &      sps,
     PPS const &      pps,
     Slice const &    slice)
@@ -400,8 +407,9 @@ void HevcHeaderPacker::PackSSHPartPB(
     ENCODE_ASSERT(nSE >= 2);
 }
 
+template <class BsWriter>
 bool HevcHeaderPacker::PackSSHPWT(
-    BitstreamWriter &bs, const SPS &sps, const PPS &pps, const Slice &slice)
+    BsWriter &bs, const SPS &sps, const PPS &pps, const Slice &slice)
 {
     //This function is not needed for I frame.
     constexpr mfxU16 Y = 0, Cb = 1, Cr = 2, W = 0, O = 1, P = 1, B = 0;
@@ -522,13 +530,13 @@ MOS_STATUS HevcHeaderPacker::LoadSliceHeaderParams(CodecEncodeHevcSliceHeaderPar
 MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
 {
     MOS_OS_FUNCTION_ENTER;
-    MOS_STATUS      eStatus;
-    BitstreamWriter rbsp(m_rbsp.data(), (mfxU32)m_rbsp.size());
-    mfxU8 *         pBegin      = rbsp.GetStart();
-    mfxU8 *         startplace  = pBegin;
-    mfxU8 *         pEnd        = pBegin + m_rbsp.size();
-    mfxU32          BitLen;
-    mfxU32          BitLenRecorded = 0;
+    MOS_STATUS          eStatus;
+    BitstreamWriterFast rbsp(m_rbsp.data(), (mfxU32)m_rbsp.size());
+    mfxU8 *             pBegin      = rbsp.GetStart();
+    mfxU8 *             startplace  = pBegin;
+    mfxU8 *             pEnd        = pBegin + m_rbsp.size();
+    mfxU32              BitLen;
+    mfxU32              BitLenRecorded = 0;
 
     EncoderParams *pCodecHalEncodeParams = encodeParams;
     ENCODE_CHK_NULL_RETURN(pCodecHalEncodeParams);
@@ -550,6 +558,7 @@ MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
         rbsp.Reset(pBegin, mfxU32(pEnd - pBegin));
         m_naluParams.long_start_code = 0/*pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 == pBSBuffer->pBase*/;
         PackSSH(rbsp, m_naluParams, m_spsParams, m_ppsParams, m_sliceParams, m_bDssEnabled);
+        rbsp.Flush();
         BitLen = rbsp.GetOffset();
         pBegin += CeilDiv(BitLen, 8u);
         pSlcData[slcCount].SliceOffset            = (uint32_t)(pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 - pBSBuffer->pBase);
@@ -564,4 +573,14 @@ MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
         (BitLenRecorded + 7) / 8);
 
     return MOS_STATUS_SUCCESS;
-}
\ No newline at end of file
+}
+
+// The slice headers are packed with BitstreamWriterFast, BitstreamWriter stays
+// available to pack with CABAC
+template void HevcHeaderPacker::PackSSH<BitstreamWriter>(
+    BitstreamWriter &bs,
+    HevcNALU const & nalu,
+    HevcSPS const &  sps,
+    HevcPPS const &  pps,
+    HevcSlice const &slice,
+    bool             dyn_slice_size);
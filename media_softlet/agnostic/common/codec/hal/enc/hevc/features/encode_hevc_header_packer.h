@@ -27,6 +27,7 @@
 #define __ENCODE_HEVC_HEADER_PACKER_H__
 
 #include "bitstream_writer.h"
+#include "bitstream_writer_fast.h"
 #include "codec_def_common_encode.h"
 #include "codec_def_encode.h"
 #include "codec_def_encode_hevc.h"
@@ -499,16 +500,19 @@ public:
     MOS_STATUS GetSPSParams(PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS hevcSeqParams);
     MOS_STATUS GetSliceParams(const CODEC_HEVC_ENCODE_SLICE_PARAMS hevcSliceParams);
     MOS_STATUS LoadSliceHeaderParams(CodecEncodeHevcSliceHeaderParams* pSH);
+    template <class BsWriter>
     void       PackSSH(
-              BitstreamWriter &bs,
+              BsWriter &       bs,
               HevcNALU const & nalu,
               HevcSPS const &  sps,
               HevcPPS const &  pps,
               HevcSlice const &slice,
-              bool             dyn_slice_size);
-    void PackNALU(BitstreamWriter &bs, NALU const &h);
+              bool             dyn_slice_size = false);
+    template <class BsWriter>
+    void PackNALU(BsWriter &bs, NALU const &h);
+    template <class BsWriter>
     void PackSSHPartIdAddr(
-        BitstreamWriter &bs,
+        BsWriter &       bs,
         NALU const &     nalu,
         SPS const &      sps,
         PPS const &      pps,
@@ -530,45 +534,54 @@ public:
             ++l;
         return l;
     }
+    template <class BsWriter>
     void PackSSHPartIndependent(
-        BitstreamWriter &bs,
+        BsWriter &       bs,
         NALU const &     nalu,
         SPS const &      sps,
         PPS const &      pps,
         Slice const &    slice);
 
+    template <class BsWriter>
     void PackSSHPartNonIDR(
-        BitstreamWriter &bs,
+        BsWriter &       bs,
         SPS const &      sps,
         Slice const &    slice);
 
-    void PackSTRPS(BitstreamWriter &bs, const STRPS *sets, mfxU32 num, mfxU32 idx);
+    template <class BsWriter>
+    void PackSTRPS(BsWriter &bs, const STRPS *sets, mfxU32 num, mfxU32 idx);
 
+    template <class BsWriter>
     void PackSSHPartPB(
-        BitstreamWriter &bs,
+        BsWriter &       bs,
         SPS const &      sps,
         PPS const &      pps,
         Slice const &    slice);
 
+    template <class BsWriter>
     bool PackSSHPWT(
-        BitstreamWriter &bs, const SPS &sps, const PPS &pps, const Slice &slice);
+        BsWriter &bs, const SPS &sps, const PPS &pps, const Slice &slice);
 
-    static bool PutUE(BitstreamWriter &bs, mfxU32 b)
+    template <class BsWriter>
+    static bool PutUE(BsWriter &bs, mfxU32 b)
     {
         bs.PutUE(b);
         return true;
     };
-    static bool PutSE(BitstreamWriter &bs, mfxI32 b)
+    template <class BsWriter>
+    static bool PutSE(BsWriter &bs, mfxI32 b)
     {
         bs.PutSE(b);
         return true;
     };
-    static bool PutBit(BitstreamWriter &bs, mfxU32 b)
+    template <class BsWriter>
+    static bool PutBit(BsWriter &bs, mfxU32 b)
     {
         bs.PutBit(!!b);
         return true;
     };
-    static bool PutBits(BitstreamWriter &bs, mfxU32 n, mfxU32 b)
+    template <class BsWriter>
+    static bool PutBits(BsWriter &bs, mfxU32 n, mfxU32 b)
     {
         if (n)
             bs.PutBits(n, b);
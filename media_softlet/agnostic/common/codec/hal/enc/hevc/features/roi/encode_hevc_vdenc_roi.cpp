@@ -51,17 +51,11 @@ HevcVdencRoi::HevcVdencRoi(
 }
 MOS_STATUS HevcVdencRoi::ClearStreaminBuffer(uint32_t lucNumber)
 {
-    // Clear streamin
+    // Clear the CPU copy only, the stream-in buffer gets all of it once the
+    // frame is written
+    m_streamInTemp = m_streamInCache.BeginFrame();
     ENCODE_CHK_NULL_RETURN(m_streamInTemp);
 
-    uint8_t *data = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(data);
-
-    MOS_ZeroMemory(m_streamInTemp, lucNumber * 64);
-    MOS_SecureMemcpy(data, m_streamInSize, m_streamInTemp, m_streamInSize);
-
-    ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(m_streamIn));
-
     return MOS_STATUS_SUCCESS;
 }
 
@@ -96,6 +90,11 @@ MOS_STATUS HevcVdencRoi::Init(void *setting)
     allocParams.pBufName = "VDEnc StreamIn Data Buffer";
     m_basicFeature->m_recycleBuf->RegisterResource(RecycleResId::StreamInBuffer, allocParams);
 
+    // Stream-in buffers are brought up to date by rows of 64x64 CTUs
+    ENCODE_CHK_STATUS_RETURN(m_streamInCache.Init(
+        m_streamInSize,
+        (MOS_ALIGN_CEIL(m_basicFeature->m_frameWidth, 64) / 32) * 2 * CODECHAL_CACHELINE_SIZE));
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -158,9 +157,6 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
     if (!m_isArbRoi || (hevcPicParams->CodingType == I_TYPE && !IFrameIsSet) || ((hevcPicParams->CodingType == P_TYPE || hevcPicParams->CodingType == B_TYPE) && !PBFrameIsSet))
     {
-        m_streamInTemp = (uint8_t *)MOS_AllocMemory(m_streamInSize);
-        ENCODE_CHK_NULL_RETURN(m_streamInTemp);
-
         uint32_t lcuNumber = GetLCUNumber();
 
         ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer(lcuNumber));
@@ -185,8 +181,6 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
         ENCODE_CHK_STATUS_RETURN(WriteStreaminData());
 
-        MOS_SafeFreeMemory(m_streamInTemp);
-
 #if (_DEBUG || _RELEASE_INTERNAL)
         ENCODE_CHK_NULL_RETURN(m_hwInterface);
         ENCODE_CHK_NULL_RETURN(m_hwInterface->GetOsInterface());
@@ -215,18 +209,27 @@ MOS_STATUS HevcVdencRoi::WriteStreaminData()
     ENCODE_CHK_NULL_RETURN(m_streamIn);
     ENCODE_CHK_NULL_RETURN(m_streamInTemp);
 
-    uint8_t *streaminBuffer = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(streaminBuffer);
-
     m_roiOverlap.WriteStreaminData(
         m_strategyFactory.GetRoi(), 
         m_strategyFactory.GetDirtyRoi(),
         m_streamInTemp);
 
-    MOS_SecureMemcpy(streaminBuffer, m_streamInSize, m_streamInTemp, m_streamInSize);
+    m_streamInCache.EndFrame();
+    m_streamInTemp = nullptr;
+
+    // Recycled buffers often still hold the data, e.g. for static ROI
+    if (m_streamInCache.IsUpToDate(m_streamIn))
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint8_t *streaminBuffer = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
+    ENCODE_CHK_NULL_RETURN(streaminBuffer);
+
+    MOS_STATUS status = m_streamInCache.Write(m_streamIn, streaminBuffer);
 
     m_allocator->UnLock(m_streamIn);
-    return MOS_STATUS_SUCCESS;
+    return status;
 }
 
 MOS_STATUS HevcVdencRoi::ExecuteRoi(
@@ -30,6 +30,7 @@
 #include "media_feature.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
 #include "encode_hevc_vdenc_roi_strategy.h"
+#include "encode_hevc_vdenc_roi_streamin_cache.h"
 #include "encode_hevc_brc.h"
 #include "mhw_vdbox_vdenc_itf.h"
 #include "mhw_vdbox_huc_itf.h"
@@ -205,7 +206,7 @@ protected:
     }
 
     //!
-    //! \brief    ClearStreaminBuffer
+    //! \brief    Start the stream-in data of the frame on the CPU
     //! \return   MOS_STATUS
     //!           MOS_STATUS_SUCCESS if success, else fail reason
     //!
@@ -244,8 +245,9 @@ protected:
     bool m_isArbRoiSupported = true;     //!< Whether is Adaptive Region Boost ROI Supported
 
     PMOS_RESOURCE      m_streamIn = nullptr; //!< Stream in buffer
-    uint8_t *          m_streamInTemp = nullptr;
+    uint8_t *          m_streamInTemp = nullptr;   //!< stream-in data of the frame in progress
     uint32_t           m_streamInSize = 0;
+    RoiStreamInCache   m_streamInCache;      //!< stream-in data of the last frame and what the buffers hold
     RoiStrategyFactory m_strategyFactory;    //!< Factory of strategy
     RoiOverlap         m_roiOverlap;         //!< ROI and dirty ROI overlap
 
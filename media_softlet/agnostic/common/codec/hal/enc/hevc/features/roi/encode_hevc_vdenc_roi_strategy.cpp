@@ -64,6 +64,8 @@ MOS_STATUS RoiStrategy::PrepareParams(
     m_roiDistinctDeltaQp = hevcPicParams->ROIDistinctDeltaQp;
     ENCODE_CHK_NULL_RETURN(m_roiDistinctDeltaQp);
 
+    m_streaminParamsByTU.Reset();
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -263,13 +265,21 @@ void RoiStrategy::SetStreaminParamByTU(
 {
     MOS_ZeroMemory(&streaminDataParams, sizeof(streaminDataParams));
 
-    auto settings = static_cast<HevcVdencFeatureSettings *>(m_featureManager->GetFeatureSettings()->GetConstSettings());
-    ENCODE_CHK_NULL_NO_STATUS_RETURN(settings);
+    // The settings only depend on the frame parameters, so they are evaluated
+    // once per frame instead of once per LCU
+    m_streaminParamsByTU.Get(
+        cu64Align,
+        streaminDataParams,
+        [this](StreamInParams &params, bool cu64Align) -> MOS_STATUS {
+            auto settings = static_cast<HevcVdencFeatureSettings *>(m_featureManager->GetFeatureSettings()->GetConstSettings());
+            ENCODE_CHK_NULL_RETURN(settings);
 
-    for (const auto &lambda : settings->vdencStreaminStateSettings)
-    {
-        lambda(streaminDataParams, cu64Align);
-    }
+            for (const auto &lambda : settings->vdencStreaminStateSettings)
+            {
+                lambda(params, cu64Align);
+            }
+            return MOS_STATUS_SUCCESS;
+        });
 }
 
 void RoiStrategy::GetLCUsInRoiRegionForTile(
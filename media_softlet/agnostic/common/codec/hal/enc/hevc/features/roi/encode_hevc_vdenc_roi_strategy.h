@@ -31,6 +31,7 @@
 #include "encode_hevc_basic_feature.h"
 #include "encode_hevc_brc.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
+#include "encode_hevc_vdenc_roi_streamin_params_cache.h"
 #include "encode_hevc_vdenc_const_settings.h"
 #include "mhw_vdbox_huc_itf.h"
 
@@ -506,6 +507,8 @@ protected:
     bool     m_isTileModeEnabled  = false;
     uint32_t m_minCodingBlockSize = 0;
 
+    RoiStreamInParamsCache<StreamInParams> m_streaminParamsByTU;  //!< streamin parameters of the frame, by CU 64 alignment
+
     EncodeAllocator *m_allocator    = nullptr;
     RecycleResource *m_recycle      = nullptr;
     HevcBasicFeature *m_basicFeature = nullptr;
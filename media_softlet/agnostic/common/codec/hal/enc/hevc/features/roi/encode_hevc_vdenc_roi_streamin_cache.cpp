@@ -0,0 +1,146 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_streamin_cache.cpp
+//! \brief    Implements the CPU copy of the ROI stream-in data
+//!
+
+#include "encode_hevc_vdenc_roi_streamin_cache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace encode
+{
+MOS_STATUS RoiStreamInCache::Init(uint32_t size, uint32_t spanSize)
+{
+    if (size == 0 || spanSize == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    if (size == m_data.size() && spanSize == m_spanSize)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    m_spanSize = spanSize;
+    m_data.assign(size, 0);
+    m_next.assign(size, 0);
+    m_spanVersions.assign((size + spanSize - 1) / spanSize, 0);
+    m_bufferVersions.clear();
+    m_version      = 0;
+    m_writtenBytes = 0;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+uint8_t *RoiStreamInCache::BeginFrame()
+{
+    if (m_next.empty())
+    {
+        return nullptr;
+    }
+
+    std::fill(m_next.begin(), m_next.end(), 0);
+    return m_next.data();
+}
+
+bool RoiStreamInCache::EndFrame()
+{
+    uint32_t size    = (uint32_t)m_data.size();
+    uint32_t version = m_version + 1;
+    bool     changed = false;
+
+    for (uint32_t span = 0; span < m_spanVersions.size(); span++)
+    {
+        uint32_t offset = span * m_spanSize;
+        uint32_t bytes  = std::min(m_spanSize, size - offset);
+
+        // Nothing was written before the first frame, so all of it counts as changed
+        if (m_version == 0 || memcmp(&m_data[offset], &m_next[offset], bytes) != 0)
+        {
+            m_spanVersions[span] = version;
+            changed              = true;
+        }
+    }
+
+    if (changed)
+    {
+        m_data.swap(m_next);
+        m_version = version;
+    }
+
+    return changed;
+}
+
+bool RoiStreamInCache::IsUpToDate(const void *buffer) const
+{
+    auto it = m_bufferVersions.find(buffer);
+    return m_version != 0 && it != m_bufferVersions.end() && it->second == m_version;
+}
+
+MOS_STATUS RoiStreamInCache::Write(const void *buffer, uint8_t *data)
+{
+    if (buffer == nullptr || data == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+
+    m_writtenBytes = 0;
+    if (m_version == 0)
+    {
+        return MOS_STATUS_UNINITIALIZED;
+    }
+
+    // A buffer never written gets all of the data
+    auto     it            = m_bufferVersions.find(buffer);
+    uint32_t bufferVersion = (it == m_bufferVersions.end()) ? 0 : it->second;
+    uint32_t size          = (uint32_t)m_data.size();
+    uint32_t spanCount     = (uint32_t)m_spanVersions.size();
+
+    // Copy the runs of spans changed since the buffer was written
+    uint32_t span = 0;
+    while (span < spanCount)
+    {
+        if (m_spanVersions[span] <= bufferVersion)
+        {
+            span++;
+            continue;
+        }
+
+        uint32_t first = span;
+        while (span < spanCount && m_spanVersions[span] > bufferVersion)
+        {
+            span++;
+        }
+
+        uint32_t offset = first * m_spanSize;
+        uint32_t bytes  = std::min(span * m_spanSize, size) - offset;
+        memcpy(data + offset, &m_data[offset], bytes);
+        m_writtenBytes += bytes;
+    }
+
+    m_bufferVersions[buffer] = m_version;
+    return MOS_STATUS_SUCCESS;
+}
+
+}  // namespace encode
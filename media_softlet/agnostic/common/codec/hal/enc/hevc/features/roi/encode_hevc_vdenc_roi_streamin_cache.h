@@ -0,0 +1,142 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_streamin_cache.h
+//! \brief    Defines the CPU copy of the ROI stream-in data
+//!
+
+#ifndef __ENCODE_HEVC_VDENC_ROI_STREAMIN_CACHE_H__
+#define __ENCODE_HEVC_VDENC_ROI_STREAMIN_CACHE_H__
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+namespace encode
+{
+
+//!
+//! \class    RoiStreamInCache
+//!
+//! \brief    Keeps the stream-in data of the last frame on the CPU and tracks
+//!           which of it every stream-in buffer already holds.
+//!
+//! \detail   The data is split in spans, e.g. one CTU row each. Every span
+//!           remembers the version of the data it last changed in, and every
+//!           stream-in buffer the version it was last written with, so a
+//!           buffer only gets the spans changed since then and no write at
+//!           all when the data did not change.
+//!
+class RoiStreamInCache
+{
+public:
+    RoiStreamInCache() = default;
+
+    ~RoiStreamInCache() = default;
+
+    //!
+    //! \brief  Set the size of the stream-in data, drops the cached data
+    //!         and the state of all the buffers if it changes
+    //!
+    //! \param  [in] size
+    //!         Size of the stream-in data in bytes
+    //! \param  [in] spanSize
+    //!         Size of a span in bytes
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Init(uint32_t size, uint32_t spanSize);
+
+    //!
+    //! \brief  Start the stream-in data of a new frame
+    //!
+    //! \return uint8_t *
+    //!         Zeroed data to write the new frame to, nullptr if not initialized
+    //!
+    uint8_t *BeginFrame();
+
+    //!
+    //! \brief  Finish the stream-in data of the new frame and compare it with
+    //!         the data of the last frame
+    //!
+    //! \return bool
+    //!         true if the data changed, otherwise false
+    //!
+    bool EndFrame();
+
+    //!
+    //! \brief  Check whether the stream-in buffer holds the data of the last frame
+    //!
+    //! \param  [in] buffer
+    //!         Stream-in buffer
+    //! \return bool
+    //!         true if nothing has to be written to the buffer, otherwise false
+    //!
+    bool IsUpToDate(const void *buffer) const;
+
+    //!
+    //! \brief  Bring the stream-in buffer up to the data of the last frame
+    //!
+    //! \param  [in] buffer
+    //!         Stream-in buffer
+    //! \param  [out] data
+    //!         Locked data of the stream-in buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Write(const void *buffer, uint8_t *data);
+
+    //!
+    //! \brief  Forget what the stream-in buffer holds, e.g. when it is written
+    //!         by someone else
+    //!
+    //! \param  [in] buffer
+    //!         Stream-in buffer
+    //!
+    void Invalidate(const void *buffer) { m_bufferVersions.erase(buffer); }
+
+    //!
+    //! \brief  Get the stream-in data of the last frame
+    //!
+    const uint8_t *GetData() const { return m_data.empty() ? nullptr : m_data.data(); }
+
+    //!
+    //! \brief  Get the bytes copied by the last write
+    //!
+    uint32_t GetWrittenBytes() const { return m_writtenBytes; }
+
+protected:
+    std::vector<uint8_t>            m_data;              //!< stream-in data of the last frame
+    std::vector<uint8_t>            m_next;              //!< stream-in data of the frame in progress
+    std::vector<uint32_t>           m_spanVersions;      //!< version each span last changed in
+    std::map<const void *, uint32_t> m_bufferVersions;   //!< version each stream-in buffer holds
+    uint32_t                        m_spanSize     = 0;  //!< size of a span in bytes
+    uint32_t                        m_version      = 0;  //!< version of the data of the last frame, 0 before the first frame
+    uint32_t                        m_writtenBytes = 0;  //!< bytes copied by the last write
+
+MEDIA_CLASS_DEFINE_END(encode__RoiStreamInCache)
+};
+
+}  // namespace encode
+#endif  // __ENCODE_HEVC_VDENC_ROI_STREAMIN_CACHE_H__
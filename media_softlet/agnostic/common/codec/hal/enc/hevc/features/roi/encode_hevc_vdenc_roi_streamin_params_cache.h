@@ -0,0 +1,98 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_streamin_params_cache.h
+//! \brief    Defines the per frame cache of the stream-in parameters set by TU
+//!
+
+#ifndef __ENCODE_HEVC_VDENC_ROI_STREAMIN_PARAMS_CACHE_H__
+#define __ENCODE_HEVC_VDENC_ROI_STREAMIN_PARAMS_CACHE_H__
+
+#include <stdint.h>
+#include "mos_defs.h"
+
+namespace encode
+{
+
+//!
+//! \class    RoiStreamInParamsCache
+//!
+//! \brief    Keeps the stream-in parameters set by TU for the current frame.
+//!
+//! \detail   The parameters only depend on the frame and on whether the CU is
+//!           64 aligned, so they are evaluated once per frame and alignment
+//!           instead of once per LCU.
+//!
+template <class Params>
+class RoiStreamInParamsCache
+{
+public:
+    //!
+    //! \brief  Drop the parameters of the last frame
+    //!
+    void Reset()
+    {
+        m_valid[0] = false;
+        m_valid[1] = false;
+    }
+
+    //!
+    //! \brief  Get the parameters of the frame, evaluates them on the first call
+    //!
+    //! \param  [in] cu64Align
+    //!         Whether CU is 64 aligned
+    //! \param  [in, out] params
+    //!         Zeroed parameters, set to the parameters of the frame
+    //! \param  [in] evaluate
+    //!         Callable setting the parameters, evaluate(params, cu64Align)
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason, the parameters
+    //!         are not cached if the evaluation fails
+    //!
+    template <class Evaluate>
+    MOS_STATUS Get(bool cu64Align, Params &params, Evaluate evaluate)
+    {
+        uint32_t idx = cu64Align ? 1 : 0;
+        if (m_valid[idx])
+        {
+            params = m_params[idx];
+            return MOS_STATUS_SUCCESS;
+        }
+
+        MOS_STATUS status = evaluate(params, cu64Align);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        m_params[idx] = params;
+        m_valid[idx]  = true;
+        return MOS_STATUS_SUCCESS;
+    }
+
+protected:
+    Params m_params[2] = {};              //!< parameters of the frame, by CU 64 alignment
+    bool   m_valid[2]  = {false, false};  //!< whether the parameters are set for the frame
+};
+
+}  // namespace encode
+#endif  // __ENCODE_HEVC_VDENC_ROI_STREAMIN_PARAMS_CACHE_H__
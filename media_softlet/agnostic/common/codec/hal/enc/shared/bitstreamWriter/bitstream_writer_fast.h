@@ -0,0 +1,177 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     bitstream_writer_fast.h
+//! \brief    Defines the accumulating bitstream writer used by the header packers
+//!
+
+#ifndef __BITSTREAM_WRITER_FAST_H__
+#define __BITSTREAM_WRITER_FAST_H__
+
+#include "bitstream_writer.h"
+#include <stdint.h>
+#include <assert.h>
+
+//!
+//! \class  BitstreamWriterFast
+//!
+//! \brief  Writes the same bits as BitstreamWriter, without virtual calls.
+//!
+//! \detail Bits are gathered in a 64 bit accumulator and stored 32 bits at a
+//!         time, an Exp-Golomb code of up to 32 bits is a single PutBits. The
+//!         bits still in the accumulator only reach the buffer on Flush, which
+//!         has to be called before the buffer is read. Meant to be the template
+//!         argument of the packers, it has no CABAC.
+//!
+class BitstreamWriterFast
+{
+public:
+    BitstreamWriterFast(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset = 0)
+    {
+        Reset(bs, size, bitOffset);
+    }
+
+    void PutBits(mfxU32 n, mfxU32 b)
+    {
+        assert(n <= sizeof(b) * 8);
+        m_acc = (m_acc << n) | (b & ((uint64_t(1) << n) - 1));
+        m_accBits += n;
+
+        if (m_accBits >= 32)
+        {
+            m_accBits -= 32;
+            Store32(mfxU32(m_acc >> m_accBits));
+        }
+    }
+
+    void PutBit(mfxU32 b) { PutBits(1, b & 1); }
+
+    void PutGolomb(mfxU32 b)
+    {
+        // n - 1 zeros, then the n bits of b + 1: the leading zeros come with the code
+        b++;
+        assert(b != 0);
+        mfxU32 n = BitLength(b);
+
+        if (n <= 16)
+        {
+            PutBits(2 * n - 1, b);
+        }
+        else
+        {
+            PutBits(n - 1, 0);
+            PutBits(n, b);
+        }
+    }
+
+    void PutUE(mfxU32 b) { PutGolomb(b); }
+    void PutSE(mfxI32 b) { (b > 0) ? PutGolomb((b << 1) - 1) : PutGolomb((-b) << 1); }
+
+    void PutTrailingBits(bool bCheckAligned = false)
+    {
+        if ((!bCheckAligned) || (m_accBits & 7))
+            PutBit(1);
+
+        PutBits((8 - (m_accBits & 7)) & 7, 0);
+    }
+
+    //!
+    //! \brief  Store the bits still in the accumulator, the last byte padded with zeros
+    //!
+    void Flush()
+    {
+        mfxU32   bytes = (m_accBits + 7) >> 3;
+        uint64_t bits  = m_acc << (bytes * 8 - m_accBits);
+
+        for (mfxU32 i = 0; i < bytes; i++)
+        {
+            m_bs[i] = (mfxU8)(bits >> ((bytes - 1 - i) * 8));
+        }
+    }
+
+    mfxU32 GetOffset()
+    {
+        return mfxU32(m_bs - m_bsStart) * 8 + m_accBits - m_bitStart;
+    }
+    mfxU8 *GetStart() { return m_bsStart; }
+    mfxU8 *GetEnd() { return m_bsEnd; }
+
+    //!
+    //! \brief  Restart writing, the bits of the first byte before the bit offset are kept
+    //!
+    void Reset(mfxU8 *bs = 0, mfxU32 size = 0, mfxU8 bitOffset = 0)
+    {
+        if (bs)
+        {
+            m_bsStart  = bs;
+            m_bsEnd    = bs + size;
+            m_bitStart = (bitOffset & 7);
+        }
+
+        m_bs      = m_bsStart;
+        m_accBits = m_bitStart;
+        m_acc     = m_bitStart ? (*m_bs >> (8 - m_bitStart)) : 0;
+    }
+
+    void AddInfo(mfxU32 key, mfxU32 value)
+    {
+        if (m_pInfo)
+            m_pInfo[0][key] = value;
+    }
+    void SetInfo(std::map<mfxU32, mfxU32> *pInfo)
+    {
+        m_pInfo = pInfo;
+    }
+
+private:
+    void Store32(mfxU32 b)
+    {
+        m_bs[0] = (mfxU8)(b >> 24);
+        m_bs[1] = (mfxU8)(b >> 16);
+        m_bs[2] = (mfxU8)(b >> 8);
+        m_bs[3] = (mfxU8)b;
+        m_bs += 4;
+    }
+
+    static mfxU32 BitLength(mfxU32 b)
+    {
+        mfxU32 n = 0;
+        if (b >> 16) { n += 16; b >>= 16; }
+        if (b >> 8)  { n += 8;  b >>= 8; }
+        if (b >> 4)  { n += 4;  b >>= 4; }
+        if (b >> 2)  { n += 2;  b >>= 2; }
+        if (b >> 1)  { n += 1;  b >>= 1; }
+        return n + b;
+    }
+
+    mfxU8                    *m_bsStart  = nullptr;
+    mfxU8                    *m_bsEnd    = nullptr;
+    mfxU8                    *m_bs       = nullptr;  //!< where the accumulator is stored next
+    mfxU8                     m_bitStart = 0;
+    uint64_t                  m_acc      = 0;        //!< bits not stored yet, in the low m_accBits bits
+    mfxU32                    m_accBits  = 0;
+    std::map<mfxU32, mfxU32> *m_pInfo    = nullptr;
+
+MEDIA_CLASS_DEFINE_END(BitstreamWriterFast)
+};
+
+#endif
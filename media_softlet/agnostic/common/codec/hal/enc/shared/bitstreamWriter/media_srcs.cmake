@@ -27,6 +27,7 @@ set(TMP_SOURCES_
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/bitstream_writer.h
+    ${CMAKE_CURRENT_LIST_DIR}/bitstream_writer_fast.h
 )
 endif()
 
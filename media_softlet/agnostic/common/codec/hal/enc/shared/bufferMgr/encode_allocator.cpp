@@ -48,7 +48,8 @@ EncodeAllocator::~EncodeAllocator()
 MOS_RESOURCE* EncodeAllocator::AllocateResource(
     MOS_ALLOC_GFXRES_PARAMS &param,
     bool zeroOnAllocate,
-    MOS_HW_RESOURCE_DEF resUsageType)
+    MOS_HW_RESOURCE_DEF resUsageType,
+    bool recyclable)
 {
     if (!m_allocator)
         return nullptr;
@@ -58,7 +59,7 @@ MOS_RESOURCE* EncodeAllocator::AllocateResource(
         param.ResUsageType = resUsageType;
     }
 
-    return m_allocator->AllocateResource(param, zeroOnAllocate, COMPONENT_Encode);
+    return m_allocator->AllocateResource(param, zeroOnAllocate, COMPONENT_Encode, recyclable);
 }
 
 MOS_SURFACE* EncodeAllocator::AllocateSurface(
@@ -63,13 +63,17 @@ public:
     //!         zero the memory if true
     //! \param  [in] resUsageType
     //!         resource usage for cache policy
+    //! \param  [in] recyclable
+    //!         share the resource with later sessions through the recycle pool of the device,
+    //!         only lockable linear buffers are shared, they are cleared when reused
     //! \return MOS_RESOURCE*
     //!         return the pointer to MOS_RESOURCE
     //!
     MOS_RESOURCE* AllocateResource(
         MOS_ALLOC_GFXRES_PARAMS &param,
         bool zeroOnAllocate,
-        MOS_HW_RESOURCE_DEF resUsageType = MOS_HW_RESOURCE_DEF_MAX);
+        MOS_HW_RESOURCE_DEF resUsageType = MOS_HW_RESOURCE_DEF_MAX,
+        bool recyclable = false);
 
     //!
     //! \brief  Allocate Surface
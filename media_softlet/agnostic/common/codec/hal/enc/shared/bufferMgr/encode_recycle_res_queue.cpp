@@ -73,7 +73,7 @@ void *RecycleQueue::GetResource(uint32_t frameIndex, ResourceType type)
         }
         else if (m_type == ResourceType::BUFFER)
         {
-            resource = m_allocator->AllocateResource(m_param, true);
+            resource = m_allocator->AllocateResource(m_param, true, MOS_HW_RESOURCE_DEF_MAX, true);
         }
         else
         {
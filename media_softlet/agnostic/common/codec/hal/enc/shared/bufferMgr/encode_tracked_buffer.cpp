@@ -63,6 +63,25 @@ TrackedBuffer::~TrackedBuffer()
 
 MOS_STATUS TrackedBuffer::RegisterParam(BufferType type, MOS_ALLOC_GFXRES_PARAMS param)
 {
+    if (m_maxSizeMode)
+    {
+        // the queue allocated for a size the new one doesn't fit in is retired,
+        // new buffers are allocated on demand
+        MaxSizeParam &maxSize = m_maxSizeParams[type];
+        if (maxSize.Register(param))
+        {
+            m_allocParams[type] = maxSize.GetAllocParam();
+            RetireBufferQueue(type);
+        }
+
+        auto queue = m_bufferQueue.find(type);
+        if (queue != m_bufferQueue.end())
+        {
+            queue->second->SetView(maxSize.GetViewParam());
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
     auto iter = m_allocParams.find(type);
     if (iter == m_allocParams.end())
     {
@@ -219,6 +238,12 @@ MOS_STATUS TrackedBuffer::Release(CODEC_REF_LIST* refList)
 
 MOS_STATUS TrackedBuffer::OnSizeChange()
 {
+    // in max size mode the queues are kept, RegisterParam retires the ones outgrown
+    if (m_maxSizeMode)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
     for (auto iter = m_bufferQueue.begin(); iter != m_bufferQueue.end();)
     {
         if (iter->second->SafeToDestory())
@@ -279,6 +304,12 @@ std::shared_ptr<BufferQueue> TrackedBuffer::GetBufferQueue(BufferType type)
 
         auto alloc = std::make_shared<BufferQueue>(m_allocator, param->second, m_maxSlotCnt);
         alloc->SetResourceType(resType);
+
+        auto maxSize = m_maxSizeParams.find(type);
+        if (maxSize != m_maxSizeParams.end())
+        {
+            alloc->SetView(maxSize->second.GetViewParam());
+        }
         m_bufferQueue.insert(std::make_pair(type, alloc));
         return alloc;
     }
@@ -288,4 +319,19 @@ std::shared_ptr<BufferQueue> TrackedBuffer::GetBufferQueue(BufferType type)
     }
 }
 
+void TrackedBuffer::RetireBufferQueue(BufferType type)
+{
+    auto iter = m_bufferQueue.find(type);
+    if (iter == m_bufferQueue.end())
+    {
+        return;
+    }
+
+    if (!iter->second->SafeToDestory())
+    {
+        m_oldQueue.insert(std::make_pair(type, iter->second));
+    }
+    m_bufferQueue.erase(iter);
+}
+
 }
\ No newline at end of file
@@ -29,6 +29,7 @@
 #define __ENCODE_BUFFER_TRACKER_H__
 
 #include "codec_def_common.h"
+#include "encode_tracked_buffer_max_size.h"
 #include "encode_tracked_buffer_queue.h"
 #include "encode_utils.h"
 #include "media_class_trace.h"
@@ -114,6 +115,22 @@ public:
     //!
     MOS_STATUS RegisterParam(BufferType type, MOS_ALLOC_GFXRES_PARAMS param);
 
+    //!
+    //! \brief  Keep the buffers allocated for the largest size registered so far
+    //!         and reinterpret them for smaller sizes, instead of reallocating
+    //!         the buffer queues on every resolution change
+    //! \param  [in] enable
+    //!         true to enable the max size mode
+    //!
+    void SetMaxSizeMode(bool enable) { m_maxSizeMode = enable; }
+
+    //!
+    //! \brief  Check whether the max size mode is enabled
+    //! \return bool
+    //!         true if buffers are allocated for the max size
+    //!
+    bool IsMaxSizeMode() { return m_maxSizeMode; }
+
     //!
     //! \brief  Acquire buffer before encoding start for each frame
     //! \param  [in] refList
@@ -208,6 +225,14 @@ protected:
     //!         shared_ptr<BufferQueue> if success, else nullptr
     std::shared_ptr<BufferQueue> GetBufferQueue(BufferType type);
 
+    //!
+    //! \brief  Retire the buffer queue of the buffer type, it's destroyed once
+    //!         all of its buffers are returned
+    //! \param  [in]type
+    //!         BufferType
+    //!
+    void RetireBufferQueue(BufferType type);
+
     static constexpr MapBufferResourceType m_mapBufferResourceType[] =
     {
         {BufferType::mbCodedBuffer,             ResourceType::bufferResource},
@@ -237,15 +262,17 @@ protected:
     uint8_t m_maxRefSlotCnt     = 0;     //!< max reference slot count in the tracked buffer
     uint8_t m_maxNonRefSlotCnt  = 0;     //!< max non-reference slot count int he tracked buffer
     uint8_t m_currSlotIndex     = 0;     //!< current free slot index
+    bool    m_maxSizeMode       = false; //!< allocate for the max size and reinterpret for the current one
 
     PMOS_MUTEX                m_mutex;                //!< mutex
     Condition                 m_condition;            //!< condition
     EncodeAllocator *         m_allocator = nullptr;  //!< encoder allocator
     std::vector<BufferSlot *> m_bufferSlots = {};          //!< buffer slots
 
-    std::map<BufferType, MOS_ALLOC_GFXRES_PARAMS>       m_allocParams = {};  //!< allocate parameters
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_bufferQueue = {};  //!< buffer queues
-    std::map<BufferType, std::shared_ptr<BufferQueue> > m_oldQueue = {};     //!< old queues for resolution change
+    std::map<BufferType, MOS_ALLOC_GFXRES_PARAMS>            m_allocParams = {};  //!< allocate parameters
+    std::map<BufferType, MaxSizeParam>                       m_maxSizeParams = {};  //!< max and current size parameters in max size mode
+    std::map<BufferType, std::shared_ptr<BufferQueue> >      m_bufferQueue = {};  //!< buffer queues
+    std::multimap<BufferType, std::shared_ptr<BufferQueue> > m_oldQueue    = {};  //!< old queues for resolution change
 
 MEDIA_CLASS_DEFINE_END(encode__TrackedBuffer)
 };
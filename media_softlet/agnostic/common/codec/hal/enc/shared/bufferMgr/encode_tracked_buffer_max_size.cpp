@@ -0,0 +1,79 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_tracked_buffer_max_size.cpp
+//! \brief    Defines the allocate parameter of tracked buffers in max size mode
+//! \details  Buffers are allocated for the largest size registered so far and
+//!           handed out as views of the current size
+//!
+#include "encode_tracked_buffer_max_size.h"
+
+namespace encode {
+
+bool MaxSizeParam::Register(const MOS_ALLOC_GFXRES_PARAMS &param)
+{
+    m_viewParam = param;
+
+    if (!m_registered)
+    {
+        m_registered = true;
+        m_allocParam = param;
+        return true;
+    }
+
+    if (Contains(m_allocParam, param))
+    {
+        return false;
+    }
+
+    // grow the allocation to cover the old and new sizes, a layout change
+    // drops the old size. dwBytes of buffers shares dwWidth.
+    MOS_ALLOC_GFXRES_PARAMS grownParam = param;
+    if (m_allocParam.Type == param.Type &&
+        m_allocParam.Format == param.Format &&
+        m_allocParam.TileType == param.TileType &&
+        m_allocParam.Flags.bNotLockable == param.Flags.bNotLockable)
+    {
+        grownParam.dwWidth  = MOS_MAX(param.dwWidth, m_allocParam.dwWidth);
+        grownParam.dwHeight = MOS_MAX(param.dwHeight, m_allocParam.dwHeight);
+    }
+    m_allocParam = grownParam;
+    return true;
+}
+
+bool MaxSizeParam::Contains(const MOS_ALLOC_GFXRES_PARAMS &allocParam, const MOS_ALLOC_GFXRES_PARAMS &viewParam)
+{
+    return allocParam.Type == viewParam.Type &&
+           allocParam.Format == viewParam.Format &&
+           allocParam.TileType == viewParam.TileType &&
+           allocParam.Flags.bNotLockable == viewParam.Flags.bNotLockable &&
+           allocParam.dwWidth >= viewParam.dwWidth &&
+           allocParam.dwHeight >= viewParam.dwHeight;
+}
+
+void MaxSizeParam::ApplyView(MOS_SURFACE &surface, uint32_t width, uint32_t height)
+{
+    surface.dwWidth  = width;
+    surface.dwHeight = height;
+}
+
+}  // namespace encode
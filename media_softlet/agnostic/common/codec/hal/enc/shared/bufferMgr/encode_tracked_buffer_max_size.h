@@ -0,0 +1,95 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_tracked_buffer_max_size.h
+//! \brief    Defines the allocate parameter of tracked buffers in max size mode
+//! \details  Buffers are allocated for the largest size registered so far and
+//!           handed out as views of the current size
+//!
+#ifndef __ENCODE_TRACKED_BUFFER_MAX_SIZE_H__
+#define __ENCODE_TRACKED_BUFFER_MAX_SIZE_H__
+
+#include "media_class_trace.h"
+#include "mos_os.h"
+
+namespace encode {
+
+class MaxSizeParam
+{
+public:
+    //!
+    //! \brief  Register the parameter of the current size
+    //! \param  [in] param
+    //!         reference to MOS_ALLOC_GFXRES_PARAMS of the current size
+    //! \return bool
+    //!         true if the allocate parameter changed, buffers allocated with
+    //!         the previous one can't be handed out any more
+    //!
+    bool Register(const MOS_ALLOC_GFXRES_PARAMS &param);
+
+    //!
+    //! \brief  Get the parameter buffers are allocated with
+    //! \return MOS_ALLOC_GFXRES_PARAMS &
+    //!
+    const MOS_ALLOC_GFXRES_PARAMS &GetAllocParam() const { return m_allocParam; }
+
+    //!
+    //! \brief  Get the parameter of the current size
+    //! \return MOS_ALLOC_GFXRES_PARAMS &
+    //!
+    const MOS_ALLOC_GFXRES_PARAMS &GetViewParam() const { return m_viewParam; }
+
+    //!
+    //! \brief  Check whether resources allocated with one parameter can be
+    //!         reinterpreted as resources of another
+    //! \param  [in] allocParam
+    //!         parameter the resources are allocated with
+    //! \param  [in] viewParam
+    //!         parameter of the resources required
+    //! \return bool
+    //!         true if the allocation has the same layout and is large enough
+    //!
+    static bool Contains(const MOS_ALLOC_GFXRES_PARAMS &allocParam, const MOS_ALLOC_GFXRES_PARAMS &viewParam);
+
+    //!
+    //! \brief  Reinterpret a surface for a size, pitch and plane offsets keep
+    //!         the allocated layout
+    //! \param  [in, out] surface
+    //!         surface allocated for a size covering the view
+    //! \param  [in] width
+    //!         width of the view
+    //! \param  [in] height
+    //!         height of the view
+    //!
+    static void ApplyView(MOS_SURFACE &surface, uint32_t width, uint32_t height);
+
+protected:
+    bool                    m_registered = false;  //!< whether a parameter was registered
+    MOS_ALLOC_GFXRES_PARAMS m_allocParam = {};     //!< parameter buffers are allocated with
+    MOS_ALLOC_GFXRES_PARAMS m_viewParam  = {};     //!< parameter of the current size
+
+MEDIA_CLASS_DEFINE_END(encode__MaxSizeParam)
+};
+
+}  // namespace encode
+
+#endif  // !__ENCODE_TRACKED_BUFFER_MAX_SIZE_H__
@@ -27,6 +27,7 @@
 #include "encode_tracked_buffer_queue.h"
 #include <algorithm>
 #include "encode_allocator.h"
+#include "encode_tracked_buffer_max_size.h"
 #include "encode_utils.h"
 #include "mos_os_hw.h"
 #include "mos_os_specific.h"
@@ -56,6 +57,7 @@ void *BufferQueue::AcquireResource()
 {
     AutoLock lock(m_mutex);
 
+    void *resource = nullptr;
     if (m_resourcePool.empty())
     {
         if (m_allocCount > m_maxCount)
@@ -64,20 +66,38 @@ void *BufferQueue::AcquireResource()
             return nullptr;
         }
         
-        void *resource = AllocateResource();
+        resource = AllocateResource();
         if (resource != nullptr)
         {
             m_allocCount++;
             m_resources.push_back(resource);
         }
-        return resource;
     }
     else
     {
-        void *resource = m_resourcePool.back();
+        resource = m_resourcePool.back();
         m_resourcePool.pop_back();
-        return resource;
     }
+
+    // reinterpret the surface for the current size
+    if (resource != nullptr && m_resourceType == ResourceType::surfaceResource && m_viewWidth && m_viewHeight)
+    {
+        MaxSizeParam::ApplyView(*(MOS_SURFACE *)resource, m_viewWidth, m_viewHeight);
+    }
+    return resource;
+}
+
+void BufferQueue::SetView(const MOS_ALLOC_GFXRES_PARAMS &param)
+{
+    AutoLock lock(m_mutex);
+
+    if (!MaxSizeParam::Contains(m_allocParam, param))
+    {
+        ENCODE_ASSERTMESSAGE("View exceeds the allocated resources");
+        return;
+    }
+    m_viewWidth  = param.dwWidth;
+    m_viewHeight = param.dwHeight;
 }
 
 MOS_STATUS BufferQueue::ReleaseResource(void *resource)
@@ -124,7 +144,7 @@ void *BufferQueue::AllocateResource()
         }
         else if (m_resourceType == ResourceType::bufferResource)
         {
-            return m_allocator->AllocateResource(m_allocParam, true);
+            return m_allocator->AllocateResource(m_allocParam, true, MOS_HW_RESOURCE_DEF_MAX, true);
         }
         else
         {
@@ -89,6 +89,14 @@ public:
 
     void SetResourceType(ResourceType resType) { m_resourceType = resType; }
 
+    //!
+    //! \brief  Set the size surfaces are reinterpreted as when acquired,
+    //!         it must not exceed the allocate parameter
+    //! \param  [in] param
+    //!         reference to MOS_ALLOC_GFXRES_PARAMS of the current size
+    //!
+    void SetView(const MOS_ALLOC_GFXRES_PARAMS &param);
+
 protected:
     //!
     //! \brief  Allocate resource
@@ -113,6 +121,8 @@ protected:
 
     EncodeAllocator *          m_allocator    = nullptr;    //!< encoder allocator
     MOS_ALLOC_GFXRES_PARAMS    m_allocParam   = {};         //!< allocate parameter
+    uint32_t                   m_viewWidth    = 0;          //!< width surfaces are acquired with, 0 for the allocated one
+    uint32_t                   m_viewHeight   = 0;          //!< height surfaces are acquired with, 0 for the allocated one
     std::vector<void *>        m_resourcePool = {};         //!< resource pool
     std::vector<void *>        m_resources    = {};         //!< all allocated resources
 
@@ -25,6 +25,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/encode_recycle_resource.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_queue.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_max_size.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_slot.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_allocator.cpp
 )
@@ -35,6 +36,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/encode_recycle_resource.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_queue.h
+    ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_max_size.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_tracked_buffer_slot.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_allocator.h
 )
@@ -73,6 +73,22 @@ MOS_STATUS EncodeBasicFeature::Init(void *setting)
     m_picHeightInMb   = (uint16_t)CODECHAL_GET_HEIGHT_IN_MACROBLOCKS(m_oriFrameHeight);
     m_frameWidth      = m_picWidthInMb * CODECHAL_MACROBLOCK_WIDTH;
     m_frameHeight     = m_picHeightInMb * CODECHAL_MACROBLOCK_HEIGHT;
+    m_maxFrameWidth   = m_frameWidth;
+    m_maxFrameHeight  = m_frameHeight;
+
+    // The context size is the max size of the stream. When asked for, tracked buffers are
+    // allocated for it once and reinterpreted for the frame size on dynamic resolution
+    // changes, trading the memory of the max size for no reallocation
+    MediaUserSetting::Value outValue;
+    ReadUserSetting(
+        m_userSettingPtr,
+        outValue,
+        "Encode Tracked Buffer Max Size",
+        MediaUserSetting::Group::Sequence);
+    if (m_trackedBuf && m_maxFrameWidth && m_maxFrameHeight && outValue.Get<bool>())
+    {
+        m_trackedBuf->SetMaxSizeMode(true);
+    }
 
     m_currOriginalPic.PicFlags = PICTURE_INVALID;
     m_currOriginalPic.FrameIdx = 0;
@@ -98,6 +98,8 @@ public:
     uint32_t                    m_frameFieldHeight = 0;       //!< Frame height in luma samples
     uint32_t                    m_oriFrameHeight = 0;         //!< Original frame height
     uint32_t                    m_oriFrameWidth = 0;          //!< Original frame width
+    uint32_t                    m_maxFrameWidth = 0;          //!< Max frame width of the stream, given at context creation
+    uint32_t                    m_maxFrameHeight = 0;         //!< Max frame height of the stream, given at context creation
     uint16_t                    m_picWidthInMb = 0;           //!< Picture Width in MB width count
     uint16_t                    m_picHeightInMb = 0;          //!< Picture Height in MB height count
     uint16_t                    m_frameFieldHeightInMb = 0;   //!< Frame/field Height in MB
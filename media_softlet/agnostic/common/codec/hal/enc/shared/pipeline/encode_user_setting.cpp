@@ -79,6 +79,13 @@ MOS_STATUS EncodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         int32_t(0),
         true);
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Tracked Buffer Max Size",
+        MediaUserSetting::Group::Sequence,
+        false,
+        false);
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
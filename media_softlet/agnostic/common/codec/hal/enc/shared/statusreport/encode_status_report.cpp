@@ -229,6 +229,7 @@ namespace encode {
     {
         MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
         
+        TrackSubmission();
         m_submittedCount++;
 
         uint32_t submitIndex = CounterToIndex(m_submittedCount);
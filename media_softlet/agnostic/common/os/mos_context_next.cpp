@@ -25,6 +25,7 @@
 //!
 
 #include "mos_context_specific_next.h"
+#include "media_recycle_pool.h"
 
 class OsContextNext* OsContextNext::GetOsContextObject()
 {
@@ -43,6 +44,9 @@ void OsContextNext::CleanUp()
 #endif
     MOS_Delete(m_mosMediaCopy);
 
+    // Pooled resources are freed while the device is still alive
+    MOS_Delete(m_recyclePool);
+
     if (m_gpuContextMgr != nullptr)
     {
         m_gpuContextMgr->CleanUp();
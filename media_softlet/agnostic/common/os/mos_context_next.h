@@ -33,6 +33,8 @@
 #include "mos_decompression.h"
 #include "mos_mediacopy.h"
 
+class MediaRecyclePool;
+
 class OsContextNext
 {
 protected:
@@ -143,6 +145,16 @@ public:
         return m_mosMediaCopy;
     }
 
+    //!
+    //! \brief  Get the pool recycling internal resources across the media
+    //!         sessions of the device
+    //! \return ptr to MediaRecyclePool
+    //!
+    MediaRecyclePool *GetRecyclePool()
+    {
+        return m_recyclePool;
+    }
+
     //! \brief  Get the DumpFrameNum
     //! \return The current dumped frameNum
     //!
@@ -253,6 +265,9 @@ protected:
     //! \brief the ptr to mos media copy module
     MosMediaCopy                    *m_mosMediaCopy = nullptr;
 
+    //! \brief the ptr to the pool recycling internal resources across sessions
+    MediaRecyclePool                *m_recyclePool = nullptr;
+
     //!< Indicate if this device is working in aync mode or normal mode
     bool                            m_aynchronousDevice = false;
 MEDIA_CLASS_DEFINE_END(OsContextNext)
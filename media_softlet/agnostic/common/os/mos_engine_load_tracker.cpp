@@ -0,0 +1,186 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_engine_load_tracker.cpp
+//! \brief    Implements the process wide load tracker of the GPU engines
+//!
+
+#include "mos_engine_load_tracker.h"
+#include <chrono>
+
+MosEngineLoadTracker &MosEngineLoadTracker::Instance()
+{
+    static MosEngineLoadTracker tracker;
+    return tracker;
+}
+
+void MosEngineLoadTracker::DecrementToZero(std::atomic<uint32_t> &counter, uint32_t count)
+{
+    uint32_t value = counter.load(std::memory_order_relaxed);
+    uint32_t newValue;
+    do
+    {
+        newValue = (value > count) ? value - count : 0;
+    } while (!counter.compare_exchange_weak(value, newValue, std::memory_order_relaxed));
+}
+
+void MosEngineLoadTracker::BindSession(MOS_GPU_NODE node)
+{
+    EngineLoad *engine = GetEngine(node);
+    if (engine)
+    {
+        engine->sessions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MosEngineLoadTracker::UnbindSession(MOS_GPU_NODE node)
+{
+    EngineLoad *engine = GetEngine(node);
+    if (engine)
+    {
+        DecrementToZero(engine->sessions, 1);
+    }
+}
+
+void MosEngineLoadTracker::Submitted(MOS_GPU_NODE node)
+{
+    EngineLoad *engine = GetEngine(node);
+    if (engine)
+    {
+        engine->outstanding.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MosEngineLoadTracker::Completed(MOS_GPU_NODE node, uint64_t busyNs)
+{
+    EngineLoad *engine = GetEngine(node);
+    if (engine == nullptr)
+    {
+        return;
+    }
+
+    DecrementToZero(engine->outstanding, 1);
+
+    // The first sample seeds the average, later ones move it by 1/2^m_ewmaShift
+    uint64_t average = engine->busyNs.load(std::memory_order_relaxed);
+    uint64_t newAverage;
+    do
+    {
+        if (average == 0)
+        {
+            newAverage = busyNs ? busyNs : 1;
+        }
+        else if (busyNs >= average)
+        {
+            newAverage = average + ((busyNs - average) >> m_ewmaShift);
+        }
+        else
+        {
+            newAverage = average - ((average - busyNs) >> m_ewmaShift);
+        }
+    } while (!engine->busyNs.compare_exchange_weak(average, newAverage, std::memory_order_relaxed));
+
+    engine->samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MosEngineLoadTracker::Abandoned(MOS_GPU_NODE node, uint32_t count)
+{
+    EngineLoad *engine = GetEngine(node);
+    if (engine && count)
+    {
+        DecrementToZero(engine->outstanding, count);
+    }
+}
+
+MOS_ENGINE_LOAD MosEngineLoadTracker::GetLoad(MOS_GPU_NODE node)
+{
+    MOS_ENGINE_LOAD load = {};
+    EngineLoad *engine = GetEngine(node);
+    if (engine)
+    {
+        load.sessions    = engine->sessions.load(std::memory_order_relaxed);
+        load.outstanding = engine->outstanding.load(std::memory_order_relaxed);
+        load.busyNs      = engine->busyNs.load(std::memory_order_relaxed);
+        load.samples     = engine->samples.load(std::memory_order_relaxed);
+    }
+    return load;
+}
+
+uint64_t MosEngineLoadTracker::GetCost(MOS_GPU_NODE node)
+{
+    MOS_ENGINE_LOAD load = GetLoad(node);
+    uint64_t busyNs = load.busyNs ? load.busyNs : m_defaultBusyNs;
+    return ((uint64_t)load.sessions + load.outstanding) * busyNs;
+}
+
+uint32_t MosEngineLoadTracker::GetSessionCount(const MOS_GPU_NODE *nodes, uint32_t count)
+{
+    uint32_t sessions = 0;
+    for (uint32_t i = 0; nodes && i < count; i++)
+    {
+        sessions += GetLoad(nodes[i]).sessions;
+    }
+    return sessions;
+}
+
+MOS_GPU_NODE MosEngineLoadTracker::SelectNode(const MOS_GPU_NODE *nodes, uint32_t count)
+{
+    MOS_GPU_NODE selected     = MOS_GPU_NODE_MAX;
+    uint64_t     bestCost     = 0;
+    uint32_t     bestSessions = 0;
+
+    for (uint32_t i = 0; nodes && i < count; i++)
+    {
+        if (GetEngine(nodes[i]) == nullptr)
+        {
+            continue;
+        }
+
+        uint64_t cost     = GetCost(nodes[i]);
+        uint32_t sessions = GetLoad(nodes[i]).sessions;
+        if (selected == MOS_GPU_NODE_MAX || cost < bestCost || (cost == bestCost && sessions < bestSessions))
+        {
+            selected     = nodes[i];
+            bestCost     = cost;
+            bestSessions = sessions;
+        }
+    }
+
+    return selected;
+}
+
+void MosEngineLoadTracker::Reset()
+{
+    for (auto &engine : m_engines)
+    {
+        engine.sessions.store(0, std::memory_order_relaxed);
+        engine.outstanding.store(0, std::memory_order_relaxed);
+        engine.busyNs.store(0, std::memory_order_relaxed);
+        engine.samples.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t MosEngineLoadTracker::GetTimeNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
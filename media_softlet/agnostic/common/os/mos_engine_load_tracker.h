@@ -0,0 +1,179 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_engine_load_tracker.h
+//! \brief    Defines the process wide load tracker of the GPU engines
+//! \details  Every media session of the process reports the GPU contexts it
+//!           creates, the frames it submits and the frames it sees completed,
+//!           so engine selection can prefer the least loaded engine instead of
+//!           only counting sessions
+//!
+
+#ifndef __MOS_ENGINE_LOAD_TRACKER_H__
+#define __MOS_ENGINE_LOAD_TRACKER_H__
+
+#include <stdint.h>
+#include <atomic>
+#include "mos_defs.h"
+#include "mos_os_specific.h"
+
+//!
+//! \brief    Snapshot of the load of one engine
+//!
+struct MOS_ENGINE_LOAD
+{
+    uint32_t sessions;          //!< GPU contexts created on the engine
+    uint32_t outstanding;       //!< frames submitted and not seen completed yet
+    uint64_t busyNs;            //!< moving average of the busy time of a frame in ns, 0 before the first sample
+    uint64_t samples;           //!< completed frames the average is made of
+};
+
+class MosEngineLoadTracker
+{
+public:
+    //!
+    //! \brief  Get the tracker shared by all the sessions of the process
+    //! \return MosEngineLoadTracker &
+    //!
+    static MosEngineLoadTracker &Instance();
+
+    //!
+    //! \brief  Account a GPU context created on the engine
+    //! \param  [in] node
+    //!         GPU node of the context
+    //!
+    void BindSession(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Account a GPU context destroyed on the engine
+    //! \param  [in] node
+    //!         GPU node of the context
+    //!
+    void UnbindSession(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Account a frame submitted to the engine
+    //! \param  [in] node
+    //!         GPU node the frame was submitted to
+    //!
+    void Submitted(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Account a frame the status report saw completed
+    //! \param  [in] node
+    //!         GPU node the frame was submitted to
+    //! \param  [in] busyNs
+    //!         Time the engine spent on the frame in ns
+    //!
+    void Completed(MOS_GPU_NODE node, uint64_t busyNs);
+
+    //!
+    //! \brief  Drop submitted frames which will never be seen completed,
+    //!         e.g. because their session moved to another engine
+    //! \param  [in] node
+    //!         GPU node the frames were submitted to
+    //! \param  [in] count
+    //!         Number of frames
+    //!
+    void Abandoned(MOS_GPU_NODE node, uint32_t count);
+
+    //!
+    //! \brief  Get a snapshot of the load of the engine
+    //! \param  [in] node
+    //!         GPU node of the engine
+    //! \return MOS_ENGINE_LOAD
+    //!
+    MOS_ENGINE_LOAD GetLoad(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Get the expected time in ns the engine needs for the work of its
+    //!         sessions, every session and every outstanding frame is weighted
+    //!         with the average busy time of a frame
+    //! \param  [in] node
+    //!         GPU node of the engine
+    //! \return uint64_t
+    //!
+    uint64_t GetCost(MOS_GPU_NODE node);
+
+    //!
+    //! \brief  Get the number of GPU contexts created on the engines
+    //! \param  [in] nodes
+    //!         GPU nodes of the engines
+    //! \param  [in] count
+    //!         Number of nodes
+    //! \return uint32_t
+    //!
+    uint32_t GetSessionCount(const MOS_GPU_NODE *nodes, uint32_t count);
+
+    //!
+    //! \brief  Pick the least loaded engine
+    //! \details  Engines are ordered by cost, then by sessions. Ties go to
+    //!           the first engine of the list.
+    //! \param  [in] nodes
+    //!         GPU nodes of the candidate engines
+    //! \param  [in] count
+    //!         Number of candidates
+    //! \return MOS_GPU_NODE
+    //!         MOS_GPU_NODE_MAX if there is no candidate
+    //!
+    MOS_GPU_NODE SelectNode(const MOS_GPU_NODE *nodes, uint32_t count);
+
+    //!
+    //! \brief  Forget all the load, only meant for tests
+    //!
+    void Reset();
+
+    //!
+    //! \brief  Get a monotonic timestamp in ns for the busy time of frames
+    //! \return uint64_t
+    //!
+    static uint64_t GetTimeNs();
+
+    static constexpr uint64_t m_defaultBusyNs = 1000000;  //!< busy time of a frame assumed before the first sample, 1 ms
+    static constexpr uint32_t m_ewmaShift     = 3;        //!< every sample moves the average by 1/8 of its distance
+
+protected:
+    MosEngineLoadTracker() {}
+
+    struct EngineLoad
+    {
+        std::atomic<uint32_t> sessions{0};
+        std::atomic<uint32_t> outstanding{0};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> samples{0};
+    };
+
+    EngineLoad *GetEngine(MOS_GPU_NODE node)
+    {
+        return ((uint32_t)node < MOS_GPU_NODE_MAX) ? &m_engines[node] : nullptr;
+    }
+
+    static void DecrementToZero(std::atomic<uint32_t> &counter, uint32_t count);
+
+    EngineLoad m_engines[MOS_GPU_NODE_MAX];  //!< load by GPU node
+
+private:
+    MosEngineLoadTracker(const MosEngineLoadTracker &) = delete;
+    MosEngineLoadTracker &operator=(const MosEngineLoadTracker &) = delete;
+};
+
+#endif  // __MOS_ENGINE_LOAD_TRACKER_H__
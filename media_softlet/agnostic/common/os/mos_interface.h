@@ -1985,6 +1985,16 @@ public:
     //!
     static bool MosResourceIsNull(PMOS_RESOURCE   resource);
 
+    //!
+    //! \brief    Check if OS resource is busy
+    //! \details  Check if GPU work referencing the OS resource is still pending
+    //! \param    PMOS_RESOURCE pOsResource
+    //!           [in] Pointer to OS Resource
+    //! \return   bool
+    //!           Return true if busy, otherwise false
+    //!
+    static bool MosResourceIsBusy(PMOS_RESOURCE   resource);
+
     //!
     //! \brief    OS reset resource
     //! \details  Resets the OS resource
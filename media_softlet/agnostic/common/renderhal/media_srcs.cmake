@@ -20,11 +20,13 @@
 
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/renderhal.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/renderhal_kernel_index.cpp
     ${CMAKE_CURRENT_LIST_DIR}/renderhal_platform_interface_next.cpp
 )
 
 set(TMP_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/renderhal_platform_interface_next.h
+    ${CMAKE_CURRENT_LIST_DIR}/renderhal_kernel_index.h
     ${CMAKE_CURRENT_LIST_DIR}/hal_oca_interface_next.h
 
 )
@@ -31,6 +31,7 @@
 #include "media_interfaces_renderhal.h"
 #include "media_interfaces_mhw_next.h"
 #include "hal_oca_interface_next.h"
+#include "renderhal_kernel_index.h"
 
 #define OutputSurfaceWidthRatio 1
 extern const SURFACE_STATE_TOKEN_COMMON g_cInit_SURFACE_STATE_TOKEN_COMMON =
@@ -1710,6 +1711,9 @@ MOS_STATUS RenderHal_FreeStateHeaps(PRENDERHAL_INTERFACE pRenderHal)
         entry->pSurface = nullptr;
     }
 
+    // Free kernel allocation index
+    MOS_Delete(pStateHeap->pKernelIndex);
+
     // Free State Heap Control structure
     MOS_AlignedFreeMemory(pStateHeap);
     pRenderHal->pStateHeap = nullptr;
@@ -2121,6 +2125,7 @@ int32_t RenderHal_LoadKernel(
 {
     PRENDERHAL_STATE_HEAP       pStateHeap;
     PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
+    RenderHalKernelIndex        *pKernelIndex;
 
     int32_t iKernelAllocationID;    // Kernel allocation ID in GSH
     int32_t iKernelCacheID;         // Kernel cache ID
@@ -2139,6 +2144,7 @@ int32_t RenderHal_LoadKernel(
     MHW_RENDERHAL_CHK_NULL(pRenderHal);
     MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
     MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocation);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelIndex);
     MHW_RENDERHAL_CHK_NULL(pParameters);
     MHW_RENDERHAL_CHK_NULL(pKernel);
 
@@ -2159,26 +2165,23 @@ int32_t RenderHal_LoadKernel(
     iKernelUniqueID = pKernel->iKUID;
     iKernelCacheID  = pKernel->iKCID;
 
-    // Check if kernel is already loaded; Search free allocation index
-    iSearchIndex = -1;
-    iMaxKernels  = pRenderHal->StateHeapSettings.iKernelCount;
-    pKernelAllocation = pStateHeap->pKernelAllocation;
-    for (iKernelAllocationID = 0;
-         iKernelAllocationID < iMaxKernels;
-         iKernelAllocationID++, pKernelAllocation++)
+    // Check if kernel is already loaded
+    pKernelIndex        = pStateHeap->pKernelIndex;
+    iMaxKernels         = pRenderHal->StateHeapSettings.iKernelCount;
+    iKernelAllocationID = pKernelIndex->Find(iKernelUniqueID, iKernelCacheID);
+    if (iKernelAllocationID >= 0)
     {
-        if (pKernelAllocation->iKUID == iKernelUniqueID &&
-            pKernelAllocation->iKCID == iKernelCacheID)
-        {
-            break;
-        }
-
-        if (iSearchIndex < 0 &&
-            pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
+        pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
+        if (pKernelAllocation->iKUID != iKernelUniqueID ||
+            pKernelAllocation->iKCID != iKernelCacheID)
         {
-            iSearchIndex = iKernelAllocationID;
+            iKernelAllocationID = iMaxKernels;
         }
     }
+    else
+    {
+        iKernelAllocationID = iMaxKernels;
+    }
 
     // The kernel size to be dumped in oca buffer.
     pStateHeap->iKernelUsedForDump = iKernelSize;
@@ -2197,6 +2200,9 @@ int32_t RenderHal_LoadKernel(
         goto finish;
     }
 
+    // Search free allocation index
+    iSearchIndex = pKernelIndex->GetFreeEntry();
+
     // Simple allocation: allocation index available, space available
     if ((iSearchIndex >= 0) &&
         (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize))
@@ -2216,49 +2222,23 @@ int32_t RenderHal_LoadKernel(
         goto loadkernel;
     }
 
-    // Search block from deallocated entry
+    // Search minimum available block from deallocated entry
     if (iSearchIndex >= 0)
     {
-        int32_t iMinSize = 0;
-
-        iSearchIndex = -1;
-        pKernelAllocation = pStateHeap->pKernelAllocation;
-        for (iKernelAllocationID = 0;
-             iKernelAllocationID < iMaxKernels;
-             iKernelAllocationID++, pKernelAllocation++)
-        {
-            // Skip allocated/empty entries
-            if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE ||
-                pKernelAllocation->iSize   == 0)
-            {
-                continue;
-            }
-
-            // Allocate minimum available block
-            if (pKernelAllocation->iSize >= iKernelSize)
-            {
-                if (iSearchIndex < 0 ||
-                    pKernelAllocation->iSize < iMinSize)
-                {
-                    iSearchIndex = iKernelAllocationID;
-                    iMinSize     = pKernelAllocation->iSize;
-                }
-            }
-        }
+        iSearchIndex = pKernelIndex->GetFreeBlock(iKernelSize);
     }
 
     // Did not find block, try to deallocate a kernel not recently used
     if (iSearchIndex < 0)
     {
-        uint32_t dwOldest = 0;
-        uint32_t dwLastUsed;
-
-        // Search and deallocate least used kernel
-        pKernelAllocation = pStateHeap->pKernelAllocation;
-        for (iKernelAllocationID = 0;
-             iKernelAllocationID < iMaxKernels;
-             iKernelAllocationID++, pKernelAllocation++)
+        // Search and deallocate least used kernel, the index keeps the kernels
+        // in the order they were touched
+        for (iKernelAllocationID = pKernelIndex->GetLeastRecentlyUsed();
+             iKernelAllocationID >= 0;
+             iKernelAllocationID = pKernelIndex->GetNextRecentlyUsed(iKernelAllocationID))
         {
+            pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
+
             // Skip unused entries and entries that would not fit
             // Skip kernels flagged as locked (cannot be automatically deallocated)
             if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE ||
@@ -2274,14 +2254,8 @@ int32_t RenderHal_LoadKernel(
                 continue;
             }
 
-            // Find kernel not used for the greater amount of time (measured in number of operations)
-            // Must not unload recently allocated kernels
-            dwLastUsed = (uint32_t)(pStateHeap->dwAccessCounter - pKernelAllocation->dwCount);
-            if (dwLastUsed > dwOldest)
-            {
-                iSearchIndex = iKernelAllocationID;
-                dwOldest     = dwLastUsed;
-            }
+            iSearchIndex = iKernelAllocationID;
+            break;
         }
 
         // Did not found any entry for deallocation
@@ -2322,6 +2296,7 @@ loadkernel:
     pKernelAllocation->Params          = *pParameters;
     pKernelAllocation->pKernelEntry    = pKernelEntry;
     pKernelAllocation->iAllocIndex     = iKernelAllocationID;
+    pKernelIndex->Loaded(iKernelAllocationID, iKernelUniqueID, iKernelCacheID);
 
     // Copy kernel data
     MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
@@ -2414,6 +2389,11 @@ MOS_STATUS RenderHal_UnloadKernel(
     pKernelAllocation->dwCount          = 0;
     pKernelAllocation->pKernelEntry     = nullptr;
 
+    if (pStateHeap->pKernelIndex)
+    {
+        pStateHeap->pKernelIndex->Unloaded(iKernelAllocationID, pKernelAllocation->iSize);
+    }
+
     eStatus = MOS_STATUS_SUCCESS;
 
 finish:
@@ -2451,6 +2431,10 @@ void RenderHal_TouchKernel(
         pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_LOCKED)
     {
         pKernelAllocation->dwCount = pStateHeap->dwAccessCounter++;
+        if (pStateHeap->pKernelIndex)
+        {
+            pStateHeap->pKernelIndex->Touch(iKernelAllocationID);
+        }
     }
 
     // Set sync tag, for deallocation control
@@ -2504,6 +2488,16 @@ void RenderHal_ResetKernels(
         pKernelAllocation->Params           = g_cRenderHal_InitKernelParams;
     }
 
+    // Reset the kernel allocation index
+    if (pStateHeap->pKernelIndex == nullptr)
+    {
+        pStateHeap->pKernelIndex = MOS_New(RenderHalKernelIndex);
+    }
+    if (pStateHeap->pKernelIndex)
+    {
+        pStateHeap->pKernelIndex->Reset(pRenderHal->StateHeapSettings.iKernelCount);
+    }
+
     // Free Kernel Heap
     pStateHeap->dwAccessCounter = 0;
     pStateHeap->iKernelSize = pRenderHal->StateHeapSettings.iKernelHeapSize;
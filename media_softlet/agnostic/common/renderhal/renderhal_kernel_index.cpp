@@ -0,0 +1,199 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     renderhal_kernel_index.cpp
+//! \brief    Implements the index of the kernel allocations of the render hal state heap
+//!
+
+#include "renderhal_kernel_index.h"
+
+MOS_STATUS RenderHalKernelIndex::Reset(int32_t kernelCount)
+{
+    if (kernelCount < 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    m_entries.assign(kernelCount, Entry());
+    m_loaded.clear();
+    m_loaded.reserve(kernelCount);
+    m_emptyEntries.clear();
+    for (int32_t i = 0; i < kernelCount; i++)
+    {
+        m_emptyEntries.insert(m_emptyEntries.end(), i);
+    }
+    m_freeBlocks.clear();
+    m_lruHead = -1;
+    m_lruTail = -1;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+int32_t RenderHalKernelIndex::Find(int32_t kuid, int32_t kcid) const
+{
+    auto it = m_loaded.find(GetKey(kuid, kcid));
+    return (it == m_loaded.end()) ? -1 : it->second;
+}
+
+void RenderHalKernelIndex::Loaded(int32_t index, int32_t kuid, int32_t kcid)
+{
+    if (index < 0 || index >= (int32_t)m_entries.size())
+    {
+        return;
+    }
+
+    Entry &entry = m_entries[index];
+    if (entry.loaded)
+    {
+        auto it = m_loaded.find(entry.key);
+        if (it != m_loaded.end() && it->second == index)
+        {
+            m_loaded.erase(it);
+        }
+        Unlink(index);
+    }
+    else
+    {
+        TakeFree(index);
+    }
+
+    entry.loaded    = true;
+    entry.key       = GetKey(kuid, kcid);
+    entry.blockSize = 0;
+
+    m_loaded[entry.key] = index;
+    LinkMostRecent(index);
+}
+
+void RenderHalKernelIndex::Unloaded(int32_t index, int32_t blockSize)
+{
+    if (index < 0 || index >= (int32_t)m_entries.size())
+    {
+        return;
+    }
+
+    Entry &entry = m_entries[index];
+    if (entry.loaded)
+    {
+        auto it = m_loaded.find(entry.key);
+        if (it != m_loaded.end() && it->second == index)
+        {
+            m_loaded.erase(it);
+        }
+        Unlink(index);
+        entry.loaded = false;
+    }
+    else
+    {
+        TakeFree(index);
+    }
+
+    entry.blockSize = blockSize;
+    if (blockSize > 0)
+    {
+        m_freeBlocks.insert(std::make_pair(blockSize, index));
+    }
+    else
+    {
+        m_emptyEntries.insert(index);
+    }
+}
+
+void RenderHalKernelIndex::Touch(int32_t index)
+{
+    if (!IsLoaded(index) || index == m_lruTail)
+    {
+        return;
+    }
+
+    Unlink(index);
+    LinkMostRecent(index);
+}
+
+int32_t RenderHalKernelIndex::GetFreeEntry() const
+{
+    if (!m_emptyEntries.empty())
+    {
+        return *m_emptyEntries.begin();
+    }
+
+    // Only entries with blocks left, the smallest block is the cheapest to drop
+    return m_freeBlocks.empty() ? -1 : m_freeBlocks.begin()->second;
+}
+
+int32_t RenderHalKernelIndex::GetFreeBlock(int32_t size) const
+{
+    auto it = m_freeBlocks.lower_bound(std::make_pair(size, -1));
+    return (it == m_freeBlocks.end()) ? -1 : it->second;
+}
+
+void RenderHalKernelIndex::TakeFree(int32_t index)
+{
+    Entry &entry = m_entries[index];
+    if (entry.blockSize > 0)
+    {
+        m_freeBlocks.erase(std::make_pair(entry.blockSize, index));
+    }
+    else
+    {
+        m_emptyEntries.erase(index);
+    }
+}
+
+void RenderHalKernelIndex::LinkMostRecent(int32_t index)
+{
+    Entry &entry = m_entries[index];
+    entry.prev   = m_lruTail;
+    entry.next   = -1;
+    if (m_lruTail >= 0)
+    {
+        m_entries[m_lruTail].next = index;
+    }
+    else
+    {
+        m_lruHead = index;
+    }
+    m_lruTail = index;
+}
+
+void RenderHalKernelIndex::Unlink(int32_t index)
+{
+    Entry &entry = m_entries[index];
+    if (entry.prev >= 0)
+    {
+        m_entries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        m_lruHead = entry.next;
+    }
+    if (entry.next >= 0)
+    {
+        m_entries[entry.next].prev = entry.prev;
+    }
+    else
+    {
+        m_lruTail = entry.prev;
+    }
+    entry.prev = -1;
+    entry.next = -1;
+}
@@ -0,0 +1,166 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     renderhal_kernel_index.h
+//! \brief    Index of the kernel allocations of the render hal state heap
+//!
+#ifndef __RENDERHAL_KERNEL_INDEX_H__
+#define __RENDERHAL_KERNEL_INDEX_H__
+
+#include <stdint.h>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mos_defs.h"
+#include "media_class_trace.h"
+
+//!
+//! \class    RenderHalKernelIndex
+//!
+//! \brief    Keeps the kernel allocation table searchable without scanning it.
+//!
+//! \detail   Loaded kernels are found by (KUID, KCID), free allocation entries
+//!           are kept apart from the ones still holding a block of the kernel
+//!           heap, sorted by block size for best fit, and loaded kernels are
+//!           kept in the order they were last touched so the least recently
+//!           used one is found first. The allocation table stays the reference,
+//!           callers check what the index returns against it.
+//!
+class RenderHalKernelIndex
+{
+public:
+    RenderHalKernelIndex() = default;
+
+    ~RenderHalKernelIndex() = default;
+
+    //!
+    //! \brief  Make all the allocation entries free without a heap block
+    //!
+    //! \param  [in] kernelCount
+    //!         Number of allocation entries
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Reset(int32_t kernelCount);
+
+    //!
+    //! \brief  Find the allocation entry of a loaded kernel
+    //!
+    //! \param  [in] kuid
+    //!         Kernel unique ID
+    //! \param  [in] kcid
+    //!         Kernel cache ID
+    //! \return int32_t
+    //!         Allocation index, -1 if the kernel is not loaded
+    //!
+    int32_t Find(int32_t kuid, int32_t kcid) const;
+
+    //!
+    //! \brief  Record a kernel loaded at the allocation entry, it becomes the most recently used one
+    //!
+    void Loaded(int32_t index, int32_t kuid, int32_t kcid);
+
+    //!
+    //! \brief  Record the allocation entry free, keeping a heap block of blockSize bytes
+    //!
+    void Unloaded(int32_t index, int32_t blockSize);
+
+    //!
+    //! \brief  Make the kernel at the allocation entry the most recently used one
+    //!
+    void Touch(int32_t index);
+
+    //!
+    //! \brief  Get a free allocation entry to take a new heap block, entries
+    //!         without a block come first so no block is dropped
+    //!
+    //! \return int32_t
+    //!         Allocation index, -1 if all the entries are in use
+    //!
+    int32_t GetFreeEntry() const;
+
+    //!
+    //! \brief  Get the free allocation entry with the smallest heap block of at least size bytes
+    //!
+    //! \return int32_t
+    //!         Allocation index, -1 if no block is large enough
+    //!
+    int32_t GetFreeBlock(int32_t size) const;
+
+    //!
+    //! \brief  Get the least recently used loaded kernel
+    //!
+    //! \return int32_t
+    //!         Allocation index, -1 if no kernel is loaded
+    //!
+    int32_t GetLeastRecentlyUsed() const { return m_lruHead; }
+
+    //!
+    //! \brief  Get the loaded kernel used right after the one at the allocation entry
+    //!
+    //! \return int32_t
+    //!         Allocation index, -1 if it is the most recently used one
+    //!
+    int32_t GetNextRecentlyUsed(int32_t index) const
+    {
+        return IsLoaded(index) ? m_entries[index].next : -1;
+    }
+
+    //!
+    //! \brief  Check whether the index has a kernel loaded at the allocation entry
+    //!
+    bool IsLoaded(int32_t index) const
+    {
+        return index >= 0 && index < (int32_t)m_entries.size() && m_entries[index].loaded;
+    }
+
+protected:
+    struct Entry
+    {
+        bool     loaded    = false;
+        uint64_t key       = 0;   //!< (KUID, KCID) of the loaded kernel
+        int32_t  blockSize = 0;   //!< heap block kept by a free entry
+        int32_t  prev      = -1;  //!< loaded kernel used right before
+        int32_t  next      = -1;  //!< loaded kernel used right after
+    };
+
+    static uint64_t GetKey(int32_t kuid, int32_t kcid)
+    {
+        return ((uint64_t)(uint32_t)kuid << 32) | (uint32_t)kcid;
+    }
+
+    void TakeFree(int32_t index);
+    void LinkMostRecent(int32_t index);
+    void Unlink(int32_t index);
+
+    std::vector<Entry>                     m_entries;
+    std::unordered_map<uint64_t, int32_t>  m_loaded;         //!< allocation index by (KUID, KCID)
+    std::set<int32_t>                      m_emptyEntries;   //!< free entries without a heap block
+    std::set<std::pair<int32_t, int32_t>>  m_freeBlocks;     //!< free entries with a heap block, by block size
+    int32_t                                m_lruHead = -1;   //!< least recently used loaded kernel
+    int32_t                                m_lruTail = -1;   //!< most recently used loaded kernel
+
+MEDIA_CLASS_DEFINE_END(RenderHalKernelIndex)
+};
+
+#endif  // __RENDERHAL_KERNEL_INDEX_H__
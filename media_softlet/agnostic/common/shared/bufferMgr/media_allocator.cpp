@@ -27,6 +27,8 @@
 //!
 #include <algorithm>
 #include "media_allocator.h"
+#include "media_recycle_pool.h"
+#include "mos_context_next.h"
 
 Allocator::Allocator(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
 {
@@ -44,7 +46,7 @@ MOS_STATUS Allocator::DestroyAllResources()
     for (auto it : m_resourcePool)
     {
         MOS_RESOURCE *resource = const_cast<MOS_RESOURCE *>(it.first);
-        m_osInterface->pfnFreeResource(m_osInterface, resource);
+        FreeOsResource(resource);
         MOS_Delete(resource);
         MOS_Delete(it.second);
     }
@@ -56,7 +58,7 @@ MOS_STATUS Allocator::DestroyAllResources()
         MOS_SURFACE *surface = const_cast<MOS_SURFACE *>(it.first);
         if (surface)
         {
-            m_osInterface->pfnFreeResource(m_osInterface, &(surface->OsResource));
+            FreeOsResource(&(surface->OsResource));
         }
         MOS_Delete(surface);
         MOS_Delete(it.second);
@@ -67,14 +69,14 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_resourcePool)
     {
-        m_osInterface->pfnFreeResource(m_osInterface, it);
+        FreeOsResource(it);
         MOS_Delete(it);
     }
     m_resourcePool.clear();
 
     for (auto it : m_surfacePool)
     {
-        m_osInterface->pfnFreeResource(m_osInterface, &it->OsResource);
+        FreeOsResource(&it->OsResource);
         MOS_Delete(it);
     }
     m_surfacePool.clear();
@@ -83,7 +85,7 @@ MOS_STATUS Allocator::DestroyAllResources()
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroOnAllocate, MOS_COMPONENT component)
+MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroOnAllocate, MOS_COMPONENT component, bool recyclable)
 {
     if (nullptr == m_osInterface)
     {
@@ -92,7 +94,8 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
 
     MOS_RESOURCE *resource = MOS_New(MOS_RESOURCE);
     memset(resource, 0, sizeof(MOS_RESOURCE));
-    MOS_STATUS status = m_osInterface->pfnAllocateResource(m_osInterface, &param, resource);
+    bool       cleared = false;
+    MOS_STATUS status  = AllocateOsResource(param, resource, recyclable, cleared);
 
     if (status != MOS_STATUS_SUCCESS)
     {
@@ -104,7 +107,7 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
     TraceInfo *info = MOS_New(TraceInfo);
     if (nullptr == info)
     {
-        FreeResource(resource);
+        FreeOsResource(resource);
         MOS_Delete(resource);
         return nullptr;
     }
@@ -120,7 +123,7 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
     m_resourcePool.push_back(resource);
 #endif
 
-    if (zeroOnAllocate)
+    if (zeroOnAllocate && !cleared)
     {
         ClearResource(resource, param);
     }
@@ -191,7 +194,7 @@ MOS_SURFACE *Allocator::AllocateSurface(MOS_ALLOC_GFXRES_PARAMS &param, bool zer
     TraceInfo *info = MOS_New(TraceInfo);
     if (nullptr == info)
     {
-        FreeResource(&surface->OsResource);
+        FreeOsResource(&surface->OsResource);
         MOS_Delete(surface);
         return nullptr;
     }
@@ -234,7 +237,7 @@ MOS_STATUS Allocator::DestroyResource(MOS_RESOURCE *resource)
 #endif
 
     m_resourcePool.erase(it);
-    m_osInterface->pfnFreeResource(m_osInterface, resource);
+    FreeOsResource(resource);
     MOS_Delete(resource);
 
     return MOS_STATUS_SUCCESS;
@@ -263,7 +266,7 @@ MOS_STATUS Allocator::DestroyBuffer(MOS_BUFFER *buffer)
 #endif
 
     m_resourcePool.erase(it);
-    m_osInterface->pfnFreeResource(m_osInterface, &buffer->OsResource);
+    FreeOsResource(&buffer->OsResource);
     MOS_Delete(buffer);
 
     return MOS_STATUS_SUCCESS;
@@ -292,7 +295,7 @@ MOS_STATUS Allocator::DestroySurface(MOS_SURFACE *surface, MOS_GFXRES_FREE_FLAGS
 #endif
 
     m_surfacePool.erase(it);
-    m_osInterface->pfnFreeResourceWithFlag(m_osInterface, &surface->OsResource, flags.Value);
+    FreeOsResource(&surface->OsResource, flags.Value);
     MOS_Delete(surface);
 
     return MOS_STATUS_SUCCESS;
@@ -323,6 +326,70 @@ MOS_STATUS Allocator::FreeResource(MOS_RESOURCE *res)
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS Allocator::AllocateOsResource(MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE *resource, bool recyclable, bool &cleared)
+{
+    // A recycled resource holds the data of the session which released it, only
+    // lockable linear buffers are pooled as ClearResource can wipe them in full
+    bool              canRecycle = recyclable && param.Format == Format_Buffer && !param.Flags.bNotLockable;
+    MediaRecyclePool *pool       = canRecycle ? GetRecyclePool() : nullptr;
+
+    cleared = false;
+    if (pool != nullptr && pool->Acquire(param, *resource))
+    {
+        if (ClearResource(resource, param) == MOS_STATUS_SUCCESS)
+        {
+            cleared                      = true;
+            m_recyclableParams[resource] = param;
+            return MOS_STATUS_SUCCESS;
+        }
+
+        m_osInterface->pfnFreeResource(m_osInterface, resource);
+        memset(resource, 0, sizeof(MOS_RESOURCE));
+    }
+
+    MOS_STATUS status = m_osInterface->pfnAllocateResource(m_osInterface, &param, resource);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (pool != nullptr)
+    {
+        m_recyclableParams[resource] = param;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+void Allocator::FreeOsResource(MOS_RESOURCE *resource, uint32_t flags)
+{
+    auto it = m_recyclableParams.find(resource);
+    if (it != m_recyclableParams.end())
+    {
+        // Free flags, e.g. synchronous destroy, ask for the allocation itself to go
+        MediaRecyclePool *pool     = flags == 0 ? GetRecyclePool() : nullptr;
+        bool              recycled = pool != nullptr && pool->Recycle(it->second, *resource);
+        m_recyclableParams.erase(it);
+        if (recycled)
+        {
+            return;
+        }
+    }
+
+    m_osInterface->pfnFreeResourceWithFlag(m_osInterface, resource, flags);
+}
+
+MediaRecyclePool *Allocator::GetRecyclePool()
+{
+    if (nullptr == m_osInterface ||
+        nullptr == m_osInterface->osStreamState ||
+        nullptr == m_osInterface->osStreamState->osDeviceContext)
+    {
+        return nullptr;
+    }
+
+    return m_osInterface->osStreamState->osDeviceContext->GetRecyclePool();
+}
+
 MOS_STATUS Allocator::ClearResource(MOS_RESOURCE *resource, MOS_ALLOC_GFXRES_PARAMS &param)
 {
     MOS_LOCK_PARAMS lockFlag;
@@ -30,6 +30,7 @@
 #define __MEDIA_ALLOCATOR_H__
 
 #include <stdint.h>
+#include <map>
 #include <vector>
 #include "mos_defs.h"
 #include "mos_os_hw.h"
@@ -37,6 +38,8 @@
 #include "mos_os.h"
 #include "media_class_trace.h"
 
+class MediaRecyclePool;
+
 class Allocator
 {
 public:
@@ -80,10 +83,13 @@ public:
     //!         zero the memory if true
     //! \param  [in] component
     //!         component type to track the buffer
+    //! \param  [in] recyclable
+    //!         take the resource from and return it to the recycle pool of the device,
+    //!         only lockable linear buffers are pooled and they are cleared when reused
     //! \return MOS_RESOURCE*
     //!         return the pointer to MOS_RESOURCE
     //!
-    MOS_RESOURCE *AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroOnAllocate, MOS_COMPONENT component);
+    MOS_RESOURCE *AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroOnAllocate, MOS_COMPONENT component, bool recyclable = false);
 
     //!
     //! \brief  Allocate Buffer
@@ -263,6 +269,38 @@ protected:
     //!
     MOS_STATUS ClearResource(MOS_RESOURCE *resource, MOS_ALLOC_GFXRES_PARAMS &param);
 
+    //!
+    //! \brief  Allocate the OS resource, from the recycle pool if requested
+    //! \param  [in] param
+    //!         reference to MOS_ALLOC_GFXRES_PARAMS
+    //! \param  [out] resource
+    //!         pointer to MOS_RESOURCE
+    //! \param  [in] recyclable
+    //!         whether the resource goes through the recycle pool
+    //! \param  [out] cleared
+    //!         set if the resource came from the pool and was cleared
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AllocateOsResource(MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE *resource, bool recyclable, bool &cleared);
+
+    //!
+    //! \brief  Free the OS resource, recyclable ones are returned to the pool
+    //!         unless free flags are given
+    //! \param  [in] resource
+    //!         pointer to MOS_RESOURCE
+    //! \param  [in] flags
+    //!         MOS_GFXRES_FREE_FLAGS value
+    //!
+    void FreeOsResource(MOS_RESOURCE *resource, uint32_t flags = 0);
+
+    //!
+    //! \brief  Get the recycle pool of the device
+    //! \return MediaRecyclePool*
+    //!         pointer to the pool, nullptr if the device has none
+    //!
+    MediaRecyclePool *GetRecyclePool();
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     struct TraceInfo
     {
@@ -277,6 +315,8 @@ protected:
     std::vector<MOS_SURFACE *>  m_surfacePool;
 #endif
 
+    std::map<MOS_RESOURCE *, MOS_ALLOC_GFXRES_PARAMS> m_recyclableParams;  //!< allocate parameters of recyclable resources
+
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
 MEDIA_CLASS_DEFINE_END(Allocator)
 };
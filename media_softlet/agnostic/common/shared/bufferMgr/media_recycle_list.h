@@ -0,0 +1,216 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_recycle_list.h
+//! \brief    Bookkeeping of the media recycle pool
+//! \details  Keeps recycled items by key in recycle order, hands out idle ones
+//!           and trims the least recently recycled ones past a high water mark.
+//!           Not thread safe, the pool serializes the calls.
+//!
+
+#ifndef __MEDIA_RECYCLE_LIST_H__
+#define __MEDIA_RECYCLE_LIST_H__
+
+#include <stdint.h>
+#include <iterator>
+#include <list>
+#include <map>
+
+//!
+//! \brief    Statistics of a recycle pool
+//!
+struct MEDIA_RECYCLE_POOL_STATS
+{
+    uint64_t hits;              //!< acquires served from the pool
+    uint64_t misses;            //!< acquires which had to allocate
+    uint64_t busySkips;         //!< pooled resources skipped because the GPU still used them
+    uint64_t recycled;          //!< resources returned to the pool
+    uint64_t rejected;          //!< resources the pool could not keep
+    uint64_t trimmed;           //!< resources freed by the high water mark policy
+    uint64_t cachedBytes;       //!< bytes currently held by the pool
+    uint64_t peakBytes;         //!< most bytes ever held by the pool
+};
+
+template <class Key, class Item>
+class MediaRecycleList
+{
+public:
+    //!
+    //! \brief  Constructor
+    //! \param  [in] highWaterMark
+    //!         Bytes the list may hold, exceeding it trims the least recently
+    //!         recycled items down to half of it
+    //!
+    MediaRecycleList(uint64_t highWaterMark) : m_highWaterMark(highWaterMark) {}
+
+    //!
+    //! \brief  Take the least recently recycled idle item of a key
+    //! \param  [in] key
+    //!         Key of the item required
+    //! \param  [out] item
+    //!         Receives the item on a hit
+    //! \param  [in] isBusy
+    //!         Callable telling whether the GPU still uses an item
+    //! \return bool
+    //!         true if an item is handed out
+    //!
+    template <class IsBusy>
+    bool Acquire(const Key &key, Item &item, IsBusy isBusy)
+    {
+        auto range = m_index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            Entry &entry = *it->second;
+            if (isBusy(entry.item))
+            {
+                m_stats.busySkips++;
+                continue;
+            }
+
+            item = entry.item;
+            m_stats.cachedBytes -= entry.size;
+            m_stats.hits++;
+            m_entries.erase(it->second);
+            m_index.erase(it);
+            return true;
+        }
+
+        m_stats.misses++;
+        return false;
+    }
+
+    //!
+    //! \brief  Check whether an item of a size can be kept
+    //! \param  [in] size
+    //!         Bytes of the item
+    //! \return bool
+    //!         false if the item alone exceeds the high water mark
+    //!
+    bool Fits(uint64_t size) const { return size <= m_highWaterMark; }
+
+    //!
+    //! \brief  Add an item, trimming the list if it exceeds the high water mark
+    //! \param  [in] key
+    //!         Key of the item
+    //! \param  [in] item
+    //!         The item, owned by the list now
+    //! \param  [in] size
+    //!         Bytes of the item, it must fit
+    //! \param  [in] free
+    //!         Callable freeing trimmed items
+    //!
+    template <class Free>
+    void Recycle(const Key &key, const Item &item, uint64_t size, Free free)
+    {
+        m_entries.push_back(Entry{key, item, size});
+        m_index.insert(std::make_pair(key, std::prev(m_entries.end())));
+
+        m_stats.recycled++;
+        m_stats.cachedBytes += size;
+        if (m_stats.cachedBytes > m_stats.peakBytes)
+        {
+            m_stats.peakBytes = m_stats.cachedBytes;
+        }
+
+        if (m_stats.cachedBytes > m_highWaterMark)
+        {
+            Trim(m_highWaterMark / 2, free);
+        }
+    }
+
+    //!
+    //! \brief  Count an item the pool could not keep
+    //!
+    void Reject() { m_stats.rejected++; }
+
+    //!
+    //! \brief  Free least recently recycled items until the list holds no
+    //!         more than the given bytes
+    //! \param  [in] targetBytes
+    //!         Bytes the list may keep
+    //! \param  [in] free
+    //!         Callable freeing trimmed items
+    //!
+    template <class Free>
+    void Trim(uint64_t targetBytes, Free free)
+    {
+        while (m_stats.cachedBytes > targetBytes && !m_entries.empty())
+        {
+            auto oldest = m_entries.begin();
+
+            auto range = m_index.equal_range(oldest->key);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == oldest)
+                {
+                    m_index.erase(it);
+                    break;
+                }
+            }
+
+            m_stats.cachedBytes -= oldest->size;
+            m_stats.trimmed++;
+            free(oldest->item);
+            m_entries.erase(oldest);
+        }
+    }
+
+    //!
+    //! \brief  Change the high water mark and trim the list to it if needed
+    //! \param  [in] highWaterMark
+    //!         Bytes the list may hold, 0 keeps nothing
+    //! \param  [in] free
+    //!         Callable freeing trimmed items
+    //!
+    template <class Free>
+    void SetHighWaterMark(uint64_t highWaterMark, Free free)
+    {
+        m_highWaterMark = highWaterMark;
+        if (m_stats.cachedBytes > m_highWaterMark)
+        {
+            Trim(m_highWaterMark / 2, free);
+        }
+    }
+
+    //!
+    //! \brief  Get the statistics
+    //! \return MEDIA_RECYCLE_POOL_STATS &
+    //!
+    const MEDIA_RECYCLE_POOL_STATS &GetStatistics() const { return m_stats; }
+
+protected:
+    struct Entry
+    {
+        Key      key;
+        Item     item;
+        uint64_t size;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    uint64_t                                  m_highWaterMark = 0;   //!< bytes the list may hold
+    EntryList                                 m_entries;             //!< items, least recently recycled first
+    std::multimap<Key, typename EntryList::iterator> m_index;        //!< items by key, in recycle order
+    MEDIA_RECYCLE_POOL_STATS                  m_stats         = {};  //!< statistics
+};
+
+#endif  // !__MEDIA_RECYCLE_LIST_H__
@@ -0,0 +1,166 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_recycle_pool.cpp
+//! \brief    Implements the device level pool of recycled media resources
+//!
+
+#include "media_recycle_pool.h"
+#include "mos_interface.h"
+#include "mos_context_next.h"
+#include "mos_graphicsresource_next.h"
+
+MediaRecyclePool::MediaRecyclePool(OsContextNext *osDeviceContext, uint64_t highWaterMark)
+    : m_osDeviceContext(osDeviceContext),
+      m_list(highWaterMark)
+{
+}
+
+MediaRecyclePool::~MediaRecyclePool()
+{
+    MEDIA_RECYCLE_POOL_STATS stats = GetStatistics();
+    MOS_OS_NORMALMESSAGE("Recycle pool: %llu hits, %llu misses, %llu busy skips, %llu recycled, %llu rejected, %llu trimmed, peak %llu bytes",
+        (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.busySkips,
+        (unsigned long long)stats.recycled, (unsigned long long)stats.rejected, (unsigned long long)stats.trimmed,
+        (unsigned long long)stats.peakBytes);
+
+    Trim(0);
+}
+
+void MediaRecyclePool::MakeKey(const MOS_ALLOC_GFXRES_PARAMS &param, MEDIA_RECYCLE_POOL_KEY &key)
+{
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type              = param.Type;
+    key.flags             = param.Flags;
+    key.width             = param.dwWidth;
+    key.height            = param.dwHeight;
+    key.depth             = param.dwDepth;
+    key.arraySize         = param.dwArraySize;
+    key.tileType          = param.TileType;
+    key.tileModeByForce   = param.m_tileModeByForce;
+    key.format            = param.Format;
+    key.compressible      = param.bIsCompressible;
+    key.compressionMode   = param.CompressionMode;
+    key.persistent        = param.bIsPersistent;
+    key.memType           = param.dwMemType;
+    key.resUsageType      = param.ResUsageType;
+    key.hardwareProtected = param.hardwareProtected;
+}
+
+bool MediaRecyclePool::Acquire(const MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE &resource)
+{
+    if (param.pSystemMemory != nullptr)
+    {
+        return false;
+    }
+
+    MEDIA_RECYCLE_POOL_KEY key;
+    MakeKey(param, key);
+
+    // Equal keys keep their recycle order, so the resource most likely idle is checked first
+    m_mutex.Lock();
+    bool hit = m_list.Acquire(key, resource, [](MOS_RESOURCE &pooled) {
+        return MosInterface::MosResourceIsBusy(&pooled);
+    });
+    m_mutex.Unlock();
+
+    return hit;
+}
+
+bool MediaRecyclePool::Recycle(const MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE &resource)
+{
+    // Only resources owned by the device context can outlive the session
+    // which allocated them
+    bool recyclable = param.pSystemMemory == nullptr &&
+                      resource.pGfxResourceNext != nullptr &&
+                      resource.pGmmResInfo != nullptr &&
+                      !resource.bConvertedFromDDIResource;
+
+    uint64_t size = recyclable ? (uint64_t)resource.pGmmResInfo->GetSizeSurface() : 0;
+
+    m_mutex.Lock();
+
+    if (!recyclable || !m_list.Fits(size))
+    {
+        m_list.Reject();
+        m_mutex.Unlock();
+        return false;
+    }
+
+    // Drop the session state, e.g. the allocation list indexes, and keep the allocation
+    MEDIA_RECYCLE_POOL_KEY key;
+    MOS_RESOURCE           pooled;
+    MakeKey(param, key);
+    MosInterface::MosResetResource(&pooled);
+    if (resource.pGfxResourceNext->ConvertToMosResource(&pooled) != MOS_STATUS_SUCCESS)
+    {
+        m_list.Reject();
+        m_mutex.Unlock();
+        return false;
+    }
+
+    m_list.Recycle(key, pooled, size, [this](MOS_RESOURCE &trimmed) { FreeResource(trimmed); });
+
+    m_mutex.Unlock();
+
+    MosInterface::MosResetResource(&resource);
+    return true;
+}
+
+void MediaRecyclePool::Trim(uint64_t targetBytes)
+{
+    m_mutex.Lock();
+    m_list.Trim(targetBytes, [this](MOS_RESOURCE &trimmed) { FreeResource(trimmed); });
+    m_mutex.Unlock();
+}
+
+void MediaRecyclePool::SetHighWaterMark(uint64_t highWaterMark)
+{
+    m_mutex.Lock();
+    m_list.SetHighWaterMark(highWaterMark, [this](MOS_RESOURCE &trimmed) { FreeResource(trimmed); });
+    m_mutex.Unlock();
+}
+
+MEDIA_RECYCLE_POOL_STATS MediaRecyclePool::GetStatistics()
+{
+    m_mutex.Lock();
+    MEDIA_RECYCLE_POOL_STATS stats = m_list.GetStatistics();
+    m_mutex.Unlock();
+    return stats;
+}
+
+void MediaRecyclePool::FreeResource(MOS_RESOURCE &resource)
+{
+    // Pooled resources outlive their sessions, so they are freed through the
+    // device context as MosInterface::FreeResource does for them
+    if (resource.pGfxResourceNext == nullptr || m_osDeviceContext == nullptr)
+    {
+        return;
+    }
+
+    resource.pGfxResourceNext->Free(m_osDeviceContext);
+    MOS_Delete(resource.pGfxResourceNext);
+    resource.pGfxResourceNext = nullptr;
+
+    MosUtilities::MosAtomicDecrement(&MosUtilities::m_mosMemAllocCounterGfx);
+    MosInterface::MosResetResource(&resource);
+}
@@ -0,0 +1,147 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_recycle_pool.h
+//! \brief    Defines the device level pool of recycled media resources
+//! \details  Internal resources released by one media session are kept in the
+//!           pool, keyed by their allocate parameters, and handed to the next
+//!           session asking for the same parameters once the GPU is done
+//!           with them
+//!
+
+#ifndef __MEDIA_RECYCLE_POOL_H__
+#define __MEDIA_RECYCLE_POOL_H__
+
+#include <stdint.h>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "mos_utilities.h"
+#include "media_class_trace.h"
+#include "media_recycle_list.h"
+
+class OsContextNext;
+
+//!
+//! \brief    Allocate parameters which decide whether a resource can be reused.
+//!           Instances are compared bytewise, so they must be zero-initialized
+//!           before the fields are filled in.
+//!
+struct MEDIA_RECYCLE_POOL_KEY
+{
+    MOS_GFXRES_TYPE       type;
+    MOS_GFXRES_FLAGS      flags;
+    uint32_t              width;
+    uint32_t              height;
+    uint32_t              depth;
+    uint32_t              arraySize;
+    MOS_TILE_TYPE         tileType;
+    MOS_TILE_MODE_GMM     tileModeByForce;
+    MOS_FORMAT            format;
+    int32_t               compressible;
+    MOS_RESOURCE_MMC_MODE compressionMode;
+    int32_t               persistent;
+    int32_t               memType;
+    MOS_HW_RESOURCE_DEF   resUsageType;
+    uint32_t              hardwareProtected;
+
+    bool operator<(const MEDIA_RECYCLE_POOL_KEY &other) const
+    {
+        return memcmp(this, &other, sizeof(MEDIA_RECYCLE_POOL_KEY)) < 0;
+    }
+};
+
+class MediaRecyclePool
+{
+public:
+    //!
+    //! \brief  Constructor
+    //! \param  [in] osDeviceContext
+    //!         Device context the pooled resources belong to
+    //! \param  [in] highWaterMark
+    //!         Bytes the pool may hold, exceeding it trims the least recently
+    //!         recycled resources down to half of it
+    //!
+    MediaRecyclePool(OsContextNext *osDeviceContext, uint64_t highWaterMark = m_defaultHighWaterMark);
+
+    //!
+    //! \brief  Destructor, frees all the pooled resources
+    //!
+    ~MediaRecyclePool();
+
+    //!
+    //! \brief  Take an idle resource allocated with the same parameters
+    //! \param  [in] param
+    //!         Allocate parameters of the resource required
+    //! \param  [out] resource
+    //!         Receives the resource on a hit
+    //! \return bool
+    //!         true if a resource is handed out, false if the caller has to allocate
+    //!
+    bool Acquire(const MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE &resource);
+
+    //!
+    //! \brief  Hand a resource over to the pool instead of freeing it
+    //! \param  [in] param
+    //!         Parameters the resource was allocated with
+    //! \param  [in, out] resource
+    //!         The resource, reset if the pool keeps it
+    //! \return bool
+    //!         true if the pool owns the resource now, false if the caller
+    //!         still has to free it
+    //!
+    bool Recycle(const MOS_ALLOC_GFXRES_PARAMS &param, MOS_RESOURCE &resource);
+
+    //!
+    //! \brief  Free least recently recycled resources until the pool holds no
+    //!         more than the given bytes
+    //! \param  [in] targetBytes
+    //!         Bytes the pool may keep
+    //!
+    void Trim(uint64_t targetBytes);
+
+    //!
+    //! \brief  Change the high water mark and trim the pool to it if needed
+    //! \param  [in] highWaterMark
+    //!         Bytes the pool may hold, 0 disables the pool
+    //!
+    void SetHighWaterMark(uint64_t highWaterMark);
+
+    //!
+    //! \brief  Get a snapshot of the pool statistics
+    //! \return MEDIA_RECYCLE_POOL_STATS
+    //!
+    MEDIA_RECYCLE_POOL_STATS GetStatistics();
+
+    static constexpr uint64_t m_defaultHighWaterMark = 128 * 1024 * 1024;  //!< default bytes the pool may hold
+
+protected:
+    static void MakeKey(const MOS_ALLOC_GFXRES_PARAMS &param, MEDIA_RECYCLE_POOL_KEY &key);
+
+    void FreeResource(MOS_RESOURCE &resource);
+
+    OsContextNext                                        *m_osDeviceContext = nullptr;  //!< device the resources belong to
+    MediaRecycleList<MEDIA_RECYCLE_POOL_KEY, MOS_RESOURCE> m_list;                      //!< pooled resources
+    MosMutex                                             m_mutex;                       //!< protects the pool against concurrent sessions
+
+MEDIA_CLASS_DEFINE_END(MediaRecyclePool)
+};
+#endif  // !__MEDIA_RECYCLE_POOL_H__
@@ -33,6 +33,9 @@
 #include <stdint.h>
 #include <map>
 #include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include "media_user_setting.h"
 #include "media_utils.h"
@@ -116,6 +119,41 @@ class MediaFeatureManager  // for pipe line use
 {
 protected:
     using container_t = std::map<int, MediaFeature *>;
+    using settings_t  = std::unordered_map<std::type_index, std::vector<const void *>>;
+
+    //!
+    //! \brief  Get the features implementing a parameter setting interface
+    //! \details The features of a manager only change on registration, so the
+    //!          dynamic casts are done on the first call for each interface and
+    //!          later calls return the cached list, in feature ID order
+    //! \param  [in] features
+    //!         Features of the manager
+    //! \param  [in, out] settings
+    //!         Cached lists of the manager
+    //! \return const std::vector<const void *> &
+    //!         Pointers to the T base of the features, to be cast back with static_cast
+    //!
+    template <class T>
+    static const std::vector<const void *> &FindParSettings(container_t &features, settings_t &settings)
+    {
+        std::type_index type(typeid(T));
+        auto iter = settings.find(type);
+        if (iter != settings.end())
+        {
+            return iter->second;
+        }
+
+        std::vector<const void *> &list = settings[type];
+        for (auto &e : features)
+        {
+            const T *p = dynamic_cast<const T *>(e.second);
+            if (p)
+            {
+                list.push_back(p);
+            }
+        }
+        return list;
+    }
 
 public:
     class ManagerLite final  // for packet use
@@ -147,8 +185,20 @@ public:
             return iter->second;
         }
 
+        //!
+        //! \brief  Get the features implementing a parameter setting interface
+        //! \return const std::vector<const void *> &
+        //!         Pointers to the T base of the features
+        //!
+        template <class T>
+        const std::vector<const void *> &GetParSettings()
+        {
+            return FindParSettings<T>(m_features, m_settings);
+        }
+
     private:
         container_t m_features;
+        settings_t  m_settings;  //!< features by parameter setting interface
     };
 
 public:
@@ -249,6 +299,17 @@ public:
         }
         return iter->second;
     }
+
+    //!
+    //! \brief  Get the features implementing a parameter setting interface
+    //! \return const std::vector<const void *> &
+    //!         Pointers to the T base of the features
+    //!
+    template <class T>
+    const std::vector<const void *> &GetParSettings()
+    {
+        return FindParSettings<T>(m_features, m_settings);
+    }
     //!
     //! \brief  Get Pass Number
     //! \return uint8_t
@@ -291,6 +352,7 @@ protected:
     uint8_t GetTargetUsage(){return m_targetUsage;}
 
     container_t m_features;
+    settings_t  m_settings;                          // features by parameter setting interface, dropped on registration
     std::map<int, std::vector<int>> m_packetIdList;  // map feature ID to a vector of packet ID
     std::map<int, LIST_TYPE> m_packetIdListTypes;  // map feature ID to a flag, indicates whether packet ID vector is a block list or an allow list
     MediaFeatureConstSettings *m_featureConstSettings = nullptr;
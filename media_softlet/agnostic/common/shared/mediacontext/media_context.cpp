@@ -30,6 +30,7 @@
 #include "media_context.h"
 #include "mos_interface.h"
 #include "mos_os_virtualengine_next.h"
+#include "mos_engine_load_tracker.h"
 #if !EMUL
 #include "codechal_hw.h"
 #include "decode_scalability_defs.h"
@@ -72,6 +73,8 @@ MediaContext::~MediaContext()
 
     for (auto& curAttribute : m_gpuContextAttributeTable)
     {
+        MosEngineLoadTracker::Instance().UnbindSession(curAttribute.node);
+
         if (curAttribute.scalabilityState)
         {
             curAttribute.scalabilityState->Destroy();
@@ -179,6 +182,11 @@ MOS_STATUS MediaContext::SwitchContext(MediaFunction func, ContextRequirement *r
         }
     }
 
+    if (func == VdboxDecodeFunc || func == VdboxEncodeFunc)
+    {
+        ((ScalabilityPars *)requirement)->numOtherVdboxSessions = GetOtherVdboxSessions();
+    }
+
     uint32_t index = m_invalidContextAttribute;
 #if !EMUL
     MOS_OS_CHK_STATUS_RETURN(SearchContext<ScalabilityPars*>(func, (ScalabilityPars*)requirement, index));
@@ -196,6 +204,7 @@ MOS_STATUS MediaContext::SwitchContext(MediaFunction func, ContextRequirement *r
     // Be compatible to legacy MOS
     MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnSetGpuContext(m_osInterface, m_gpuContextAttributeTable[index].ctxForLegacyMos));
     veStateProvided = m_gpuContextAttributeTable[index].scalabilityState;
+    m_currentNode   = m_gpuContextAttributeTable[index].node;
     MOS_OS_NORMALMESSAGE("Switched to GpuContext %d, index %d", m_gpuContextAttributeTable[index].ctxForLegacyMos, index);
 
     if (requirement->IsEnc)
@@ -311,6 +320,8 @@ MOS_STATUS MediaContext::CreateContext(MediaFunction func, T params, uint32_t& i
     MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnCreateGpuContext(m_osInterface, newAttr.ctxForLegacyMos, node, &option));
     m_osInterface->pfnSetGpuContext(m_osInterface, newAttr.ctxForLegacyMos);
     newAttr.gpuContext = m_osInterface->CurrentGpuContextHandle;
+    newAttr.node       = node;
+    MosEngineLoadTracker::Instance().BindSession(node);
     MOS_OS_NORMALMESSAGE("Create GpuContext %d, node %d, handle 0x%x, protectMode %d, raMode %d",
         newAttr.ctxForLegacyMos, node, newAttr.gpuContext, option.ProtectMode, option.RAMode);
 
@@ -359,6 +370,7 @@ MOS_STATUS MediaContext::SwitchContext(
     // Be compatible to legacy MOS
     MOS_OS_CHK_STATUS_RETURN(m_osInterface->pfnSetGpuContext(m_osInterface, m_gpuContextAttributeTable[index].ctxForLegacyMos));
     veStateProvided = m_gpuContextAttributeTable[index].scalabilityState;
+    m_currentNode   = m_gpuContextAttributeTable[index].node;
 
     if (isEnc)
     {
@@ -376,6 +388,27 @@ MOS_STATUS MediaContext::SwitchContext(
     return MOS_STATUS_SUCCESS;
 }
 
+uint32_t MediaContext::GetOtherVdboxSessions()
+{
+    if (m_otherVdboxSessions == m_invalidSessionCount)
+    {
+        const MOS_GPU_NODE vdboxNodes[] = {MOS_GPU_NODE_VIDEO, MOS_GPU_NODE_VIDEO2};
+        uint32_t sessions = MosEngineLoadTracker::Instance().GetSessionCount(vdboxNodes, sizeof(vdboxNodes) / sizeof(vdboxNodes[0]));
+
+        uint32_t ownSessions = 0;
+        for (auto &curAttribute : m_gpuContextAttributeTable)
+        {
+            if (curAttribute.node == MOS_GPU_NODE_VIDEO || curAttribute.node == MOS_GPU_NODE_VIDEO2)
+            {
+                ownSessions++;
+            }
+        }
+        m_otherVdboxSessions = (sessions > ownSessions) ? sessions - ownSessions : 0;
+    }
+
+    return m_otherVdboxSessions;
+}
+
 MOS_STATUS MediaContext::FunctionToNode(MediaFunction func, const MOS_GPUCTX_CREATOPTIONS_ENHANCED &option, MOS_GPU_NODE& node)
 {
     MOS_OS_FUNCTION_ENTER;
@@ -57,6 +57,7 @@ struct GpuContextAttribute
 
     MOS_GPU_CONTEXT    ctxForLegacyMos     = MOS_GPU_CONTEXT_MAX;
     GPU_CONTEXT_HANDLE gpuContext          = MOS_GPU_CONTEXT_INVALID_HANDLE;
+    MOS_GPU_NODE       node                = MOS_GPU_NODE_MAX;
 };
 
 class MediaContext
@@ -117,6 +118,22 @@ public:
         return MOS_RCS_ENGINE_USED(gpuContext);
     }
 
+    //!
+    //! \brief  Get the GPU node of the context switched to last
+    //! \return MOS_GPU_NODE
+    //!         MOS_GPU_NODE_MAX if no context has been switched to yet
+    //!
+    MOS_GPU_NODE GetCurrentGpuNode() { return m_currentNode; }
+
+    //!
+    //! \brief  Get the VDBox contexts the other sessions of the process have
+    //! \detail They are counted once, when this media context is first asked,
+    //!         so the scalability mode of a session does not flip with the load
+    //!         of the others
+    //! \return uint32_t
+    //!
+    uint32_t GetOtherVdboxSessions();
+
 protected:
     PMOS_INTERFACE                    m_osInterface             = nullptr;           //!< OS interface
     void                             *m_hwInterface             = nullptr;           //!< HW interface
@@ -124,10 +141,13 @@ protected:
     uint32_t                          m_streamId                = m_invalidStreamId; //!< Stream id of this media context
 
     std::vector<GpuContextAttribute>  m_gpuContextAttributeTable;                    //!< Gpu Context Attribute Table to store the contexts to reuse
+    MOS_GPU_NODE                      m_currentNode             = MOS_GPU_NODE_MAX;  //!< GPU node of the context switched to last
+    uint32_t                          m_otherVdboxSessions      = m_invalidSessionCount; //!< VDBox contexts of the other sessions when this one first asked for a VDBox
 
     static const uint32_t             m_invalidContextAttribute = 0xffffffdf;        //!< Index value to indicate invalid Context Attribute
     static const uint32_t             m_invalidStreamId         = 0xffffffcb;        //!< Id to indicate invalid Stream
     static const uint32_t             m_maxContextAttribute     = 4096;              //!< Max number of entries supported in gpuContextAttributeTable in one media context
+    static const uint32_t             m_invalidSessionCount     = 0xffffffff;        //!< Session count not sampled yet
 
     //!
     //! \brief  Search the ContextAttributeTable to reuse or create gpu Context and scalabilty state meeting the requirements
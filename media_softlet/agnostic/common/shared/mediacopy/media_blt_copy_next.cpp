@@ -384,9 +384,17 @@ MOS_STATUS BltStateNext::SubmitCMD(
               }
          }
     }
-    // Add flush DW
-    flushDwParams = {};
+    // Add flush DW, it writes the GPU status tag so the copy can be seen done
+    PMOS_RESOURCE gpuStatusBuffer = nullptr;
+    BLT_CHK_STATUS_RETURN(m_osInterface->pfnGetGpuStatusBufferResource(m_osInterface, gpuStatusBuffer));
+    BLT_CHK_NULL_RETURN(gpuStatusBuffer);
+    BLT_CHK_STATUS_RETURN(m_osInterface->pfnRegisterResource(m_osInterface, gpuStatusBuffer, true, true));
+    flushDwParams                  = {};
+    flushDwParams.pOsResource      = gpuStatusBuffer;
+    flushDwParams.dwResourceOffset = m_osInterface->pfnGetGpuStatusTagOffset(m_osInterface, MOS_GPU_CONTEXT_BLT);
+    flushDwParams.dwDataDW1        = m_osInterface->pfnGetGpuStatusTag(m_osInterface, MOS_GPU_CONTEXT_BLT);
     BLT_CHK_STATUS_RETURN(m_miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(&cmdBuffer));
+    m_osInterface->pfnIncrementGpuStatusTag(m_osInterface, MOS_GPU_CONTEXT_BLT);
     // Add Batch Buffer end
     BLT_CHK_STATUS_RETURN(m_miItf->AddMiBatchBufferEnd(&cmdBuffer, nullptr));
     // Flush the command buffer
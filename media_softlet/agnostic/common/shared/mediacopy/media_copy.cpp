@@ -30,6 +30,7 @@
 #include "vp_dumper.h"
 #include "mhw_cp_interface.h"
 #include "mos_utilities.h"
+#include "mos_engine_load_tracker.h"
 
 MediaCopyBaseState::MediaCopyBaseState():
     m_osInterface(nullptr)
@@ -160,13 +161,18 @@ MOS_STATUS MediaCopyBaseState::PreProcess(MCPY_METHOD preferMethod)
 //!
 MOS_STATUS MediaCopyBaseState::CopyEnigneSelect(MCPY_METHOD preferMethod)
 {
-    // assume perf render > vebox > blt. blt data should be measured.
+    // performance goes to the engine the cost model expects done first, ties keep render > blt > vebox.
     // driver should make sure there is at least one he can process copy even customer choice doesn't match caps.
+    static const MCPY_ENGINE perfOrder[] = {MCPY_ENGINE_RENDER, MCPY_ENGINE_BLT, MCPY_ENGINE_VEBOX};
+    MCPY_ENGINE              engine      = MCPY_ENGINE_MAX;
+
     switch (preferMethod)
     {
         case MCPY_METHOD_PERFORMANCE:
         case MCPY_METHOD_DEFAULT:
-            m_mcpyEngine = m_mcpyEngineCaps.engineRender?MCPY_ENGINE_RENDER:(m_mcpyEngineCaps.engineBlt ? MCPY_ENGINE_BLT : MCPY_ENGINE_VEBOX);
+            engine = m_costModel.SelectEngine(m_mcpyEngineCaps, m_mcpyCopy, perfOrder, sizeof(perfOrder) / sizeof(perfOrder[0]));
+            m_mcpyEngine = (engine != MCPY_ENGINE_MAX) ? engine :
+                (m_mcpyEngineCaps.engineRender?MCPY_ENGINE_RENDER:(m_mcpyEngineCaps.engineBlt ? MCPY_ENGINE_BLT : MCPY_ENGINE_VEBOX));
             break;
         case MCPY_METHOD_BALANCE:
             m_mcpyEngine = m_mcpyEngineCaps.engineVebox?MCPY_ENGINE_VEBOX:(m_mcpyEngineCaps.engineBlt?MCPY_ENGINE_BLT:MCPY_ENGINE_RENDER);
@@ -205,6 +211,11 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     MCPY_NORMALMESSAGE("input surface's format %d, width %d; hight %d, pitch %d, tiledmode %d, mmc mode %d",
         ResDetails.Format, ResDetails.dwWidth, ResDetails.dwHeight, ResDetails.dwPitch, m_mcpySrc.TileMode, m_mcpySrc.CompressionMode);
 
+    // the copy moves the whole resource, its size carries the format and the planes
+    m_mcpyCopy.size               = ResDetails.dwSize ? ResDetails.dwSize : (uint64_t)ResDetails.dwPitch * ResDetails.dwHeight;
+    m_mcpyCopy.srcTileMode        = m_mcpySrc.TileMode;
+    m_mcpyCopy.srcCompressionMode = m_mcpySrc.CompressionMode;
+
     MOS_ZeroMemory(&ResDetails, sizeof(MOS_SURFACE));
     MCPY_CHK_STATUS_RETURN(m_osInterface->pfnGetResourceInfo(m_osInterface, dst, &ResDetails));
     MCPY_CHK_STATUS_RETURN(m_osInterface->pfnGetMemoryCompressionMode(m_osInterface,dst, (PMOS_MEMCOMP_STATE) &(m_mcpyDst.CompressionMode)));
@@ -213,6 +224,13 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     m_mcpyDst.OsRes           = dst;
     MCPY_NORMALMESSAGE("Output surface's format %d, width %d; hight %d, pitch %d, tiledmode %d, mmc mode %d",
         ResDetails.Format, ResDetails.dwWidth, ResDetails.dwHeight, ResDetails.dwPitch, m_mcpyDst.TileMode, m_mcpyDst.CompressionMode);
+    m_mcpyCopy.dstTileMode        = m_mcpyDst.TileMode;
+
+    // only the calibrated model weighs the queued work, else nothing polls the engines
+    if (m_costModel.IsCalibrated())
+    {
+        GetEngineQueue(m_mcpyCopy);
+    }
 
     MCPY_CHK_STATUS_RETURN(PreProcess(preferMethod));
 
@@ -225,6 +243,74 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     return eStatus;
 }
 
+//!
+//! \brief    get the work queued on the copy engines.
+//! \details  every frame outstanding on an engine is weighted with its average busy time,
+//!           only done once the cost model is calibrated.
+//! \param    copy
+//!           [out] copy description to fill the queued time of
+//! \return   void
+//!
+void MediaCopyBaseState::GetEngineQueue(MCPY_COPY_DESC &copy)
+{
+    uint64_t now = MosEngineLoadTracker::GetTimeNs();
+
+    // account the copies of this state done by now
+    MosUtilities::MosLockMutex(m_inUseGPUMutex);
+    for (uint32_t engine = 0; engine < MCPY_ENGINE_MAX; engine++)
+    {
+        if (m_loadTracker.GetPending((MCPY_ENGINE)engine) && m_osInterface->pfnGetGpuStatusSyncTag)
+        {
+            uint32_t syncTag = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, GetGpuContext((MCPY_ENGINE)engine));
+            m_loadTracker.Poll((MCPY_ENGINE)engine, syncTag, now);
+        }
+    }
+    MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
+
+    for (uint32_t engine = 0; engine < MCPY_ENGINE_MAX; engine++)
+    {
+        MOS_ENGINE_LOAD load = MosEngineLoadTracker::Instance().GetLoad(MediaCopyLoadTracker::GetNode((MCPY_ENGINE)engine));
+        uint64_t busyNs      = load.busyNs ? load.busyNs : MosEngineLoadTracker::m_defaultBusyNs;
+        copy.queuedNs[engine] = load.outstanding * busyNs;
+    }
+}
+
+MOS_GPU_CONTEXT MediaCopyBaseState::GetGpuContext(MCPY_ENGINE engine)
+{
+    switch (engine)
+    {
+        case MCPY_ENGINE_VEBOX:
+            return MOS_GPU_CONTEXT_VEBOX;
+        case MCPY_ENGINE_BLT:
+            return MOS_GPU_CONTEXT_BLT;
+        case MCPY_ENGINE_RENDER:
+            return MOS_GPU_CONTEXT_COMPUTE;
+        default:
+            return MOS_GPU_CONTEXT_INVALID_HANDLE;
+    }
+}
+
+void MediaCopyBaseState::TrackSubmission(MCPY_ENGINE engine, uint32_t tagBefore)
+{
+    if (engine >= MCPY_ENGINE_MAX)
+    {
+        return;
+    }
+
+    // the status tag is only read once the GPU context of the engine is created
+    bool     tagged = false;
+    uint32_t tag    = 0;
+    if (m_osInterface->pfnGetGpuStatusTag)
+    {
+        uint32_t tagAfter = m_osInterface->pfnGetGpuStatusTag(m_osInterface, GetGpuContext(engine));
+        tagged            = m_engineSubmitted[engine] && tagAfter != tagBefore;
+        tag               = tagAfter - 1;
+    }
+
+    m_loadTracker.Submitted(engine, tagged, tag, MosEngineLoadTracker::GetTimeNs());
+    m_engineSubmitted[engine] = true;
+}
+
 #if (_DEBUG || _RELEASE_INTERNAL)
 MOS_STATUS MediaCopyBaseState::CloneResourceInfo(PVPHAL_SURFACE pVphalSurface, PMOS_SURFACE pMosSurface)
 {
@@ -273,9 +359,16 @@ MOS_STATUS MediaCopyBaseState::CloneResourceInfo(PVPHAL_SURFACE pVphalSurface, P
 
 MOS_STATUS MediaCopyBaseState::TaskDispatch()
 {
-    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+    MOS_STATUS eStatus   = MOS_STATUS_SUCCESS;
+    uint32_t   tagBefore = 0;
+    bool       tracked   = m_costModel.IsCalibrated();     // the engine load only feeds the calibrated model
     MosUtilities::MosLockMutex(m_inUseGPUMutex);
 
+    if (tracked && m_mcpyEngine < MCPY_ENGINE_MAX && m_engineSubmitted[m_mcpyEngine] && m_osInterface->pfnGetGpuStatusTag)
+    {
+        tagBefore = m_osInterface->pfnGetGpuStatusTag(m_osInterface, GetGpuContext(m_mcpyEngine));
+    }
+
     switch(m_mcpyEngine)
     {
         case MCPY_ENGINE_VEBOX:
@@ -300,6 +393,10 @@ MOS_STATUS MediaCopyBaseState::TaskDispatch()
         default:
             break;
     }
+    if (tracked && eStatus == MOS_STATUS_SUCCESS)
+    {
+        TrackSubmission(m_mcpyEngine, tagBefore);
+    }
     MosUtilities::MosUnlockMutex(m_inUseGPUMutex);
 
 #if (_DEBUG || _RELEASE_INTERNAL)
@@ -36,39 +36,18 @@
 #include "mos_util_debug.h"
 #include "mos_os.h"
 #include "mos_interface.h"
+#include "media_copy_cost_model.h"
+#include "media_copy_load_tracker.h"
 
 class VpSurfaceDumper;
 typedef struct VPHAL_SURFACE* PVPHAL_SURFACE;
 
-typedef struct _MCPY_ENGINE_CAPS
-{
-    uint32_t engineVebox   :1;
-    uint32_t engineBlt     :1;
-    uint32_t engineRender  :1;
-    uint32_t reversed      :29;
-}MCPY_ENGINE_CAPS;
-
-enum MCPY_ENGINE
-{
-    MCPY_ENGINE_VEBOX = 0,
-    MCPY_ENGINE_BLT,
-    MCPY_ENGINE_RENDER,
-};
-
 enum MCPY_CPMODE
 {
     MCPY_CPMODE_CP = 0,
     MCPY_CPMODE_CLEAR,
 };
 
-enum MCPY_METHOD
-{
-    MCPY_METHOD_DEFAULT = 0,  
-    MCPY_METHOD_POWERSAVING,  // use BCS engine
-    MCPY_METHOD_PERFORMANCE,  // use EU to get the best perf.
-    MCPY_METHOD_BALANCE,      // use vebox engine.
-};
-
 typedef struct _MCPY_STATE_PARAMS
 {
     MOS_RESOURCE         *OsRes;              // mos resource
@@ -226,6 +205,35 @@ protected:
     //!
     MOS_STATUS CopyEnigneSelect(MCPY_METHOD preferMethod);
 
+    //!
+    //! \brief    get the work queued on the copy engines.
+    //! \details  every frame outstanding on an engine is weighted with its average busy time,
+    //!           only done once the cost model is calibrated.
+    //! \param    copy
+    //!           [out] copy description to fill the queued time of
+    //! \return   void
+    //!
+    void GetEngineQueue(MCPY_COPY_DESC &copy);
+
+    //!
+    //! \brief    account the copy submitted on the engine in the engine load tracker.
+    //! \details  the copy is tagged if it moved the GPU status tag of its context on.
+    //! \param    engine
+    //!           [in] engine the copy was submitted on
+    //! \param    tagBefore
+    //!           [in] GPU status tag of the context before the copy
+    //! \return   void
+    //!
+    void TrackSubmission(MCPY_ENGINE engine, uint32_t tagBefore);
+
+    //!
+    //! \brief    get the GPU context the copies of the engine are submitted on.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \return   MOS_GPU_CONTEXT
+    //!
+    static MOS_GPU_CONTEXT GetGpuContext(MCPY_ENGINE engine);
+
     //!
     //! \brief    use blt engie to do surface copy.
     //! \details  implementation media blt copy.
@@ -276,11 +284,15 @@ public:
     MCPY_ENGINE         m_mcpyEngine     = MCPY_ENGINE_RENDER;
     MCPY_STATE_PARAMS   m_mcpySrc        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false}; // source surface.
     MCPY_STATE_PARAMS   m_mcpyDst        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false}; // destination surface.
+    MCPY_COPY_DESC      m_mcpyCopy       = {};       // what the cost of the copy depends on.
+    MediaCopyCostModel  m_costModel;                // engine cost model, platforms set their calibrated table.
     bool                m_allowCPBltCopy  = false;  // allow cp call media copy only for output clear cases.
     VpSurfaceDumper     *m_surfaceDumper  = nullptr;
 
 protected:
     PMOS_MUTEX           m_inUseGPUMutex = nullptr; // Mutex for in-use GPU context
+    MediaCopyLoadTracker m_loadTracker;                // copies submitted and not seen done yet, under m_inUseGPUMutex.
+    bool                 m_engineSubmitted[MCPY_ENGINE_MAX] = {}; // whether the GPU context of the engine is created.
 MEDIA_CLASS_DEFINE_END(MediaCopyBaseState)
 };
 #endif
@@ -0,0 +1,130 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_cost_model.cpp
+//! \brief    Cost model of the media copy engines
+//! \details  Estimates the time each engine needs for a copy
+//!
+
+#include "media_copy_cost_model.h"
+
+// No platform is calibrated yet. The empty table keeps the fixed precedence
+// until a platform sets the table fitted from its perf profiler data.
+const MCPY_COST_TABLE MediaCopyCostModel::m_defaultTable = {};
+
+MediaCopyCostModel::MediaCopyCostModel() :
+    m_table(m_defaultTable)
+{
+}
+
+bool MediaCopyCostModel::IsCalibrated() const
+{
+    for (auto &throughput : m_table.engine)
+    {
+        if (throughput.linearBytesPerUs || throughput.tiledBytesPerUs)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MediaCopyCostModel::IsEngineSupported(const MCPY_ENGINE_CAPS &caps, MCPY_ENGINE engine)
+{
+    switch (engine)
+    {
+    case MCPY_ENGINE_VEBOX:
+        return caps.engineVebox;
+    case MCPY_ENGINE_BLT:
+        return caps.engineBlt;
+    case MCPY_ENGINE_RENDER:
+        return caps.engineRender;
+    default:
+        return false;
+    }
+}
+
+uint64_t MediaCopyCostModel::GetCostNs(MCPY_ENGINE engine, const MCPY_COPY_DESC &copy) const
+{
+    if (engine >= MCPY_ENGINE_MAX)
+    {
+        return UINT64_MAX;
+    }
+
+    const MCPY_ENGINE_THROUGHPUT &throughput = m_table.engine[engine];
+    bool     linear     = copy.srcTileMode == MOS_TILE_LINEAR && copy.dstTileMode == MOS_TILE_LINEAR;
+    uint32_t bytesPerUs = linear ? throughput.linearBytesPerUs : throughput.tiledBytesPerUs;
+    if (bytesPerUs == 0)
+    {
+        return UINT64_MAX;
+    }
+
+    uint64_t costNs = (uint64_t)throughput.setupUs * 1000 + copy.size * 1000 / bytesPerUs + copy.queuedNs[engine];
+
+    // BLT copies the compressed source only once it is resolved in place
+    if (engine == MCPY_ENGINE_BLT &&
+        copy.srcTileMode != MOS_TILE_LINEAR &&
+        copy.srcCompressionMode != MOS_MMC_DISABLED)
+    {
+        if (m_table.resolveBytesPerUs == 0)
+        {
+            return UINT64_MAX;
+        }
+        costNs += copy.size * 1000 / m_table.resolveBytesPerUs;
+    }
+
+    return costNs;
+}
+
+MCPY_ENGINE MediaCopyCostModel::SelectEngine(
+    const MCPY_ENGINE_CAPS &caps,
+    const MCPY_COPY_DESC   &copy,
+    const MCPY_ENGINE      *order,
+    uint32_t                count) const
+{
+    MCPY_ENGINE selected   = MCPY_ENGINE_MAX;
+    uint64_t    minCost    = UINT64_MAX;
+    bool        calibrated = IsCalibrated();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!IsEngineSupported(caps, order[i]))
+        {
+            continue;
+        }
+
+        // Without a calibrated table the first able engine is taken
+        if (!calibrated)
+        {
+            return order[i];
+        }
+
+        uint64_t cost = GetCostNs(order[i], copy);
+        if (selected == MCPY_ENGINE_MAX || cost < minCost)
+        {
+            selected = order[i];
+            minCost  = cost;
+        }
+    }
+
+    return selected;
+}
@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_cost_model.h
+//! \brief    Cost model of the media copy engines
+//! \details  Estimates the time each engine needs for a copy from calibrated
+//!           throughput tables, the layout of the surfaces and the work already
+//!           queued on the engine, so the copy goes to the engine done first
+//!
+
+#ifndef __MEDIA_COPY_COST_MODEL_H__
+#define __MEDIA_COPY_COST_MODEL_H__
+
+#include <stdint.h>
+#include "mos_defs.h"
+#include "mos_resource_defs.h"
+#include "media_class_trace.h"
+
+typedef struct _MCPY_ENGINE_CAPS
+{
+    uint32_t engineVebox   :1;
+    uint32_t engineBlt     :1;
+    uint32_t engineRender  :1;
+    uint32_t reversed      :29;
+}MCPY_ENGINE_CAPS;
+
+enum MCPY_ENGINE
+{
+    MCPY_ENGINE_VEBOX = 0,
+    MCPY_ENGINE_BLT,
+    MCPY_ENGINE_RENDER,
+    MCPY_ENGINE_MAX
+};
+
+enum MCPY_METHOD
+{
+    MCPY_METHOD_DEFAULT = 0,
+    MCPY_METHOD_POWERSAVING,  // use BCS engine
+    MCPY_METHOD_PERFORMANCE,  // use EU to get the best perf.
+    MCPY_METHOD_BALANCE,      // use vebox engine.
+};
+
+//!
+//! \brief  Calibrated throughput of one copy engine
+//!
+typedef struct _MCPY_ENGINE_THROUGHPUT
+{
+    uint32_t linearBytesPerUs;      //!< copy rate when both surfaces are linear
+    uint32_t tiledBytesPerUs;       //!< copy rate when a surface is tiled
+    uint32_t setupUs;               //!< fixed cost of a copy, state setup and submission
+}MCPY_ENGINE_THROUGHPUT;
+
+//!
+//! \brief  Calibrated throughput of the copy engines of a platform
+//!
+typedef struct _MCPY_COST_TABLE
+{
+    MCPY_ENGINE_THROUGHPUT engine[MCPY_ENGINE_MAX];     //!< by MCPY_ENGINE
+    uint32_t               resolveBytesPerUs;           //!< rate of the resolve a compressed tiled source needs before a BLT copy
+}MCPY_COST_TABLE;
+
+//!
+//! \brief  What the cost of a copy depends on
+//!
+typedef struct _MCPY_COPY_DESC
+{
+    uint64_t              size;                         //!< bytes to copy
+    MOS_TILE_TYPE         srcTileMode;                  //!< source tiling
+    MOS_TILE_TYPE         dstTileMode;                  //!< destination tiling
+    MOS_RESOURCE_MMC_MODE srcCompressionMode;           //!< source compression
+    uint64_t              queuedNs[MCPY_ENGINE_MAX];    //!< time the work already queued on each engine needs, by MCPY_ENGINE
+}MCPY_COPY_DESC;
+
+class MediaCopyCostModel
+{
+public:
+    //!
+    //! \brief    Cost model with the default table, not calibrated
+    //!
+    MediaCopyCostModel();
+
+    virtual ~MediaCopyCostModel() {}
+
+    //!
+    //! \brief    Replace the throughput table, e.g. by the calibrated one of the platform
+    //! \param    table
+    //!           [in] Throughput table
+    //!
+    void SetTable(const MCPY_COST_TABLE &table) { m_table = table; }
+
+    const MCPY_COST_TABLE &GetTable() const { return m_table; }
+
+    //!
+    //! \brief    Check whether the table holds the throughput of any engine
+    //! \return   bool
+    //!           false for an empty table, the engines are then taken in preferred order
+    //!
+    bool IsCalibrated() const;
+
+    //!
+    //! \brief    Estimate when the engine would be done with the copy
+    //! \param    engine
+    //!           [in] Copy engine
+    //! \param    copy
+    //!           [in] Copy description
+    //! \return   uint64_t
+    //!           Time in ns, the work queued on the engine included
+    //!
+    uint64_t GetCostNs(MCPY_ENGINE engine, const MCPY_COPY_DESC &copy) const;
+
+    //!
+    //! \brief    Select the engine done first with the copy
+    //! \details  Ties go to the engine first in preferred order. Without a
+    //!           calibrated table the first able engine in preferred order is taken.
+    //! \param    caps
+    //!           [in] Engines able to do the copy
+    //! \param    copy
+    //!           [in] Copy description
+    //! \param    order
+    //!           [in] Engines in preferred order
+    //! \param    count
+    //!           [in] Number of engines in order
+    //! \return   MCPY_ENGINE
+    //!           MCPY_ENGINE_MAX if no engine of order is able to do the copy
+    //!
+    MCPY_ENGINE SelectEngine(const MCPY_ENGINE_CAPS &caps, const MCPY_COPY_DESC &copy, const MCPY_ENGINE *order, uint32_t count) const;
+
+    static bool IsEngineSupported(const MCPY_ENGINE_CAPS &caps, MCPY_ENGINE engine);
+
+    static const MCPY_COST_TABLE m_defaultTable;   //!< empty table of the platforms not calibrated
+
+protected:
+    MCPY_COST_TABLE m_table;
+
+MEDIA_CLASS_DEFINE_END(MediaCopyCostModel)
+};
+
+#endif  // __MEDIA_COPY_COST_MODEL_H__
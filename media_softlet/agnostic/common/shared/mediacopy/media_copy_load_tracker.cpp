@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_load_tracker.cpp
+//! \brief    Reports the media copy submissions to the engine load tracker
+//!
+
+#include "media_copy_load_tracker.h"
+#include "mos_engine_load_tracker.h"
+
+constexpr uint32_t MediaCopyLoadTracker::m_maxPending;
+
+MediaCopyLoadTracker::~MediaCopyLoadTracker()
+{
+    for (uint32_t engine = 0; engine < MCPY_ENGINE_MAX; engine++)
+    {
+        if (!m_pending[engine].empty())
+        {
+            MosEngineLoadTracker::Instance().Abandoned(GetNode((MCPY_ENGINE)engine), (uint32_t)m_pending[engine].size());
+        }
+    }
+}
+
+MOS_GPU_NODE MediaCopyLoadTracker::GetNode(MCPY_ENGINE engine)
+{
+    switch (engine)
+    {
+    case MCPY_ENGINE_VEBOX:
+        return MOS_GPU_NODE_VE;
+    case MCPY_ENGINE_BLT:
+        return MOS_GPU_NODE_BLT;
+    case MCPY_ENGINE_RENDER:
+        // render copy contexts, compute included, are accounted on the 3D node
+        return MOS_GPU_NODE_3D;
+    default:
+        return MOS_GPU_NODE_MAX;
+    }
+}
+
+void MediaCopyLoadTracker::Submitted(MCPY_ENGINE engine, bool tagged, uint32_t tag, uint64_t nowNs)
+{
+    if (engine >= MCPY_ENGINE_MAX)
+    {
+        return;
+    }
+
+    MOS_GPU_NODE node = GetNode(engine);
+    if (m_pending[engine].size() >= m_maxPending)
+    {
+        MosEngineLoadTracker::Instance().Abandoned(node, 1);
+        m_pending[engine].pop_front();
+    }
+
+    m_pending[engine].push_back({tag, tagged, nowNs});
+    MosEngineLoadTracker::Instance().Submitted(node);
+}
+
+void MediaCopyLoadTracker::Poll(MCPY_ENGINE engine, uint32_t syncTag, uint64_t nowNs)
+{
+    if (engine >= MCPY_ENGINE_MAX || m_pending[engine].empty())
+    {
+        return;
+    }
+
+    MosEngineLoadTracker   &tracker   = MosEngineLoadTracker::Instance();
+    MOS_GPU_NODE            node      = GetNode(engine);
+    std::deque<Submission> &pending   = m_pending[engine];
+    MOS_ENGINE_LOAD         load      = tracker.GetLoad(node);
+    uint64_t                busyNs    = load.busyNs ? load.busyNs : MosEngineLoadTracker::m_defaultBusyNs;
+    uint32_t                completed = 0;
+    uint64_t                start     = 0;
+
+    // The copies of an engine are done in submission order, copies which do
+    // not write the tag are assumed done after an average frame
+    while (!pending.empty())
+    {
+        const Submission &submission = pending.front();
+        if (submission.tagged && (int32_t)(syncTag - submission.tag) >= 0)
+        {
+            start = completed ? start : MOS_MAX(submission.submitNs, m_lastCompletionNs[engine]);
+            completed++;
+        }
+        else if (!submission.tagged && nowNs - submission.submitNs >= busyNs)
+        {
+            tracker.Abandoned(node, 1);
+        }
+        else
+        {
+            break;
+        }
+        pending.pop_front();
+    }
+
+    if (completed)
+    {
+        uint64_t busy = (nowNs > start) ? (nowNs - start) / completed : 0;
+        for (uint32_t i = 0; i < completed; i++)
+        {
+            tracker.Completed(node, busy);
+        }
+        m_lastCompletionNs[engine] = nowNs;
+    }
+}
@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_load_tracker.h
+//! \brief    Reports the media copy submissions to the engine load tracker
+//! \details  Keeps the copies submitted on each engine until the GPU status
+//!           sync tag of their context shows them done, so the work queued on
+//!           the copy engines is seen by the cost model
+//!
+
+#ifndef __MEDIA_COPY_LOAD_TRACKER_H__
+#define __MEDIA_COPY_LOAD_TRACKER_H__
+
+#include <stdint.h>
+#include <deque>
+#include "mos_defs.h"
+#include "mos_os_specific.h"
+#include "media_copy_cost_model.h"
+#include "media_class_trace.h"
+
+class MediaCopyLoadTracker
+{
+public:
+    MediaCopyLoadTracker() {}
+
+    //!
+    //! \brief    Drop the copies not seen done yet from the engine load tracker
+    //!
+    virtual ~MediaCopyLoadTracker();
+
+    //!
+    //! \brief    Account a copy submitted on the engine
+    //! \param    engine
+    //!           [in] Copy engine
+    //! \param    tagged
+    //!           [in] Whether the copy writes the GPU status tag of its context when done
+    //! \param    tag
+    //!           [in] GPU status tag the copy writes
+    //! \param    nowNs
+    //!           [in] Submission time in ns
+    //! \return   void
+    //!
+    void Submitted(MCPY_ENGINE engine, bool tagged, uint32_t tag, uint64_t nowNs);
+
+    //!
+    //! \brief    Account the copies of the engine done by now
+    //! \details  Tagged copies are done once the sync tag reached their tag.
+    //!           Copies without tag are dropped once they are pending longer
+    //!           than a frame of the engine takes on average, they give no
+    //!           busy time sample.
+    //! \param    engine
+    //!           [in] Copy engine
+    //! \param    syncTag
+    //!           [in] Last GPU status tag written on the context of the engine
+    //! \param    nowNs
+    //!           [in] Current time in ns
+    //! \return   void
+    //!
+    void Poll(MCPY_ENGINE engine, uint32_t syncTag, uint64_t nowNs);
+
+    //!
+    //! \brief    Get the copies of the engine not seen done yet
+    //!
+    uint32_t GetPending(MCPY_ENGINE engine) const
+    {
+        return (engine < MCPY_ENGINE_MAX) ? (uint32_t)m_pending[engine].size() : 0;
+    }
+
+    //!
+    //! \brief    Get the GPU node the copies of the engine are submitted to
+    //!
+    static MOS_GPU_NODE GetNode(MCPY_ENGINE engine);
+
+    static constexpr uint32_t m_maxPending = 64;   //!< copies kept per engine, older ones are dropped
+
+protected:
+    struct Submission
+    {
+        uint32_t tag;
+        bool     tagged;
+        uint64_t submitNs;
+    };
+
+    std::deque<Submission> m_pending[MCPY_ENGINE_MAX];                  //!< copies not seen done yet, in submission order
+    uint64_t               m_lastCompletionNs[MCPY_ENGINE_MAX] = {};    //!< time the last copy of the engine was seen done
+
+MEDIA_CLASS_DEFINE_END(MediaCopyLoadTracker)
+};
+
+#endif  // __MEDIA_COPY_LOAD_TRACKER_H__
@@ -21,6 +21,8 @@
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
     ${CMAKE_CURRENT_LIST_DIR}/media_copy.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_copy_cost_model.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_copy_load_tracker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_blt_copy_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_vebox_copy_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_render_copy_next.cpp
@@ -30,6 +32,8 @@ set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/media_copy_common.h
     ${CMAKE_CURRENT_LIST_DIR}/media_copy.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_copy_cost_model.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_copy_load_tracker.h
     ${CMAKE_CURRENT_LIST_DIR}/media_blt_copy_next.h
     ${CMAKE_CURRENT_LIST_DIR}/media_vebox_copy_next.h
     ${CMAKE_CURRENT_LIST_DIR}/media_render_copy_next.h
@@ -56,13 +56,10 @@ namespace mhw{namespace mi{class Itf;}}  // namespace mhw
     }                                                                                   \
     if (m_featureManager)                                                               \
     {                                                                                   \
-        for (auto feature : *m_featureManager)                                          \
+        for (auto setting : m_featureManager->template GetParSettings<setting_t>())     \
         {                                                                               \
-            p = dynamic_cast<const setting_t *>(feature);                               \
-            if (p)                                                                      \
-            {                                                                           \
-                MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                       \
-            }                                                                           \
+            p = static_cast<const setting_t *>(setting);                                \
+            MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                           \
         }                                                                               \
     }
 
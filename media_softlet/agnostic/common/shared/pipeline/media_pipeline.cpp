@@ -218,6 +218,12 @@ MOS_STATUS MediaPipeline::ActivatePacket(uint32_t packetId, bool immediateSubmit
 MOS_STATUS MediaPipeline::ExecuteActivePackets()
 {
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_START, nullptr, 0, nullptr, 0);
+
+    if (m_statusReport && m_mediaContext)
+    {
+        m_statusReport->SetTrackedNode(m_mediaContext->GetCurrentGpuNode());
+    }
+
     for (auto prop : m_activePacketList)
     {
         prop.stateProperty.statusReport = m_statusReport;
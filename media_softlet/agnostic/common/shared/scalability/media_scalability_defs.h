@@ -85,6 +85,8 @@ struct ScalabilityPars : public ContextRequirement
     bool    enableTileReplay = false;
     uint32_t raMode = 0;
     uint32_t protectMode = 0;
+
+    uint32_t numOtherVdboxSessions = 0;  //!< VDBox contexts of the other sessions in the process, filled in by MediaContext
 };
 
 class ScalabilityTrace
@@ -26,6 +26,7 @@ set(TMP_SOURCES_
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
+    ${CMAKE_CURRENT_LIST_DIR}/media_status_load_tracking.h
     ${CMAKE_CURRENT_LIST_DIR}/media_status_report.h
     ${CMAKE_CURRENT_LIST_DIR}/media_status_report_observer.h
 )
@@ -0,0 +1,126 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_status_load_tracking.h
+//! \brief    Busy time of the frames a status report feeds to the engine load tracker
+//! \details  The status reports hold no GPU timestamps, so the busy time is
+//!           measured on the CPU: from the submission of a frame, or the
+//!           previous completion if later, until a completion is first seen
+//!           through the completed count. A completion is only seen when the
+//!           count is read, on the next submission or status query, so the
+//!           busy time includes the time until then and grows when the
+//!           application polls rarely. Frames seen completed together share
+//!           the time equally.
+//!
+
+#ifndef __MEDIA_STATUS_LOAD_TRACKING_H__
+#define __MEDIA_STATUS_LOAD_TRACKING_H__
+
+#include <stdint.h>
+
+//!
+//! \class  MediaStatusLoadTracking
+//! \brief  Submission times of the tracked frames of a status report, indexed
+//!         like the status buffer by the submitted count modulo frameNum
+//!
+template <uint32_t frameNum>
+class MediaStatusLoadTracking
+{
+public:
+    //!
+    //! \brief  Start tracking with the frame of the submitted count, frames
+    //!         still pending are forgotten
+    //! \param  [in] submittedCount
+    //!         Counter of the next frame to submit
+    //!
+    void Start(uint32_t submittedCount)
+    {
+        m_next = m_end = submittedCount;
+    }
+
+    //!
+    //! \brief  Get the tracked frames not seen completed yet
+    //! \return uint32_t
+    //!
+    uint32_t GetPending() const { return m_end - m_next; }
+
+    //!
+    //! \brief  Account the frame of the submitted count as submitted
+    //! \param  [in] submittedCount
+    //!         Counter of the frame
+    //! \param  [in] nowNs
+    //!         Submission time in ns
+    //!
+    void Submitted(uint32_t submittedCount, uint64_t nowNs)
+    {
+        if (m_next == m_end)
+        {
+            m_next = submittedCount;
+        }
+        m_submitTimeNs[submittedCount % frameNum] = nowNs;
+        m_end = submittedCount + 1;
+    }
+
+    //!
+    //! \brief  Account the tracked frames the completed count moved past
+    //! \param  [in] completedCount
+    //!         Completed count read from the status buffer
+    //! \param  [in] nowNs
+    //!         Time the completed count was read in ns
+    //! \param  [out] busyNs
+    //!         Busy time of each of the frames in ns
+    //! \return uint32_t
+    //!         number of frames seen completed
+    //!
+    uint32_t Completed(uint32_t completedCount, uint64_t nowNs, uint64_t &busyNs)
+    {
+        uint32_t completed = completedCount - m_next;
+        busyNs             = 0;
+        if ((int32_t)completed <= 0)
+        {
+            return 0;
+        }
+        if (completed > GetPending())
+        {
+            completed = GetPending();
+        }
+
+        uint64_t start = m_submitTimeNs[m_next % frameNum];
+        if (m_lastCompletionNs > start)
+        {
+            start = m_lastCompletionNs;
+        }
+        busyNs = (nowNs > start) ? (nowNs - start) / completed : 0;
+
+        m_next += completed;
+        m_lastCompletionNs = nowNs;
+        return completed;
+    }
+
+private:
+    uint32_t m_next                     = 0;   //!< counter of the oldest tracked frame not seen completed
+    uint32_t m_end                      = 0;   //!< counter following the last tracked frame
+    uint64_t m_lastCompletionNs         = 0;   //!< time the last tracked completion was seen
+    uint64_t m_submitTimeNs[frameNum]   = {};  //!< submission time of the tracked frames
+};
+
+#endif // __MEDIA_STATUS_LOAD_TRACKING_H__
@@ -27,6 +27,16 @@
 //!
 #include <algorithm>
 #include "media_status_report.h"
+#include "mos_engine_load_tracker.h"
+
+MediaStatusReport::~MediaStatusReport()
+{
+    // The status buffer may be gone already, so pending frames are not checked
+    if (m_trackedNode != MOS_GPU_NODE_MAX)
+    {
+        MosEngineLoadTracker::Instance().Abandoned(m_trackedNode, m_loadTracking.GetPending());
+    }
+}
 
 MOS_STATUS MediaStatusReport::GetAddress(uint32_t statusReportType, PMOS_RESOURCE &osResource, uint32_t &offset)
 {
@@ -54,6 +64,8 @@ MOS_STATUS MediaStatusReport::GetReport(uint16_t requireNum, void *status)
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    TrackCompletions();
+
     uint32_t completedCount = *m_completedCount;
     uint32_t reportedCount = m_reportedCount;
     uint32_t reportedCountOrigin = m_reportedCount;
@@ -136,5 +148,47 @@ MOS_STATUS MediaStatusReport::NotifyObservers(void *mfxStatus, void *rcsStatus,
     return eStatus;
 }
 
+void MediaStatusReport::SetTrackedNode(MOS_GPU_NODE node)
+{
+    if (node == m_trackedNode)
+    {
+        return;
+    }
+
+    if (m_trackedNode != MOS_GPU_NODE_MAX)
+    {
+        TrackCompletions();
+        MosEngineLoadTracker::Instance().Abandoned(m_trackedNode, m_loadTracking.GetPending());
+    }
 
+    m_trackedNode = node;
+    m_loadTracking.Start(m_submittedCount);
+}
 
+void MediaStatusReport::TrackSubmission()
+{
+    if (m_trackedNode == MOS_GPU_NODE_MAX)
+    {
+        return;
+    }
+
+    TrackCompletions();
+    m_loadTracking.Submitted(m_submittedCount, MosEngineLoadTracker::GetTimeNs());
+
+    MosEngineLoadTracker::Instance().Submitted(m_trackedNode);
+}
+
+void MediaStatusReport::TrackCompletions()
+{
+    if (m_trackedNode == MOS_GPU_NODE_MAX || m_completedCount == nullptr)
+    {
+        return;
+    }
+
+    uint64_t busy      = 0;
+    uint32_t completed = m_loadTracking.Completed(*m_completedCount, MosEngineLoadTracker::GetTimeNs(), busy);
+    for (uint32_t i = 0; i < completed; i++)
+    {
+        MosEngineLoadTracker::Instance().Completed(m_trackedNode, busy);
+    }
+}
@@ -29,6 +29,7 @@
 
 #include "mos_os_specific.h"
 #include "media_status_report_observer.h"
+#include "media_status_load_tracking.h"
 
 #define STATUS_REPORT_GLOBAL_COUNT 0
 
@@ -54,7 +55,7 @@ public:
     //! \brief  Constructor
     //!
     MediaStatusReport() {};
-    virtual ~MediaStatusReport() {};
+    virtual ~MediaStatusReport();
 
     //!
     //! \brief  Create resources for status report and do initialization
@@ -152,7 +153,32 @@ public:
     //!
     MOS_STATUS UnregistObserver(MediaStatusReportObserver *observer);
 
+    //!
+    //! \brief  Feed the process wide engine load tracker with the frames of
+    //!         this status report
+    //! \details Frames still pending on the previous node are dropped from the
+    //!          tracker, since their completion will not be accounted any more
+    //! \param  [in] node
+    //!         GPU node the next frames are submitted to, MOS_GPU_NODE_MAX
+    //!         stops tracking
+    //!
+    void SetTrackedNode(MOS_GPU_NODE node);
+
 protected:
+    //!
+    //! \brief  Account the frame of m_submittedCount as submitted to the
+    //!         tracked node, to be called before m_submittedCount moves on
+    //!
+    void TrackSubmission();
+
+    //!
+    //! \brief  Account the tracked frames the GPU completed since last time,
+    //!         the time between their submission, or the previous completion
+    //!         if later, and now is shared among them as busy time, see
+    //!         MediaStatusLoadTracking for what the time includes
+    //!
+    void TrackCompletions();
+
     //!
     //! \brief  Collect the status report information into report buffer.
     //! \param  [in] report
@@ -199,6 +225,9 @@ protected:
     StatusBufAddr    *m_statusBufAddr        = nullptr;
 
     std::vector<MediaStatusReportObserver *>  m_completeObservers;
+
+    MOS_GPU_NODE     m_trackedNode           = MOS_GPU_NODE_MAX;  //!< node fed to the engine load tracker
+    MediaStatusLoadTracking<m_statusNum> m_loadTracking;          //!< submission and completion times of the tracked frames
 MEDIA_CLASS_DEFINE_END(MediaStatusReport)
 };
 
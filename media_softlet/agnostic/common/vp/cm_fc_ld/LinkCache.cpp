@@ -0,0 +1,136 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+// Cache of linked kernels.
+//
+
+#include <cstring>
+#include <iterator>
+
+#include "LinkCache.h"
+
+using namespace cm::patch;
+
+namespace {
+
+const std::uint64_t FNVOffset = 0xcbf29ce484222325ULL;
+const std::uint64_t FNVPrime = 0x100000001b3ULL;
+
+/// FNV-1a over 64-bit words, the tail byte by byte.
+std::uint64_t hashBytes(std::uint64_t H, const char *Buf, std::size_t Size) {
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= Size; i += sizeof(std::uint64_t)) {
+    std::uint64_t W;
+    std::memcpy(&W, Buf + i, sizeof(W));
+    H = (H ^ W) * FNVPrime;
+  }
+  for (; i < Size; ++i)
+    H = (H ^ static_cast<unsigned char>(Buf[i])) * FNVPrime;
+  return H;
+}
+
+} // End anonymous namespace
+
+LinkKey::LinkKey(std::size_t NumKernels, const cm_fc_kernel_t *Kernels,
+                 const char *Opts)
+  : Hash(FNVOffset), Options(Opts ? Opts : "") {
+  std::size_t InputSize = 0;
+  for (std::size_t i = 0; i != NumKernels; ++i)
+    InputSize += Kernels[i].patch_size + Kernels[i].binary_size;
+
+  Sizes.reserve(NumKernels * 2);
+  Input.reserve(InputSize);
+  for (std::size_t i = 0; i != NumKernels; ++i) {
+    Sizes.push_back(Kernels[i].patch_size);
+    Sizes.push_back(Kernels[i].binary_size);
+    Input.append(Kernels[i].patch_buf, Kernels[i].patch_size);
+    Input.append(Kernels[i].binary_buf, Kernels[i].binary_size);
+    Hash = hashBytes(Hash, Kernels[i].patch_buf, Kernels[i].patch_size);
+    Hash = hashBytes(Hash, Kernels[i].binary_buf, Kernels[i].binary_size);
+  }
+  Hash = hashBytes(Hash, Options.data(), Options.size());
+  Hash = (Hash ^ NumKernels) * FNVPrime;
+}
+
+LinkCache &LinkCache::getInstance() {
+  static LinkCache Cache;
+  return Cache;
+}
+
+LinkCache::EntryList::iterator LinkCache::lookup(const LinkKey &Key) {
+  auto Range = Index.equal_range(Key.getHash());
+  for (auto I = Range.first; I != Range.second; ++I)
+    if (I->second->Key == Key)
+      return I->second;
+  return Entries.end();
+}
+
+void LinkCache::erase(EntryList::iterator E) {
+  auto Range = Index.equal_range(E->Key.getHash());
+  for (auto I = Range.first; I != Range.second; ++I)
+    if (I->second == E) {
+      Index.erase(I);
+      break;
+    }
+  Bytes -= E->Key.getSize() + E->Linked.size();
+  Entries.erase(E);
+}
+
+bool LinkCache::find(const LinkKey &Key, std::string &Linked) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto E = lookup(Key);
+  if (E == Entries.end()) {
+    ++Misses;
+    return false;
+  }
+  ++Hits;
+  Entries.splice(Entries.begin(), Entries, E);
+  Linked = E->Linked;
+  return true;
+}
+
+void LinkCache::insert(const LinkKey &Key, const std::string &Linked) {
+  // Skip binaries which would flush the whole cache.
+  std::size_t Size = Key.getSize() + Linked.size();
+  if (Size > MaxBytes)
+    return;
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto E = lookup(Key);
+  if (E != Entries.end())
+    erase(E);
+
+  while (!Entries.empty() && Bytes + Size > MaxBytes)
+    erase(std::prev(Entries.end()));
+
+  Entries.push_front(Entry{Key, Linked});
+  Index.insert(std::make_pair(Key.getHash(), Entries.begin()));
+  Bytes += Size;
+}
+
+void LinkCache::clear() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Index.clear();
+  Entries.clear();
+  Bytes = 0;
+  Hits = 0;
+  Misses = 0;
+}
@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+// Cache of linked kernels.
+//
+
+#pragma once
+
+#ifndef __CM_FC_LINK_CACHE_H__
+#define __CM_FC_LINK_CACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cm_fc_ld.h"
+
+#include "media_class_trace.h"
+
+namespace cm {
+namespace patch {
+
+/// LinkKey identifies the input of a link: the ordered kernel list, by the
+/// content of their patch info and binaries, and the link options. The hash
+/// only picks the candidates, keys are equal if their input bytes are.
+///
+class LinkKey {
+protected:
+  std::uint64_t Hash;
+  std::vector<std::size_t> Sizes; ///< Patch info and binary sizes, in order.
+  std::string Input;              ///< Patch infos and binaries, in order.
+  std::string Options;
+
+public:
+  LinkKey(std::size_t NumKernels, const cm_fc_kernel_t *Kernels,
+          const char *Opts);
+
+  std::uint64_t getHash() const { return Hash; }
+
+  /// Bytes held by the key, counted against the cache budget.
+  std::size_t getSize() const { return Input.size() + Options.size(); }
+
+  bool operator==(const LinkKey &Other) const {
+    return Hash == Other.Hash && Sizes == Other.Sizes &&
+           Options == Other.Options && Input == Other.Input;
+  }
+MEDIA_CLASS_DEFINE_END(cm__patch__LinkKey)
+};
+
+/// LinkCache keeps the most recently linked binaries so the same kernel list
+/// is not read, resolved and linked again. Linking is deterministic, so a
+/// cached binary is the one the linker would produce.
+///
+class LinkCache {
+  struct Entry {
+    LinkKey Key;
+    std::string Linked;
+  };
+  typedef std::list<Entry> EntryList;
+
+  std::mutex Mutex;
+  EntryList Entries; ///< Most recently used first.
+  std::unordered_multimap<std::uint64_t, EntryList::iterator> Index;
+  std::size_t Bytes;
+  std::size_t MaxBytes;
+  unsigned Hits;
+  unsigned Misses;
+
+public:
+  /// Default budget, room for a few dozen typical composition kernels and
+  /// their input.
+  static const std::size_t DefaultMaxBytes = 4 * 1024 * 1024;
+
+  explicit LinkCache(std::size_t Max = DefaultMaxBytes)
+    : Bytes(0), MaxBytes(Max), Hits(0), Misses(0) {}
+
+  static LinkCache &getInstance();
+
+  /// Copy the linked binary of the key to \p Linked, return false if it is
+  /// not cached.
+  bool find(const LinkKey &Key, std::string &Linked);
+
+  /// Add the linked binary of the key, dropping the least recently used ones
+  /// above the budget. The budget covers the keys and the binaries.
+  void insert(const LinkKey &Key, const std::string &Linked);
+
+  void clear();
+
+  unsigned getHits() const { return Hits; }
+  unsigned getMisses() const { return Misses; }
+  std::size_t getBytes() const { return Bytes; }
+
+protected:
+  EntryList::iterator lookup(const LinkKey &Key);
+  void erase(EntryList::iterator I);
+MEDIA_CLASS_DEFINE_END(cm__patch__LinkCache)
+};
+
+} // End namespace patch
+} // End namespace cm
+
+#endif // __CM_FC_LINK_CACHE_H__
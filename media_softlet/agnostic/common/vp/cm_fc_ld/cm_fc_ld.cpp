@@ -26,6 +26,7 @@
 
 #include "cm_fc_ld.h"
 
+#include "LinkCache.h"
 #include "PatchInfoLinker.h"
 #include "PatchInfoReader.h"
 #include "PatchInfoRecord.h"
@@ -76,11 +77,19 @@ int cm_fc_combine_kernels(size_t num_kernels, cm_fc_kernel_t kernels[],
   if (!out_buf || !out_size)
     return CM_FC_FAILURE;
 
-  cm::patch::Collection C;
-  if (linkPatchInfo(C, num_kernels, kernels, options))
-    return CM_FC_FAILURE;
+  // The same kernel list is linked again whenever the combined kernel is
+  // rebuilt, e.g. after it was evicted from the kernel cache.
+  cm::patch::LinkCache &Cache = cm::patch::LinkCache::getInstance();
+  cm::patch::LinkKey Key(num_kernels, kernels, options);
+  std::string B;
+  if (!Cache.find(Key, B)) {
+    cm::patch::Collection C;
+    if (linkPatchInfo(C, num_kernels, kernels, options))
+      return CM_FC_FAILURE;
+    B = C.getLinkedBinary();
+    Cache.insert(Key, B);
+  }
 
-  const std::string &B = C.getLinkedBinary();
   if (B.size() > *out_size) {
     *out_size = B.size();
     return CM_FC_NOBUFS;
@@ -21,6 +21,7 @@
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/cm_fc_ld.cpp
     ${CMAKE_CURRENT_LIST_DIR}/DepGraph.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/LinkCache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/PatchInfoLinker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/PatchInfoReader.cpp
 )
@@ -28,6 +29,7 @@ set(TMP_SOURCES_
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/cm_fc_ld.h
     ${CMAKE_CURRENT_LIST_DIR}/DepGraph.h
+    ${CMAKE_CURRENT_LIST_DIR}/LinkCache.h
     ${CMAKE_CURRENT_LIST_DIR}/PatchInfo.h
     ${CMAKE_CURRENT_LIST_DIR}/PatchInfoLinker.h
     ${CMAKE_CURRENT_LIST_DIR}/PatchInfoReader.h
@@ -39,6 +39,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_ief.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_sfc_base.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_vebox_cmd_packet.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_vebox_statistics.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_vebox_cmd_packet_base.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_sfc_common.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_vebox_common.h
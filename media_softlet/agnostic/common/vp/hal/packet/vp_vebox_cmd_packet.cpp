@@ -26,6 +26,7 @@
 //!
 
 #include "vp_vebox_cmd_packet.h"
+#include "vp_vebox_statistics.h"
 #include "vp_utils.h"
 #include "mos_resource_defs.h"
 #include "hal_oca_interface_next.h"
@@ -3124,27 +3125,22 @@ MOS_STATUS VpVeboxCmdPacket::GNELumaConsistentCheck(
     uint32_t *pStatSlice1GNEPtr)
 {
     uint32_t dwGNEChromaU = 0, dwGNEChromaV = 0;
-    uint32_t dwGNECountChromaU = 0, dwGNECountChromaV = 0;
     VP_PUBLIC_CHK_NULL_RETURN(pStatSlice0GNEPtr);
     VP_PUBLIC_CHK_NULL_RETURN(pStatSlice1GNEPtr);
 
     // Combine the GNE in slice0 and slice1 to generate the global GNE and Count
-    dwGNEChromaU = pStatSlice0GNEPtr[1] + pStatSlice1GNEPtr[1];
-    dwGNEChromaV = pStatSlice0GNEPtr[2] + pStatSlice1GNEPtr[2];
-
-    dwGNECountChromaU = pStatSlice0GNEPtr[4] + pStatSlice1GNEPtr[4];
-    dwGNECountChromaV = pStatSlice0GNEPtr[5] + pStatSlice1GNEPtr[5];
+    VP_VEBOX_GNE_STAT gne = VpVeboxStatistics::CombineGne(pStatSlice0GNEPtr, pStatSlice1GNEPtr);
 
     // Validate GNE
-    if (dwGNEChromaU == 0xFFFFFFFF || dwGNECountChromaU == 0xFFFFFFFF ||
-        dwGNEChromaV == 0xFFFFFFFF || dwGNECountChromaV == 0xFFFFFFFF)
+    if (gne.chromaU == VpVeboxStatistics::m_invalidValue || gne.countChromaU == VpVeboxStatistics::m_invalidValue ||
+        gne.chromaV == VpVeboxStatistics::m_invalidValue || gne.countChromaV == VpVeboxStatistics::m_invalidValue)
     {
         VP_RENDER_ASSERTMESSAGE("Incorrect GNE / GNE count.");
         return MOS_STATUS_UNKNOWN;
     }
 
-    dwGNEChromaU = dwGNEChromaU * 100 / (dwGNECountChromaU + 1);
-    dwGNEChromaV = dwGNEChromaV * 100 / (dwGNECountChromaV + 1);
+    dwGNEChromaU = VpVeboxStatistics::GetNoiseLevel(gne.chromaU, gne.countChromaU);
+    dwGNEChromaV = VpVeboxStatistics::GetNoiseLevel(gne.chromaV, gne.countChromaV);
     VP_RENDER_NORMALMESSAGE("Consistent Check: dwGNEChromaU %d  dwGNEChromaV %d", dwGNEChromaU, dwGNEChromaV);
     if ((dwGNEChromaU < NOSIE_GNE_CHROMA_THRESHOLD) &&
         (dwGNEChromaV < NOSIE_GNE_CHROMA_THRESHOLD) &&
@@ -3223,17 +3219,16 @@ MOS_STATUS VpVeboxCmdPacket::UpdateDnHVSParameters(
     }
 
     // Combine the GNE in slice0 and slice1 to generate the global GNE and Count
-    dwGNELuma         = pStatSlice0GNEPtr[0] + pStatSlice1GNEPtr[0];
-    dwGNEChromaU      = pStatSlice0GNEPtr[1] + pStatSlice1GNEPtr[1];
-    dwGNEChromaV      = pStatSlice0GNEPtr[2] + pStatSlice1GNEPtr[2];
-    dwGNECountLuma    = pStatSlice0GNEPtr[3] + pStatSlice1GNEPtr[3];
-    dwGNECountChromaU = pStatSlice0GNEPtr[4] + pStatSlice1GNEPtr[4];
-    dwGNECountChromaV = pStatSlice0GNEPtr[5] + pStatSlice1GNEPtr[5];
+    VP_VEBOX_GNE_STAT gne = VpVeboxStatistics::CombineGne(pStatSlice0GNEPtr, pStatSlice1GNEPtr);
+    dwGNELuma         = gne.luma;
+    dwGNEChromaU      = gne.chromaU;
+    dwGNEChromaV      = gne.chromaV;
+    dwGNECountLuma    = gne.countLuma;
+    dwGNECountChromaU = gne.countChromaU;
+    dwGNECountChromaV = gne.countChromaV;
 
     // Validate GNE
-    if (dwGNELuma == 0xFFFFFFFF || dwGNECountLuma == 0xFFFFFFFF ||
-        dwGNEChromaU == 0xFFFFFFFF || dwGNECountChromaU == 0xFFFFFFFF ||
-        dwGNEChromaV == 0xFFFFFFFF || dwGNECountChromaV == 0xFFFFFFF)
+    if (!VpVeboxStatistics::IsValid(gne))
     {
         VP_RENDER_ASSERTMESSAGE("Incorrect GNE / GNE count.");
         return MOS_STATUS_UNKNOWN;
@@ -3261,9 +3256,9 @@ MOS_STATUS VpVeboxCmdPacket::UpdateDnHVSParameters(
         tgneParams.bTgneFirstFrame = false;  // next frame bTgneFirstFrame should be false
 
         // caculate GNE
-        dwGNELuma    = dwGNELuma * 100 / (dwGNECountLuma + 1);
-        dwGNEChromaU = dwGNEChromaU * 100 / (dwGNECountChromaU + 1);
-        dwGNEChromaV = dwGNEChromaV * 100 / (dwGNECountChromaV + 1);
+        dwGNELuma    = VpVeboxStatistics::GetNoiseLevel(dwGNELuma, dwGNECountLuma);
+        dwGNEChromaU = VpVeboxStatistics::GetNoiseLevel(dwGNEChromaU, dwGNECountChromaU);
+        dwGNEChromaV = VpVeboxStatistics::GetNoiseLevel(dwGNEChromaV, dwGNECountChromaV);
 
         // Set some mhw params
         tgneParams.bTgneEnable  = true;
@@ -3313,23 +3308,25 @@ MOS_STATUS VpVeboxCmdPacket::UpdateDnHVSParameters(
     }
     else if (m_bTgneEnable && m_bTgneValid && !sharedContext->isVeboxFirstFrame)  //Middle frame
     {
-        dwGNECountLuma    = (pStatSlice0GNEPtr[3] & 0x7FFFFFFF) + (pStatSlice1GNEPtr[3] & 0x7FFFFFFF);
-        dwGNECountChromaU = (pStatSlice0GNEPtr[4] & 0x7FFFFFFF) + (pStatSlice1GNEPtr[4] & 0x7FFFFFFF);
-        dwGNECountChromaV = (pStatSlice0GNEPtr[5] & 0x7FFFFFFF) + (pStatSlice1GNEPtr[5] & 0x7FFFFFFF);
+        VP_VEBOX_GNE_STAT tgne = VpVeboxStatistics::CombineGne(
+            pStatSlice0GNEPtr, pStatSlice1GNEPtr, VpVeboxStatistics::m_tgneCountMask);
+        dwGNECountLuma    = tgne.countLuma;
+        dwGNECountChromaU = tgne.countChromaU;
+        dwGNECountChromaV = tgne.countChromaV;
 
         sgne_offset        = -12;
-        dwSGNELuma         = pStatSlice0GNEPtr[sgne_offset] + pStatSlice1GNEPtr[sgne_offset];
-        dwSGNEChromaU      = pStatSlice0GNEPtr[sgne_offset + 1] + pStatSlice1GNEPtr[sgne_offset + 1];
-        dwSGNEChromaV      = pStatSlice0GNEPtr[sgne_offset + 2] + pStatSlice1GNEPtr[sgne_offset + 2];
-        dwSGNECountLuma    = pStatSlice0GNEPtr[sgne_offset + 3] + pStatSlice1GNEPtr[sgne_offset + 3];
-        dwSGNECountChromaU = pStatSlice0GNEPtr[sgne_offset + 4] + pStatSlice1GNEPtr[sgne_offset + 4];
-        dwSGNECountChromaV = pStatSlice0GNEPtr[sgne_offset + 5] + pStatSlice1GNEPtr[sgne_offset + 5];
+        VP_VEBOX_GNE_STAT sgne = VpVeboxStatistics::CombineGne(
+            pStatSlice0GNEPtr + sgne_offset, pStatSlice1GNEPtr + sgne_offset);
+        dwSGNELuma         = sgne.luma;
+        dwSGNEChromaU      = sgne.chromaU;
+        dwSGNEChromaV      = sgne.chromaV;
+        dwSGNECountLuma    = sgne.countLuma;
+        dwSGNECountChromaU = sgne.countChromaU;
+        dwSGNECountChromaV = sgne.countChromaV;
 
         // Validate TGNE
         if (dwGNECountLuma == 0 || dwGNECountChromaU == 0 || dwGNECountChromaV == 0 ||
-            dwSGNELuma == 0xFFFFFFFF || dwSGNECountLuma == 0xFFFFFFFF ||
-            dwSGNEChromaU == 0xFFFFFFFF || dwSGNECountChromaU == 0xFFFFFFFF ||
-            dwSGNEChromaV == 0xFFFFFFFF || dwSGNECountChromaV == 0xFFFFFFF)
+            !VpVeboxStatistics::IsValid(sgne))
         {
             VP_RENDER_ASSERTMESSAGE("Incorrect GNE count.");
             return MOS_STATUS_UNKNOWN;
@@ -3383,9 +3380,9 @@ MOS_STATUS VpVeboxCmdPacket::UpdateDnHVSParameters(
         m_veboxItf->SetgnHVSParams(
             tgneParams.bTgneEnable, tgneParams.lumaStadTh, tgneParams.chromaStadTh, tgneParams.dw4X4TGNEThCnt, tgneParams.dwHistoryInit, hvsParams.hVSfallback);
 
-        hvsParams.Sgne_Level          = dwSGNELuma * 100 / (dwSGNECountLuma + 1);
-        hvsParams.Sgne_LevelU         = dwSGNEChromaU * 100 / (dwSGNECountChromaU + 1);
-        hvsParams.Sgne_LevelV         = dwSGNEChromaV * 100 / (dwSGNECountChromaV + 1);
+        hvsParams.Sgne_Level          = VpVeboxStatistics::GetNoiseLevel(dwSGNELuma, dwSGNECountLuma);
+        hvsParams.Sgne_LevelU         = VpVeboxStatistics::GetNoiseLevel(dwSGNEChromaU, dwSGNECountChromaU);
+        hvsParams.Sgne_LevelV         = VpVeboxStatistics::GetNoiseLevel(dwSGNEChromaV, dwSGNECountChromaV);
         hvsParams.Sgne_Count          = dwSGNECountLuma;
         hvsParams.Sgne_CountU         = dwSGNECountChromaU;
         hvsParams.Sgne_CountV         = dwSGNECountChromaV;
@@ -3398,9 +3395,9 @@ MOS_STATUS VpVeboxCmdPacket::UpdateDnHVSParameters(
     }
     else  //First frame and fallback frame
     {
-        dwGNELuma    = dwGNELuma * 100 / (dwGNECountLuma + 1);
-        dwGNEChromaU = dwGNEChromaU * 100 / (dwGNECountChromaU + 1);
-        dwGNEChromaV = dwGNEChromaV * 100 / (dwGNECountChromaV + 1);
+        dwGNELuma    = VpVeboxStatistics::GetNoiseLevel(dwGNELuma, dwGNECountLuma);
+        dwGNEChromaU = VpVeboxStatistics::GetNoiseLevel(dwGNEChromaU, dwGNECountChromaU);
+        dwGNEChromaV = VpVeboxStatistics::GetNoiseLevel(dwGNEChromaV, dwGNECountChromaV);
 
         GNELumaConsistentCheck(dwGNELuma, pStatSlice0GNEPtr, pStatSlice1GNEPtr);
 
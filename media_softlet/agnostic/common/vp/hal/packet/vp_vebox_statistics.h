@@ -0,0 +1,113 @@
+/*
+* Copyright (c) 2022, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_vebox_statistics.h
+//! \brief    Reduction of the per slice GNE statistics written by vebox
+//! \details  Vebox writes the global noise estimate of every slice as six
+//!           dwords: the sums of luma, U and V noise followed by their
+//!           counts. The DN/HVS feedback of the next frame works on the sums
+//!           of both slices, which are reduced here in one pass.
+//!
+
+#ifndef __VP_VEBOX_STATISTICS_H__
+#define __VP_VEBOX_STATISTICS_H__
+
+#include <stdint.h>
+
+//!
+//! \brief    Global noise estimate of a frame, summed over the slices
+//!
+union VP_VEBOX_GNE_STAT
+{
+    struct
+    {
+        uint32_t luma;              //!< sum of luma noise
+        uint32_t chromaU;           //!< sum of U noise
+        uint32_t chromaV;           //!< sum of V noise
+        uint32_t countLuma;         //!< luma blocks in the sum
+        uint32_t countChromaU;      //!< U blocks in the sum
+        uint32_t countChromaV;      //!< V blocks in the sum
+    };
+    uint32_t value[6];
+};
+
+class VpVeboxStatistics
+{
+public:
+    static constexpr uint32_t m_gneDwords     = 6;            //!< dwords of the GNE block of a slice
+    static constexpr uint32_t m_invalidValue  = 0xFFFFFFFF;   //!< value of a sum vebox failed to report
+    static constexpr uint32_t m_tgneCountMask = 0x7FFFFFFF;   //!< TGNE counts carry the valid flag in bit 31
+
+    //!
+    //! \brief    Sum the GNE blocks of two slices
+    //! \param    [in] slice0
+    //!           GNE block of slice 0
+    //! \param    [in] slice1
+    //!           GNE block of slice 1
+    //! \param    [in] countMask
+    //!           Mask applied to the counts of each slice before they are summed
+    //! \return   VP_VEBOX_GNE_STAT
+    //!
+    static VP_VEBOX_GNE_STAT CombineGne(const uint32_t *slice0, const uint32_t *slice1, uint32_t countMask = 0xFFFFFFFF)
+    {
+        const uint32_t mask[m_gneDwords] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, countMask, countMask, countMask};
+
+        // Fixed trip count without dependencies, so the compiler emits vector adds
+        VP_VEBOX_GNE_STAT gne;
+        for (uint32_t i = 0; i < m_gneDwords; i++)
+        {
+            gne.value[i] = (slice0[i] & mask[i]) + (slice1[i] & mask[i]);
+        }
+        return gne;
+    }
+
+    //!
+    //! \brief    Check no sum of the frame was reported invalid by vebox
+    //! \param    [in] gne
+    //!           Combined GNE of the frame
+    //! \return   bool
+    //!
+    static bool IsValid(const VP_VEBOX_GNE_STAT &gne)
+    {
+        uint32_t invalid = 0;
+        for (uint32_t i = 0; i < m_gneDwords; i++)
+        {
+            invalid |= (gne.value[i] == m_invalidValue);
+        }
+        return invalid == 0;
+    }
+
+    //!
+    //! \brief    Get the noise level of a sum in 1/100 units
+    //! \param    [in] sum
+    //!           Sum of noise
+    //! \param    [in] count
+    //!           Blocks in the sum
+    //! \return   uint32_t
+    //!
+    static uint32_t GetNoiseLevel(uint32_t sum, uint32_t count)
+    {
+        return sum * 100 / (count + 1);
+    }
+};
+
+#endif  // __VP_VEBOX_STATISTICS_H__
@@ -57,6 +57,8 @@ void VpFeatureReport::InitReportValue()
     m_features.diScdMode           = false;
     m_features.veFeatureInUse      = false;
     m_features.hdrMode             = VPHAL_HDR_MODE_NONE;
+    m_features.compBbHits          = 0;
+    m_features.compBbMisses        = 0;
 
     return;
 }
@@ -98,6 +100,10 @@ void VpFeatureReport::SetConfigValues(
     // Report vp packet reused flag.
     configValues->isPacketReused        = m_features.packetReused;
 
+    // Report composition batch buffer reuse
+    configValues->dwCompBbHits          = m_features.compBbHits;
+    configValues->dwCompBbMisses        = m_features.compBbMisses;
+
     // Report MMC status
     configValues->dwVPMMCInUse          = m_features.vpMMCInUse;
     configValues->dwRTCompressible      = m_features.rtCompressible;
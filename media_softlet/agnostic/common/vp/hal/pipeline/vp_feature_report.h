@@ -69,6 +69,8 @@ public:
         bool                          diScdMode           = false;                        //!< Scene change detection
         VPHAL_HDR_MODE                hdrMode             = VPHAL_HDR_MODE_NONE;          //!< HDR mode
         bool                          packetReused        = false;                        //!< true if packet reused.
+        uint32_t                      compBbHits          = 0;                            //!< Composition batch buffers reused
+        uint32_t                      compBbMisses        = 0;                            //!< Composition batch buffers not found for reuse
     };
 
     virtual ~VpFeatureReport(){};
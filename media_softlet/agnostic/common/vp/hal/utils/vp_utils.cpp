@@ -692,6 +692,20 @@ MOS_STATUS VpUtils::DeclareUserSettings(MediaUserSettingSharedPtr userSettingPtr
         0,
         true); //"HDR Mode. 0x1: H2S kernel, 0x3: H2H kernel, 0x21 65size H2S, 0x23 65size H2H, 0x31 33size H2S, 0x33 33size H2H."
 
+    DeclareUserSettingKeyForDebug(  // Composition batch buffers reused
+        userSettingPtr,
+        __VPHAL_COMP_BB_HITS,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
+    DeclareUserSettingKeyForDebug(  // Composition batch buffers not found for reuse
+        userSettingPtr,
+        __VPHAL_COMP_BB_MISSES,
+        MediaUserSetting::Group::Sequence,
+        0,
+        true);
+
     DeclareUserSettingKeyForDebug(  // VP Enable Compute Context
         userSettingPtr,
         __VPHAL_ENABLE_COMPUTE_CONTEXT,
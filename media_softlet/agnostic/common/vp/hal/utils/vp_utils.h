@@ -289,6 +289,8 @@ protected:
 #define __VPHAL_RNDR_CMFC_CONTROL                                       "CMFC Control"
 #define __VPHAL_ENABLE_1K_1DLUT                                         "Enable 1K 1DLUT"
 #define __VPHAL_VEBOX_HDR_MODE                                          "VeboxHDRMode"
+#define __VPHAL_COMP_BB_HITS                                            "Composition BB Hits"
+#define __VPHAL_COMP_BB_MISSES                                          "Composition BB Misses"
 
 #define __VPHAL_RNDR_FORCE_VP_DECOMPRESSED_OUTPUT                       "FORCE VP DECOMPRESSED OUTPUT"
 #define __VPHAL_COMP_8TAP_ADAPTIVE_ENABLE                               "8-TAP Enable"
@@ -31,6 +31,7 @@
 #include <dlfcn.h>
 #include "hwinfo_linux.h"
 #include "mos_interface.h"
+#include "media_recycle_pool.h"
 #include <stdlib.h>
 
 #include <sys/ipc.h>
@@ -259,6 +260,12 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
                 MOS_OS_NORMALMESSAGE("Media Copy state creation failed");
             }
         }
+
+        m_recyclePool = MOS_New(MediaRecyclePool, this);
+        if (nullptr == m_recyclePool)
+        {
+            MOS_OS_NORMALMESSAGE("m_recyclePool creation failed");
+        }
     }
     return eStatus;
 }
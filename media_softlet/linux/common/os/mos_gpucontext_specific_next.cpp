@@ -962,12 +962,7 @@ MOS_STATUS GpuContextSpecificNext::MapResourcesToAuxTable(mos_linux_bo *cmd_bo)
     if (auxTableMgr)
     {
         // Map compress allocations to aux table if it is not mapped.
-        for (uint32_t i = 0; i < m_numAllocations; i++)
-        {
-            auto res = (PMOS_RESOURCE)m_allocationList[i].hAllocation;
-            MOS_OS_CHK_NULL_RETURN(res);
-            MOS_OS_CHK_STATUS_RETURN(auxTableMgr->MapResource(res->pGmmResInfo, res->bo));
-        }
+        MOS_OS_CHK_STATUS_RETURN(auxTableMgr->MapResources(m_allocationList, m_numAllocations));
         MOS_OS_CHK_STATUS_RETURN(auxTableMgr->EmitAuxTableBOList(cmd_bo));
     }
     return MOS_STATUS_SUCCESS;
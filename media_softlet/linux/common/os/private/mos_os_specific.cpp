@@ -62,6 +62,7 @@
 #include "memory_policy_manager.h"
 #include "mos_oca_interface_specific.h"
 #include "mos_os_next.h"
+#include "mos_engine_load_tracker.h"
 
 //!
 //! \brief DRM VMAP patch
@@ -2613,7 +2614,20 @@ MOS_STATUS Mos_Specific_CreateVideoNodeAssociation(
     }
     else
     {
-        if (pVDBoxWorkLoad->uiVDBoxCount[0] < pVDBoxWorkLoad->uiVDBoxCount[1])
+        // The shared counts balance the sessions of all processes. Within one
+        // session of each other, the load the sessions of this process put on
+        // each VDBox decides, so heavy streams do not pile up on one VDBox.
+        const MOS_GPU_NODE    vdboxNodes[] = {MOS_GPU_NODE_VIDEO, MOS_GPU_NODE_VIDEO2};
+        MosEngineLoadTracker &tracker      = MosEngineLoadTracker::Instance();
+        int64_t               countDelta   = (int64_t)pVDBoxWorkLoad->uiVDBoxCount[0] - pVDBoxWorkLoad->uiVDBoxCount[1];
+
+        if (countDelta > -2 && countDelta < 2 &&
+            tracker.GetCost(MOS_GPU_NODE_VIDEO) != tracker.GetCost(MOS_GPU_NODE_VIDEO2))
+        {
+            *pVideoNodeOrdinal = tracker.SelectNode(vdboxNodes, 2);
+            pVDBoxWorkLoad->uiVDBoxCount[(*pVideoNodeOrdinal == MOS_GPU_NODE_VIDEO) ? 0 : 1]++;
+        }
+        else if (pVDBoxWorkLoad->uiVDBoxCount[0] < pVDBoxWorkLoad->uiVDBoxCount[1])
         {
             *pVideoNodeOrdinal = MOS_GPU_NODE_VIDEO;
             pVDBoxWorkLoad->uiVDBoxCount[0]++;